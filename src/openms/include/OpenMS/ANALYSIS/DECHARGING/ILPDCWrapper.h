@@ -61,26 +61,47 @@ public:
 
     /// Compute optimal solution and return value of objective function
     /// If the input feature map is empty, a warning is issued and -1 is returned.
+    /// The connected components of the edge graph are independent: small ones are solved
+    /// by enumeration, the others are grouped into bins. Each bin is solved as a separate ILP
+    /// (COIN-OR), several bins at a time if OpenMP is enabled.
     /// @return value of objective function
     /// and @p pairs will have all realized edges set to "active"
-    double compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const;
+    double compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const;
 
 private:
 
     /// slicing the problem into subproblems
-    double computeSlice_(const FeatureMap fm,
+    double computeSlice_(const FeatureMap& fm,
                          PairsType& pairs,
                          const PairsIndex margin_left,
                          const PairsIndex margin_right,
                          const Size verbose_level) const;
 
     /// slicing the problem into subproblems
-    double computeSliceOld_(const FeatureMap fm,
+    double computeSliceOld_(const FeatureMap& fm,
                             PairsType& pairs,
                             const PairsIndex margin_left,
                             const PairsIndex margin_right,
                             const Size verbose_level) const;
 
+    /**
+      @brief solve a small connected component without the ILP
+
+      Enumerates all joint charge/adduct variant assignments of the features in
+      @p component (if there are at most @p max_assignments) and keeps all edges
+      which agree with the best one. Since every edge weight is positive, this is
+      exactly the ILP optimum. Edge scores and activity in @p pairs are only
+      updated if the optimal set of edges is unique, otherwise false is returned
+      and the component has to go to the ILP.
+
+      @return true if the component was solved, its objective value is stored in @p score
+    */
+    bool computeSmallComponent_(const FeatureMap& fm,
+                                PairsType& pairs,
+                                const std::set<Size>& component,
+                                const Size max_assignments,
+                                double& score) const;
+
     /// calculate a score for the i_th edge
     double getLogScore_(const PairsType::value_type& pair, const FeatureMap& fm) const;
 
@@ -45,6 +45,11 @@ namespace OpenMS
   /**
       @brief A map alignment algorithm based on spectrum similarity (dynamic programming).
 
+      The maps are aligned against the first (reference) map independently of
+      each other, so they are processed in parallel if OpenMP is available.
+      The banded alignment matrices are stored contiguously and the spectrum
+      similarities of a band are computed in parallel blocks of rows.
+
       @htmlinclude OpenMS_MapAlignmentAlgorithmSpectrumAlignment.parameters
 
       @experimental This algorithm is work in progress and might change.
@@ -147,9 +152,9 @@ private:
 
         @param pattern template map.
         @param aligned map which has to be aligned.
-        @param transformation container for rebuilding the alignment only by specific data-points
+        @param transformation transformation of @p aligned, rebuilt only from specific data-points
     */
-    void prepareAlign_(const std::vector<MSSpectrum*>& pattern, PeakMap& aligned, std::vector<TransformationDescription>& transformation);
+    void prepareAlign_(const std::vector<MSSpectrum*>& pattern, PeakMap& aligned, TransformationDescription& transformation);
 
     /**
         @brief filtered the MSLevel to gain only MSLevel 1
@@ -164,18 +169,11 @@ private:
     void msFilter_(PeakMap& peakmap, std::vector<MSSpectrum*>& spectrum_pointer_container);
 
     /**
-        @brief function for the test if cell i,j of the grid is inside the band
-
-        The function returns true if the cell underlie these conditions:
-        -k<=i-j<=k+n-m
-        else return false.
-        @param i coordinate i
-        @param j coordinate j
-        @param n size of column
-        @param m size of row
-        @param k_ size of k_
+        @brief the cells i,j of the grid inside the band (-k<=i-j<=k+n-m), stored contiguously row by row
+
+        Defined in the implementation file.
     */
-    bool insideBand_(Size i, Size j, Size n, Size m, Int k_);
+    struct Band_;
 
     /**
         @brief calculate the size of the band for the alignment for two given Sequence
@@ -187,7 +185,6 @@ private:
 
         @param pattern vector of pointers of the template sequence
         @param aligned vector of pointers of the aligned sequence
-        @param buffer holds the calculated score of index i,j.
         @param column_row_orientation indicate the order of the matrix
         @param xbegin indicate the beginning of the template sequence
         @param xend indicate the end of the template sequence
@@ -195,7 +192,7 @@ private:
         @param yend indicate the end of the aligned sequence
     */
     Int bestk_(const std::vector<MSSpectrum*>& pattern,
-              std::vector<MSSpectrum*>& aligned, std::map<Size, std::map<Size, float> >& buffer,
+              std::vector<MSSpectrum*>& aligned,
               bool column_row_orientation, Size xbegin, Size xend, Size ybegin, Size yend);
 
     /**
@@ -205,9 +202,7 @@ private:
         MSSpectra are chosen by the coordinates i,j.  The two coordinates i,j
         indicate the index in the matrix. To find the right index on the
         sequence, each beginning is also given to the function.  A flag
-        indicates the labeling of the axes. The buffermatrix stores the result
-        of the scoring. If the band expands only a lookup of known scores is
-        done.
+        indicates the labeling of the axes.
 
         @param i is a index from the matrix.
         @param j is a index from the matrix.
@@ -215,12 +210,11 @@ private:
         @param alignbegin  indicate the beginning of the aligned sequence
         @param pattern vector of pointers of the template sequence
         @param aligned vector of pointers of the aligned sequence
-        @param buffer  holds the calculated score of index i,j.
         @param column_row_orientation indicate the order of the matrix
     */
     float scoreCalculation_(Size i, Size j, Size patternbegin, Size alignbegin,
                             const std::vector<MSSpectrum*>& pattern, std::vector<MSSpectrum*>& aligned,
-                            std::map<Size, std::map<Size, float> >& buffer, bool column_row_orientation);
+                            bool column_row_orientation);
 
     /**
         @brief return the score of two given MSSpectra by calling the scorefunction
@@ -232,6 +226,8 @@ private:
 
         This Alignment is based on the Needleman Wunsch Algorithm.
         To improve the time complexity a banded version was implemented, known as k - alignment.
+        The scores and the traceback of the band are kept in contiguous storage; if the band
+        has to be widened, only the scores of the new cells are calculated.
         To save some space, the alignment is going to be calculated by position xbegin to xend of one sequence and ybegin
         and yend by another given sequence. The result of the alignment is stored in the second argument.
         The first sequence is used as a template for the alignment.
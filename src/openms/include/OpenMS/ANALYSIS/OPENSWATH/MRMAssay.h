@@ -97,6 +97,14 @@ public:
 
     typedef boost::unordered_map<String, TargetedExperiment::Peptide> TargetDecoyMapT; ///< Maps the peptide id (same for target and decoy) to the decoy peptide object
 
+    /// Fragment ions of a FragmentSeqMap sorted by m/z, with the peptidoforms referenced by their index
+    struct FragmentIndex
+    {
+      std::vector<std::pair<double, Size> > ions; ///< "fragment m/z" -> index into peptidoforms, sorted by m/z
+      std::vector<std::string> peptidoforms; ///< sorted and unique peptidoforms
+    };
+    typedef boost::unordered_map<size_t, boost::unordered_map<String, FragmentIndex> > IonIndexT; ///< Stores a FragmentIndex for every entry of an IonMapT
+
     /**
       @brief Annotates and filters transitions in a TargetedExperiment
 
@@ -214,6 +222,30 @@ protected:
                                                       const FragmentSeqMap& ions,
                                                       const double mz_threshold);
 
+    /**
+      @brief Check whether fragment ion are unique ion signatures within threshold and return matching peptidoforms
+
+      Same result as the FragmentSeqMap version, but only the ions within
+      the threshold are visited (binary search on the sorted index).
+
+      @param fragment_ion the queried fragment ion
+      @param ions the m/z sorted fragment ions which could interfere with fragment_ion
+      @param mz_threshold the threshold within which to search for interferences
+
+      @return a (sorted) vector of strings containing all peptidoforms with which fragment_ion overlaps
+    */
+    std::vector<std::string> getMatchingPeptidoforms_(const double fragment_ion,
+                                                      const FragmentIndex& ions,
+                                                      const double mz_threshold);
+
+    /**
+      @brief Build the m/z sorted FragmentIndex for every entry of an ion map
+
+      @param ion_map the ion map as generated by generateTargetInSilicoMap_() or generateDecoyInSilicoMap_()
+      @param ion_index the resulting index (same keys as @p ion_map)
+    */
+    void buildIonIndex_(const IonMapT& ion_map, IonIndexT& ion_index);
+
     /**
       @brief Get swath index (precursor isolation window ordinal) for a particular precursor
 
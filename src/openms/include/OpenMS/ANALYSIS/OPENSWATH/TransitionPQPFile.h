@@ -210,7 +210,7 @@ namespace OpenMS
     public TransitionTSVFile
   {
 
-private:
+protected:
 
     /** @brief Read PQP SQLite file
      *
@@ -221,6 +221,26 @@ private:
     */
     void readPQPInput_(const char* filename, std::vector<TSVTransition>& transition_list, bool legacy_traml_id = false);
 
+    /** @brief Read PQP SQLite file directly into a LightTargetedExperiment
+     *
+     * In contrast to the TSVTransition based reader, precursor-level data
+     * (peptide or compound, proteins, modifications) is read and converted
+     * once per precursor and each transition row only refers to it by
+     * index, so that identifiers and protein accessions shared by many rows
+     * are only decoded once. The output order is the one of the
+     * TSVTransition based reader (see convertPQPToTargetedExperiment()).
+     *
+     * @param filename The input file
+     * @param targeted_exp The output targeted experiment
+     * @param precursor_windows Only read precursors (and their transitions) with an m/z strictly inside one of these windows (read everything if empty)
+     * @param legacy_traml_id Should legacy TraML IDs be used (boolean)?
+     *
+    */
+    void readPQPInput_(const char* filename,
+                       OpenSwath::LightTargetedExperiment& targeted_exp,
+                       const std::vector<std::pair<double, double> >& precursor_windows,
+                       bool legacy_traml_id = false);
+
     /** @brief Write a TargetedExperiment to a file
      *
      * @param filename Name of the output file
@@ -256,6 +276,14 @@ public:
     void convertPQPToTargetedExperiment(const char* filename, OpenMS::TargetedExperiment& targeted_exp, bool legacy_traml_id = false);
 
     /** @brief Read in a PQP file and construct a targeted experiment (Light transition structure)
+     *
+     * Transitions are ordered by precursor m/z, product m/z, library RT and
+     * transition identifier; compounds and proteins in the order in which
+     * they are first referenced by a transition.
+     *
+     * @note A peptide which maps to several genes is read once (annotated
+     * with the first gene name in sort order). Earlier versions returned
+     * its transitions once per gene.
      *
      * @param filename The input file
      * @param targeted_exp The output targeted experiment
@@ -264,6 +292,26 @@ public:
     */
     void convertPQPToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false);
 
+    /** @brief Read in a PQP file and construct a targeted experiment (Light transition structure),
+     * restricted to the given precursor isolation windows
+     *
+     * Only precursors with an m/z strictly inside one of the @p
+     * precursor_windows (lower, upper) are read, together with their
+     * transitions, peptides and proteins. This allows to load only the part
+     * of a large library that can be extracted from the SWATH windows of
+     * the data at hand.
+     *
+     * @param filename The input file
+     * @param targeted_exp The output targeted experiment
+     * @param precursor_windows Precursor m/z windows to retain (all precursors are read if empty)
+     * @param legacy_traml_id Should legacy TraML IDs be used (boolean)?
+     *
+    */
+    void convertPQPToTargetedExperiment(const char* filename,
+                                        OpenSwath::LightTargetedExperiment& targeted_exp,
+                                        const std::vector<std::pair<double, double> >& precursor_windows,
+                                        bool legacy_traml_id = false);
+
   };
 }
 
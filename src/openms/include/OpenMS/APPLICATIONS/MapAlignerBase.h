@@ -175,11 +175,12 @@ protected:
       writeLog_("Error: The number of data input and transformation output files has to be equal (parameters 'in'/'trafo_out')");
       return ILLEGAL_PARAMETERS;
     }
-    // check whether all input files have the same type (this type is used to store the output type too):
-    FileTypes::Type in_type = FileHandler::getType(ins[0]);
+    // check whether all input files have the same type (this type is used to store the output type too);
+    // omsBin files count as the XML type of their content:
+    FileTypes::Type in_type = FileHandler::getXMLEquivalentType(ins[0]);
     for (Size i = 1; i < ins.size(); ++i)
     {
-      if (FileHandler::getType(ins[i]) != in_type)
+      if (FileHandler::getXMLEquivalentType(ins[i]) != in_type)
       {
         writeLog_("Error: All input files (parameter 'in') must have the same format!");
         return ILLEGAL_PARAMETERS;
@@ -202,7 +203,7 @@ protected:
       }
 
       if ((ref_params_ == REF_RESTRICTED) && !reference_file.empty() &&
-          (FileHandler::getType(reference_file) != in_type))
+          (FileHandler::getXMLEquivalentType(reference_file) != in_type))
       {
         writeLog_("Error: Reference file must have the same format as other input files (parameters 'reference:file'/'in')");
         return ILLEGAL_PARAMETERS;
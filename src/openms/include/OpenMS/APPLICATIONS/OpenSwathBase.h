@@ -308,11 +308,13 @@ protected:
    * @param tr_type Input file type
    * @param tr_file Input file name
    * @param tsv_reader_param Parameters on how to interpret spectral data
+   * @param precursor_windows Only load precursors within these m/z windows (PQP input only, load all if empty)
    *
    */
   OpenSwath::LightTargetedExperiment loadTransitionList(const FileTypes::Type& tr_type,
                                                         const String& tr_file,
-                                                        const Param& tsv_reader_param)
+                                                        const Param& tsv_reader_param,
+                                                        const std::vector<std::pair<double, double> >& precursor_windows = std::vector<std::pair<double, double> >())
   {
     OpenSwath::LightTargetedExperiment transition_exp;
     ProgressLogger progresslogger;
@@ -328,7 +330,7 @@ protected:
     else if (tr_type == FileTypes::PQP)
     {
       progresslogger.startProgress(0, 1, "Load PQP file");
-      TransitionPQPFile().convertPQPToTargetedExperiment(tr_file.c_str(), transition_exp);
+      TransitionPQPFile().convertPQPToTargetedExperiment(tr_file.c_str(), transition_exp, precursor_windows);
       progresslogger.endProgress();
     }
     else if (tr_type == FileTypes::TSV)
@@ -0,0 +1,282 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/APPLICATIONS/TOPPBase.h>
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelProcessingConsumer.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
+
+//-------------------------------------------------------------
+// Doxygen docu
+//-------------------------------------------------------------
+
+/**
+    @page TOPP_PeakMapProcessingBase PeakMapProcessingBase
+
+    @brief Base class for TOPP tools which process spectra one by one (filters, smoothing, baseline removal).
+*/
+
+// We do not want this class to show up in the docu:
+/// @cond TOPPCLASSES
+
+namespace OpenMS
+{
+
+class TOPPPeakMapProcessingBase :
+  public TOPPBase
+{
+
+public:
+  TOPPPeakMapProcessingBase(String name, String description, bool official = true) :
+    TOPPBase(name, description, official)
+  {
+  }
+
+protected:
+
+  /// Checks of the input data, applied in the same way in-memory and in lowmemory mode
+  enum InputCheck
+  {
+    NO_CHECKS = 0,
+    CHECK_SORTED_SPECTRA = 1,        ///< spectra have to be sorted by m/z (error otherwise)
+    CHECK_SORTED_CHROMATOGRAMS = 2,  ///< chromatograms have to be sorted by RT (error otherwise)
+    CHECK_PROFILE = 4,               ///< warn if the first spectrum seems to be centroided
+    REMOVE_META_DATA_ARRAYS = 8      ///< remove meta data arrays of spectra (they cannot be sorted along), with a warning
+  };
+
+  /// Registers the 'processOption' parameter (inmemory or lowmemory)
+  void registerProcessOption_()
+  {
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+  }
+
+  /// Returns true if the data is to be processed on the fly ('processOption' is 'lowmemory')
+  bool isLowMemory_() const
+  {
+    return getStringOption_("processOption") == "lowmemory";
+  }
+
+  /**
+    @brief Checks a loaded experiment (see InputCheck)
+
+    @param exp The experiment, meta data arrays are removed if requested
+    @param checks Combination of InputCheck flags
+    @return EXECUTION_OK or INCOMPATIBLE_INPUT_DATA (the reason was logged)
+  */
+  ExitCodes checkInput_(PeakMap& exp, int checks) const
+  {
+    if ((checks & CHECK_PROFILE) && !exp.empty())
+    {
+      checkProfile_(exp[0]);
+    }
+    if (checks & CHECK_SORTED_SPECTRA)
+    {
+      for (Size i = 0; i < exp.size(); ++i)
+      {
+        if (!checkSorted_(exp[i])) return INCOMPATIBLE_INPUT_DATA;
+      }
+    }
+    if (checks & CHECK_SORTED_CHROMATOGRAMS)
+    {
+      for (Size i = 0; i < exp.getChromatograms().size(); ++i)
+      {
+        if (!checkSorted_(exp.getChromatogram(i))) return INCOMPATIBLE_INPUT_DATA;
+      }
+    }
+    if ((checks & REMOVE_META_DATA_ARRAYS) && exp.clearMetaDataArrays())
+    {
+      writeLog_("Warning: Spectrum meta data arrays cannot be sorted. They are deleted.");
+    }
+    return EXECUTION_OK;
+  }
+
+  /**
+    @brief Streams @p in through @p processor into @p out (lowmemory mode)
+
+    Spectra and chromatograms are checked on the fly, in the same way as
+    checkInput_() does for loaded data, and then processed in parallel
+    blocks.
+
+    @param in Input mzML file
+    @param out Output mzML file
+    @param processor The parallel driver holding the processing functions
+    @param action The data processing action annotated in the output
+    @param checks Combination of InputCheck flags
+    @return EXECUTION_OK or INCOMPATIBLE_INPUT_DATA (the reason was logged)
+  */
+  ExitCodes processLowMemory_(const String& in, const String& out,
+                              const ParallelExperimentProcessor& processor,
+                              DataProcessing::ProcessingAction action,
+                              int checks) const
+  {
+    ///////////////////////////////////
+    // Create the consumer objects, add data processing
+    ///////////////////////////////////
+    PlainMSDataWritingConsumer writing_consumer(out);
+    writing_consumer.addDataProcessing(getProcessingInfo_(action));
+    MSDataParallelProcessingConsumer processing_consumer(&writing_consumer, processor);
+    InputCheckingConsumer_ checking_consumer(this, &processing_consumer, checks);
+
+    ///////////////////////////////////
+    // Create new MSDataReader and set our consumer
+    ///////////////////////////////////
+    MzMLFile f;
+    f.setLogType(log_type_);
+    f.transform(in, &checking_consumer);
+    if (checking_consumer.failed())
+    {
+      return INCOMPATIBLE_INPUT_DATA;
+    }
+    processing_consumer.flush();
+
+    return EXECUTION_OK;
+  }
+
+private:
+
+  void checkProfile_(const MSSpectrum& spectrum) const
+  {
+    if (spectrum.getType(true) == SpectrumSettings::CENTROID)
+    {
+      writeLog_("Warning: OpenMS peak type estimation indicates that this is not profile data!");
+    }
+  }
+
+  bool checkSorted_(const MSSpectrum& spectrum) const
+  {
+    if (spectrum.isSorted()) return true;
+    writeLog_("Error: Not all spectra are sorted according to peak m/z positions. Use FileFilter to sort the input!");
+    return false;
+  }
+
+  bool checkSorted_(const MSChromatogram& chromatogram) const
+  {
+    if (chromatogram.isSorted()) return true;
+    writeLog_("Error: Not all chromatograms are sorted according to peak m/z positions. Use FileFilter to sort the input!");
+    return false;
+  }
+
+  /// Applies the input checks to streamed data before passing it on (parsing stops at the first error)
+  class InputCheckingConsumer_ :
+    public Interfaces::IMSDataConsumer
+  {
+  public:
+    InputCheckingConsumer_(const TOPPPeakMapProcessingBase* tool, Interfaces::IMSDataConsumer* next_consumer, int checks) :
+      tool_(tool),
+      next_consumer_(next_consumer),
+      checks_(checks),
+      spectra_count_(0),
+      meta_data_removed_(false),
+      failed_(false)
+    {
+    }
+
+    void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override
+    {
+      next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+    }
+
+    void setExperimentalSettings(const ExperimentalSettings& exp) override
+    {
+      next_consumer_->setExperimentalSettings(exp);
+    }
+
+    void consumeSpectrum(SpectrumType& s) override
+    {
+      if ((checks_ & CHECK_PROFILE) && spectra_count_ == 0)
+      {
+        tool_->checkProfile_(s);
+      }
+      ++spectra_count_;
+      if ((checks_ & CHECK_SORTED_SPECTRA) && !tool_->checkSorted_(s))
+      {
+        fail_();
+      }
+      if ((checks_ & REMOVE_META_DATA_ARRAYS) &&
+          (!s.getFloatDataArrays().empty() || !s.getIntegerDataArrays().empty() || !s.getStringDataArrays().empty()))
+      {
+        s.getFloatDataArrays().clear();
+        s.getIntegerDataArrays().clear();
+        s.getStringDataArrays().clear();
+        if (!meta_data_removed_)
+        {
+          tool_->writeLog_("Warning: Spectrum meta data arrays cannot be sorted. They are deleted.");
+          meta_data_removed_ = true;
+        }
+      }
+      next_consumer_->consumeSpectrum(s);
+    }
+
+    void consumeChromatogram(ChromatogramType& c) override
+    {
+      if ((checks_ & CHECK_SORTED_CHROMATOGRAMS) && !tool_->checkSorted_(c))
+      {
+        fail_();
+      }
+      next_consumer_->consumeChromatogram(c);
+    }
+
+    /// Returns true if the input did not pass the checks
+    bool failed() const
+    {
+      return failed_;
+    }
+
+  private:
+    void fail_()
+    {
+      failed_ = true;
+      throw Internal::XMLHandler::EndParsingSoftly(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+    }
+
+    const TOPPPeakMapProcessingBase* tool_;
+    Interfaces::IMSDataConsumer* next_consumer_;
+    int checks_;
+    Size spectra_count_;
+    bool meta_data_removed_;
+    bool failed_;
+  };
+
+};
+
+}
+
+/// @endcond
@@ -6,6 +6,7 @@ set(sources_list_h
 ConsoleUtils.h
 INIUpdater.h
 MapAlignerBase.h
+PeakMapProcessingBase.h
 ParameterInformation.h
 ToolHandler.h
 TOPPBase.h
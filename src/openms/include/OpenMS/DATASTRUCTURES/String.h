@@ -505,6 +505,19 @@ public:
     {
     }
 
+    // create view on a character range (e.g. a buffer or memory-mapped file)
+    StringView(const char* begin, Size size) : begin_(begin), size_(size)
+    {
+    }
+
+    /// assignment
+    StringView& operator=(const StringView& s)
+    {
+      begin_ = s.begin_;
+      size_ = s.size_;
+      return *this;
+    }
+
     /// less operator
     bool operator<(const StringView other) const
     {
@@ -542,6 +555,24 @@ public:
       return size_;
     }
 
+    /// is the view empty?
+    inline bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    /// pointer to the first character (the view is not zero-terminated!)
+    inline const char* begin() const
+    {
+      return begin_;
+    }
+
+    /// pointer past the last character
+    inline const char* end() const
+    {
+      return begin_ + size_;
+    }
+
     /// create String object from view
     inline String getString() const
     {
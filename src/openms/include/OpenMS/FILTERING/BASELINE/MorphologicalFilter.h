@@ -39,6 +39,7 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
 #include <algorithm>
@@ -199,8 +200,9 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
+      // the buffer is static only to avoid reallocation (thread-local, so that
+      // several filters can run concurrently, see ParallelExperimentProcessor)
+      static thread_local std::vector<typename InputIterator::value_type> buffer;
       const UInt size = input_end - input_begin;
 
       //determine the struct size in data points if not already set
@@ -326,13 +328,12 @@ public:
     */
     void filterExperiment(PeakMap & exp)
     {
-      startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
-      {
-        filter(exp[i]);
-        setProgress(i);
-      }
-      endProgress();
+      // each thread works on its own copy of the filter
+      MorphologicalFilter filter_copy(*this);
+      ParallelExperimentProcessor processor;
+      processor.setLogType(getLogType());
+      processor.setSpectraProcessingFunc([filter_copy](MSSpectrum& s) mutable { filter_copy.filter(s); });
+      processor.processExperiment(exp, "filtering baseline");
     }
 
 protected:
@@ -351,7 +352,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
+      static thread_local std::vector<ValueType> buffer;
       if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
 
       Int anchor;           // anchoring position of the current block
@@ -451,7 +452,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
+      static thread_local std::vector<ValueType> buffer;
       if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
 
       Int anchor;           // anchoring position of the current block
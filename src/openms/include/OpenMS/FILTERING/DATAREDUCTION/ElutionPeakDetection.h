@@ -97,6 +97,12 @@ public:
     /** @brief Extracts chromatographic peaks from multiple MassTraces and
      *         stores the resulting split traces in a vector of new mass traces.
      *
+     * The traces are processed in parallel. Each thread reuses its own
+     * buffers (smoothing input/output, smoothing filters, extrema search)
+     * across traces and writes its results into the slot of the input trace,
+     * so no locking is needed and @p single_mtraces follows the order of @p
+     * mt_vec (independent of the number of threads).
+     *
      * @note Smoothed intensities are added to @p mt_vec
      *
      * @param mt_vec Input mass traces
@@ -163,8 +169,18 @@ private:
     /// Whether to apply S/N filtering
     bool mt_snr_filtering_;
 
+    /// Reusable buffers for processing one mass trace at a time (defined in the implementation, one per thread)
+    struct Workspace_;
+
     /// Main function to do the work
-    void detectElutionPeaks_(MassTrace&, std::vector<MassTrace>&);
+    void detectElutionPeaks_(MassTrace&, std::vector<MassTrace>&, Workspace_&) const;
+
+    /// Implementation of findLocalExtrema() using the buffers of @p ws
+    void findLocalExtrema_(const MassTrace& tr, Size num_neighboring_peaks,
+                           std::vector<Size>& chrom_maxes, std::vector<Size>& chrom_mins, Workspace_& ws) const;
+
+    /// Implementation of smoothData() using the buffers of @p ws
+    void smoothData_(MassTrace& mt, int win_size, Workspace_& ws) const;
   };
 
 } // namespace OpenMS
@@ -66,9 +66,15 @@ public:
     /// copy constructor
     FeatureHypothesis(const FeatureHypothesis&);
 
+    /// move constructor
+    FeatureHypothesis(FeatureHypothesis&&) = default;
+
     /// assignment operator
     FeatureHypothesis& operator=(const FeatureHypothesis& rhs);
 
+    /// move assignment operator
+    FeatureHypothesis& operator=(FeatureHypothesis&&) = default;
+
     // getter & setter
     Size getSize() const;
 
@@ -182,6 +188,9 @@ protected:
     void updateMembers_() override;
 
 private:
+    /// Per-thread hypothesis arena and scoring buffers (defined in the implementation)
+    struct Workspace_;
+
     /** @brief Computes the cosine similarity between two vectors
      *
      * The cosine similarity (or cosine distance) is the cosine of the angle
@@ -233,24 +242,27 @@ private:
     /** @brief Perform retention time scoring of two multiple mass traces
      *
      * Computes the similarity of the two peak shapes using cosine similarity
-     * (see computeCosineSim_) if som#include <OpenMS/KERNEL/MSExperiment.h>
-e conditions are fulfilled. Mainly the
+     * (see computeCosineSim_) if some conditions are fulfilled. Mainly the
      * overlap between the two peaks at FHWM needs to exceed a certain
      * threshold. The threshold is set at 0.7 (i.e. 70 % overlap) as also
      * described in Kenar et al.
      *
      * @note this only works for equally sampled mass traces, e.g. they need to
      * come from the same map (not for SRM measurements for example).
+     *
+     * The coinciding intensities are collected in the buffers of @p ws.
     */
-    double scoreRT_(const MassTrace&, const MassTrace&) const;
+    double scoreRT_(const MassTrace&, const MassTrace&, Workspace_& ws) const;
 
     /** @brief Perform intensity scoring using the averagine model (for peptides only)
      *
      * Compare the isotopic intensity distribution with the theoretical one
      * expected for peptides, using the averagine model. Compute the cosine
      * similarity between the two values.
+     *
+     * The averagine distribution is estimated with the generator of @p ws.
     */
-    double computeAveragineSimScore_(const std::vector<double>& intensities, const double& molecular_weight) const;
+    double computeAveragineSimScore_(const std::vector<double>& intensities, const double& molecular_weight, Workspace_& ws) const;
 
     /** @brief Identify groupings of mass traces based on a set of reasonable candidates
      *
@@ -258,9 +270,10 @@ e conditions are fulfilled. Mainly the
      * all combinations of charge and isotopic positions on the candidates. It
      * is assumed that candidates[0] is the monoisotopic trace.
      *
-     * The resulting possible groupings are appended to output_hypotheses.
+     * The resulting possible groupings are appended to the hypotheses of
+     * @p ws (the arena of the calling thread, no synchronization needed).
     */
-    void findLocalFeatures_(const std::vector<const MassTrace*>& candidates, double total_intensity, std::vector<FeatureHypothesis>& output_hypotheses) const;
+    void findLocalFeatures_(const std::vector<const MassTrace*>& candidates, double total_intensity, Workspace_& ws) const;
 
     /// SVM parameters
     svm_model* isotope_filt_svm_;
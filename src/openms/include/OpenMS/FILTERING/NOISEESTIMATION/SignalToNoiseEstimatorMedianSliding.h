@@ -0,0 +1,334 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+//
+
+#pragma once
+
+
+#include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimator.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+#include <set>
+
+namespace OpenMS
+{
+  /**
+    @brief Estimates the signal/noise (S/N) ratio of each data point in a scan by using the exact median of a sliding window
+
+    For each datapoint in the given scan, we collect a range of data points
+    around it (param: <i>win_len</i>). The noise for a datapoint is estimated
+    to be the median of the intensities of the current window (for an even
+    number of elements, the lower of the two middle values is used, as in
+    SignalToNoiseEstimatorMedian). If the number of elements in the current
+    window is not sufficient (param: <i>min_required_elements</i>), the noise
+    level is set to a default value (param: <i>noise_for_empty_window</i>).
+
+    In contrast to SignalToNoiseEstimatorMedian, no intensity histogram is
+    used, so there is neither a binning error nor a need to estimate a maximal
+    intensity. The window is moved across the scan by inserting the data
+    points entering it and removing the ones leaving it from two balanced
+    ordered sets (lower and upper half of the window). The median is always
+    the largest element of the lower half, which makes the cost per data
+    point O(log w) for a window holding w points, independent of the
+    intensity distribution.
+
+    Changing any of the parameters will invalidate the S/N values (which will invoke a recomputation on the next request).
+
+    @note If more than 20 percent of windows have less than <i>min_required_elements</i> of elements, a warning is issued to <i>OPENMS_LOG_WARN</i> and noise estimates in those windows are set to the constant <i>noise_for_empty_window</i>.
+
+    @htmlinclude OpenMS_SignalToNoiseEstimatorMedianSliding.parameters
+
+    @ingroup SignalProcessing
+  */
+
+  template <typename Container = MSSpectrum>
+  class SignalToNoiseEstimatorMedianSliding :
+    public SignalToNoiseEstimator<Container>
+  {
+
+public:
+
+    using SignalToNoiseEstimator<Container>::stn_estimates_;
+    using SignalToNoiseEstimator<Container>::first_;
+    using SignalToNoiseEstimator<Container>::last_;
+    using SignalToNoiseEstimator<Container>::is_result_valid_;
+    using SignalToNoiseEstimator<Container>::defaults_;
+    using SignalToNoiseEstimator<Container>::param_;
+
+    typedef typename SignalToNoiseEstimator<Container>::PeakIterator PeakIterator;
+    typedef typename SignalToNoiseEstimator<Container>::PeakType PeakType;
+
+    /// default constructor
+    inline SignalToNoiseEstimatorMedianSliding()
+    {
+      //set the name for DefaultParamHandler error messages
+      this->setName("SignalToNoiseEstimatorMedianSliding");
+
+      defaults_.setValue("win_len", 200.0, "window length in Thomson");
+      defaults_.setMinFloat("win_len", 1.0);
+
+      defaults_.setValue("min_required_elements", 10, "minimum number of elements required in a window (otherwise it is considered sparse)");
+      defaults_.setMinInt("min_required_elements", 1);
+
+      defaults_.setValue("noise_for_empty_window", std::pow(10.0, 20), "noise value used for sparse windows", ListUtils::create<String>("advanced"));
+
+      defaults_.setValue("write_log_messages", "true", "Write out log messages in case of sparse windows");
+      defaults_.setValidStrings("write_log_messages", ListUtils::create<String>("true,false"));
+
+      SignalToNoiseEstimator<Container>::defaultsToParam_();
+    }
+
+    /// Copy Constructor
+    inline SignalToNoiseEstimatorMedianSliding(const SignalToNoiseEstimatorMedianSliding & source) :
+      SignalToNoiseEstimator<Container>(source)
+    {
+      updateMembers_();
+    }
+
+    /** @name Assignment
+     */
+    //@{
+    ///
+    inline SignalToNoiseEstimatorMedianSliding & operator=(const SignalToNoiseEstimatorMedianSliding & source)
+    {
+      if (&source == this) return *this;
+
+      SignalToNoiseEstimator<Container>::operator=(source);
+      updateMembers_();
+      return *this;
+    }
+
+    //@}
+
+    /// Destructor
+    ~SignalToNoiseEstimatorMedianSliding() override
+    {}
+
+    /// Returns how many percent of the windows were sparse
+    double getSparseWindowPercent() const
+    {
+      return sparse_window_percent_;
+    }
+
+protected:
+
+    /**
+      @brief Order statistic of a sliding window of intensities
+
+      Keeps the lower half (including the median) and the upper half of the
+      window in two ordered multisets, whose sizes differ by at most one.
+    */
+    class SlidingMedian_
+    {
+public:
+      /// add an intensity to the window
+      void insert(double value)
+      {
+        if (lower_.empty() || value <= *lower_.rbegin())
+        {
+          lower_.insert(value);
+        }
+        else
+        {
+          upper_.insert(value);
+        }
+        rebalance_();
+      }
+
+      /// remove one occurrence of an intensity which was added before
+      void erase(double value)
+      {
+        if (!lower_.empty() && value <= *lower_.rbegin())
+        {
+          lower_.erase(lower_.find(value));
+        }
+        else
+        {
+          upper_.erase(upper_.find(value));
+        }
+        rebalance_();
+      }
+
+      /// number of elements in the window
+      Size size() const
+      {
+        return lower_.size() + upper_.size();
+      }
+
+      /// the ceil(size/2)-th smallest element (window must not be empty)
+      double median() const
+      {
+        return *lower_.rbegin();
+      }
+
+private:
+      void rebalance_()
+      {
+        if (lower_.size() > upper_.size() + 1)
+        {
+          typename std::multiset<double>::iterator largest = --lower_.end();
+          upper_.insert(upper_.begin(), *largest);
+          lower_.erase(largest);
+        }
+        else if (upper_.size() > lower_.size())
+        {
+          lower_.insert(lower_.end(), *upper_.begin());
+          upper_.erase(upper_.begin());
+        }
+      }
+
+      std::multiset<double> lower_;
+      std::multiset<double> upper_;
+    };
+
+    /** Calculate signal-to-noise values for all data points given, by using a sliding window approach
+
+        @param scan_first_ first element in the scan
+        @param scan_last_ last element in the scan (disregarded)
+    */
+    void computeSTN_(const PeakIterator & scan_first_, const PeakIterator & scan_last_) override
+    {
+      // reset counter for sparse windows
+      sparse_window_percent_ = 0;
+
+      // reset the results
+      stn_estimates_.clear();
+
+      PeakIterator window_pos_center  = scan_first_;
+      PeakIterator window_pos_borderleft = scan_first_;
+      PeakIterator window_pos_borderright = scan_first_;
+
+      double window_half_size = win_len_ / 2;
+
+      SlidingMedian_ window;
+
+      // number of windows
+      int window_count = 0;
+
+      double noise;    // noise value of a datapoint
+
+      // determine how many elements we need to estimate (for progress estimation)
+      int windows_overall = 0;
+      PeakIterator run = scan_first_;
+      while (run != scan_last_)
+      {
+        ++windows_overall;
+        ++run;
+      }
+      SignalToNoiseEstimator<Container>::startProgress(0, windows_overall, "noise estimation of data");
+
+      // MAIN LOOP
+      while (window_pos_center != scan_last_)
+      {
+        // erase all elements that will leave the window on the LEFT side
+        while ((*window_pos_borderleft).getMZ() <  (*window_pos_center).getMZ() - window_half_size)
+        {
+          window.erase((*window_pos_borderleft).getIntensity());
+          ++window_pos_borderleft;
+        }
+
+        // add all elements that will enter the window on the RIGHT side
+        while ((window_pos_borderright != scan_last_)
+              && ((*window_pos_borderright).getMZ() <= (*window_pos_center).getMZ() + window_half_size))
+        {
+          window.insert((*window_pos_borderright).getIntensity());
+          ++window_pos_borderright;
+        }
+
+        if ((int)window.size() < min_required_elements_)
+        {
+          noise = noise_for_empty_window_;
+          ++sparse_window_percent_;
+        }
+        else
+        {
+          // just avoid division by 0
+          noise = std::max(1.0, window.median());
+        }
+
+        // store result
+        stn_estimates_[*window_pos_center] = (*window_pos_center).getIntensity() / noise;
+
+        // advance the window center by one datapoint
+        ++window_pos_center;
+        ++window_count;
+        // update progress
+        SignalToNoiseEstimator<Container>::setProgress(window_count);
+
+      } // end while
+
+      SignalToNoiseEstimator<Container>::endProgress();
+
+      if (window_count == 0) return;
+
+      sparse_window_percent_ = sparse_window_percent_ * 100 / window_count;
+
+      // warn if percentage of sparse windows is above 20%
+      if (sparse_window_percent_ > 20 && write_log_messages_)
+      {
+        OPENMS_LOG_WARN << "WARNING in SignalToNoiseEstimatorMedianSliding: "
+                 << sparse_window_percent_
+                 << "% of all windows were sparse. You should consider increasing 'win_len' or decreasing 'min_required_elements'"
+                 << std::endl;
+      }
+    }
+
+    /// overridden function from DefaultParamHandler to keep members up to date, when a parameter is changed
+    void updateMembers_() override
+    {
+      win_len_                 = (double)param_.getValue("win_len");
+      min_required_elements_   = param_.getValue("min_required_elements");
+      noise_for_empty_window_  = (double)param_.getValue("noise_for_empty_window");
+      write_log_messages_      = (bool)param_.getValue("write_log_messages").toBool();
+      is_result_valid_         = false;
+    }
+
+    /// range of data points which belong to a window in Thomson
+    double win_len_;
+    /// minimal number of elements a window needs to cover to be used
+    int min_required_elements_;
+    /// used as noise value for windows which cover less than "min_required_elements_"
+    /// use a very high value if you want to get a low S/N result
+    double noise_for_empty_window_;
+
+    // whether to write out log messages in the case of sparse windows
+    bool write_log_messages_;
+
+    // counter for sparse windows
+    double sparse_window_percent_;
+
+  };
+
+} // namespace OpenMS
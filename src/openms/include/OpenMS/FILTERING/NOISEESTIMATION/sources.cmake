@@ -7,6 +7,7 @@ SignalToNoiseEstimator.h
 SignalToNoiseEstimatorMeanIterative.h
 SignalToNoiseEstimatorMedian.h
 SignalToNoiseEstimatorMedianRapid.h
+SignalToNoiseEstimatorMedianSliding.h
 )
 
 ### add path to the filenames
@@ -41,6 +41,7 @@
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilterAlgorithm.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
 
 #include <cmath>
 
@@ -192,19 +193,13 @@ public:
     */
     void filterExperiment(PeakMap & map)
     {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
-      endProgress();
+      // each thread works on its own copy of the filter
+      GaussFilter filter_copy(*this);
+      ParallelExperimentProcessor processor;
+      processor.setLogType(getLogType());
+      processor.setSpectraProcessingFunc([filter_copy](MSSpectrum& s) mutable { filter_copy.filter(s); });
+      processor.setChromatogramProcessingFunc([filter_copy](MSChromatogram& c) mutable { filter_copy.filter(c); });
+      processor.processExperiment(map, "smoothing data");
     }
 
 protected:
@@ -137,6 +137,12 @@ public:
         IterT mz_out,
         IterT int_out)
     {
+      // equidistant data (e.g. most chromatograms) can use pre-tabulated weights
+      if (!use_ppm_tolerance_ && isEquidistant_(mz_in_start, mz_in_end))
+      {
+        return filterEquidistant_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out);
+      }
+
       bool found_signal = false;
 
       ConstIterT mz_it = mz_in_start;
@@ -177,6 +183,100 @@ protected:
     bool use_ppm_tolerance_;
     double ppm_tolerance_;
 
+    /// Maximal relative deviation of the spacing for data to be considered equidistant
+    static const double EQUIDISTANT_TOLERANCE;
+
+    /// Returns the (interpolated) value of the kernel at the given distance from its center
+    double coefficientAt_(double distance) const;
+
+    /// Checks if the positions are equally spaced (within EQUIDISTANT_TOLERANCE)
+    template <typename ConstIterT>
+    bool isEquidistant_(ConstIterT first, ConstIterT last) const
+    {
+      const SignedSize n = std::distance(first, last);
+      if (n < 3) return false;
+
+      const double spacing = (*(last - 1) - *first) / (n - 1);
+      if (!(spacing > 0)) return false;
+
+      const double max_deviation = spacing * EQUIDISTANT_TOLERANCE;
+      for (ConstIterT it = first + 1; it != last; ++it)
+      {
+        if (fabs((*it - *(it - 1)) - spacing) > max_deviation) return false;
+      }
+      return true;
+    }
+
+    /**
+      @brief Fast path of filter() for equidistant data
+
+      Since all data points have the same distance to their neighbors, the
+      kernel weights only depend on the offset between two points and can be
+      tabulated once instead of being interpolated for every pair of points.
+      The integration windows and the trapezoid widths are determined exactly
+      as in integrate_(), the result agrees with it up to the rounding of the
+      data positions.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterEquidistant_(
+        ConstIterT mz_in_start,
+        ConstIterT mz_in_end,
+        ConstIterT int_in_start,
+        IterT mz_out,
+        IterT int_out)
+    {
+      const SignedSize n = std::distance(mz_in_start, mz_in_end);
+      const double first_pos = *mz_in_start;
+      const double last_pos = *(mz_in_end - 1);
+      const double spacing = (last_pos - first_pos) / (n - 1);
+      const double half_width = coeffs_.size() * spacing_;
+
+      // tabulate the kernel for all offsets (plus a margin for rounding)
+      const SignedSize nr_weights = (SignedSize)(half_width / spacing) + 3;
+      std::vector<double> weights(nr_weights);
+      for (SignedSize k = 0; k < nr_weights; ++k)
+      {
+        weights[k] = coefficientAt_(k * spacing);
+      }
+
+      bool found_signal = false;
+      for (SignedSize i = 0; i < n; ++i)
+      {
+        const double x = *(mz_in_start + i);
+        const double start_pos = (x - half_width > first_pos) ? x - half_width : first_pos;
+        const double end_pos = (x + half_width < last_pos) ? x + half_width : last_pos;
+        double v = 0.;
+        double norm = 0.;
+
+        // integrate from middle to start_pos
+        for (SignedSize k = 1; k <= i && k < nr_weights && *(mz_in_start + (i - k)) > start_pos; ++k)
+        {
+          const double width = fabs(*(mz_in_start + (i - k)) - *(mz_in_start + (i - k + 1))) / 2.;
+          norm += width * (weights[k] + weights[k - 1]);
+          v += width * (*(int_in_start + (i - k)) * weights[k] + *(int_in_start + (i - k + 1)) * weights[k - 1]);
+        }
+
+        // integrate from middle to end_pos
+        for (SignedSize k = 1; i + k < n && k < nr_weights && *(mz_in_start + (i + k)) < end_pos; ++k)
+        {
+          const double width = fabs(*(mz_in_start + (i + k - 1)) - *(mz_in_start + (i + k))) / 2.;
+          norm += width * (weights[k - 1] + weights[k]);
+          v += width * (*(int_in_start + (i + k - 1)) * weights[k - 1] + *(int_in_start + (i + k)) * weights[k]);
+        }
+
+        const double new_int = (v > 0) ? v / norm : 0;
+
+        // store new intensity and m/z into output iterator
+        *mz_out = x;
+        *int_out = new_int;
+        ++mz_out;
+        ++int_out;
+
+        if (fabs(new_int) > 0) found_signal = true;
+      }
+      return found_signal;
+    }
+
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
     double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
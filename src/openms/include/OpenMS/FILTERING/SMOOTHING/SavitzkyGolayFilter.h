@@ -38,6 +38,7 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
 
 namespace OpenMS
 {
@@ -143,19 +144,50 @@ public:
       }
 
       // compute the steady state output
-      InputIt it_help = (last - mid);
+      //
+      // All interior points share the same row of coefficients. The
+      // intensities are copied into a contiguous buffer and four output points
+      // are computed at once with independent accumulators, which the compiler
+      // maps to vector registers. Each output point still sums its terms in
+      // the same order as the scalar loop, so the result is unchanged.
+      const Size steady_size = n - 2 * mid - 1;
+      std::vector<double> intensities;
+      intensities.reserve(n);
+      for (InputIt it = first - mid; it != last; ++it)
+      {
+        intensities.push_back(it->getIntensity());
+      }
+      const double* row = &coeffs_[mid * frame_size_];
+      const double* in = intensities.data();
+      double acc[4];
 
-      while (first != it_help)
+      Size k = 0;
+      for (; k + 4 <= steady_size; k += 4)
+      {
+        acc[0] = acc[1] = acc[2] = acc[3] = 0;
+        for (j = 0; j < frame_size_; ++j)
+        {
+          const double coeff = row[j];
+          acc[0] += in[k + j] * coeff;
+          acc[1] += in[k + j + 1] * coeff;
+          acc[2] += in[k + j + 2] * coeff;
+          acc[3] += in[k + j + 3] * coeff;
+        }
+        for (Size l = 0; l < 4; ++l)
+        {
+          out_it->setPosition(first->getPosition());
+          out_it->setIntensity(std::max(0.0, acc[l]));
+          ++out_it;
+          ++first;
+        }
+      }
+      for (; k < steady_size; ++k)
       {
-        InputIt it_forward = (first - mid);
         help = 0;
-
         for (j = 0; j < frame_size_; ++j)
         {
-          help += it_forward->getIntensity() * coeffs_[mid * frame_size_ + j];
-          ++it_forward;
+          help += in[k + j] * row[j];
         }
-
         out_it->setPosition(first->getPosition());
         out_it->setIntensity(std::max(0.0, help));
         ++out_it;
@@ -213,19 +245,13 @@ public:
     */
     void filterExperiment(PeakMap & map)
     {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
-      endProgress();
+      // each thread works on its own copy of the filter
+      SavitzkyGolayFilter filter_copy(*this);
+      ParallelExperimentProcessor processor;
+      processor.setLogType(getLogType());
+      processor.setSpectraProcessingFunc([filter_copy](MSSpectrum& s) mutable { filter_copy.filter(s); });
+      processor.setChromatogramProcessingFunc([filter_copy](MSChromatogram& c) mutable { filter_copy.filter(c); });
+      processor.processExperiment(map, "smoothing data");
     }
 
 protected:
@@ -109,6 +109,9 @@ protected:
     /// Writes a peptide identification to a stream (for assigned/unassigned peptide identifications)
     void writePeptideIdentification_(const String& filename, std::ostream& os, const PeptideIdentification& id, const String& tag_name, UInt indentation_level);
 
+    /// Writes a consensus element to a stream (called from several threads during store())
+    void writeConsensusElement_(const String& filename, std::ostream& os, const ConsensusFeature& elem);
+
 
     /// Options that can be set
     PeakFileOptions options_;
@@ -117,6 +120,7 @@ protected:
     //@{
     ConsensusMap* consensus_map_;
     ConsensusFeature act_cons_element_;
+    std::vector<FeatureHandle> act_cons_handles_; ///< handles of the current consensusElement, inserted on its end tag
     DPosition<2> pos_;
     double it_;
     //@}
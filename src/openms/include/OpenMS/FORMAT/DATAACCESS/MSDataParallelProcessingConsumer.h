@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Consumer which processes blocks of streamed data in parallel
+
+      Spectra and chromatograms passed to this consumer are collected in a
+      buffer of @p buffer_size items. Once the buffer is full, all items are
+      processed in parallel by a ParallelExperimentProcessor and then passed on
+      (in their original order) to the next consumer, e.g. a
+      MSDataWritingConsumer. This allows to use the parallel driver for data
+      which is read from disk on the fly and never fully held in memory.
+
+      Usage:
+      @code
+      MSDataWritingConsumer writer(outfile);
+      {
+        MSDataParallelProcessingConsumer parallel_consumer(&writer, processor);
+        MzMLFile().transform(infile, &parallel_consumer);
+        parallel_consumer.flush(); // passes the remaining data to the writer
+      }
+      @endcode
+
+      @note The consumed spectra are copied into the buffer, so the processed
+      data is only seen by the next consumer and not by the caller.
+
+      @note It is essential to not delete the underlying next_consumer before
+      deleting this object, since the destructor flushes the remaining data.
+    */
+    class OPENMS_DLLAPI MSDataParallelProcessingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param next_consumer Consumer which receives the processed data
+        @param processor The parallel driver holding the processing functions
+        @param buffer_size Number of spectra or chromatograms processed at once
+
+        @note This does not transfer ownership of the consumer
+      */
+      MSDataParallelProcessingConsumer(Interfaces::IMSDataConsumer* next_consumer,
+                                       const ParallelExperimentProcessor& processor,
+                                       Size buffer_size = 1000);
+
+      /**
+        @brief Destructor
+
+        Flushes remaining data to next consumer. Errors raised while doing so
+        cannot be propagated from a destructor and are only logged, call
+        flush() explicitly to get them reported.
+      */
+      ~MSDataParallelProcessingConsumer() override;
+
+      /// Passes the expected size on to the next consumer
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      /// Passes the experimental settings on to the next consumer
+      void setExperimentalSettings(const ExperimentalSettings& exp) override;
+
+      void consumeSpectrum(SpectrumType& s) override;
+
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /**
+        @brief Processes all buffered data and passes it on to the next consumer
+
+        @exception Exceptions of the processing functions or the next consumer are passed on
+      */
+      void flush();
+
+    protected:
+
+      void flushSpectra_();
+
+      void flushChromatograms_();
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      ParallelExperimentProcessor processor_;
+      Size buffer_size_;
+      std::vector<SpectrumType> spectra_buffer_;
+      std::vector<ChromatogramType> chromatograms_buffer_;
+    };
+
+} //end namespace OpenMS
+
@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <memory>
+#include <vector>
+
+class QFile;
+
+namespace OpenMS
+{
+  /**
+    @brief Streaming reader for large delimited text files (TSV, CSV, mzTab, ...)
+
+    In contrast to TextFile, the file is not copied into a buffer of lines.
+    It is memory-mapped and read line by line. Each line is split into fields
+    which are returned as StringView objects pointing into the mapped file, so
+    no memory is allocated per line or field. Memory usage is therefore
+    independent of the file size (apart from the pages cached by the operating
+    system).
+
+    Line endings are handled like in TextFile::getLine() (\\n, \\r\\n and \\r).
+    Fields are separated by a single delimiter character, quotes are not
+    interpreted. A delimiter at the end of a line yields an empty last field.
+
+    @note The views returned by line() and fields() are only valid until the
+    next call of readLine() or the destruction of the reader. Use
+    StringView::getString() to keep a copy.
+
+    If the file cannot be mapped (e.g. it is a pipe), it is read into memory
+    instead.
+
+    Usage:
+    @code
+    DelimitedTextReader reader("library.tsv", '\t');
+    while (reader.readLine())
+    {
+      double mz = DelimitedTextReader::toDouble(reader.fields()[0]);
+      ...
+    }
+    @endcode
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI DelimitedTextReader
+  {
+public:
+    /**
+      @brief Opens and maps the file @p filename
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::FileNotReadable is thrown if the file cannot be read
+    */
+    explicit DelimitedTextReader(const String& filename, char delimiter = '\t');
+
+    /// Destructor (unmaps and closes the file)
+    ~DelimitedTextReader();
+
+    /**
+      @brief Advances to the next line and splits it into fields
+
+      @return false if the end of the file was reached (there is no current line then)
+    */
+    bool readLine();
+
+    /// The current line (without line ending)
+    const StringView& line() const;
+
+    /// The fields of the current line
+    const std::vector<StringView>& fields() const;
+
+    /// Number of the current line (the first line has number 1; 0 before the first call of readLine())
+    Size getLineNumber() const;
+
+    /// Sets the delimiter (takes effect with the next call of readLine())
+    void setDelimiter(char delimiter);
+
+    /// Returns the delimiter
+    char getDelimiter() const;
+
+    /**
+      @brief Converts the field @p s to a double (leading and trailing whitespace is allowed)
+
+      Same behavior as String::toDouble(), but without creating a String.
+
+      @exception Exception::ConversionError if @p s is not a valid double
+    */
+    static double toDouble(const StringView& s);
+
+    /**
+      @brief Converts the field @p s to an integer (leading and trailing whitespace is allowed)
+
+      Same behavior as String::toInt(), but without creating a String.
+
+      @exception Exception::ConversionError if @p s is not a valid integer
+    */
+    static Int toInt(const StringView& s);
+
+protected:
+    /// The file (kept open while it is mapped)
+    std::unique_ptr<QFile> file_;
+
+    /// Used if the file cannot be mapped
+    std::string buffer_;
+
+    /// Current position in the file content
+    const char* pos_;
+
+    /// End of the file content
+    const char* end_;
+
+    /// Current line
+    StringView line_;
+
+    /// Fields of the current line
+    std::vector<StringView> fields_;
+
+    /// Field delimiter
+    char delimiter_;
+
+    /// Number of the current line
+    Size line_number_;
+
+private:
+    /// Not implemented
+    DelimitedTextReader(const DelimitedTextReader& rhs);
+
+    /// Not implemented
+    DelimitedTextReader& operator=(const DelimitedTextReader& rhs);
+  };
+
+} // namespace OpenMS
+
@@ -38,6 +38,9 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/FORMAT/OPTIONS/PeakFileOptions.h>
+#include <OpenMS/FORMAT/OPTIONS/FeatureFileOptions.h>
+
+#include <vector>
 
 namespace OpenMS
 {
@@ -45,6 +48,9 @@ namespace OpenMS
   class MSSpectrum;
   class MSExperiment;
   class FeatureMap;
+  class ConsensusMap;
+  class ProteinIdentification;
+  class PeptideIdentification;
 
   /**
     @brief Facilitates file handling by file type recognition.
@@ -90,6 +96,19 @@ public:
     */
     static FileTypes::Type getTypeByContent(const String& filename);
 
+    /**
+      @brief Determines the file type like getType(), but reports omsBin files as the XML type of their content
+
+      Binary omsBin files hold a feature map, a consensus map or identifications.
+      For them, FileTypes::FEATUREXML, FileTypes::CONSENSUSXML or FileTypes::IDXML
+      is returned, so tools can handle them like the respective XML files. Load
+      them with loadFeatures(), loadConsensusFeatures() or loadIdentifications().
+
+      @exception Exception::FileNotFound is thrown if the file is not present
+      @exception Exception::ParseError is thrown if an omsBin file has an invalid header
+    */
+    static FileTypes::Type getXMLEquivalentType(const String& filename);
+
     /// Returns if the file type is supported in this build of the library
     static bool isSupported(FileTypes::Type type);
 
@@ -102,6 +121,15 @@ public:
     /// set options for loading/storing
     void setOptions(const PeakFileOptions&);
 
+    /// Mutable access to the options for loading featureXML files (omsBin files are always loaded completely)
+    FeatureFileOptions& getFeatOptions();
+
+    /// Non-mutable access to the options for loading featureXML files
+    const FeatureFileOptions& getFeatOptions() const;
+
+    /// set options for loading featureXML files
+    void setFeatOptions(const FeatureFileOptions&);
+
     /**
       @brief Loads a file into an MSExperiment
 
@@ -138,13 +166,76 @@ public:
       @param filename the file name of the file to load.
       @param map The FeatureMap to load the data into.
       @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+      @param log Progress logging mode
+
+      The options set with setFeatOptions() are used for featureXML files.
 
       @return true if the file could be loaded, false otherwise
 
       @exception Exception::FileNotFound is thrown if the file could not be opened
       @exception Exception::ParseError is thrown if an error occurs during parsing
     */
-    bool loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
+    bool loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN, ProgressLogger::LogType log = ProgressLogger::NONE);
+
+    /**
+      @brief Stores a FeatureMap to a file
+
+      The file type to store the data in is determined by the file name. Supported formats are featureXML and the binary omsBin format.
+      If the file format cannot be determined from the file name, the featureXML format is used.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeFeatures(const String& filename, const FeatureMap& map, ProgressLogger::LogType log = ProgressLogger::NONE);
+
+    /**
+      @brief Loads a file into a ConsensusMap
+
+      @param filename the file name of the file to load.
+      @param map The ConsensusMap to load the data into.
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+      @param log Progress logging mode
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN, ProgressLogger::LogType log = ProgressLogger::NONE);
+
+    /**
+      @brief Stores a ConsensusMap to a file
+
+      The file type to store the data in is determined by the file name. Supported formats are consensusXML and the binary omsBin format.
+      If the file format cannot be determined from the file name, the consensusXML format is used.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeConsensusFeatures(const String& filename, const ConsensusMap& map, ProgressLogger::LogType log = ProgressLogger::NONE);
+
+    /**
+      @brief Loads protein and peptide identifications from a file
+
+      @param filename the file name of the file to load.
+      @param protein_ids The protein identifications to load the data into.
+      @param peptide_ids The peptide identifications to load the data into.
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadIdentifications(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, FileTypes::Type force_type = FileTypes::UNKNOWN);
+
+    /**
+      @brief Stores protein and peptide identifications to a file
+
+      The file type to store the data in is determined by the file name. Supported formats are idXML and the binary omsBin format.
+      If the file format cannot be determined from the file name, the idXML format is used.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
 
     /**
       @brief Computes a SHA-1 hash value for the content of the given file.
@@ -155,6 +246,7 @@ public:
 
 private:
     PeakFileOptions options_;
+    FeatureFileOptions feature_options_;
 
   };
 
@@ -69,10 +69,14 @@ namespace Internal
     extracting all the offsets of the <chromatogram> and <spectrum> tags. These
     offsets are stored as members of this class as well as the offset to the <indexList> element
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    Spectra and chromatograms may be retrieved concurrently from several
+    threads using the same object: data is read with positioned reads
+    (pread) which do not move a shared file pointer. On platforms without
+    pread, reads are serialized internally (decoding still runs in
+    parallel). getMSSpectraById() reads and decodes many spectra in parallel.
+
+    @note openFile() and setSkipXMLChecks() must not be called while other
+    threads retrieve data.
 
   */
   class OPENMS_DLLAPI IndexedMzMLHandler
@@ -87,8 +91,10 @@ namespace Internal
       std::streampos index_offset_;
       /// Whether spectra are written before chromatograms in this file
       bool spectra_before_chroms_;
-      /// The current filestream (opened by openFile)
+      /// The current filestream (opened by openFile; only used if pread is not available)
       std::ifstream filestream_;
+      /// File descriptor for positioned reads (opened by openFile, -1 if not open)
+      int fd_;
       /// Whether parsing the indexedmzML file was successful
       bool parsing_success_;
       /// Whether to skip XML checks
@@ -108,6 +114,15 @@ namespace Internal
 
     std::string getSpectrumById_helper_(int id);
 
+    /// Checks @p id and returns the byte range [@p start, @p end) of the spectrum in the file
+    void getSpectrumRange_(int id, std::streampos& start, std::streampos& end) const;
+
+    /// Reads the bytes in [@p start, @p end) of the file (thread-safe)
+    std::string readRange_(std::streampos start, std::streampos end);
+
+    /// Opens the file for reading (closes the previous one)
+    void openStreams_(const String& filename);
+
     public:
 
     /**
@@ -183,6 +198,41 @@ namespace Internal
     */
     void getMSSpectrumById(int id, OpenMS::MSSpectrum& s);
 
+    /**
+      @brief Retrieve the raw data for multiple spectra (reading and decoding in parallel)
+
+      @throw Exception if getParsingSuccess() returns false
+      @throw Exception if any id is not within [0, getNrSpectra()-1]
+
+      @param ids The spectrum ids
+      @param spectra The spectra to be filled with data. Resized to the size of
+      @p ids; existing entries are used as in getMSSpectrumById(int, MSSpectrum&).
+    */
+    void getMSSpectraById(const std::vector<int>& ids, std::vector<OpenMS::MSSpectrum>& spectra);
+
+    /**
+      @brief Retrieve the XML text of the spectrum at position "id" (without decoding it)
+
+      @throw Exception if getParsingSuccess() returns false
+      @throw Exception if id is not within [0, getNrSpectra()-1]
+
+      @return The text from the start of the spectrum element up to the next element in the file
+    */
+    std::string getSpectrumXMLById(int id);
+
+    /**
+      @brief Retrieve the XML text of the spectrum at position "id" up to its data arrays
+
+      Only the meta data (MS level, retention time, precursors etc.) is read
+      from the file, the binary data arrays are skipped.
+
+      @throw Exception if getParsingSuccess() returns false
+      @throw Exception if id is not within [0, getNrSpectra()-1]
+
+      @return The text from the start of the spectrum element up to the <binaryDataArrayList> element
+    */
+    std::string getSpectrumHeaderXMLById(int id);
+
     /**
       @brief Retrieve the raw data for the chromatogram at position "id"
 
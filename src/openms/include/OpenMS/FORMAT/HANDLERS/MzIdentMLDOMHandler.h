@@ -174,6 +174,9 @@ protected:
 
 
 private:
+      /// streams the file and feeds DOM fragments to the parse functions
+      friend class MzIdentMLFragmentHandler;
+
       MzIdentMLDOMHandler();
       MzIdentMLDOMHandler(const MzIdentMLDOMHandler& rhs);
       MzIdentMLDOMHandler& operator=(const MzIdentMLDOMHandler& rhs);
@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Mathias Walzer $
+// $Authors: Mathias Walzer $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ProgressLogger;
+  namespace Internal
+  {
+
+    /**
+        @brief XML SAX handler for reading MzIdentMLFile without building a DOM of the whole file
+
+        The file is streamed with SAX. Every self-contained element (AnalysisSoftware, the Inputs,
+        DBSequence, Peptide, PeptideEvidence and a single SpectrumIdentificationResult or
+        ProteinAmbiguityGroup at a time) is collected into a small DOM fragment, converted by the
+        functions of MzIdentMLDOMHandler and released again. SpectrumIdentificationItem ->
+        PeptideEvidence -> DBSequence references are resolved through the id maps filled from the
+        SequenceCollection, so the peak memory is bounded by the converted identifications and these
+        maps instead of by the size of the document.
+
+        SpectrumIdentification and SpectrumIdentificationProtocol refer to inputs listed later in
+        the file. Their (small) fragments are kept until the Inputs are complete.
+
+        Peptides of cross-linking MS results can only be converted once the search protocol is
+        known, which is stored after the SequenceCollection. When such a file is encountered,
+        parsing is stopped and isCrossLinkingSearch() returns true: the file has to be read with
+        MzIdentMLDOMHandler instead.
+
+        @note Do not use this class. It is only needed in MzIdentMLFile.
+    */
+    class OPENMS_DLLAPI MzIdentMLFragmentHandler :
+      public XMLHandler
+    {
+public:
+      /**@name Constructors and destructor */
+      //@{
+      /// Constructor for a read-only handler for internal identification structures
+      MzIdentMLFragmentHandler(std::vector<ProteinIdentification>& pro_id, std::vector<PeptideIdentification>& pep_id, const String& filename, const String& version, const ProgressLogger& logger);
+      /// Destructor
+      ~MzIdentMLFragmentHandler() override;
+      //@}
+
+      // Docu in base class
+      void startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes) override;
+
+      // Docu in base class
+      void endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname) override;
+
+      // Docu in base class
+      void characters(const XMLCh* const chars, const XMLSize_t length) override;
+
+      /// Returns true if parsing was stopped because the file contains cross-linking MS results
+      bool isCrossLinkingSearch() const;
+
+protected:
+      /// Converts the fragments and holds the id maps
+      MzIdentMLDOMHandler converter_;
+
+      /// Scratch document the fragments are built in
+      xercesc::DOMDocument* doc_;
+      /// Element the complete fragments are attached to before they are converted
+      xercesc::DOMElement* holder_;
+      /// Open elements of the current fragment (innermost last)
+      std::vector<xercesc::DOMElement*> fragment_;
+      /// Attribute-only copy of the current SpectrumIdentificationList or ProteinDetectionList (or null)
+      xercesc::DOMElement* list_shell_;
+      /// SpectrumIdentification fragments waiting for the Inputs
+      std::vector<xercesc::DOMElement*> deferred_si_;
+      /// SpectrumIdentificationProtocol fragments waiting for the Inputs
+      std::vector<xercesc::DOMElement*> deferred_sip_;
+      /// Were the deferred fragments converted already?
+      bool deferred_done_;
+      /// Number of SpectraData elements seen
+      Size spectra_data_count_;
+      /// Number of SpectrumIdentificationList elements seen
+      Size sil_count_;
+      /// Approximate number of characters allocated in the scratch document since it was created
+      Size doc_chars_;
+      /// Did we stop because of cross-linking MS results?
+      bool xl_ms_search_;
+
+      /// Returns true if @p tag starts a fragment below the element @p parent
+      static bool isFragmentRoot_(const String& tag, const String& parent);
+
+      /// Creates an element with the attributes of @p attributes in the scratch document
+      xercesc::DOMElement* createElement_(const XMLCh* const qname, const xercesc::Attributes& attributes);
+
+      /// Converts the fragment(s) attached to holder_ and releases them
+      void convert_(const String& tag);
+
+      /// Converts the deferred SpectrumIdentification and SpectrumIdentificationProtocol fragments
+      void convertDeferred_();
+
+      /// Starts a new scratch document once enough memory was allocated in the current one
+      void recycleDocument_();
+
+private:
+      MzIdentMLFragmentHandler();
+      MzIdentMLFragmentHandler(const MzIdentMLFragmentHandler& rhs);
+      MzIdentMLFragmentHandler& operator=(const MzIdentMLFragmentHandler& rhs);
+    };
+  } // namespace Internal
+} // namespace OpenMS
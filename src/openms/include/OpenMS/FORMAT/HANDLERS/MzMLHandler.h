@@ -462,6 +462,9 @@ protected:
       /// Vector of spectrum data stored for later parallel processing
       std::vector<SpectrumData> spectrum_data_;
 
+      /// Settings of the last spectrum per MS level, repeated settings blocks of the next spectra are shared with it
+      std::map<UInt, SpectrumSettings> last_settings_;
+
       /**
           @brief Data necessary to generate a single chromatogram
 
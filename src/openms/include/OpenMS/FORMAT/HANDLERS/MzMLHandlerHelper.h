@@ -149,8 +149,10 @@ namespace OpenMS
 
         @param data_ The input and output
         @param skipXMLCheck whether to skip cleaning the Base64 arrays and remove whitespaces
+        @param np_intensity_32 decode numpress-compressed "intensity array" data (without unit multiplier)
+          directly into single precision (floats_32), e.g. for spectra which store intensities as float anyway
       */
-      static void decodeBase64Arrays(std::vector<BinaryData> & data_, const bool skipXMLCheck = false);
+      static void decodeBase64Arrays(std::vector<BinaryData> & data_, const bool skipXMLCheck = false, const bool np_intensity_32 = false);
 
       /**
         @brief Identify a data array from a list.
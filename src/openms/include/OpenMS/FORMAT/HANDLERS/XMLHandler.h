@@ -48,9 +48,15 @@
 #include <xercesc/sax2/Attributes.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <iosfwd>
+#include <sstream>
 #include <string>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   class ProteinIdentification;
@@ -143,6 +149,34 @@ public:
       */
       static void appendASCII(const XMLCh * str, const XMLSize_t length, String & result);
 
+      /**
+       * @brief Transcodes the ASCII C string @p str into the fixed-size buffer @p dest without allocating memory
+       *
+       * @return false if @p str (including the terminating zero) does not fit into @p dest or is not plain ASCII.
+       * In that case the content of @p dest is undefined and XMLString::transcode has to be used instead.
+      */
+      template <size_t N>
+      static bool transcodeASCII(const char * str, XMLCh (&dest)[N])
+      {
+        for (size_t i = 0; i < N; ++i)
+        {
+          const unsigned char c = static_cast<unsigned char>(str[i]);
+          if (c > 127) return false;
+          dest[i] = static_cast<XMLCh>(c);
+          if (c == 0) return true;
+        }
+        return false;
+      }
+
+      /**
+       * @brief Converts the supplied XMLCh* to a double without creating intermediate strings
+       *
+       * Leading and trailing whitespace is allowed, as in String::toDouble().
+       *
+       * @exception Exception::ConversionError if @p str is not a valid double
+      */
+      static double toDouble(const XMLCh * str);
+
     };
 
     /**
@@ -288,6 +322,78 @@ protected:
 
       //@}
 
+      /**
+          @brief Serializes @p count independent elements in parallel and writes them to @p os in their original order
+
+          @p write_element(std::ostream&, Size index) writes the element with index @p index.
+          Blocks of consecutive elements are serialized into string chunks by different
+          threads (using the precision and format flags of @p os) and appended to @p os in
+          order. The output is therefore identical to calling write_element(os, i) for all i.
+          Elements are processed in batches to bound the memory of the buffered chunks.
+          @p progress(Size done) is called after each batch (from the calling thread).
+
+          @note @p write_element must not modify shared state. Without OpenMP (or with a
+          single thread) the elements are written directly to @p os.
+      */
+      template <typename WriteElement, typename Progress>
+      static void writeElementsParallel_(std::ostream & os, Size count, WriteElement write_element, Progress progress)
+      {
+        const Size chunk_size = 512;
+        Size n_chunks = 1;
+#ifdef _OPENMP
+        n_chunks = 4 * omp_get_max_threads();
+#endif
+        if (n_chunks == 1 || count <= chunk_size)
+        {
+          for (Size i = 0; i < count; ++i)
+          {
+            write_element(os, i);
+            if ((i + 1) % chunk_size == 0) progress(i + 1);
+          }
+          progress(count);
+          return;
+        }
+
+        std::vector<std::string> chunks(n_chunks);
+        for (Size batch_begin = 0; batch_begin < count; batch_begin += n_chunks * chunk_size)
+        {
+          std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+          for (SignedSize c = 0; c < (SignedSize)n_chunks; ++c)
+          {
+            const Size begin = std::min(count, batch_begin + c * chunk_size);
+            const Size end = std::min(count, begin + chunk_size);
+            try
+            {
+              std::ostringstream chunk;
+              chunk.precision(os.precision());
+              chunk.flags(os.flags());
+              for (Size i = begin; i < end; ++i)
+              {
+                write_element(chunk, i);
+              }
+              chunks[c] = chunk.str();
+            }
+            catch (...)
+            {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_XMLHandler_writeElementsParallel)
+#endif
+              if (!error) error = std::current_exception();
+            }
+          }
+          if (error) std::rethrow_exception(error);
+
+          for (Size c = 0; c < n_chunks; ++c)
+          {
+            os.write(chunks[c].data(), chunks[c].size());
+          }
+          progress(std::min(count, batch_begin + n_chunks * chunk_size));
+        }
+      }
+
       ///@name controlled vocabulary handling methods
       //@{
 
@@ -373,6 +479,21 @@ protected:
         return res;
       }
 
+      /// Conversion of a Xerces string to a double value (without intermediate String)
+      inline double asDouble_(const XMLCh * in)
+      {
+        double res = 0.0;
+        try
+        {
+          res = StringManager::toDouble(in);
+        }
+        catch (Exception::ConversionError& )
+        {
+          error(LOAD, String("Double conversion error of \"") + sm_.convert(in) + "\"");
+        }
+        return res;
+      }
+
       /// Conversion of a String to a float value
       inline float asFloat_(const String & in)
       {
@@ -438,10 +559,26 @@ protected:
       ///@name Accessing attributes
       //@{
 
+      /**
+          @brief Returns the value of the attribute @p name (or nullptr if it is not present)
+
+          Attribute names are transcoded on the stack, so no memory is allocated for the lookup.
+          Handlers with very frequent lookups should nevertheless use pre-transcoded static XMLCh* keys.
+      */
+      inline const XMLCh * attributeValue_(const xercesc::Attributes & a, const char * name) const
+      {
+        XMLCh key[64];
+        if (StringManager::transcodeASCII(name, key))
+        {
+          return a.getValue(key);
+        }
+        return a.getValue(sm_.convert(name).c_str());
+      }
+
       /// Converts an attribute to a String
       inline String attributeAsString_(const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
         return sm_.convert(val);
       }
@@ -449,7 +586,7 @@ protected:
       /// Converts an attribute to a Int
       inline Int attributeAsInt_(const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
         return xercesc::XMLString::parseInt(val);
       }
@@ -457,9 +594,9 @@ protected:
       /// Converts an attribute to a double
       inline double attributeAsDouble_(const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
-        return String(sm_.convert(val)).toDouble();
+        return StringManager::toDouble(val);
       }
 
       /// Converts an attribute to a DoubleList
@@ -490,7 +627,7 @@ protected:
       */
       inline bool optionalAttributeAsString_(String & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
           value = sm_.convert(val);
@@ -506,7 +643,7 @@ protected:
       */
       inline bool optionalAttributeAsInt_(Int & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
           value = xercesc::XMLString::parseInt(val);
@@ -522,7 +659,7 @@ protected:
       */
       inline bool optionalAttributeAsUInt_(UInt & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
           value = xercesc::XMLString::parseInt(val);
@@ -538,10 +675,10 @@ protected:
       */
       inline bool optionalAttributeAsDouble_(double & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
-          value = String(sm_.convert(val)).toDouble();
+          value = StringManager::toDouble(val);
           return true;
         }
         return false;
@@ -554,7 +691,7 @@ protected:
       */
       inline bool optionalAttributeAsDoubleList_(DoubleList & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
           value = attributeAsDoubleList_(a, name);
@@ -570,7 +707,7 @@ protected:
       */
       inline bool optionalAttributeAsStringList_(StringList & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
           value = attributeAsStringList_(a, name);
@@ -586,7 +723,7 @@ protected:
       */
       inline bool optionalAttributeAsIntList_(IntList & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = attributeValue_(a, name);
         if (val != nullptr)
         {
           value = attributeAsIntList_(a, name);
@@ -616,7 +753,7 @@ protected:
       {
         const XMLCh * val = a.getValue(name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + sm_.convert(name) + "' not present!");
-        return sm_.convert(val).toDouble();
+        return StringManager::toDouble(val);
       }
 
       /// Converts an attribute to a DoubleList
@@ -682,7 +819,7 @@ protected:
         const XMLCh * val = a.getValue(name);
         if (val != nullptr)
         {
-          value = sm_.convert(val).toDouble();
+          value = StringManager::toDouble(val);
           return true;
         }
         return false;
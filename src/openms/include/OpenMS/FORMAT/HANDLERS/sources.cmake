@@ -10,6 +10,7 @@ IndexedMzMLHandler.h
 MascotXMLHandler.h
 MzDataHandler.h
 MzIdentMLDOMHandler.h
+MzIdentMLFragmentHandler.h
 MzIdentMLHandler.h
 MzMLHandler.h
 MzMLHandlerHelper.h
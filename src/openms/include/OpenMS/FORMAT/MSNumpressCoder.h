@@ -174,6 +174,10 @@ public:
     void decodeNP(const String & in, std::vector<double> & out,
         bool zlib_compression, const NumpressConfig & config);
 
+    /// decodeNP into single precision (values are rounded from the double precision result)
+    void decodeNP(const String & in, std::vector<float> & out,
+        bool zlib_compression, const NumpressConfig & config);
+
     /**
      * @brief Encode the vector in to the result string using numpress (unsafe)
      *
@@ -215,9 +219,44 @@ public:
     */
     void decodeNPRaw(const std::string & in, std::vector<double> & out, const NumpressConfig & config);
 
+    /// decodeNPRaw into single precision (values are rounded from the double precision result)
+    void decodeNPRaw(const std::string & in, std::vector<float> & out, const NumpressConfig & config);
+
+    /**
+     * @brief Decode a raw numpress byte array into a caller-provided buffer (unsafe)
+     *
+     * Same as decodeNPRaw() above but writes directly into @p out without any
+     * intermediate container, which allows decoding straight into the storage
+     * of a spectrum or chromatogram. Use decodedSizeBound() to size the buffer.
+     *
+     * @param in Pointer to the raw (not Base64 encoded) numpress data
+     * @param in_size Number of bytes in @p in
+     * @param out Output buffer
+     * @param out_size Capacity of @p out (number of values)
+     * @param config The numpress configuration defining the compression strategy
+     *
+     * @return The number of decoded values
+     *
+     * @throw throws Exception::ConversionError if the data cannot be decoded or @p out is too small
+    */
+    Size decodeNPRaw(const unsigned char* in, Size in_size, double* out, Size out_size, const NumpressConfig & config);
+
+    /// decodeNPRaw into a caller-provided single precision buffer
+    Size decodeNPRaw(const unsigned char* in, Size in_size, float* out, Size out_size, const NumpressConfig & config);
+
+    /// Upper bound for the number of values encoded in @p in_size bytes of raw numpress data
+    static Size decodedSizeBound(Size in_size, NumpressCompression compression);
+
 private:
 
-    void decodeNPInternal_(const unsigned char* in, size_t in_size, std::vector<double>& out, const NumpressConfig & config);
+    template <typename T>
+    void encodeNPRawT_(const T* in, Size in_size, String & result, const NumpressConfig & config);
+
+    template <typename T>
+    void decodeNPInternal_(const unsigned char* in, size_t in_size, std::vector<T>& out, const NumpressConfig & config);
+
+    template <typename T>
+    Size decodeNPInternal_(const unsigned char* in, size_t in_size, T* out, Size out_size, const NumpressConfig & config);
   };
 
 } //namespace OpenMS
@@ -50,7 +50,9 @@ namespace OpenMS
 
       This file adapter exposes the internal MzIdentML processing capabilities to the library. The file
       adapter interface is kept the same as idXML file adapter for downward capability reasons.
-      For now, read-in will be performed with DOM write-out with STREAM
+      Read-in is streamed: the file is parsed with SAX and converted element by element, so the memory
+      needed does not depend on the size of the document (cross-linking MS results are still read with DOM).
+      Write-out is performed with STREAM.
 
       @note due to the limited capabilities of idXML/PeptideIdentification/ProteinIdentification not all
         MzIdentML features can be supported. Development for these structures will be discontinued, a new
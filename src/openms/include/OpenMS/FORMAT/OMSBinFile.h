@@ -0,0 +1,150 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class FeatureMap;
+  class ConsensusMap;
+
+  /**
+    @brief Compact binary format for passing feature maps, consensus maps and identifications between tools
+
+    XML parsing and writing make up a large part of the runtime of
+    multi-step pipelines (e.g. FeatureFinder -> IDMapper -> MapAligner ->
+    FeatureLinker -> ProteinQuantifier). This format stores the same content
+    as featureXML, consensusXML and idXML in a form that can be read back
+    without any parsing:
+
+    - positions, intensities, charges, qualities, widths and unique ids of
+      features, consensus features, feature handles and peptide identifications
+      are stored as contiguous columns (one array per property),
+    - all strings (identifiers, accessions, sequences, meta value keys and
+      string values, ...) are stored once in a string table and referenced by
+      index.
+
+    The file starts with a magic number, a format version and the content
+    type (feature map, consensus map or identifications). Numbers are written
+    in the byte order of the machine (like cachedMzML), so the files are
+    meant as fast intermediate files within a workflow. Use the XML formats
+    for archiving and exchange.
+
+    Content that the XML formats do not store either (e.g. modifications of
+    protein hits or ontology information of the software) is not written.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI OMSBinFile :
+    public ProgressLogger
+  {
+public:
+    /// Type of the data contained in a file
+    enum ContentType
+    {
+      FEATURES = 1,       ///< FeatureMap
+      CONSENSUS = 2,      ///< ConsensusMap
+      IDENTIFICATIONS = 3 ///< protein and peptide identifications
+    };
+
+    /// Default constructor
+    OMSBinFile();
+
+    /// Destructor
+    ~OMSBinFile();
+
+    /**
+      @brief Loads a feature map from the file @p filename and calls updateRanges().
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary feature map or is truncated
+    */
+    void load(const String& filename, FeatureMap& feature_map);
+
+    /**
+      @brief Stores the feature map @p feature_map in the file @p filename.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const FeatureMap& feature_map);
+
+    /**
+      @brief Loads a consensus map from the file @p filename and calls updateRanges().
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary consensus map or is truncated
+    */
+    void load(const String& filename, ConsensusMap& consensus_map);
+
+    /**
+      @brief Stores the consensus map @p consensus_map in the file @p filename.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const ConsensusMap& consensus_map);
+
+    /**
+      @brief Loads protein and peptide identifications from the file @p filename.
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file does not contain identifications or is truncated
+    */
+    void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids);
+
+    /**
+      @brief Stores protein and peptide identifications in the file @p filename.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+
+    /// Checks whether @p filename starts with the magic number of this format (used for file type detection)
+    static bool isOMSBinFile(const String& filename);
+
+    /**
+      @brief Returns the type of the data stored in the file @p filename (e.g. to choose the matching load() overload).
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary OpenMS file
+    */
+    static ContentType getContentType(const String& filename);
+  };
+
+} // namespace OpenMS
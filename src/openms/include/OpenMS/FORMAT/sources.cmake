@@ -31,6 +31,7 @@ ControlledVocabulary.h
 CsvFile.h
 DTA2DFile.h
 DTAFile.h
+DelimitedTextReader.h
 EDTAFile.h
 ExperimentalDesignFile.h
 FASTAFile.h
@@ -62,6 +63,7 @@ MzMLFile.h
 MzTab.h
 MzTabFile.h
 MzXMLFile.h
+OMSBinFile.h
 OMSSACSVFile.h
 OMSSAXMLFile.h
 OSWFile.h
@@ -44,6 +44,8 @@
 
 #include <set>
 
+#include <boost/container/flat_set.hpp>
+
 namespace OpenMS
 {
   class FeatureMap;
@@ -72,7 +74,15 @@ namespace OpenMS
 public:
     ///Type definitions
     //@{
-    typedef std::set<FeatureHandle, FeatureHandle::IndexLess> HandleSetType;
+    /**
+      @brief Sorted set of feature handles
+
+      The handles are stored contiguously in a sorted vector (one allocation
+      per consensus feature instead of one per handle). Iteration order and
+      insert semantics are those of a std::set, but inserting or erasing
+      invalidates iterators.
+    */
+    typedef boost::container::flat_set<FeatureHandle, FeatureHandle::IndexLess> HandleSetType;
     typedef HandleSetType::const_iterator const_iterator;
     typedef HandleSetType::iterator iterator;
     typedef HandleSetType::const_reverse_iterator const_reverse_iterator;
@@ -162,6 +172,9 @@ public:
     /// Copy constructor
     ConsensusFeature(const ConsensusFeature& rhs);
 
+    /// Move constructor
+    ConsensusFeature(ConsensusFeature&& rhs) = default;
+
     /// Constructor from basic feature
     explicit ConsensusFeature(const BaseFeature& feature);
 
@@ -184,6 +197,9 @@ public:
     /// Assignment operator
     ConsensusFeature& operator=(const ConsensusFeature& rhs);
 
+    /// Move assignment operator
+    ConsensusFeature& operator=(ConsensusFeature&& rhs) = default;
+
     /// Destructor
     ~ConsensusFeature() override;
     //@}
@@ -208,6 +224,18 @@ public:
     /// Adds all feature handles in @p handle_set to this consensus feature.
     void insert(const HandleSetType& handle_set);
 
+    /**
+      @brief Adds all feature handles in @p handles (in any order) at once
+
+      Sorts the new handles and merges them with the existing ones in a single
+      pass, which is much faster than inserting them one by one.
+
+      @exception Exception::InvalidValue is thrown if a handle with the same map index and unique
+      id already exists (or occurs twice in @p handles). The consensus feature then contains
+      each handle once.
+    */
+    void insert(const std::vector<FeatureHandle>& handles);
+
     /**
       @brief Creates a FeatureHandle and adds it
 
@@ -93,9 +93,15 @@ public:
     /// Copy constructor
     MassTrace(const MassTrace &);
 
+    /// Move constructor
+    MassTrace(MassTrace &&) = default;
+
     /// Assignment operator
     MassTrace & operator=(const MassTrace &);
 
+    /// Move assignment operator
+    MassTrace & operator=(MassTrace &&) = default;
+
     /// Random access operator
     PeakType& operator[](const Size & mt_idx);
     const PeakType& operator[](const Size & mt_idx) const;
@@ -45,6 +45,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <limits>
 
 #include <boost/shared_ptr.hpp>
@@ -56,12 +57,29 @@ namespace OpenMS
 
     @ingroup Kernel
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. Please provide a separate copy to each thread, e.g. 
+    Spectra and chromatograms can be retrieved concurrently from several
+    threads (see Internal::IndexedMzMLHandler). Copies of an object (e.g.
+    firstprivate copies in an OpenMP loop) share its spectrum index.
+    getSpectra() reads and decodes many spectra in parallel.
+
+    For range queries (RT, MS level, precursor m/z), a small spectrum index is
+    built on first use (see getSpectrumIndex()). It is taken from the meta data
+    if these were loaded, otherwise only the spectrum headers are read using
+    the offsets of the indexedmzML. Optionally (see setIndexCaching()), the
+    index is cached next to the data file (see getIndexFilename()) and reused
+    as long as the data file is unchanged, so that a file opened with
+    @p skipMetaData can be queried without parsing the whole mzML. Range
+    queries only decode the spectra they return:
 
     @code
-    #pragma omp parallel for firstprivate(ondisc_map) 
+    OnDiscPeakMap exp;
+    exp.openFile("huge.mzML", true);
+    std::vector<Size> ms1 = exp.getSpectraInRTRange(600.0, 900.0, 1);
+    for (Size i = 0; i < ms1.size(); ++i)
+    {
+      MSSpectrum s = exp.getSpectrum(ms1[i]);
+      ...
+    }
     @endcode
 
   */
@@ -73,12 +91,27 @@ namespace OpenMS
 
 public:
 
+    /// Entry of the spectrum index: basic meta data of a single spectrum
+    struct SpectrumIndexEntry
+    {
+      /// retention time (in seconds)
+      double rt;
+      /// MS level
+      Int ms_level;
+      /// m/z of the first precursor (0 if there is none)
+      double precursor_mz;
+    };
+
     /**
       @brief Constructor
 
       This initializes the object, use openFile to open a file.
     */
-    OnDiscMSExperiment() {}
+    OnDiscMSExperiment() :
+      spectrum_index_(new SpectrumIndex_()),
+      index_caching_(false),
+      is_copy_(false)
+    {}
 
     /**
       @brief Open a specific file on disk.
@@ -92,6 +125,9 @@ public:
     bool openFile(const String& filename, bool skipMetaData = false)
     {
       filename_ = filename;
+      spectrum_index_.reset(new SpectrumIndex_());
+      is_copy_ = false;
+      meta_ms_experiment_.reset();
       indexed_mzml_file_.openFile(filename);
       if (filename != "" && !skipMetaData)
       {
@@ -100,11 +136,14 @@ public:
       return indexed_mzml_file_.getParsingSuccess();
     }
 
-    /// Copy constructor
+    /// Copy constructor (the spectrum index is shared with @p source)
     OnDiscMSExperiment(const OnDiscMSExperiment& source) :
       filename_(source.filename_),
       indexed_mzml_file_(source.indexed_mzml_file_),
-      meta_ms_experiment_(source.meta_ms_experiment_)
+      meta_ms_experiment_(source.meta_ms_experiment_),
+      spectrum_index_(source.spectrum_index_),
+      index_caching_(source.index_caching_),
+      is_copy_(true)
     {
     }
 
@@ -134,11 +173,11 @@ public:
 
       Note that we cannot check whether all spectra are sorted (except if we
       were to load them all and check).
+
+      If no meta data was loaded (see openFile()), the spectrum index is used
+      (and built if necessary).
     */
-    bool isSortedByRT() const
-    {
-      return meta_ms_experiment_->isSorted(false);
-    }
+    bool isSortedByRT() const;
 
     /// alias for getNrSpectra
     inline Size size() const
@@ -184,15 +223,29 @@ public:
     /**
       @brief returns a single spectrum
 
+      If no meta data was loaded (see openFile()), RT, MS level and precursor
+      m/z are taken from the spectrum index.
+
       @param id The index of the spectrum
     */
     MSSpectrum getSpectrum(Size id)
     {
+      if (!meta_ms_experiment_)
+      {
+        return getSpectrumFromIndex_(id);
+      }
       MSSpectrum spectrum(meta_ms_experiment_->operator[](id));
       indexed_mzml_file_.getMSSpectrumById(static_cast<int>(id), spectrum);
       return spectrum;
     }
 
+    /**
+      @brief returns multiple spectra, read and decoded in parallel
+
+      @param ids The indices of the spectra
+    */
+    std::vector<MSSpectrum> getSpectra(const std::vector<Size>& ids);
+
     /**
       @brief returns a single spectrum
     */
@@ -227,6 +280,88 @@ public:
       indexed_mzml_file_.setSkipXMLChecks(skip);
     }
 
+    /**
+      @name Range queries
+
+      These use the spectrum index, which is built (or loaded from the cache)
+      on first use. Only the returned spectra are decoded, when passed to
+      getSpectrum().
+    */
+    //@{
+    /**
+      @brief Returns the spectrum index (one entry per spectrum)
+
+      The index is built on first use, only once for an object and all its copies.
+
+      @exception Exception::ParseError is thrown if the spectrum headers cannot be read
+    */
+    const std::vector<SpectrumIndexEntry>& getSpectrumIndex();
+
+    /**
+      @brief Index of the first spectrum with RT >= @p rt
+
+      @note The spectra have to be sorted by RT (see isSortedByRT()).
+    */
+    Size RTBegin(double rt);
+
+    /**
+      @brief Index after the last spectrum with RT <= @p rt
+
+      @note The spectra have to be sorted by RT (see isSortedByRT()).
+    */
+    Size RTEnd(double rt);
+
+    /**
+      @brief Indices of all spectra with RT in [@p rt_min, @p rt_max] (in file order)
+
+      @param rt_min Minimum RT
+      @param rt_max Maximum RT
+      @param ms_level Only report spectra of this MS level (0 for all)
+    */
+    std::vector<Size> getSpectraInRTRange(double rt_min, double rt_max, Int ms_level = 0);
+
+    /**
+      @brief Indices of all spectra with a precursor m/z in [@p mz_min, @p mz_max] (in file order)
+
+      Spectra without precursor are never reported.
+    */
+    std::vector<Size> getSpectraByPrecursorMZ(double mz_min, double mz_max,
+                                              double rt_min = -std::numeric_limits<double>::max(),
+                                              double rt_max = std::numeric_limits<double>::max());
+
+    /**
+      @brief Extracts the peaks in an RT/m/z area (the equivalent of MSExperiment::areaBegin/areaEnd)
+
+      Only spectra in the RT range are decoded. The spectra in @p output
+      keep their meta data, but only contain the peaks in [@p mz_min, @p mz_max].
+      Spectra without peaks in that range are kept as well.
+
+      @param rt_min Minimum RT
+      @param rt_max Maximum RT
+      @param mz_min Minimum m/z
+      @param mz_max Maximum m/z
+      @param ms_level Only use spectra of this MS level (0 for all)
+      @param output The area (previous content is removed)
+    */
+    void getArea(double rt_min, double rt_max, double mz_min, double mz_max, Int ms_level, PeakMap& output);
+
+    /**
+      @brief Sets whether the spectrum index is cached next to the data file (default: false)
+
+      The cache is only written by the object that opened the file, never by copies of it.
+    */
+    void setIndexCaching(bool caching)
+    {
+      index_caching_ = caching;
+    }
+
+    /// Returns the name of the spectrum index cache file for @p filename
+    static String getIndexFilename(const String& filename)
+    {
+      return filename + ".rtidx";
+    }
+    //@}
+
 private:
 
     /// Private Assignment operator -> we cannot copy file streams in IndexedMzMLHandler
@@ -234,14 +369,47 @@ private:
 
     void loadMetaData_(const String& filename);
 
+    /// Builds the spectrum index (if not done yet), guarded against concurrent calls (lock-free once built)
+    void buildSpectrumIndex_();
+
+    /// Reads the spectrum index from the cache, the meta data or the spectrum headers (in parallel)
+    void readSpectrumIndex_();
+
+    /// Loads the spectrum index from its cache file (returns false if missing or out of date)
+    bool loadSpectrumIndex_(const String& filename);
+
+    /// Stores the spectrum index in its cache file (failures are ignored)
+    void storeSpectrumIndex_(const String& filename) const;
+
+    /// Reads a spectrum and annotates it using the spectrum index (if no meta data is available)
+    MSSpectrum getSpectrumFromIndex_(Size id);
+
 protected:
 
+    /// RT, MS level and precursor of each spectrum, shared by all copies of an object
+    struct SpectrumIndex_
+    {
+      SpectrumIndex_() :
+        built(false)
+      {}
+
+      std::vector<SpectrumIndexEntry> entries;
+      /// set (after @p entries) once the index is complete
+      std::atomic<bool> built;
+    };
+
     /// The filename of the underlying data file
     String filename_;
     /// The index of the underlying data file
     Internal::IndexedMzMLHandler indexed_mzml_file_;
     /// The meta-data
     boost::shared_ptr<PeakMap> meta_ms_experiment_;
+    /// The spectrum index (empty until first use, shared by copies)
+    boost::shared_ptr<SpectrumIndex_> spectrum_index_;
+    /// Whether to cache the spectrum index next to the data file
+    bool index_caching_;
+    /// Whether this object is a copy (copies do not write the index cache)
+    bool is_copy_;
   };
 
 typedef OpenMS::OnDiscMSExperiment OnDiscPeakMap;
@@ -0,0 +1,151 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <functional>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Applies spectrum and chromatogram operations to a whole experiment in parallel
+
+    Most signal processing steps (smoothing, baseline removal, noise
+    estimation, the FILTERING/TRANSFORMERS functors) work on each spectrum or
+    chromatogram independently. This class is the shared driver which applies
+    such an operation to all spectra and chromatograms of an experiment using
+    all available OpenMP threads:
+
+    - the data is distributed in chunks of @p chunk_size items using dynamic
+      scheduling (spectra differ strongly in size, so static scheduling leaves
+      threads idle)
+    - every thread works on its own copy of the processing function. A filter
+      that is captured by value in the lambda is therefore copied once per
+      thread, so filters with internal state (e.g. cached coefficients) can be
+      used without locking
+    - progress is reported through the ProgressLogger interface
+
+    Usage:
+    @code
+    SavitzkyGolayFilter sgf;
+    ParallelExperimentProcessor processor;
+    processor.setSpectraProcessingFunc([sgf](MSSpectrum& s) mutable { sgf.filter(s); });
+    processor.setChromatogramProcessingFunc([sgf](MSChromatogram& c) mutable { sgf.filter(c); });
+    processor.processExperiment(exp);
+    @endcode
+
+    For out-of-core processing, MSDataParallelProcessingConsumer uses the same
+    driver on blocks of data streamed through the IMSDataConsumer interface.
+
+    @note Captures by reference are shared between all threads, only captures by
+    value are thread-local.
+
+    @note Exceptions thrown by the processing functions are caught inside the
+    parallel region. After all items have been processed, the first exception
+    caught is rethrown.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI ParallelExperimentProcessor :
+    public ProgressLogger
+  {
+public:
+
+    /// Operation applied to a single spectrum
+    typedef std::function<void (MSSpectrum&)> SpectrumProcessingFunc;
+    /// Operation applied to a single chromatogram
+    typedef std::function<void (MSChromatogram&)> ChromatogramProcessingFunc;
+
+    /**
+      @brief Constructor
+
+      @param chunk_size Number of consecutive spectra/chromatograms handed to a thread at once
+    */
+    explicit ParallelExperimentProcessor(Size chunk_size = 16);
+
+    /// Destructor
+    virtual ~ParallelExperimentProcessor();
+
+    /**
+      @brief Sets the function applied to every spectrum
+
+      Pass a nullptr if spectra should be left unchanged (default).
+    */
+    void setSpectraProcessingFunc(SpectrumProcessingFunc f_spec);
+
+    /**
+      @brief Sets the function applied to every chromatogram
+
+      Pass a nullptr if chromatograms should be left unchanged (default).
+    */
+    void setChromatogramProcessingFunc(ChromatogramProcessingFunc f_chrom);
+
+    /// Sets the number of items a thread processes at once (minimum 1)
+    void setChunkSize(Size chunk_size);
+
+    /// Returns the number of items a thread processes at once
+    Size getChunkSize() const;
+
+    /**
+      @brief Applies the processing functions to all spectra and chromatograms of @p exp
+
+      @param exp The experiment to process in-place
+      @param label The label of the progress display
+    */
+    void processExperiment(PeakMap& exp, const String& label = "processing data") const;
+
+    /// Applies the spectrum processing function to all @p spectra (without progress report)
+    void processSpectra(std::vector<MSSpectrum>& spectra) const;
+
+    /// Applies the chromatogram processing function to all @p chromatograms (without progress report)
+    void processChromatograms(std::vector<MSChromatogram>& chromatograms) const;
+
+protected:
+
+    /// Parallel loop over @p data, shared by all process methods
+    template <typename ContainerT, typename FuncT>
+    void process_(ContainerT& data, const FuncT& func, bool report_progress) const;
+
+    SpectrumProcessingFunc lambda_spec_;
+    ChromatogramProcessingFunc lambda_chrom_;
+    Size chunk_size_;
+  };
+
+} // namespace OpenMS
+
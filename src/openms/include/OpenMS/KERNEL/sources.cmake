@@ -23,6 +23,7 @@ MSChromatogram.h
 MSExperiment.h
 MSSpectrum.h
 OnDiscMSExperiment.h
+ParallelExperimentProcessor.h
 Peak1D.h
 Peak2D.h
 PeakIndex.h
@@ -84,6 +84,9 @@ namespace OpenMS
     This means only one item of such a type with a given key can be stored in an IdentificationData object.
     If items with an existing key are registered subsequently, attempts are made to merge new information (e.g. additional scores) into the existing entry.
 
+    The "register..." functions modify the data structure and are therefore not thread-safe.
+    To build up search results in parallel, data queries, identified molecules and molecule-query matches can be collected in one StagingBuffer per thread (without access to the IdentificationData instance) and registered afterwards in one go using @ref commitStagingBuffers().
+
     @ingroup Metadata
   */
   class OPENMS_DLLAPI IdentificationData: public MetaInfoInterface
@@ -173,6 +176,94 @@ namespace OpenMS
 
     using AddressLookup = boost::unordered_set<uintptr_t>;
 
+    /*!
+      @brief Staging area for the bulk registration of search results
+
+      Data queries, identified molecules and molecule-query matches are collected here without modifying an IdentificationData instance, so several buffers can be filled concurrently (e.g. one per thread).
+      Items refer to each other via their indices in the buffer (as returned by the "add..." functions).
+      Items that are already registered may be referenced as usual (e.g. parent molecules or input files).
+
+      The buffers are registered via IdentificationData::commitStagingBuffers(), which validates and merges the items in the same way as the corresponding "register..." functions.
+      Afterwards, references to the registered items can be looked up by index.
+    */
+    class OPENMS_DLLAPI StagingBuffer
+    {
+    public:
+      /// Stage a data query, returns its index in this buffer
+      Size addDataQuery(const DataQuery& query);
+
+      /// Stage an identified peptide, returns its index in this buffer
+      Size addIdentifiedPeptide(const IdentifiedPeptide& peptide);
+
+      /// Stage an identified compound, returns its index in this buffer
+      Size addIdentifiedCompound(const IdentifiedCompound& compound);
+
+      /// Stage an identified oligonucleotide, returns its index in this buffer
+      Size addIdentifiedOligo(const IdentifiedOligo& oligo);
+
+      /*!
+        @brief Stage a molecule-query match between a staged data query and a staged identified molecule
+
+        The references stored in @p match are replaced on commit; they can be default-constructed.
+
+        @param match The match (scores, charge, annotations, meta data)
+        @param query_index Index of the data query in this buffer
+        @param molecule_type Type of the identified molecule (selects peptides, compounds or oligonucleotides)
+        @param molecule_index Index of the identified molecule in this buffer
+
+        @return Index of the match in this buffer
+      */
+      Size addMoleculeQueryMatch(const MoleculeQueryMatch& match,
+                                 Size query_index, MoleculeType molecule_type,
+                                 Size molecule_index);
+
+      /// Reference to a registered data query (valid after commit)
+      DataQueryRef getDataQueryRef(Size index) const;
+
+      /// Reference to a registered identified peptide (valid after commit)
+      IdentifiedPeptideRef getIdentifiedPeptideRef(Size index) const;
+
+      /// Reference to a registered identified compound (valid after commit)
+      IdentifiedCompoundRef getIdentifiedCompoundRef(Size index) const;
+
+      /// Reference to a registered identified oligonucleotide (valid after commit)
+      IdentifiedOligoRef getIdentifiedOligoRef(Size index) const;
+
+      /// Reference to a registered molecule-query match (valid after commit)
+      QueryMatchRef getMoleculeQueryMatchRef(Size index) const;
+
+      /// Are there any staged (uncommitted) items?
+      bool empty() const;
+
+      /// Remove all staged items and references
+      void clear();
+
+    protected:
+      /// A match with references to staged items
+      struct StagedMatch
+      {
+        MoleculeQueryMatch match;
+        Size query_index;
+        MoleculeType molecule_type;
+        Size molecule_index;
+      };
+
+      std::vector<DataQuery> queries_;
+      std::vector<IdentifiedPeptide> peptides_;
+      std::vector<IdentifiedCompound> compounds_;
+      std::vector<IdentifiedOligo> oligos_;
+      std::vector<StagedMatch> matches_;
+
+      // references to registered items (filled on commit):
+      std::vector<DataQueryRef> query_refs_;
+      std::vector<IdentifiedPeptideRef> peptide_refs_;
+      std::vector<IdentifiedCompoundRef> compound_refs_;
+      std::vector<IdentifiedOligoRef> oligo_refs_;
+      std::vector<QueryMatchRef> match_refs_;
+
+      friend class IdentificationData;
+    };
+
 
     /// Default constructor
     IdentificationData():
@@ -296,6 +387,20 @@ namespace OpenMS
     */
     MatchGroupRef registerQueryMatchGroup(const QueryMatchGroup& group);
 
+    /*!
+      @brief Register the contents of several staging buffers
+
+      All items are validated first; if any item is invalid, an exception is thrown and nothing is registered.
+      Items with the same key are merged (within and across buffers, and with already registered items) exactly as if they had been registered individually in buffer order.
+      Afterwards, the buffers contain the references to the registered items (see StagingBuffer::getDataQueryRef() etc.) and no more staged items.
+
+      @throw Exception::IllegalArgument if an item is invalid (see the corresponding "register..." function) or an index is out of range
+    */
+    void commitStagingBuffers(std::vector<StagingBuffer>& buffers);
+
+    /// Register the contents of a single staging buffer (see @ref commitStagingBuffers())
+    void commitStagingBuffer(StagingBuffer& buffer);
+
     /// Return the registered input files (immutable)
     const InputFiles& getInputFiles() const
     {
@@ -485,6 +590,24 @@ namespace OpenMS
     void checkParentMatches_(const ParentMatches& matches,
                              MoleculeType expected_type) const;
 
+    /// Helper functions to check required information and references of items before registration
+    void checkDataQuery_(const DataQuery& query) const;
+    void checkIdentifiedPeptide_(const IdentifiedPeptide& peptide) const;
+    void checkIdentifiedCompound_(const IdentifiedCompound& compound) const;
+    void checkIdentifiedOligo_(const IdentifiedOligo& oligo) const;
+
+    /*!
+      @brief Helper function for commitStagingBuffers(): register items of one type from all buffers
+
+      Items are sorted by key (stable, i.e. keeping buffer order for equal keys) and entries with equal keys are merged before they are inserted.
+      The resulting references are written to @p refs (same layout as @p items).
+    */
+    template <typename ContainerType, typename ElementType, typename RefType>
+    void commitStagedItems_(ContainerType& container,
+                            const std::vector<const std::vector<ElementType>*>& items,
+                            const std::vector<std::vector<RefType>*>& refs,
+                            AddressLookup& lookup);
+
     /*!
       @brief Helper functor for adding processing steps to elements in a @t boost::multi_index_container structure
 
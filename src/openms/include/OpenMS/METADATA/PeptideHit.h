@@ -309,7 +309,7 @@ public:
     void setRank(UInt newrank);
 
     /// returns the fragment annotations
-    std::vector<PeptideHit::PeakAnnotation> getPeakAnnotations() const;
+    const std::vector<PeptideHit::PeakAnnotation>& getPeakAnnotations() const;
 
     /// sets the fragment annotations
     void setPeakAnnotations(std::vector<PeptideHit::PeakAnnotation> frag_annotations);
@@ -43,6 +43,8 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/DataProcessing.h>
 
+#include <boost/shared_ptr.hpp>
+
 #include <map>
 #include <vector>
 
@@ -58,6 +60,12 @@ namespace OpenMS
       The precursor spectrum is the first spectrum before this spectrum, that has a lower MS-level than
       the current spectrum.
 
+      Instrument settings, acquisition info and source file are usually identical for many
+      spectra of a run. They are stored copy-on-write, i.e. copies of a spectrum (and spectra
+      joined by shareSettings()) point to the same instance until it is modified. A non-const
+      accessor detaches the block of this spectrum first, so a reference obtained from it must
+      not be used for modification after the spectrum was copied.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI SpectrumSettings :
@@ -82,14 +90,14 @@ public:
     /// Copy constructor
     SpectrumSettings(const SpectrumSettings &) = default;
     /// Move constructor
-    SpectrumSettings(SpectrumSettings&&) = default;
+    SpectrumSettings(SpectrumSettings&&);
     /// Destructor
     ~SpectrumSettings();
 
     // Assignment operator
     SpectrumSettings & operator=(const SpectrumSettings &) = default;
     /// Move assignment operator
-    SpectrumSettings& operator=(SpectrumSettings&&) & = default;
+    SpectrumSettings& operator=(SpectrumSettings&&) &;
 
     /// Equality operator
     bool operator==(const SpectrumSettings & rhs) const;
@@ -165,14 +173,24 @@ public:
     /// returns a const reference to the description of the applied processing
     const std::vector< boost::shared_ptr<const DataProcessing > > getDataProcessing() const;
 
+    /**
+      @brief Shares the instrument settings, acquisition info and source file of @p rhs where they are equal to the ones of this spectrum
+
+      Afterwards both spectra point to the same instance of each equal block, which saves
+      memory when the settings repeat across the spectra of an experiment.
+
+      @return true if at least one block is shared afterwards
+    */
+    bool shareSettings(const SpectrumSettings & rhs);
+
 protected:
 
     SpectrumType type_;
     String native_id_;
     String comment_;
-    InstrumentSettings instrument_settings_;
-    SourceFile source_file_;
-    AcquisitionInfo acquisition_info_;
+    boost::shared_ptr<InstrumentSettings> instrument_settings_;
+    boost::shared_ptr<SourceFile> source_file_;
+    boost::shared_ptr<AcquisitionInfo> acquisition_info_;
     std::vector<Precursor> precursors_;
     std::vector<Product> products_;
     std::vector<PeptideIdentification> identification_;
@@ -110,6 +110,7 @@ protected:
 
   double isotope_pmin_; ///< min. isotope probability for peptide assay
   Size n_isotopes_; ///< number of isotopes for peptide assay
+  Size batch_size_; ///< number of peptides per batch for extraction/detection
 
   double rt_quantile_;
 
@@ -239,6 +240,10 @@ protected:
 
   void createAssayLibrary_(PeptideMap& peptide_map, PeptideRefRTMap& ref_rt_map);
 
+  /// split the assay library into batches of peptides (with their transitions) that can be processed independently
+  void createAssayBatches_(std::vector<TargetedExperiment>& batch_libraries,
+                           std::vector<OpenSwath::LightTargetedExperiment>& batch_assays) const;
+
   void addPeptideToMap_(PeptideIdentification& peptide, 
     PeptideMap& peptide_map,
     bool external = false) const;
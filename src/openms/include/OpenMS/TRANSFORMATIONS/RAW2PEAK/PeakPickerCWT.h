@@ -130,6 +130,9 @@ protected:
     /// Signal to noise threshold
     float signal_to_noise_;
 
+    /// Use SignalToNoiseEstimatorMedianSliding instead of SignalToNoiseEstimatorMeanIterative
+    bool snt_median_sliding_;
+
     /// The minimal full width at half maximum
     float fwhm_bound_;
 
@@ -46,6 +46,10 @@ namespace OpenMS
 {
   class MSChromatogram;
   class OnDiscMSExperiment;
+  namespace Interfaces
+  {
+    class IMSDataConsumer;
+  }
 
   /**
     @brief This class implements a fast peak-picking algorithm best suited for
@@ -57,8 +61,11 @@ namespace OpenMS
     This peak-picking algorithm detects ion signals in profile data and
     reconstructs the corresponding peak shape by cubic spline interpolation.
     Signal detection depends on the signal-to-noise ratio which is adjustable
-    by the user (see parameter signal_to_noise). A picked peak's m/z and
-    intensity value is given by the maximum of the underlying peak spline.
+    by the user (see parameter signal_to_noise). The noise level is estimated
+    by SignalToNoiseEstimatorMedian or, if 'signal_to_noise_estimator' is set
+    to 'median_sliding', by SignalToNoiseEstimatorMedianSliding. A picked
+    peak's m/z and intensity value is given by the maximum of the underlying
+    peak spline.
 
     So far, this peak picker was mainly tested on high resolution data. With
     appropriate preprocessing steps (e.g. noise reduction and baseline
@@ -133,7 +140,8 @@ public:
     /**
      * @brief Applies the peak-picking algorithm to a map (MSExperiment). This
      * method picks peaks for each scan in the map consecutively. The resulting
-     * picked peaks are written to the output map.
+     * picked peaks are written to the output map. Spectra and chromatograms
+     * are picked in parallel if OpenMP is enabled.
      *
      * @param input  input map in profile mode
      * @param output  output map with picked peaks
@@ -144,7 +152,8 @@ public:
     /**
      * @brief Applies the peak-picking algorithm to a map (MSExperiment). This
      * method picks peaks for each scan in the map consecutively. The resulting
-     * picked peaks are written to the output map.
+     * picked peaks are written to the output map. Spectra and chromatograms
+     * are picked in parallel if OpenMP is enabled.
      *
      * @param input  input map in profile mode
      * @param output  output map with picked peaks
@@ -159,14 +168,38 @@ public:
       method picks peaks for each scan in the map consecutively. The resulting
       picked peaks are written to the output map.
 
+      Each worker thread reads, decodes and picks its own spectra and
+      chromatograms; the output keeps the order of the input.
+
       Currently we have to give up const-correctness but we know that everything on disc is constant
     */
     void pickExperiment(/* const */ OnDiscMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const;
 
+    /**
+      @brief Applies the peak-picking algorithm to a map on disk and hands
+      the picked spectra and chromatograms to a consumer (e.g. an
+      MSDataWritingConsumer), in the order of the input.
+
+      Data is processed in batches: each worker thread reads, decodes and
+      picks its own spectra and chromatograms of a batch, and the batch is
+      handed to @p consumer in input order. Only one batch is held in memory
+      at a time, independent of the size of the input file.
+
+      @param input  input map in profile mode
+      @param consumer  receives the experimental settings and all picked spectra and chromatograms
+      @param check_spectrum_type  if set, checks spectrum type and throws an exception if a centroided spectrum is passed
+
+      @exception Exception::IllegalArgument is thrown if centroided data is encountered and @p check_spectrum_type is set
+    */
+    void pickExperiment(/* const */ OnDiscMSExperiment& input, Interfaces::IMSDataConsumer& consumer, const bool check_spectrum_type = true) const;
+
 protected:
     // signal-to-noise parameter
     double signal_to_noise_;
 
+    // use SignalToNoiseEstimatorMedianSliding instead of SignalToNoiseEstimatorMedian
+    bool snt_median_sliding_;
+
     // maximal spacing difference defining a large gap
     double spacing_difference_gap_;
     
@@ -185,6 +218,13 @@ protected:
     /// unit of 'FWHM' float data array (can be absolute or ppm).
     bool report_FWHM_as_ppm_;
 
+    /**
+      @brief Decides whether a spectrum is picked or copied to the output unchanged
+
+      @exception Exception::IllegalArgument is thrown if a centroided spectrum is selected for picking and @p check_spectrum_type is set
+    */
+    bool isPickingRequired_(const MSSpectrum& spectrum, const bool check_spectrum_type) const;
+
     // docu in base class
     void updateMembers_() override;
 
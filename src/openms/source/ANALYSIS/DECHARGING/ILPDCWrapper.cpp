@@ -38,11 +38,59 @@
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 
+#include <exception>
 #include <fstream>
 
 namespace OpenMS
 {
 
+  namespace
+  {
+    /**
+      @brief Owns an LPWrapper which is created and destroyed under a lock
+
+      The LPWrapper constructor and destructor call glp_create_prob() and
+      glp_delete_prob() (also when COIN-OR is used as the solver), and GLPK
+      is not thread-safe. Building and solving a COIN-OR model only touches
+      the model of the instance and may run concurrently.
+    */
+    struct LockedLPWrapper_
+    {
+      LockedLPWrapper_() :
+        lp(nullptr)
+      {
+        std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_LPWrapper)
+#endif
+        {
+          try
+          {
+            lp = new LPWrapper();
+          }
+          catch (...)
+          {
+            error = std::current_exception();
+          }
+        }
+        if (error) std::rethrow_exception(error);
+      }
+
+      ~LockedLPWrapper_()
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_LPWrapper)
+#endif
+        delete lp;
+      }
+
+      LockedLPWrapper_(const LockedLPWrapper_&) = delete;
+      LockedLPWrapper_& operator=(const LockedLPWrapper_&) = delete;
+
+      LPWrapper* lp;
+    };
+  }
+
   ILPDCWrapper::ILPDCWrapper()
   {
   }
@@ -51,7 +99,7 @@ namespace OpenMS
   {
   }
 
-  double ILPDCWrapper::compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const
+  double ILPDCWrapper::compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const
   {
     if (fm.empty())
     {
@@ -61,6 +109,10 @@ namespace OpenMS
 
     PairsType pairs_clique_ordered;
     pairs_clique_ordered.reserve(pairs.size());
+    double small_score = 0;
+    // edges of components which need the ILP, and their index in pairs_clique_ordered
+    PairsType pairs_ilp;
+    std::vector<Size> ilp_origin;
     typedef std::vector<std::pair<Size, Size> > BinType;
     BinType bins;
     // check number of components for complete putative edge graph (usually not all will be set to 'active' during ILP):
@@ -139,53 +191,101 @@ namespace OpenMS
         }
       }
 
-      /* partition the cliques into bins, one given to the ILP at a time */
+      /* small components (the vast majority) are solved directly, without the ILP */
+      Size max_small_component_assignments = 256;
+
+      std::vector<const std::set<Size>*> components;
+      components.reserve(g2pairs.size());
+      for (Map<Size, std::set<Size> >::ConstIterator it = g2pairs.begin(); it != g2pairs.end(); ++it)
+      {
+        components.push_back(&it->second);
+      }
+      std::vector<Byte> solved(components.size(), 0);
+      Size solved_count(0);
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(+: small_score, solved_count)
+#endif
+      for (SignedSize c = 0; c < static_cast<SignedSize>(components.size()); ++c)
+      {
+        try
+        {
+          double component_score(0);
+          if (computeSmallComponent_(fm, pairs, *components[c], max_small_component_assignments, component_score))
+          {
+            solved[c] = 1;
+            small_score += component_score;
+            ++solved_count;
+          }
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_ILPDCWrapper_error)
+#endif
+          {
+            if (!error) error = std::current_exception();
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+      if (verbose_level > 1)
+      {
+        OPENMS_LOG_INFO << solved_count << " of " << components.size() << " components solved without ILP\n";
+      }
+
+      /* partition the remaining cliques into bins, one given to the ILP at a time */
       UInt pairs_per_bin = 1000;
       UInt big_clique_bin_threshold = 200;
 
       Size start(0);
       Size count(0);
-      for (Map<Size, std::set<Size> >::ConstIterator it = g2pairs.begin(); it != g2pairs.end(); ++it)
+      for (Size c = 0; c < components.size(); ++c)
       {
-        Size clique_size = it->second.size();
-        if (count > pairs_per_bin || clique_size > big_clique_bin_threshold)
+        const std::set<Size>& clique = *components[c];
+        Size clique_size = clique.size();
+        if (!solved[c] && (count > pairs_per_bin || clique_size > big_clique_bin_threshold))
         {
           if (count > 0) // either bin is full or we have to close it due to big clique
           {
             if (verbose_level > 2)
               OPENMS_LOG_INFO << "Overstepping border of " << pairs_per_bin << " by " << SignedSize(count - pairs_per_bin) << " elements!\n";
-            bins.push_back(std::make_pair(start, pairs_clique_ordered.size()));
-            start = pairs_clique_ordered.size();
+            bins.push_back(std::make_pair(start, pairs_ilp.size()));
+            start = pairs_ilp.size();
             count = 0;
           }
-          if (clique_size > big_clique_bin_threshold) // extra bin for this big clique
+        }
+        // the overall order of edges is by clique, independent of how they are solved
+        for (std::set<Size>::const_iterator i_p = clique.begin(); i_p != clique.end(); ++i_p)
+        {
+          if (!solved[c])
           {
-            for (std::set<Size>::const_iterator i_p = it->second.begin(); i_p != it->second.end(); ++i_p)
-            {
-              pairs_clique_ordered.push_back(pairs[*i_p]);
-            }
-            if (verbose_level > 2)
-              OPENMS_LOG_INFO << "Extra bin for big clique (" << clique_size << ") prepended to schedule\n";
-            bins.insert(bins.begin(), std::make_pair(start, pairs_clique_ordered.size()));
-            start = pairs_clique_ordered.size();
-            continue; // next clique (this one is already processed)
+            pairs_ilp.push_back(pairs[*i_p]);
+            ilp_origin.push_back(pairs_clique_ordered.size());
           }
+          pairs_clique_ordered.push_back(pairs[*i_p]);
         }
-        count += clique_size;
-        for (std::set<Size>::const_iterator i_p = it->second.begin(); i_p != it->second.end(); ++i_p)
+        if (solved[c]) continue;
+
+        if (clique_size > big_clique_bin_threshold) // extra bin for this big clique
         {
-          pairs_clique_ordered.push_back(pairs[*i_p]);
+          if (verbose_level > 2)
+            OPENMS_LOG_INFO << "Extra bin for big clique (" << clique_size << ") prepended to schedule\n";
+          bins.insert(bins.begin(), std::make_pair(start, pairs_ilp.size()));
+          start = pairs_ilp.size();
+          continue; // next clique (this one is already processed)
         }
+        count += clique_size;
       }
       if (count > 0)
-        bins.push_back(std::make_pair(start, pairs_clique_ordered.size()));
+        bins.push_back(std::make_pair(start, pairs_ilp.size()));
     }
 
     if (pairs_clique_ordered.size() != pairs.size())
     {
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pairs_clique_ordered.size() - pairs.size());
     }
-    /* swap pairs, such that edges are order by cliques (so we can make clean cuts) */
+    /* swap pairs, such that edges are order by cliques */
     pairs.swap(pairs_clique_ordered);
 
     //PairsType pt2 = pairs;
@@ -193,15 +293,35 @@ namespace OpenMS
     time1.start();
 
     // split problem into slices and have each one solved by the ILPS
+    // (every slice builds and solves its own LPWrapper and writes to a disjoint range of pairs_ilp;
+    // only creating and destroying the LPWrapper is serialized, see LockedLPWrapper_)
     double score = 0;
-// OMP currently causes spurious segfaults in Release mode; OMP fix applied, however: disable if problem persists
-//#ifdef _OPENMP
-//#pragma omp parallel for schedule(dynamic, 1), reduction(+: score)
-//#endif
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) reduction(+: score)
+#endif
     for (SignedSize i = 0; i < static_cast<SignedSize>(bins.size()); ++i)
     {
-      score = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
+      try
+      {
+        score += computeSlice_(fm, pairs_ilp, bins[i].first, bins[i].second, verbose_level);
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_ILPDCWrapper_error)
+#endif
+        {
+          if (!error) error = std::current_exception();
+        }
+      }
+    }
+    if (error) std::rethrow_exception(error);
+    for (Size i = 0; i < pairs_ilp.size(); ++i)
+    {
+      pairs[ilp_origin[i]] = pairs_ilp[i];
     }
+    score += small_score;
     time1.stop();
     OPENMS_LOG_INFO << " Branch and cut took " << time1.getClockTime() << " seconds, "
              << " with objective value: " << score << "."
@@ -210,12 +330,104 @@ namespace OpenMS
     return score;
   }
 
+  bool ILPDCWrapper::computeSmallComponent_(const FeatureMap& fm,
+                                            PairsType& pairs,
+                                            const std::set<Size>& component,
+                                            const Size max_assignments,
+                                            double& score) const
+  {
+    std::vector<Size> edges(component.begin(), component.end());
+    std::vector<double> weights(edges.size());
+    // per edge and side: the feature (position in 'variant_count') and its variant
+    std::vector<Size> edge_feature(2 * edges.size()), edge_variant(2 * edges.size());
+    std::map<Size, std::pair<Size, std::map<String, Size> > > features; // feature idx --> (position, variant --> id)
+    std::vector<Size> variant_count;
+
+    for (Size k = 0; k < edges.size(); ++k)
+    {
+      const ChargePair& pair = pairs[edges[k]];
+      // same objective coefficient as in computeSlice_()
+      weights[k] = exp(getLogScore_(pair, fm)) * pair.getEdgeScore();
+      if (!(weights[k] > 0)) return false; // the ILP may or may not use such an edge
+
+      for (UInt side = 0; side < 2; ++side)
+      {
+        std::map<Size, std::pair<Size, std::map<String, Size> > >::iterator it_f = features.find(pair.getElementIndex(side));
+        if (it_f == features.end())
+        {
+          it_f = features.insert(std::make_pair(pair.getElementIndex(side), std::make_pair(variant_count.size(), std::map<String, Size>()))).first;
+          variant_count.push_back(0);
+        }
+        String variant = pair.getCompomer().getAdductsAsString(side) + "_" + pair.getCharge(side);
+        std::map<String, Size>::iterator it_v = it_f->second.second.find(variant);
+        if (it_v == it_f->second.second.end())
+        {
+          it_v = it_f->second.second.insert(std::make_pair(variant, variant_count[it_f->second.first]++)).first;
+        }
+        edge_feature[2 * k + side] = it_f->second.first;
+        edge_variant[2 * k + side] = it_v->second;
+      }
+    }
+
+    Size assignments(1);
+    for (Size p = 0; p < variant_count.size(); ++p)
+    {
+      assignments *= variant_count[p];
+      if (assignments > max_assignments) return false;
+    }
+
+    // an edge is realized iff both of its features take the variant it implies
+    std::vector<Size> choice(variant_count.size(), 0);
+    std::vector<bool> active(edges.size());
+    auto evaluate = [&]()
+    {
+      double s(0);
+      for (Size k = 0; k < edges.size(); ++k)
+      {
+        active[k] = choice[edge_feature[2 * k]] == edge_variant[2 * k] &&
+                    choice[edge_feature[2 * k + 1]] == edge_variant[2 * k + 1];
+        if (active[k]) s += weights[k];
+      }
+      return s;
+    };
+    auto next = [&]()
+    {
+      for (Size p = 0; p < choice.size() && ++choice[p] == variant_count[p]; ++p) choice[p] = 0;
+    };
+
+    double best(-1);
+    std::vector<bool> best_active;
+    for (Size a = 0; a < assignments; ++a, next())
+    {
+      double s = evaluate();
+      if (s > best)
+      {
+        best = s;
+        best_active = active;
+      }
+    }
+    // if another set of edges comes close, leave the decision to the ILP
+    double tolerance = 1e-6 * std::max(1.0, best);
+    for (Size a = 0; a < assignments; ++a, next())
+    {
+      if (evaluate() >= best - tolerance && active != best_active) return false;
+    }
+
+    for (Size k = 0; k < edges.size(); ++k)
+    {
+      pairs[edges[k]].setEdgeScore(weights[k]);
+      pairs[edges[k]].setActive(best_active[k]);
+    }
+    score = best;
+    return true;
+  }
+
   void ILPDCWrapper::updateFeatureVariant_(FeatureType_& f_set, const String& rota_l, const Size& v) const
   {
     f_set[rota_l].insert(v);
   }
 
-  double ILPDCWrapper::computeSlice_(const FeatureMap fm,
+  double ILPDCWrapper::computeSlice_(const FeatureMap& fm,
                                      PairsType& pairs,
                                      const PairsIndex margin_left,
                                      const PairsIndex margin_right,
@@ -225,8 +437,10 @@ namespace OpenMS
     typedef std::map<Size, FeatureType_> r_type;
     r_type features;
 
-
-    LPWrapper build;
+    // slices are solved in parallel by compute(): each one uses its own LPWrapper with the
+    // COIN-OR solver (GLPK is not thread-safe)
+    LockedLPWrapper_ wrapper;
+    LPWrapper& build = *wrapper.lp;
     build.setSolver(LPWrapper::SOLVER_COINOR);
     build.setObjectiveSense(LPWrapper::MAX); // maximize
 
@@ -317,7 +531,7 @@ namespace OpenMS
 
   // old version, slower, as ILP has different layout (i.e, the same as described in paper)
 
-  double ILPDCWrapper::computeSliceOld_(const FeatureMap fm,
+  double ILPDCWrapper::computeSliceOld_(const FeatureMap& fm,
                                         PairsType& pairs,
                                         const PairsIndex margin_left,
                                         const PairsIndex margin_right,
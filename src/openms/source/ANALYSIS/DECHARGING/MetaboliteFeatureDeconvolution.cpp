@@ -41,6 +41,8 @@
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 
+#include <exception>
+
 //DEBUG:
 #include <fstream>
 
@@ -406,6 +408,7 @@ namespace OpenMS
     double rt_diff_max_local = param_.getValue("retention_max_diff_local");
 
     double mz_diff_max = param_.getValue("mass_max_diff");
+    String unit = param_.getValue("unit");
 
     double rt_min_overlap = param_.getValue("min_rt_overlap");
 
@@ -450,221 +453,257 @@ namespace OpenMS
     OPENMS_LOG_INFO << "done\n";
 
 
-    // holds query results for a mass difference
-    MassExplainer::CompomerIterator md_s, md_e;
     Compomer null_compomer(0, 0, -std::numeric_limits<double>::max());
-    SignedSize hits(0);
 
-    CoordinateType mz1, mz2, m1;
     Size possibleEdges(0), overallHits(0);
 
     // # compomer results that either passed or failed the feature charge constraints
     Size no_cmp_hit(0), cmp_hit(0);
 
-    for (Size i_RT = 0; i_RT < fm_out.size(); ++i_RT) // ** RT-sweep line
+    // Each position of the sweep line is independent of the others. Its edges and adduct
+    // candidates (indexed relative to its own edges) are collected separately and merged
+    // in RT order afterwards, so the result does not depend on the number of threads.
+    std::vector<PairsType> edges_at(fm_out.size());
+    std::vector<std::vector<std::pair<Size, CmpInfo_> > > adducts_at(fm_out.size());
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(+: possibleEdges, overallHits, no_cmp_hit, cmp_hit)
+#endif
+    for (SignedSize i_RT = 0; i_RT < (SignedSize)fm_out.size(); ++i_RT) // ** RT-sweep line
     {
-      mz1 = fm_out[i_RT].getMZ();
-
-      for (Size i_RT_window = i_RT + 1
-           ; (i_RT_window < fm_out.size())
-          && ((fm_out[i_RT_window].getRT() - fm_out[i_RT].getRT()) <= rt_diff_max)
-           ; ++i_RT_window)
-      { // ** RT-window
+      try
+      {
+        PairsType& edges = edges_at[i_RT];
+        std::vector<std::pair<Size, CmpInfo_> >& adducts = adducts_at[i_RT];
 
-        // knock-out criterion first: RT overlap
-        // use sorted structure and use 2nd start--1stend / 1st start--2ndend
-        const Feature& f1 = fm_out[i_RT];
-        const Feature& f2 = fm_out[i_RT_window];
+        const CoordinateType mz1 = fm_out[i_RT].getMZ();
 
-        if (!(f1.getConvexHull().getBoundingBox().isEmpty() || f2.getConvexHull().getBoundingBox().isEmpty()))
-        {
-          double f_start1 = std::min(f1.getConvexHull().getBoundingBox().minX(), f2.getConvexHull().getBoundingBox().minX());
-          double f_start2 = std::max(f1.getConvexHull().getBoundingBox().minX(), f2.getConvexHull().getBoundingBox().minX());
-          double f_end1 = std::min(f1.getConvexHull().getBoundingBox().maxX(), f2.getConvexHull().getBoundingBox().maxX());
-          double f_end2 = std::max(f1.getConvexHull().getBoundingBox().maxX(), f2.getConvexHull().getBoundingBox().maxX());
+        for (Size i_RT_window = i_RT + 1
+             ; (i_RT_window < fm_out.size())
+            && ((fm_out[i_RT_window].getRT() - fm_out[i_RT].getRT()) <= rt_diff_max)
+             ; ++i_RT_window)
+        { // ** RT-window
 
-          double union_length = f_end2 - f_start1;
-          double intersect_length = std::max(0., f_end1 - f_start2);
+          // knock-out criterion first: RT overlap
+          // use sorted structure and use 2nd start--1stend / 1st start--2ndend
+          const Feature& f1 = fm_out[i_RT];
+          const Feature& f2 = fm_out[i_RT_window];
 
-          if (intersect_length / union_length < rt_min_overlap)
-            continue;
-        }
+          if (!(f1.getConvexHull().getBoundingBox().isEmpty() || f2.getConvexHull().getBoundingBox().isEmpty()))
+          {
+            double f_start1 = std::min(f1.getConvexHull().getBoundingBox().minX(), f2.getConvexHull().getBoundingBox().minX());
+            double f_start2 = std::max(f1.getConvexHull().getBoundingBox().minX(), f2.getConvexHull().getBoundingBox().minX());
+            double f_end1 = std::min(f1.getConvexHull().getBoundingBox().maxX(), f2.getConvexHull().getBoundingBox().maxX());
+            double f_end2 = std::max(f1.getConvexHull().getBoundingBox().maxX(), f2.getConvexHull().getBoundingBox().maxX());
 
-        // start guessing charges ...
-        mz2 = fm_out[i_RT_window].getMZ();
+            double union_length = f_end2 - f_start1;
+            double intersect_length = std::max(0., f_end1 - f_start2);
 
-        for (Int q1 = q_min; q1 <= q_max; ++q1) // ** q1
-        {
-          //We assume that ionization modes won't get mixed in pipeline ->
-          //detected features should have same charge sign as provided to decharger settings for positive mode.
-          //For negative mode, this requirement is relaxed.
-          if (!chargeTestworthy_(f1.getCharge(), q1, true))
-            continue;
-
-          m1 = mz1 * abs(q1);
-          // additionally: forbid q1 and q2 with distance greater than q_span
-          for (Int q2 = std::max(q_min, q1 - q_span + 1)
-               ; (q2 <= q_max) && (q2 <= q1 + q_span - 1)
-               ; ++q2)
-          { // ** q2
-            //again, for negative mode relaxed, thus we consider the absolute of charge
-            if (!chargeTestworthy_(f2.getCharge(), q2, abs(f1.getCharge()) == abs(q1)))
+            if (intersect_length / union_length < rt_min_overlap)
               continue;
+          }
 
-            ++possibleEdges; // internal count, not vital
-
-            // Find possible adduct combinations.
-            // Masses and tolerances are multiplied with their charges to nullify charge influence on mass shift.
-            // Allows to remove compound mass M from both sides of compomer equation -> queried shift only due to different adducts.
-            // Tolerance must increase when looking at M instead of m/z, as error margins increase as well by multiplication.
-            CoordinateType naive_mass_diff = mz2 * abs(q2) - m1;
-
-            double abs_mass_diff;
-            if (param_.getValue("unit") == "Da")
-            {
-              abs_mass_diff = mz_diff_max * abs(q1) + mz_diff_max * abs(q2);
-            }
-            else if (param_.getValue("unit") == "ppm")
-            {
-              // For the ppm case, we multiply the respective experimental feature mz by its allowed ppm error before multiplication by charge.
-              // We look at the tolerance window with a simplified way: Just use the feature mz, and assume a symmetrc window around it.
-              // Instead of answering the more complex/asymetrical question: "which experimental mz can for given tolerance cause observed mz".
-              // (In the complex case we might have to consider different queries for different tolerance windows.)
-              // The expected error of this simplicfication is negligible:
-              // Assuming Y > X (X > Y is analog), given causative experimental mz Y and observed mz X with
-              // X = Y*(1 - d)
-              // for allowed tolerance d, the expected Error E between experimental mz and maximal mz in the tolerance window based on experimental mz is:
-              // E = (mz_exp - (mz_obs + max tolerance))/mz_exp = (Y - X*(1 + d))/Y = 1 - X*(1 + d)/Y = 1 - Y*(1 - d)*(1 + d)/Y = 1 - 1 - d*d = - d*d
-              // As d should be ppm sized, the error is something around 10 to the power of minus 12.
-              abs_mass_diff = mz1 * mz_diff_max * 1e-6 * abs(q1)   +   mz2 * mz_diff_max * 1e-6 * abs(q2);
-            }
-            else
-            {
-              throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING! Invalid tolerance unit! " + String(param_.getValue("unit"))  + "\n");
-            }
+          // start guessing charges ...
+          const CoordinateType mz2 = fm_out[i_RT_window].getMZ();
 
-            //abs charge "3" to abs charge "1" -> simply invert charge delta for negative case?
-            hits = me.query(q2 - q1, naive_mass_diff, abs_mass_diff, thresh_logp, md_s, md_e);
-            OPENMS_PRECONDITION(hits >= 0, "MetaboliteFeatureDeconvolution querying #hits got negative result!");
+          for (Int q1 = q_min; q1 <= q_max; ++q1) // ** q1
+          {
+            //We assume that ionization modes won't get mixed in pipeline ->
+            //detected features should have same charge sign as provided to decharger settings for positive mode.
+            //For negative mode, this requirement is relaxed.
+            if (!chargeTestworthy_(f1.getCharge(), q1, true))
+              continue;
 
-            overallHits += hits;
-            // choose most probable hit (TODO think of something clever here)
-            // for now, we take the one that has highest p in terms of the compomer structure
-            if (hits > 0)
-            {
-              Compomer best_hit = null_compomer;
-              for (; md_s != md_e; ++md_s)
+            const CoordinateType m1 = mz1 * abs(q1);
+            // additionally: forbid q1 and q2 with distance greater than q_span
+            for (Int q2 = std::max(q_min, q1 - q_span + 1)
+                 ; (q2 <= q_max) && (q2 <= q1 + q_span - 1)
+                 ; ++q2)
+            { // ** q2
+              //again, for negative mode relaxed, thus we consider the absolute of charge
+              if (!chargeTestworthy_(f2.getCharge(), q2, abs(f1.getCharge()) == abs(q1)))
+                continue;
+
+              ++possibleEdges; // internal count, not vital
+
+              // Find possible adduct combinations.
+              // Masses and tolerances are multiplied with their charges to nullify charge influence on mass shift.
+              // Allows to remove compound mass M from both sides of compomer equation -> queried shift only due to different adducts.
+              // Tolerance must increase when looking at M instead of m/z, as error margins increase as well by multiplication.
+              CoordinateType naive_mass_diff = mz2 * abs(q2) - m1;
+
+              double abs_mass_diff;
+              if (unit == "Da")
+              {
+                abs_mass_diff = mz_diff_max * abs(q1) + mz_diff_max * abs(q2);
+              }
+              else if (unit == "ppm")
+              {
+                // For the ppm case, we multiply the respective experimental feature mz by its allowed ppm error before multiplication by charge.
+                // We look at the tolerance window with a simplified way: Just use the feature mz, and assume a symmetrc window around it.
+                // Instead of answering the more complex/asymetrical question: "which experimental mz can for given tolerance cause observed mz".
+                // (In the complex case we might have to consider different queries for different tolerance windows.)
+                // The expected error of this simplicfication is negligible:
+                // Assuming Y > X (X > Y is analog), given causative experimental mz Y and observed mz X with
+                // X = Y*(1 - d)
+                // for allowed tolerance d, the expected Error E between experimental mz and maximal mz in the tolerance window based on experimental mz is:
+                // E = (mz_exp - (mz_obs + max tolerance))/mz_exp = (Y - X*(1 + d))/Y = 1 - X*(1 + d)/Y = 1 - Y*(1 - d)*(1 + d)/Y = 1 - 1 - d*d = - d*d
+                // As d should be ppm sized, the error is something around 10 to the power of minus 12.
+                abs_mass_diff = mz1 * mz_diff_max * 1e-6 * abs(q1)   +   mz2 * mz_diff_max * 1e-6 * abs(q2);
+              }
+              else
               {
-                // post-filter hits by local RT
-                if (fabs(f1.getRT() - f2.getRT() + md_s->getRTShift()) > rt_diff_max_local)
-                  continue;
+                throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING! Invalid tolerance unit! " + unit  + "\n");
+              }
 
-                //std::cout << md_s->getAdductsAsString() << " neg: " << md_s->getNegativeCharges() << " pos: " << md_s->getPositiveCharges() << " p: " << md_s->getLogP() << " \n";
-                int left_charges, right_charges;
-                if (is_neg)
-                {
-                  left_charges = -md_s->getPositiveCharges();
-                  right_charges = -md_s->getNegativeCharges();//for negative, a pos charge means either losing an H-1 from the left (decreasing charge) or the Na  case. (We do H-1Na as neutral, because of the pos,negcharges)
-                }
-                else
-                {
-                  left_charges = md_s->getNegativeCharges();//for positive mode neutral switches still have to fulfill requirement that they have at most charge as each side
-                  right_charges = md_s->getPositiveCharges();
-                }
+              //abs charge "3" to abs charge "1" -> simply invert charge delta for negative case?
+              // holds query results for a mass difference
+              MassExplainer::CompomerIterator md_s, md_e;
+              SignedSize hits = me.query(q2 - q1, naive_mass_diff, abs_mass_diff, thresh_logp, md_s, md_e);
+              OPENMS_PRECONDITION(hits >= 0, "MetaboliteFeatureDeconvolution querying #hits got negative result!");
 
-                if ( // compomer fits charge assignment of left & right feature. doesnt consider charge sign switch over span!
-                  (abs(q1)  >= abs(left_charges)) && (abs(q2) >= abs(right_charges)))
+              overallHits += hits;
+              // choose most probable hit (TODO think of something clever here)
+              // for now, we take the one that has highest p in terms of the compomer structure
+              if (hits > 0)
+              {
+                Compomer best_hit = null_compomer;
+                for (; md_s != md_e; ++md_s)
                 {
-                  // compomer has better probability
-                  if (best_hit.getLogP() < md_s->getLogP())
-                    best_hit = *md_s;
-
+                  // post-filter hits by local RT
+                  if (fabs(f1.getRT() - f2.getRT() + md_s->getRTShift()) > rt_diff_max_local)
+                    continue;
 
-                  /** testing: we just add every explaining edge
-                      - a first estimate shows that 90% of hits are of |1|
-                      - the remaining 10% have |2|, so the additional overhead is minimal
-                  **/
-                  Compomer cmp = me.getCompomerById(md_s->getID());
+                  //std::cout << md_s->getAdductsAsString() << " neg: " << md_s->getNegativeCharges() << " pos: " << md_s->getPositiveCharges() << " p: " << md_s->getLogP() << " \n";
+                  int left_charges, right_charges;
                   if (is_neg)
                   {
-                    left_charges = -cmp.getPositiveCharges();
-                    right_charges = -cmp.getNegativeCharges();
+                    left_charges = -md_s->getPositiveCharges();
+                    right_charges = -md_s->getNegativeCharges();//for negative, a pos charge means either losing an H-1 from the left (decreasing charge) or the Na  case. (We do H-1Na as neutral, because of the pos,negcharges)
                   }
                   else
                   {
-                    left_charges = cmp.getNegativeCharges();
-                    right_charges = cmp.getPositiveCharges();
+                    left_charges = md_s->getNegativeCharges();//for positive mode neutral switches still have to fulfill requirement that they have at most charge as each side
+                    right_charges = md_s->getPositiveCharges();
                   }
 
-                  //this block should only be of interest if we have something multiply charges instead of protonation or deprotonation
-                  if (((q1 - left_charges) % default_adduct.getCharge() != 0) ||
-                      ((q2 - right_charges) % default_adduct.getCharge() != 0))
+                  if ( // compomer fits charge assignment of left & right feature. doesnt consider charge sign switch over span!
+                    (abs(q1)  >= abs(left_charges)) && (abs(q2) >= abs(right_charges)))
                   {
-                    OPENMS_LOG_WARN << "Cannot add enough default adduct (" << default_adduct.getFormula() << ") to exactly fit feature charge! Next...)\n";
-                    continue;
-                  }
-
-                  int hc_left  = (q1 - left_charges) / default_adduct.getCharge();//this should always be positive! check!!
-                  int hc_right = (q2 - right_charges) / default_adduct.getCharge();//this should always be positive! check!!
-
-
-                  if (hc_left < 0 || hc_right < 0)
-                  {
-                    throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING!!! implicit number of default adduct is negative!!! left:" + String(hc_left) + " right: " + String(hc_right) + "\n");
-                  }
-
-                  // intensity constraint:
-                  // no edge is drawn if low-prob feature has higher intensity
-                  if (!intensityFilterPassed_(q1, q2, cmp, f1, f2))
-                    continue;
-
-                  // get non-default adducts of this edge
-                  Compomer cmp_stripped(cmp.removeAdduct(default_adduct));
-
-                  // save new adduct candidate
-                  if (cmp_stripped.getComponent()[Compomer::LEFT].size() > 0)
-                  {
-                    String tmp = cmp_stripped.getAdductsAsString(Compomer::LEFT);
-                    CmpInfo_ cmp_left(tmp, feature_relation.size(), Compomer::LEFT);
-                    feature_adducts[i_RT].insert(cmp_left);
-                  }
-                  if (cmp_stripped.getComponent()[Compomer::RIGHT].size() > 0)
-                  {
-                    String tmp = cmp_stripped.getAdductsAsString(Compomer::RIGHT);
-                    CmpInfo_ cmp_right(tmp, feature_relation.size(), Compomer::RIGHT);
-                    feature_adducts[i_RT_window].insert(cmp_right);
-                  }
-
-                  // add implicit default adduct (H+ or H-) (if != 0)
-                  if (hc_left > 0)
-                  {
-                    cmp.add(default_adduct * hc_left, Compomer::LEFT);
-                  }
-                  if (hc_right > 0)
-                  {
-                    cmp.add(default_adduct * hc_right, Compomer::RIGHT);
+                    // compomer has better probability
+                    if (best_hit.getLogP() < md_s->getLogP())
+                      best_hit = *md_s;
+
+
+                    /** testing: we just add every explaining edge
+                        - a first estimate shows that 90% of hits are of |1|
+                        - the remaining 10% have |2|, so the additional overhead is minimal
+                    **/
+                    Compomer cmp = me.getCompomerById(md_s->getID());
+                    if (is_neg)
+                    {
+                      left_charges = -cmp.getPositiveCharges();
+                      right_charges = -cmp.getNegativeCharges();
+                    }
+                    else
+                    {
+                      left_charges = cmp.getNegativeCharges();
+                      right_charges = cmp.getPositiveCharges();
+                    }
+
+                    //this block should only be of interest if we have something multiply charges instead of protonation or deprotonation
+                    if (((q1 - left_charges) % default_adduct.getCharge() != 0) ||
+                        ((q2 - right_charges) % default_adduct.getCharge() != 0))
+                    {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MetaboliteFeatureDeconvolution_log)
+#endif
+                      OPENMS_LOG_WARN << "Cannot add enough default adduct (" << default_adduct.getFormula() << ") to exactly fit feature charge! Next...)\n";
+                      continue;
+                    }
+
+                    int hc_left  = (q1 - left_charges) / default_adduct.getCharge();//this should always be positive! check!!
+                    int hc_right = (q2 - right_charges) / default_adduct.getCharge();//this should always be positive! check!!
+
+
+                    if (hc_left < 0 || hc_right < 0)
+                    {
+                      throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING!!! implicit number of default adduct is negative!!! left:" + String(hc_left) + " right: " + String(hc_right) + "\n");
+                    }
+
+                    // intensity constraint:
+                    // no edge is drawn if low-prob feature has higher intensity
+                    if (!intensityFilterPassed_(q1, q2, cmp, f1, f2))
+                      continue;
+
+                    // get non-default adducts of this edge
+                    Compomer cmp_stripped(cmp.removeAdduct(default_adduct));
+
+                    // save new adduct candidate
+                    if (cmp_stripped.getComponent()[Compomer::LEFT].size() > 0)
+                    {
+                      String tmp = cmp_stripped.getAdductsAsString(Compomer::LEFT);
+                      CmpInfo_ cmp_left(tmp, edges.size(), Compomer::LEFT);
+                      adducts.push_back(std::make_pair(Size(i_RT), cmp_left));
+                    }
+                    if (cmp_stripped.getComponent()[Compomer::RIGHT].size() > 0)
+                    {
+                      String tmp = cmp_stripped.getAdductsAsString(Compomer::RIGHT);
+                      CmpInfo_ cmp_right(tmp, edges.size(), Compomer::RIGHT);
+                      adducts.push_back(std::make_pair(i_RT_window, cmp_right));
+                    }
+
+                    // add implicit default adduct (H+ or H-) (if != 0)
+                    if (hc_left > 0)
+                    {
+                      cmp.add(default_adduct * hc_left, Compomer::LEFT);
+                    }
+                    if (hc_right > 0)
+                    {
+                      cmp.add(default_adduct * hc_right, Compomer::RIGHT);
+                    }
+
+                    ChargePair cp(i_RT, i_RT_window, q1, q2, cmp, naive_mass_diff - md_s->getMass(), false);
+                    edges.push_back(cp);
                   }
+                } // ! hits loop
 
-                  ChargePair cp(i_RT, i_RT_window, q1, q2, cmp, naive_mass_diff - md_s->getMass(), false);
-                  feature_relation.push_back(cp);
+                if (best_hit == null_compomer)
+                {
+                  //std::cout << "MetaboliteFeatureDeconvolution.h:: could find no compomer complying with assumed q1 and q2 values!\n with q1: " << q1 << " q2: " << q2 << "\n";
+                  ++no_cmp_hit;
+                }
+                else
+                {
+                  ++cmp_hit;
                 }
-              } // ! hits loop
-
-              if (best_hit == null_compomer)
-              {
-                //std::cout << "MetaboliteFeatureDeconvolution.h:: could find no compomer complying with assumed q1 and q2 values!\n with q1: " << q1 << " q2: " << q2 << "\n";
-                ++no_cmp_hit;
-              }
-              else
-              {
-                ++cmp_hit;
               }
-            }
 
-          } // q2
-        } // q1
-      } // RT-window
+            } // q2
+          } // q1
+        } // RT-window
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MetaboliteFeatureDeconvolution_error)
+#endif
+        {
+          if (!error) error = std::current_exception();
+        }
+      }
     } // RT sweep line
+    if (error) std::rethrow_exception(error);
+
+    for (Size i_RT = 0; i_RT < fm_out.size(); ++i_RT)
+    {
+      for (std::vector<std::pair<Size, CmpInfo_> >::iterator it = adducts_at[i_RT].begin(); it != adducts_at[i_RT].end(); ++it)
+      {
+        it->second.idx_cp += feature_relation.size();
+        feature_adducts[it->first].insert(it->second);
+      }
+      feature_relation.insert(feature_relation.end(), edges_at[i_RT].begin(), edges_at[i_RT].end());
+    }
 
 
     OPENMS_LOG_INFO << no_cmp_hit << " of " << (no_cmp_hit + cmp_hit) << " valid net charge compomer results did not pass the feature charge constraints\n";
@@ -1274,6 +1313,9 @@ namespace OpenMS
       else
       {
         // forbid this edge?!
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MetaboliteFeatureDeconvolution_log)
+#endif
         std::cout << "intensity constraint: edge with intensity " << f1.getIntensity() << "(" << cmp.getAdductsAsString(Compomer::LEFT) << ") and " << f2.getIntensity() << "(" << cmp.getAdductsAsString(Compomer::RIGHT) << ") deleted\n";
         return false;
       }
@@ -37,11 +37,64 @@
 
 #include <OpenMS/CONCEPT/Factory.h>
 
+#include <exception>
 #include <fstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
 
+  /// Cells (i, j) of the (n + 1) x (m + 1) alignment matrix with m - n - k <= i - j <= k, stored row after row in one block. A band with k < 0 is empty.
+  struct MapAlignmentAlgorithmSpectrumAlignment::Band_
+  {
+    Band_(Size n, Size m, Int k) :
+      n_(n), m_(m), k_(k), offset_(n + 2, 0)
+    {
+      for (Size i = 0; i <= n_; ++i)
+      {
+        offset_[i + 1] = offset_[i] + std::max(last(i) - first(i) + 1, SignedSize(0));
+      }
+    }
+
+    /// first column of row @p i inside the band
+    SignedSize first(Size i) const
+    {
+      return std::max(SignedSize(i) - k_, SignedSize(0));
+    }
+
+    /// last column of row @p i inside the band (smaller than first(i) if the row is empty)
+    SignedSize last(Size i) const
+    {
+      if (k_ < 0) return first(i) - 1;
+      return std::min(SignedSize(i) + k_ + SignedSize(n_) - SignedSize(m_), SignedSize(m_));
+    }
+
+    bool contains(Size i, Size j) const
+    {
+      return i <= n_ && first(i) <= SignedSize(j) && SignedSize(j) <= last(i);
+    }
+
+    /// position of cell (i, j) in the storage, the cell must be inside the band
+    Size index(Size i, Size j) const
+    {
+      return offset_[i] + (j - first(i));
+    }
+
+    /// number of cells inside the band
+    Size size() const
+    {
+      return offset_.back();
+    }
+
+    Size n_;
+    Size m_;
+    SignedSize k_;
+    std::vector<Size> offset_;
+  };
+
   MapAlignmentAlgorithmSpectrumAlignment::MapAlignmentAlgorithmSpectrumAlignment() :
     DefaultParamHandler("MapAlignmentAlgorithmSpectrumAlignment"),
     ProgressLogger(), c1_(nullptr)
@@ -76,18 +129,42 @@ namespace OpenMS
   void MapAlignmentAlgorithmSpectrumAlignment::align(std::vector<PeakMap >& peakmaps, std::vector<TransformationDescription>& transformation)
   {
     transformation.clear();
-    TransformationDescription trafo;
-    trafo.fitModel("identity");
-    transformation.push_back(trafo); // transformation of reference map
+    transformation.resize(peakmaps.size());
+    transformation[0].fitModel("identity"); // transformation of reference map
     try
     {
       std::vector<MSSpectrum*> spectrum_pointers;
       msFilter_(peakmaps[0], spectrum_pointers);
       startProgress(0, (peakmaps.size() - 1), "Alignment");
-      for (Size i = 1; i < peakmaps.size(); ++i)
+      Size progress = 0;
+      std::exception_ptr error;
+      // the maps are aligned independently against the reference map (but the
+      // debug output goes to the same files and has to be written serially)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (!debug_ && peakmaps.size() > 2)
+#endif
+      for (SignedSize i = 1; i < (SignedSize)peakmaps.size(); ++i)
+      {
+        try
+        {
+          prepareAlign_(spectrum_pointers, peakmaps[i], transformation[i]);
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MapAlignmentAlgorithmSpectrumAlignment_error)
+#endif
+          if (!error) error = std::current_exception();
+        }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+        IF_MASTERTHREAD setProgress(progress);
+      }
+      if (error)
       {
-        prepareAlign_(spectrum_pointers, peakmaps[i], transformation);
-        setProgress(i);
+        std::rethrow_exception(error);
       }
       endProgress();
     }
@@ -97,7 +174,7 @@ namespace OpenMS
     }
   }
 
-  void MapAlignmentAlgorithmSpectrumAlignment::prepareAlign_(const std::vector<MSSpectrum*>& pattern, PeakMap& aligned, std::vector<TransformationDescription>& transformation)
+  void MapAlignmentAlgorithmSpectrumAlignment::prepareAlign_(const std::vector<MSSpectrum*>& pattern, PeakMap& aligned, TransformationDescription& transformation)
   {
     //tempalign ->container for holding only MSSpectrums with MS-Level 1
     std::vector<MSSpectrum*> tempalign;
@@ -157,7 +234,10 @@ namespace OpenMS
     std::vector<Int> xcoordinate;
     std::vector<Int> xcoordinatepattern;
     std::vector<float> ycoordinate;
-    debugmatrix_.clear();
+    if (debug_)
+    {
+      debugmatrix_.clear();
+    }
 
     for (Size i = 0; i < alignpoint.size() - 2; i += 2)
     {
@@ -191,159 +271,146 @@ namespace OpenMS
       double rt = tempalign[xcoordinate[i]]->getRT();
       data.push_back(std::make_pair(rt, double(ycoordinate[i])));
     }
-    transformation.emplace_back(data);
+    transformation = TransformationDescription(data);
   }
 
   void MapAlignmentAlgorithmSpectrumAlignment::affineGapalign_(Size xbegin, Size ybegin, Size xend, Size yend, const std::vector<MSSpectrum*>& pattern, std::vector<MSSpectrum*>& aligned, std::vector<int>& xcoordinate, std::vector<float>& ycoordinate, std::vector<int>& xcoordinatepattern)
   {
-    //affine gap alignment needs two matrices
-    std::map<Size, std::map<Size, float> > firstcolummatchmatrix;
-    std::map<Size, std::map<Size, float> > secondcolummatchmatrix;
     Size n = std::max((xend - xbegin), (yend - ybegin)) + 1; //column
     Size m = std::min((xend - xbegin), (yend - ybegin)) + 1; //row
-    // std::cout<< n << " n " << m << " m " <<  xbegin << " " <<xend<< " " << ybegin << " " << yend <<std::endl;
     //log the Progress of the subaligmnet
     String temp = "sub-alignment of interval: template sequence " + String(xbegin) + " " + String(xend) + " interval: alignsequence " + String(ybegin) + " " + String(yend);
-    startProgress(0, n, temp);
+    IF_MASTERTHREAD startProgress(0, n, temp);
 
     bool column_row_orientation = false;
     if (n != (xend - xbegin) + 1)
     {
       column_row_orientation = true;
     }
-    //matrix for holding calculated scores
-    std::map<Size, std::map<Size, float> > buffermatrix;
-    std::map<Size, std::map<Size, Size> > traceback;
     //calculate the value of k
-    Int k_ = bestk_(pattern, aligned, buffermatrix, column_row_orientation, xbegin, xend, ybegin, yend) + 2;
+    Int k_ = bestk_(pattern, aligned, column_row_orientation, xbegin, xend, ybegin, yend) + 2;
     float score_ = -99999999.0f;
+    //band of the last alignment, the scores of its cells and the traceback
+    Band_ band(n, m, -1);
+    std::vector<float> buffer;
+    std::vector<Byte> traceback;
     //flag if we have to calculate again the alignment in step k+1
     bool finish = false;
     while (!finish)
     {
-      traceback.clear();
+      //score all cells of the (wider) band; cells of the previous band are already known
+      Band_ wider(n, m, k_);
+      std::vector<float> wider_buffer(wider.size(), 0.0f);
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16) if (!debug_)
+#endif
+      for (SignedSize i = 1; i <= (SignedSize)n; ++i)
+      {
+        try
+        {
+          for (SignedSize j = std::max(wider.first(i), SignedSize(1)); j <= wider.last(i); ++j)
+          {
+            wider_buffer[wider.index(i, j)] = band.contains(i, j) ? buffer[band.index(i, j)] :
+                                              scoreCalculation_(i, j, xbegin, ybegin, pattern, aligned, column_row_orientation);
+          }
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MapAlignmentAlgorithmSpectrumAlignment_error)
+#endif
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+      band = wider;
+      buffer.swap(wider_buffer);
+      traceback.assign(band.size(), 0);
+
+      //affine gap alignment only needs the previous and the current row
+      std::vector<float> previous(m + 1, 0.0f), current(m + 1, 0.0f);
       for (Size i = 0; i <= n; ++i)
       {
-        setProgress(i);
-        for (Size j = 0; j <= m; ++j) //if( j >=1 && (Size)j<=m)
+        IF_MASTERTHREAD setProgress(i);
+        for (SignedSize j = band.first(i); j <= band.last(i); ++j)
         {
-          if (insideBand_(i, j, n, m, k_))
+          if (i == 0)
+          {
+            previous[j] = (-gap_) * j;
+          }
+          else if (j == 0)
           {
-            if (i == 0 || j == 0)
+            current[j] = (-gap_) * i;
+          }
+          else
+          {
+            double s = buffer[band.index(i, j)];
+            if (debug_)
             {
-              if (i == 0)
+              std::vector<float> ltemp;
+              if (!column_row_orientation)
               {
-                firstcolummatchmatrix[i][j] = (-gap_) * j;
-                //std::cout << firstcolummatchmatrix[i][j] << " i j firstcolum "<< std::endl;
+                ltemp.push_back((float)i + xbegin - 1);
+                ltemp.push_back((float)j + ybegin - 1);
               }
-              else if (j == 0)
+              else
               {
-                secondcolummatchmatrix[i][j] = (-gap_) * i;
-                //std::cout << secondcolummatchmatrix[i][j] << " i j secondcolum "<< std::endl;
+                ltemp.push_back((float)j + xbegin - 1);
+                ltemp.push_back((float)i + ybegin - 1);
               }
+              ltemp.push_back(s);
+              ltemp.push_back(0);
+              debugscorematrix_.push_back(ltemp);
+            }
+            float mv = -999.0;
+            float mh = -999.0;
+            if (band.contains(i - 1, j))
+            {
+              mh = previous[j] - gap_;
+            }
+            if (band.contains(i, j - 1))
+            {
+              mv = current[j - 1] - gap_;
+            }
+            float md = previous[j - 1] + s;
+            current[j] = std::max((float)md, std::max((float)(mv), (float)(mh)));
+            if (current[j] == mh)
+            {
+              traceback[band.index(i, j)] = 1;
+            }
+            else if (current[j] == mv)
+            {
+              traceback[band.index(i, j)] = 2;
             }
             else
             {
-              try
-              {
-                double s = scoreCalculation_(i, j, xbegin, ybegin, pattern, aligned, buffermatrix, column_row_orientation);
-                if (debug_)
-                {
-                  std::vector<float> ltemp;
-                  if (!column_row_orientation)
-                  {
-                    ltemp.push_back((float)i + xbegin - 1);
-                    ltemp.push_back((float)j + ybegin - 1);
-                    ltemp.push_back(s);
-                    ltemp.push_back(0);
-                    debugscorematrix_.push_back(ltemp);
-                  }
-                  else
-                  {
-                    ltemp.push_back((float)j + xbegin - 1);
-                    ltemp.push_back((float)i + ybegin - 1);
-                    ltemp.push_back(s);
-                    ltemp.push_back(0);
-                    debugscorematrix_.push_back(ltemp);
-                  }
-                }
-                float mv = -999.0;
-                float mh = -999.0;
-                i = i - 1;
-                if (insideBand_(i, j, n, m, k_))
-                {
-                  mh = firstcolummatchmatrix[i][j] - gap_;
-                  //std::cout <<firstcolummatchmatrix[i][j] << " " << i << " " << j<<" firstcolumnnn "<<std::endl;
-                  i += 1;
-                }
-                else
-                {
-                  i += 1;
-                }
-                j = j - 1;
-                if (insideBand_(i, j, n, m, k_))
-                {
-                  mv = secondcolummatchmatrix[i][j] - gap_;
-                  j += 1;
-                }
-                else
-                {
-                  j += 1;
-                }
-                //mv=matchmatrix[i][j-1]-gap_;
-                //mh=matchmatrix[i-1][j]-gap_;
-                float md = firstcolummatchmatrix[i - 1][j - 1] + s;
-                //std::cout << i << " " << j << " i j " << mv << " mv " << mh << " mh " << md << " md " << std::endl;
-                secondcolummatchmatrix[i][j] = std::max((float)md, std::max((float)(mv), (float)(mh)));
-                //std::cout << secondcolummatchmatrix[i][j] << " " << i << " "<< j << " i j zweiter colum" << std::endl;
-                if (secondcolummatchmatrix[i][j] == mh)
-                {
-                  traceback[i][j] = 1;
-                }
-                else if (secondcolummatchmatrix[i][j] == mv)
-                {
-                  traceback[i][j] = 2;
-                }
-                else
-                  traceback[i][j] = 0;
-              }
-              catch (Exception::OutOfRange& /*e*/)
-              {
-                throw Exception::OutOfRange(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
-              }
+              traceback[band.index(i, j)] = 0;
             }
           }
         }
         if (i != 0)
         {
-          firstcolummatchmatrix = secondcolummatchmatrix;
-          secondcolummatchmatrix.clear();
+          previous.swap(current);
         }
       }
-      if (score_ >= firstcolummatchmatrix[n][m] || k_ == (Int)n + 2) // || matchmatrix[n][m] >= (2*(k_+1)+n-m)*(-gap_)+(n-(k_+1))*3/*(m-(k_+1))*cutoffScore_ -2* gap_ - (2*(k_) +((Int)m-(Int)n))*e_*/)
+      //a cell outside of the band has no score
+      float last = band.contains(n, m) ? previous[m] : 0.0f;
+      if (score_ >= last || k_ == (Int)n + 2)
       {
         finish = true;
-        firstcolummatchmatrix.clear();
-        secondcolummatchmatrix.clear();
       }
       else
       {
-        score_ = firstcolummatchmatrix[n][m];
+        score_ = last;
         k_ *= 2;
         if (k_ > (Int)n + 2)
           k_ = (Int)n + 2;
       }
     }
-    // matchmatrix.clear();
-    /*for(Size i=0; i <=n;++i)
-        {
-            for(Size j=0; j<=m;++j)
-            {
-                if(insideBand_(i,j,n,m,k_))
-                std::cout << i << " "<< j << " i j " << traceback[i][j] << " Match  Trace" << std::endl;
-            }
-        std::cout<< std::endl;
-        }*/
     //traceback
     bool endtraceback = false;
     int i = (int) n;
@@ -361,7 +428,8 @@ namespace OpenMS
         endtraceback = true;
       else
       {
-        if (traceback[i][j] == 0)
+        Byte direction = band.contains(i, j) ? traceback[band.index(i, j)] : 0;
+        if (direction == 0)
         {
           if (!column_row_orientation)
           {
@@ -386,9 +454,9 @@ namespace OpenMS
           i = i - 1;
           j = j - 1;
         }
-        else if (traceback[i][j] == 1)
+        else if (direction == 1)
           i = i - 1;
-        else if (traceback[i][j] == 2)
+        else if (direction == 2)
           j = j - 1;
       }
     }
@@ -412,7 +480,7 @@ namespace OpenMS
       }
     }
     //std::cout<< xcoordinate.size()<< std::endl;
-    endProgress();
+    IF_MASTERTHREAD endProgress();
   }
 
   void MapAlignmentAlgorithmSpectrumAlignment::msFilter_(PeakMap& peakmap, std::vector<MSSpectrum*>& spectrum_pointer_container)
@@ -437,29 +505,30 @@ namespace OpenMS
     }
   }
 
-  inline bool MapAlignmentAlgorithmSpectrumAlignment::insideBand_(Size i, Size j, Size n, Size m, Int k_)
-  {
-    if ((Int)(m - n - k_) <= (Int)(i - j) && (Int) (i - j) <= k_) //  if((Int)(-k_)<=(Int)(i-j) &&(Int) (i-j) <=(Int)(k_+n-m))
-    {
-      //std::cout << i << " i " << j << " j " << " innerhalb der Bande " << std::endl;
-      return true;
-    }
-    else
-    {
-      //std::cout << i << " i " << j << " j " << "NICHT innerhalb der Bande " << std::endl;
-      return false;
-    }
-  }
-
-  inline Int MapAlignmentAlgorithmSpectrumAlignment::bestk_(const std::vector<MSSpectrum*>& pattern, std::vector<MSSpectrum*>& aligned, std::map<Size, std::map<Size, float> >& buffer, bool column_row_orientation, Size xbegin, Size xend, Size ybegin, Size yend)
+  inline Int MapAlignmentAlgorithmSpectrumAlignment::bestk_(const std::vector<MSSpectrum*>& pattern, std::vector<MSSpectrum*>& aligned, bool column_row_orientation, Size xbegin, Size xend, Size ybegin, Size yend)
   {
     Int ktemp = 2;
+    std::vector<float> scores(xend - xbegin + 1);
     for (float i = 0.25; i <= 0.75; i += 0.25)
     {
       Size temp = (Size)((yend - ybegin) * i);
+      // score the whole row first, the search for the highscore pairs below depends on the order
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (!debug_)
+#endif
+      for (SignedSize k = 0; k < (SignedSize)scores.size(); ++k)
+      {
+        if (column_row_orientation)
+        {
+          scores[k] = scoreCalculation_(temp + 1, k + 1, xbegin, ybegin, pattern, aligned, column_row_orientation);
+        }
+        else
+        {
+          scores[k] = scoreCalculation_(k + 1, temp + 1, xbegin, ybegin, pattern, aligned, column_row_orientation);
+        }
+      }
       float    maxi = -999.0;
-      float    s = -999.0;
-      for (Size k = 0; k <= (xend - xbegin); ++k)
+      for (Size k = 0; k < scores.size(); ++k)
       {
         Size x;
         Int y;
@@ -467,14 +536,13 @@ namespace OpenMS
         {
           x = temp + 1;
           y = (Int)k + 1;
-          s = scoreCalculation_(x, y, xbegin, ybegin, pattern, aligned, buffer, column_row_orientation);
         }
         else
         {
           x = k + 1;
           y = (Int)(temp + 1);
-          s = scoreCalculation_(x, y, xbegin, ybegin, pattern, aligned, buffer, column_row_orientation);
         }
+        float s = scores[k];
         if (s > maxi && s > cutoffScore_)
         {
           maxi = s;
@@ -488,46 +556,28 @@ namespace OpenMS
     return ktemp;
   }
 
-  inline float MapAlignmentAlgorithmSpectrumAlignment::scoreCalculation_(Size i, Size j, Size patternbegin, Size alignbegin, const std::vector<MSSpectrum*>& pattern, std::vector<MSSpectrum*>& aligned, std::map<Size, std::map<Size, float> >& buffer, bool column_row_orientation)
+  inline float MapAlignmentAlgorithmSpectrumAlignment::scoreCalculation_(Size i, Size j, Size patternbegin, Size alignbegin, const std::vector<MSSpectrum*>& pattern, std::vector<MSSpectrum*>& aligned, bool column_row_orientation)
   {
+    float score;
     if (!column_row_orientation)
     {
-      if (buffer[i][j] == 0)
-      {
-        float score = scoring_(*pattern[i + patternbegin - 1], *aligned[j + alignbegin - 1]);
-        if (score > 1)
-          score = 1;
-        if (debug_)
-        {
-          debugscoreDistributionCalculation_(score);
-        }
-        if (score < threshold_)
-          score = mismatchscore_;
-        else
-          score = 2 + score;
-        buffer[i][j] = score;
-      }
-      return buffer[i][j];
+      score = scoring_(*pattern[i + patternbegin - 1], *aligned[j + alignbegin - 1]);
     }
     else
     {
-      if (buffer[j][i] == 0)
-      {
-        float score = scoring_(*pattern[j + patternbegin - 1], *aligned[i + alignbegin - 1]);
-        if (score > 1)
-          score = 1;
-        if (debug_)
-        {
-          debugscoreDistributionCalculation_(score);
-        }
-        if (score < threshold_)
-          score = mismatchscore_;
-        else
-          score = 2 + score;
-        buffer[j][i] = score;
-      }
-      return buffer[j][i];
+      score = scoring_(*pattern[j + patternbegin - 1], *aligned[i + alignbegin - 1]);
     }
+    if (score > 1)
+      score = 1;
+    if (debug_)
+    {
+      debugscoreDistributionCalculation_(score);
+    }
+    if (score < threshold_)
+      score = mismatchscore_;
+    else
+      score = 2 + score;
+    return score;
   }
 
   inline float MapAlignmentAlgorithmSpectrumAlignment::scoring_(const MSSpectrum& a, MSSpectrum& b)
@@ -539,29 +589,31 @@ namespace OpenMS
   {
     std::vector<std::pair<std::pair<Int, float>, float> > tempxy;
     Size size = 0;
+    // the maps are filtered concurrently, so the bucket size must not be changed for the following ones
+    Size bucketsize = bucketsize_;
     //std::cout <<bucketsize_  << " bucketsize " <<xcoordinate.size() << " xsize()" << std::endl;
-    if (bucketsize_ >= xcoordinate.size())
+    if (bucketsize >= xcoordinate.size())
     {
-      bucketsize_ = xcoordinate.size() - 1;
+      bucketsize = xcoordinate.size() - 1;
       size = 1;
     }
     else
-      size = xcoordinate.size() / bucketsize_;
+      size = xcoordinate.size() / bucketsize;
 
     if (size == 1)
-      bucketsize_ = xcoordinate.size() - 1;
+      bucketsize = xcoordinate.size() - 1;
     //std::cout << size << " size "<< xcoordinate.size() << " xcoordinate.size() " << std::endl;
     for (Size i = 0; i < size; ++i)
     {
       std::vector<std::pair<std::pair<Int, float>, float> > temp;
-      for (Size j = 0; j < bucketsize_; ++j)
+      for (Size j = 0; j < bucketsize; ++j)
       {
         //std::cout<< j << " j " << std::endl;
-        float score = scoring_(*pattern[xcoordinatepattern[(i * bucketsize_) + j]], *aligned[xcoordinate[(i * bucketsize_) + j]]);
+        float score = scoring_(*pattern[xcoordinatepattern[(i * bucketsize) + j]], *aligned[xcoordinate[(i * bucketsize) + j]]);
         //modification only view as a possible data point if the score is higher than 0
         if (score >= threshold_)
         {
-          temp.emplace_back(std::make_pair(xcoordinate[(i * bucketsize_) + j], ycoordinate[(i * bucketsize_) + j]), score);
+          temp.emplace_back(std::make_pair(xcoordinate[(i * bucketsize) + j], ycoordinate[(i * bucketsize) + j]), score);
         }
       }
       /*for(Size i=0; i < temp.size();++i)
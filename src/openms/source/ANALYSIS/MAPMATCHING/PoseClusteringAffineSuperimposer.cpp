@@ -37,6 +37,8 @@
 #include <OpenMS/MATH/STATISTICS/BasicStatistics.h>
 #include <OpenMS/MATH/MISC/LinearInterpolation.h>
 
+#include <limits>
+
 
 // #define Debug_PoseClusteringAffineSuperimposer
 
@@ -83,6 +85,13 @@ namespace OpenMS
                                            "The minimal scaling is the reciprocal of this.", ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("max_scaling", 1.);
 
+    defaults_.setValue("pairing", "sweep", "How the combinations of point pairs are enumerated for hashing.  "
+                                           "'scan' searches the m/z windows of both maps again for every combination.  "
+                                           "'sweep' collects all pairs of model and scene points within 'mz_pair_max_distance' once "
+                                           "(sorted sweep over m/z) and combines them from contiguous arrays.  Both hash the same "
+                                           "transformations, but 'sweep' is much faster for large values of 'num_used_points'.", ListUtils::create<String>("advanced"));
+    defaults_.setValidStrings("pairing", ListUtils::create<String>("sweep,scan"));
+
     defaults_.setValue("dump_buckets", "", "[DEBUG] If non-empty, base filename where hash table buckets will be dumped to.  "
                                            "A serial number for each invocation will be appended automatically.", ListUtils::create<String>("advanced"));
 
@@ -307,6 +316,204 @@ namespace OpenMS
     }   // i
   }
 
+  /**
+    @brief Same as affineTransformationHashing(), but the point pairs are collected in advance.
+
+    A sorted sweep over both maps (sorted by m/z) collects, for every point j
+    of the model map, all points l of the scene map within
+    mz_pair_max_distance, i.e. the m/z bucket of j.  The buckets are stored
+    one after the other in contiguous arrays.  Each pair (i,k) is then
+    combined with all pairs (j,l) of the following buckets (j > i).  The
+    transformations of a whole bucket range are computed in one tight loop
+    (which the compiler can vectorize) before they are hashed.
+
+    The hashed values, their weights and their order are identical to
+    affineTransformationHashing(), but the m/z windows are not searched again
+    for every combination of points.
+  */
+  void affineTransformationHashingSweep(const bool do_dump_pairs,
+                                        const std::vector<Peak2D> & model_map,
+                                        const std::vector<Peak2D> & scene_map,
+                                        Math::LinearInterpolation<double, double>& scaling_hash_1,
+                                        Math::LinearInterpolation<double, double>& scaling_hash_2,
+                                        Math::LinearInterpolation<double, double>& rt_low_hash_,
+                                        Math::LinearInterpolation<double, double>& rt_high_hash_,
+                                        const int hashing_round,
+                                        const double rt_pair_min_distance,
+                                        const String dump_pairs_basename,
+                                        const Int dump_buckets_serial,
+                                        const double mz_pair_max_distance,
+                                        const double winlength_factor_baseline,
+                                        const double total_intensity_ratio,
+                                        const double scale_low_1,
+                                        const double scale_high_1,
+                                        const double rt_low, const double rt_high)
+  {
+    Size const model_map_size = model_map.size();   // i j
+    Size const scene_map_size = scene_map.size();   // k l
+
+    String dump_pairs_filename;
+    std::ofstream dump_pairs_file;
+    if (do_dump_pairs)
+    {
+      dump_pairs_filename = dump_pairs_basename + "_phase_two_" + String(dump_buckets_serial);
+      dump_pairs_file.open(dump_pairs_filename.c_str());
+      dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
+    }
+
+    // weight of the m/z window of each model point (inverse proportional to the number of model points in it)
+    std::vector<double> model_winlength_factor(model_map_size);
+    // pairs (j,l) of the bucket of model point j start at pair_begin[j]
+    std::vector<Size> pair_begin(model_map_size + 1);
+    std::vector<Size> pair_model, pair_scene;
+    std::vector<double> pair_model_rt, pair_scene_rt, pair_intensity_similarity, pair_scene_winlength_factor;
+    for (Size j = 0, j_low = 0, j_high = 0, l_low = 0, l_high = 0; j < model_map_size; ++j)
+    {
+      const double mz = model_map[j].getMZ();
+      while (j_low < model_map_size && model_map[j_low].getMZ() < mz - mz_pair_max_distance)
+        ++j_low;
+      while (j_high < model_map_size && model_map[j_high].getMZ() <= mz + mz_pair_max_distance)
+        ++j_high;
+      model_winlength_factor[j] = 1. / (j_high - j_low) - winlength_factor_baseline;
+
+      while (l_low < scene_map_size && scene_map[l_low].getMZ() < mz - mz_pair_max_distance)
+        ++l_low;
+      while (l_high < scene_map_size && scene_map[l_high].getMZ() <= mz + mz_pair_max_distance)
+        ++l_high;
+
+      pair_begin[j] = pair_model.size();
+      // stop if there are too many features are in our window
+      double l_winlength_factor = 1. / (l_high - l_low);
+      l_winlength_factor -= winlength_factor_baseline;
+      if (l_winlength_factor <= 0)
+        continue;
+
+      for (Size l = l_low; l < l_high; ++l)
+      {
+        // similarity of intensities j l (weighted later, the weight of j depends on its partner i)
+        const double int_j = model_map[j].getIntensity();
+        const double int_l = scene_map[l].getIntensity() * total_intensity_ratio;
+        pair_model.push_back(j);
+        pair_scene.push_back(l);
+        pair_model_rt.push_back(model_map[j].getRT());
+        pair_scene_rt.push_back(scene_map[l].getRT());
+        pair_intensity_similarity.push_back((int_j < int_l) ? int_j / int_l : int_l / int_j);
+        pair_scene_winlength_factor.push_back(l_winlength_factor);
+      }
+    }
+    pair_begin[model_map_size] = pair_model.size();
+
+    // Only scalings within these bounds are hashed.  In round 1, the bounds
+    // include one more bucket on each side of the histogram, outside of it
+    // addValue() would not change anything.
+    double scaling_min = scale_low_1;
+    double scaling_max = scale_high_1;
+    if (hashing_round == 1)
+    {
+      scaling_min = 0.;
+      scaling_max = std::numeric_limits<double>::infinity();
+      if (scaling_hash_1.getScale() > 0)
+      {
+        scaling_min = exp(scaling_hash_1.index2key(-2.));
+        scaling_max = exp(scaling_hash_1.index2key(double(scaling_hash_1.getData().size()) + 1.));
+      }
+    }
+
+    // transformations of one pair (i,k) with all pairs (j,l) of the following buckets
+    std::vector<double> scalings;
+    std::vector<Byte> valid;
+    std::vector<Size> selected;
+
+    // first point in model map (i)
+    for (Size i = 0; i + 1 < model_map_size; ++i)
+    {
+      const double i_winlength_factor = model_winlength_factor[i];
+      if (i_winlength_factor <= 0)
+        continue;
+
+      const Size first = pair_begin[i + 1]; // pairs with j > i
+      const Size count = pair_begin[model_map_size] - first;
+      if (count == 0)
+        break;
+      scalings.resize(count);
+      valid.resize(count);
+      selected.resize(count);
+      const double* model_rt = &pair_model_rt[first];
+      const double* scene_rt = &pair_scene_rt[first];
+
+      // first point in scene map (k)
+      for (Size ik = pair_begin[i]; ik < pair_begin[i + 1]; ++ik)
+      {
+        const double rt_i = pair_model_rt[ik];
+        const double rt_k = pair_scene_rt[ik];
+        double similarity_ik = pair_intensity_similarity[ik];
+        // weight is inverse proportional to number of elements with similar mz
+        similarity_ik *= i_winlength_factor;
+        similarity_ik *= pair_scene_winlength_factor[ik];
+
+        // second points (j,l): compute all transformations (i,j) -> (k,l) at
+        // once (no branches, so this loop is vectorized) ...
+        for (Size c = 0; c < count; ++c)
+        {
+          const double diff_model = model_rt[c] - rt_i;
+          const double diff_scene = scene_rt[c] - rt_k;
+          const double scaling = diff_model / diff_scene;
+          scalings[c] = scaling;
+          // skip point pairs that are too close in RT and avoid cross mappings (i,j) -> (k,l)
+          valid[c] = (std::fabs(diff_model) >= rt_pair_min_distance) & (std::fabs(diff_scene) >= rt_pair_min_distance) &
+                     ((diff_model > 0) == (diff_scene > 0)) & (scaling >= scaling_min) & (scaling <= scaling_max);
+        }
+        // ... collect the valid ones (their order is random, so branching would be expensive) ...
+        Size hashed = 0;
+        for (Size c = 0; c < count; ++c)
+        {
+          selected[hashed] = c;
+          hashed += valid[c];
+        }
+
+        // ... and hash them
+        for (Size h = 0; h < hashed; ++h)
+        {
+          const Size jl = first + selected[h];
+          const double scaling = scalings[selected[h]];
+
+          // j uses the window weight of i (as in affineTransformationHashing())
+          double similarity_jl = pair_intensity_similarity[jl];
+          similarity_jl *= i_winlength_factor;
+          similarity_jl *= pair_scene_winlength_factor[jl];
+          const double similarity_ik_jl = similarity_ik * similarity_jl;
+
+          if (hashing_round == 1)
+          {
+            // hashing round 1 (estimate the scaling only)
+            scaling_hash_1.addValue(log(scaling), similarity_ik_jl);
+          }
+          else
+          {
+            // hashing round 2 (estimate scaling and shift)
+            scaling_hash_2.addValue(log(scaling), similarity_ik_jl);
+
+            const double shift = rt_i - rt_k * scaling;
+            const double rt_low_image = shift + rt_low * scaling;
+            rt_low_hash_.addValue(rt_low_image, similarity_ik_jl);
+            const double rt_high_image = shift + rt_high * scaling;
+            rt_high_hash_.addValue(rt_high_image, similarity_ik_jl);
+
+            if (do_dump_pairs)
+            {
+              const Size j = pair_model[jl];
+              const Size k = pair_scene[ik];
+              const Size l = pair_scene[jl];
+              dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
+                              << model_map[j].getMZ() << ' ' << k << ' ' << scene_map[k].getRT() << ' ' << scene_map[k].getMZ() << ' ' << l << ' '
+                              << scene_map[l].getRT() << ' ' << scene_map[l].getMZ() << ' ' << similarity_ik_jl << ' ' << std::endl;
+            }
+          }
+        }
+      }   // k
+    }   // i
+  }
+
   /**
     @brief Estimates likely position of the scale factor based on scaling_hash_1.
 
@@ -904,6 +1111,10 @@ namespace OpenMS
     static Int dump_buckets_serial = 0;
     ++dump_buckets_serial;
 
+    // both enumerate the same combinations of point pairs
+    const bool pairing_sweep = (param_.getValue("pairing") == "sweep");
+    decltype(&affineTransformationHashing) hashing = pairing_sweep ? &affineTransformationHashingSweep : &affineTransformationHashing;
+
     //**************************************************************************
     // Step 4: Hashing
     //         Compute the transformations between each point pair in the model
@@ -918,7 +1129,7 @@ namespace OpenMS
 
     ///////////////////////////////////////////////////////////////////
     // Step 4.1 First round of hashing: Estimate the scaling
-    affineTransformationHashing(
+    hashing(
       do_dump_pairs,
       model_map, scene_map,
       scaling_hash_1, scaling_hash_2, rt_low_hash_, rt_high_hash_,
@@ -958,7 +1169,7 @@ namespace OpenMS
     // Step 4.3 Second round of hashing: Estimate the shift at both ends and
     // thereby re-estimate the scaling. This uses the first guess of the
     // scaling to reduce noise in the histograms.
-    affineTransformationHashing(
+    hashing(
       do_dump_pairs,
       model_map, scene_map,
       scaling_hash_1, scaling_hash_2, rt_low_hash_, rt_high_hash_,
@@ -34,10 +34,59 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMAssay.h>
 
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    // number of peptides whose in silico ion series are computed in parallel
+    // before they are merged into the (order-sensitive) maps
+    const Size UIS_CHUNK_SIZE = 1000;
+
+    // peptidoform with its theoretical transitions
+    struct InSilicoPeptidoform
+    {
+      String sequence;
+      String unmodified_sequence;
+      MRMAssay::IonSeries ions; // "ion type" -> rounded fragment m/z
+    };
+
+    // identification transitions of a single peptide; the transition names
+    // are prefixed with the running transition index when merging
+    struct PeptideUISTransitions
+    {
+      MRMAssay::TransitionVectorType transitions;
+      std::vector<Size> index; // transition index relative to the peptide
+      std::vector<String> name_suffix;
+      Size num_indices = 0; // number of transition indices used by the peptide
+    };
+
+    void appendUISTransitions(std::vector<PeptideUISTransitions>& results, MRMAssay::TransitionVectorType& transitions)
+    {
+      Size transition_index = 0;
+      for (auto& result : results)
+      {
+        for (Size i = 0; i < result.transitions.size(); ++i)
+        {
+          ReactionMonitoringTransition& trn = result.transitions[i];
+          String identifier = String(transition_index + result.index[i]) + result.name_suffix[i];
+          trn.setName(identifier);
+          trn.setNativeID(identifier);
+          OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
+          transitions.push_back(std::move(trn));
+        }
+        transition_index += result.num_indices;
+      }
+    }
+  }
+
   MRMAssay::MRMAssay()
   {
   }
@@ -66,6 +115,79 @@ namespace OpenMS
     return isoforms;
   }
 
+  std::vector<std::string> MRMAssay::getMatchingPeptidoforms_(const double fragment_ion,
+                                                              const FragmentIndex& ions,
+                                                              const double mz_threshold)
+  {
+    // both bounds of the FragmentSeqMap version are monotonic in the ion
+    // m/z, thus the matching ions form a contiguous range of the sorted index
+    auto it = std::partition_point(ions.ions.begin(), ions.ions.end(),
+      [&](const std::pair<double, Size>& ion) { return !(ion.first + mz_threshold >= fragment_ion); });
+
+    std::vector<Size> matches;
+    for (; it != ions.ions.end() && it->first - mz_threshold <= fragment_ion; ++it)
+    {
+      matches.push_back(it->second);
+    }
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+    // peptidoforms are sorted, so their indices are in string order
+    std::vector<std::string> isoforms;
+    isoforms.reserve(matches.size());
+    for (Size m : matches)
+    {
+      isoforms.push_back(ions.peptidoforms[m]);
+    }
+    return isoforms;
+  }
+
+  void MRMAssay::buildIonIndex_(const IonMapT& ion_map, IonIndexT& ion_index)
+  {
+    std::vector<std::pair<const FragmentSeqMap*, FragmentIndex*> > entries;
+    for (const auto& swath : ion_map)
+    {
+      for (const auto& seq : swath.second)
+      {
+        entries.emplace_back(&seq.second, &ion_index[swath.first][seq.first]);
+      }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)entries.size(); ++i)
+    {
+      const FragmentSeqMap& ions = *entries[i].first;
+      FragmentIndex& index = *entries[i].second;
+
+      for (const auto& ion : ions)
+      {
+        if (index.peptidoforms.empty() || index.peptidoforms.back() != ion.second)
+        {
+          index.peptidoforms.push_back(ion.second);
+        }
+      }
+      std::sort(index.peptidoforms.begin(), index.peptidoforms.end());
+      index.peptidoforms.erase(std::unique(index.peptidoforms.begin(), index.peptidoforms.end()), index.peptidoforms.end());
+
+      // ions of the same peptidoform are consecutive, look each one up only once
+      index.ions.reserve(ions.size());
+      const std::string* last = nullptr;
+      Size last_index = 0;
+      for (const auto& ion : ions)
+      {
+        if (last == nullptr || *last != ion.second)
+        {
+          last = &ion.second;
+          last_index = std::lower_bound(index.peptidoforms.begin(), index.peptidoforms.end(), ion.second) - index.peptidoforms.begin();
+        }
+        index.ions.emplace_back(ion.first, last_index);
+      }
+      std::sort(index.ions.begin(), index.ions.end());
+    }
+  }
+
   int MRMAssay::getSwath_(const std::vector<std::pair<double, double> >& swathes, const double precursor_mz)
   {
     int swath = -1;
@@ -325,60 +447,132 @@ namespace OpenMS
                                             IonMapT & TargetIonMap,
                                             PeptideMapT& TargetPeptideMap)
   {
-    OpenMS::MRMIonSeries mrmis;
+    // theoretical transitions of a single peptide
+    struct InSilicoPeptide
+    {
+      bool skipped = false;
+      int swath = -1;
+      double precursor_mz = 0.0;
+      std::vector<InSilicoPeptidoform> peptidoforms;
+    };
 
     // Step 1: Generate target in silico peptide map containing theoretical transitions
     Size progress = 0;
     startProgress(0, exp.getPeptides().size(), "Generation of target in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    for (Size chunk_start = 0; chunk_start < exp.getPeptides().size(); chunk_start += UIS_CHUNK_SIZE)
     {
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
-      OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
+      Size chunk_end = std::min(chunk_start + UIS_CHUNK_SIZE, exp.getPeptides().size());
+      std::vector<InSilicoPeptide> chunk(chunk_end - chunk_start);
+
+      // Peptidoforms and ion series are computed in parallel ...
+      // exceptions must not leave the parallel region - keep the first one and rethrow it afterwards
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
       {
-        precursor_charge = peptide.getChargeState();
-      }
-      double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
-      int precursor_swath = getSwath_(swathes, precursor_mz);
+        OpenMS::MRMIonSeries mrmis;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = chunk_start; i < (SignedSize)chunk_end; ++i)
+        {
+          try
+          {
+            const TargetedExperiment::Peptide& peptide = exp.getPeptides()[i];
+            InSilicoPeptide& result = chunk[i - chunk_start];
 
-      // Compute all alternative peptidoforms compatible with ModificationsDB
-      const vector<AASequence> alternative_peptide_sequences = generateTheoreticalPeptidoforms_(peptide_sequence);  
+            OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+            int precursor_charge = 1;
+            if (peptide.hasCharge())
+            {
+              precursor_charge = peptide.getChargeState();
+            }
+            result.precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
+            result.swath = getSwath_(swathes, result.precursor_mz);
 
-      // Some permutations might be too complex, skip if threshold is reached
-      if (alternative_peptide_sequences.size() > max_num_alternative_localizations)
-      {
-        OPENMS_LOG_DEBUG << "[uis] Peptide skipped (too many permutations possible): " << peptide.id << std::endl;
-        continue;
+            // Compute all alternative peptidoforms compatible with ModificationsDB
+            const vector<AASequence> alternative_peptide_sequences = generateTheoreticalPeptidoforms_(peptide_sequence);
+
+            // Some permutations might be too complex, skip if threshold is reached
+            if (alternative_peptide_sequences.size() > max_num_alternative_localizations)
+            {
+              result.skipped = true;
+              continue;
+            }
+
+            result.peptidoforms.resize(alternative_peptide_sequences.size());
+            for (Size k = 0; k < alternative_peptide_sequences.size(); ++k)
+            {
+              const AASequence& alt_aa = alternative_peptide_sequences[k];
+              InSilicoPeptidoform& form = result.peptidoforms[k];
+              form.sequence = alt_aa.toString();
+              form.unmodified_sequence = alt_aa.toUnmodifiedString();
+
+              // Generate theoretical ion series
+              auto ionseries = mrmis.getIonSeries(alt_aa, precursor_charge,
+                  fragment_types, fragment_charges, enable_specific_losses,
+                  enable_unspecific_losses);
+              form.ions.reserve(ionseries.size());
+              for (const auto& im_it : ionseries)
+              {
+                form.ions.emplace_back(im_it.first, Math::roundDecimal(im_it.second, round_decPow));
+              }
+            }
+          }
+          catch (...)
+          {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MRMAssay_error)
+#endif
+            {
+              if (!error) error = std::current_exception();
+            }
+          }
+        }
       }
+      if (error) std::rethrow_exception(error);
 
-      // Iterate over all peptidoforms
-      for (const auto& alt_aa : alternative_peptide_sequences)
-      { 
-        // Append peptidoform to index
-        TargetSequenceMap[precursor_swath][alt_aa.toUnmodifiedString()].insert(alt_aa.toString());
-        // Generate theoretical ion series
-        auto ionseries = mrmis.getIonSeries(alt_aa, precursor_charge,
-            fragment_types, fragment_charges, enable_specific_losses,
-            enable_unspecific_losses);
-
-        if (enable_ms2_precursors)
+      // ... and inserted into the maps in the order of the peptides
+      for (Size i = chunk_start; i < chunk_end; ++i)
+      {
+        setProgress(progress++);
+
+        const TargetedExperiment::Peptide& peptide = exp.getPeptides()[i];
+        const InSilicoPeptide& result = chunk[i - chunk_start];
+        if (result.skipped)
         {
-          // Add precursor to theoretical transitions
-          double prec_mz = Math::roundDecimal(precursor_mz, round_decPow);
-          TargetIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(prec_mz, alt_aa.toString());
-          TargetPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
+          OPENMS_LOG_DEBUG << "[uis] Peptide skipped (too many permutations possible): " << peptide.id << std::endl;
+          continue;
         }
 
-        // Iterate over all theoretical transitions
-        for (const auto& im_it : ionseries)
+        // Iterate over all peptidoforms
+        for (const auto& form : result.peptidoforms)
         {
-          // Append transition to indices to find interfering transitions
-          double fragment_mz = Math::roundDecimal(im_it.second, round_decPow);
-          TargetIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(fragment_mz, alt_aa.toString());
-          TargetPeptideMap[peptide.id].emplace_back(im_it.first, fragment_mz);
+          // Append peptidoform to index
+          TargetSequenceMap[result.swath][form.unmodified_sequence].insert(form.sequence);
+          if (!enable_ms2_precursors && form.ions.empty())
+          {
+            continue;
+          }
+          FragmentSeqMap& ions = TargetIonMap[result.swath][form.unmodified_sequence];
+          IonSeries& peptide_transitions = TargetPeptideMap[peptide.id];
+
+          if (enable_ms2_precursors)
+          {
+            // Add precursor to theoretical transitions
+            double prec_mz = Math::roundDecimal(result.precursor_mz, round_decPow);
+            ions.emplace_back(prec_mz, form.sequence);
+            peptide_transitions.emplace_back("MS2_Precursor_i0", prec_mz);
+          }
+
+          // Iterate over all theoretical transitions
+          for (const auto& im_it : form.ions)
+          {
+            // Append transition to indices to find interfering transitions
+            ions.emplace_back(im_it.second, form.sequence);
+            peptide_transitions.push_back(im_it);
+          }
         }
       }
     }
@@ -464,21 +658,21 @@ namespace OpenMS
                                            IonMapT & DecoyIonMap,
                                            PeptideMapT& DecoyPeptideMap)
   {
-    MRMIonSeries mrmis;
-
-    // Step 2b: Generate decoy in silico peptide map containing theoretical transitions
-    Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of decoy in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    // theoretical transitions of a single decoy peptide
+    struct InSilicoPeptide
     {
-      setProgress(progress++);
+      const TargetedExperiment::Peptide* decoy_peptide = nullptr; // nullptr: target was skipped
+      int swath = -1;
+      double precursor_mz = 0.0;
+      std::vector<InSilicoPeptidoform> peptidoforms;
+    };
 
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
-      {
-        precursor_charge = peptide.getChargeState();
-      }
+    // Copy properties of target peptides to decoys and get sequences from map
+    // (in peptide order, since the maps are modified)
+    std::vector<InSilicoPeptide> decoys(exp.getPeptides().size());
+    for (Size i = 0; i < exp.getPeptides().size(); ++i)
+    {
+      const TargetedExperiment::Peptide& peptide = exp.getPeptides()[i];
 
       // Skip if target peptide is not in map, e.g. permutation threshold was reached
       if (TargetPeptideMap.find(peptide.id) == TargetPeptideMap.end())
@@ -486,44 +680,127 @@ namespace OpenMS
         continue;
       }
 
-      OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      double precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
-      int precursor_swath = getSwath_(swathes, precursor_mz);
-
-      // Copy properties of target peptide to decoy and get sequence from map
       TargetedExperiment::Peptide decoy_peptide = peptide;
       decoy_peptide.sequence = DecoySequenceMap[peptide.sequence];
-
       TargetDecoyMap[peptide.id] = decoy_peptide;
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+      decoys[i].decoy_peptide = &TargetDecoyMap[peptide.id]; // references stay valid on rehashing
+    }
 
-      // Compute all alternative peptidoforms compatible with ModificationsDB
-      // Infers residue specificity from target sequence but is applied to decoy sequence
-      const vector<AASequence> alternative_decoy_peptide_sequences = generateTheoreticalPeptidoformsDecoy_(peptide_sequence, decoy_peptide_sequence);
+    // Step 2b: Generate decoy in silico peptide map containing theoretical transitions
+    Size progress = 0;
+    startProgress(0, exp.getPeptides().size(), "Generation of decoy in silico peptide map");
+    for (Size chunk_start = 0; chunk_start < exp.getPeptides().size(); chunk_start += UIS_CHUNK_SIZE)
+    {
+      Size chunk_end = std::min(chunk_start + UIS_CHUNK_SIZE, exp.getPeptides().size());
+
+      // Peptidoforms and ion series are computed in parallel ...
+      // exceptions must not leave the parallel region - keep the first one and rethrow it afterwards
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        MRMIonSeries mrmis;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = chunk_start; i < (SignedSize)chunk_end; ++i)
+        {
+          try
+          {
+            InSilicoPeptide& result = decoys[i];
+            if (result.decoy_peptide == nullptr)
+            {
+              continue;
+            }
+
+            const TargetedExperiment::Peptide& peptide = exp.getPeptides()[i];
+            int precursor_charge = 1;
+            if (peptide.hasCharge())
+            {
+              precursor_charge = peptide.getChargeState();
+            }
 
-      // Iterate over all peptidoforms
-      for (const auto& alt_aa : alternative_decoy_peptide_sequences)
+            OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+            result.precursor_mz = peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge;
+            result.swath = getSwath_(swathes, result.precursor_mz);
+
+            OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(*result.decoy_peptide);
+
+            // Compute all alternative peptidoforms compatible with ModificationsDB
+            // Infers residue specificity from target sequence but is applied to decoy sequence
+            const vector<AASequence> alternative_decoy_peptide_sequences = generateTheoreticalPeptidoformsDecoy_(peptide_sequence, decoy_peptide_sequence);
+
+            result.peptidoforms.resize(alternative_decoy_peptide_sequences.size());
+            for (Size k = 0; k < alternative_decoy_peptide_sequences.size(); ++k)
+            {
+              const AASequence& alt_aa = alternative_decoy_peptide_sequences[k];
+              InSilicoPeptidoform& form = result.peptidoforms[k];
+              form.sequence = alt_aa.toString();
+              form.unmodified_sequence = alt_aa.toUnmodifiedString();
+
+              // Generate theoretical ion series
+              MRMIonSeries::IonSeries ionseries = mrmis.getIonSeries(alt_aa, precursor_charge, // use same charge state as target
+                                                                     fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);
+              form.ions.reserve(ionseries.size());
+              for (const auto& im_it : ionseries)
+              {
+                form.ions.emplace_back(im_it.first, Math::roundDecimal(im_it.second, round_decPow));
+              }
+            }
+          }
+          catch (...)
+          {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MRMAssay_error)
+#endif
+            {
+              if (!error) error = std::current_exception();
+            }
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      // ... and inserted into the maps in the order of the peptides
+      for (Size i = chunk_start; i < chunk_end; ++i)
       {
-        // Generate theoretical ion series
-        MRMIonSeries::IonSeries ionseries = mrmis.getIonSeries(alt_aa, precursor_charge, // use same charge state as target
-                                                               fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);  
+        setProgress(progress++);
 
-        if (enable_ms2_precursors)
+        InSilicoPeptide& result = decoys[i];
+        if (result.decoy_peptide == nullptr)
         {
-          // Add precursor to theoretical transitions
-          double prec_mz = Math::roundDecimal(precursor_mz, round_decPow);
-          DecoyIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(prec_mz, alt_aa.toString());
-          DecoyPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
+          continue;
         }
+        const TargetedExperiment::Peptide& peptide = exp.getPeptides()[i];
 
-        // Iterate over all theoretical transitions
-        for (const auto& im_it : ionseries)
+        // Iterate over all peptidoforms
+        for (const auto& form : result.peptidoforms)
         {
-          // Append transition to indices to find interfering transitions
-          double fragment_mz = Math::roundDecimal(im_it.second, round_decPow);
-          DecoyIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(fragment_mz, alt_aa.toString());
-          DecoyPeptideMap[decoy_peptide.id].emplace_back(im_it.first, fragment_mz);
+          if (!enable_ms2_precursors && form.ions.empty())
+          {
+            continue;
+          }
+          FragmentSeqMap& ions = DecoyIonMap[result.swath][form.unmodified_sequence];
+
+          if (enable_ms2_precursors)
+          {
+            // Add precursor to theoretical transitions
+            double prec_mz = Math::roundDecimal(result.precursor_mz, round_decPow);
+            ions.emplace_back(prec_mz, form.sequence);
+            DecoyPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
+          }
+
+          // Iterate over all theoretical transitions
+          for (const auto& im_it : form.ions)
+          {
+            // Append transition to indices to find interfering transitions
+            ions.emplace_back(im_it.second, form.sequence);
+            DecoyPeptideMap[result.decoy_peptide->id].push_back(im_it);
+          }
         }
+        // release memory of the merged peptide early
+        std::vector<InSilicoPeptidoform>().swap(result.peptidoforms);
       }
     }
     endProgress();
@@ -537,70 +814,108 @@ namespace OpenMS
                                       const PeptideMapT& TargetPeptideMap,
                                       const IonMapT & TargetIonMap)
   {
-    MRMIonSeries mrmis;
+    // m/z sorted fragment ions for fast interference lookup
+    IonIndexT TargetIonIndex;
+    buildIonIndex_(TargetIonMap, TargetIonIndex);
+
+    // Peptides are processed in parallel, the transition index follows the order of the map
+    std::vector<PeptideMapT::const_iterator> peptides;
+    std::vector<const TargetedExperiment::Peptide*> peptide_refs;
+    for (auto pep_it = TargetPeptideMap.begin(); pep_it != TargetPeptideMap.end(); ++pep_it)
+    {
+      peptides.push_back(pep_it);
+      peptide_refs.push_back(&exp.getPeptideByRef(pep_it->first));
+    }
+    std::vector<PeptideUISTransitions> results(peptides.size());
 
     // Step 3: Generate target identification transitions
     Size progress = 0;
     startProgress(0, TargetPeptideMap.size(), "Generation of target identification transitions");
 
-    // Iterate over all target peptides
-    int transition_index = 0;
-    for (const auto& pep_it : TargetPeptideMap)
-    { 
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptideByRef(pep_it.first);
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
+    // exceptions must not leave the parallel region - keep the first one and rethrow it afterwards
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      MRMIonSeries mrmis;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (SignedSize p = 0; p < (SignedSize)peptides.size(); ++p)
       {
-        precursor_charge = peptide.getChargeState();
-      }
-      AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MRMAssay_progress)
+#endif
+        setProgress(progress++);
 
-      // Sort all transitions and make them unique
-      auto transition_vector = pep_it.second;
-      std::sort(transition_vector.begin(), transition_vector.end());
-      auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+        try
+        {
+          const TargetedExperiment::Peptide& peptide = *peptide_refs[p];
+          PeptideUISTransitions& result = results[p];
+          int precursor_charge = 1;
+          if (peptide.hasCharge())
+          {
+            precursor_charge = peptide.getChargeState();
+          }
+          AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+          int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
+          const FragmentIndex& target_ions = TargetIonIndex.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString());
 
-      // Iterate over all transitions
-      for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
-      { 
-        // Compute the set of peptidoforms mapping to this transition
-        vector<string> isoforms = getMatchingPeptidoforms_(
-            tr_it->second, TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString()), mz_threshold);
+          // Sort all transitions and make them unique
+          auto transition_vector = peptides[p]->second;
+          std::sort(transition_vector.begin(), transition_vector.end());
+          auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
 
-        // Check that transition maps to at least one peptidoform
-        if (isoforms.size() > 0)
-        {
-          ReactionMonitoringTransition trn;
-          trn.setDetectingTransition(false);
-          trn.setMetaValue("insilico_transition", "true");
-          trn.setPrecursorMZ(Math::roundDecimal(peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
-          trn.setProductMZ(tr_it->second);
-          trn.setPeptideRef(peptide.id);
-          mrmis.annotateTransitionCV(trn, tr_it->first);
-          trn.setIdentifyingTransition(true);
-          trn.setQuantifyingTransition(false);
-
-          // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UIS") +  \
-            "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +  \
-            String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" + 
-            String(peptide.getRetentionTime()) + "_" + tr_it->first; 
-          trn.setName(identifier); 
-          trn.setNativeID(identifier);
-          trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
+          // Iterate over all transitions
+          for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
+          {
+            // Compute the set of peptidoforms mapping to this transition
+            vector<string> isoforms = getMatchingPeptidoforms_(tr_it->second, target_ions, mz_threshold);
 
-          OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
+            // Check that transition maps to at least one peptidoform
+            if (isoforms.size() > 0)
+            {
+              ReactionMonitoringTransition trn;
+              trn.setDetectingTransition(false);
+              trn.setMetaValue("insilico_transition", "true");
+              trn.setPrecursorMZ(Math::roundDecimal(peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
+              trn.setProductMZ(tr_it->second);
+              trn.setPeptideRef(peptide.id);
+              mrmis.annotateTransitionCV(trn, tr_it->first);
+              trn.setIdentifyingTransition(true);
+              trn.setQuantifyingTransition(false);
+
+              // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
+              // (prefixed with the transition index when merging)
+              String name_suffix = String("_") + String("UIS") +  \
+                "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +  \
+                String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
+                String(peptide.getRetentionTime()) + "_" + tr_it->first;
+              trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
 
-          // Append transition
-          transitions.push_back(trn);
+              // Append transition
+              result.transitions.push_back(trn);
+              result.index.push_back(result.num_indices);
+              result.name_suffix.push_back(name_suffix);
+            }
+            result.num_indices++;
+          }
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MRMAssay_error)
+#endif
+          {
+            if (!error) error = std::current_exception();
+          }
         }
-        transition_index++;
       }
-      OPENMS_LOG_DEBUG << "[uis] Peptide " << peptide.id << std::endl;
     }
+    if (error) std::rethrow_exception(error);
+
+    appendUISTransitions(results, transitions);
     endProgress();
   }
 
@@ -614,84 +929,129 @@ namespace OpenMS
                                      const IonMapT& DecoyIonMap,
                                      const IonMapT& TargetIonMap)
   {
-    MRMIonSeries mrmis;
+    // m/z sorted fragment ions for fast interference lookup
+    IonIndexT DecoyIonIndex, TargetIonIndex;
+    buildIonIndex_(DecoyIonMap, DecoyIonIndex);
+    buildIonIndex_(TargetIonMap, TargetIonIndex);
+
+    // Peptides are processed in parallel, the transition index follows the order of the map
+    std::vector<PeptideMapT::const_iterator> decoy_peptides;
+    std::vector<const TargetedExperiment::Peptide*> target_refs, decoy_refs;
+    for (auto pep_it = DecoyPeptideMap.begin(); pep_it != DecoyPeptideMap.end(); ++pep_it)
+    {
+      decoy_peptides.push_back(pep_it);
+      target_refs.push_back(&exp.getPeptideByRef(pep_it->first));
+      decoy_refs.push_back(&TargetDecoyMap[pep_it->first]);
+    }
+    std::vector<PeptideUISTransitions> results(decoy_peptides.size());
 
     // Step 4: Generate decoy identification transitions
     Size progress = 0;
     startProgress(0, DecoyPeptideMap.size(), "Generation of decoy identification transitions");
 
-    // Iterate over all decoy peptides
-    int transition_index = 0;
-    for (const auto & decoy_pep_it : DecoyPeptideMap)
+    // exceptions must not leave the parallel region - keep the first one and rethrow it afterwards
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-      setProgress(progress++);
-      TargetedExperiment::Peptide target_peptide = exp.getPeptideByRef(decoy_pep_it.first);
-      int precursor_charge = 1;
-      if (target_peptide.hasCharge()) 
-      {
-        precursor_charge = target_peptide.getChargeState();
-      }
-      AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
-      int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
-
-      TargetedExperiment::Peptide decoy_peptide = TargetDecoyMap[decoy_pep_it.first];
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
-
-      // Sort all transitions and make them unique
-      auto transition_vector = decoy_pep_it.second;
-      std::sort(transition_vector.begin(), transition_vector.end());
-      auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
-
-      // Iterate over all transitions
-      for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
+      MRMIonSeries mrmis;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (SignedSize p = 0; p < (SignedSize)decoy_peptides.size(); ++p)
       {
-        // Check mapping of transitions to other peptidoforms
-        vector<string> decoy_isoforms = getMatchingPeptidoforms_(
-            decoy_tr_it->second, DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString()), mz_threshold);
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MRMAssay_progress)
+#endif
+        setProgress(progress++);
 
-        // Check that transition maps to at least one peptidoform
-        if (decoy_isoforms.size() > 0)
+        try
         {
-          ReactionMonitoringTransition trn;
-          trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
-          trn.setDetectingTransition(false);
-          trn.setMetaValue("insilico_transition", "true");
-          trn.setPrecursorMZ(Math::roundDecimal(target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
-          trn.setProductMZ(decoy_tr_it->second);
-          trn.setPeptideRef(decoy_peptide.id);
-          mrmis.annotateTransitionCV(trn, decoy_tr_it->first);
-          trn.setIdentifyingTransition(true);
-          trn.setQuantifyingTransition(false);
-
-          // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UISDECOY") +
-                "_{" + ListUtils::concatenate(decoy_isoforms, "|") + "}_" +
-                String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
-                String(decoy_peptide.getRetentionTime()) + "_" + decoy_tr_it->first;
-          trn.setName(identifier); 
-          trn.setNativeID(identifier);
-          trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
+          const TargetedExperiment::Peptide& target_peptide = *target_refs[p];
+          PeptideUISTransitions& result = results[p];
+          int precursor_charge = 1;
+          if (target_peptide.hasCharge())
+          {
+            precursor_charge = target_peptide.getChargeState();
+          }
+          AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
+          int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge);
+
+          const TargetedExperiment::Peptide& decoy_peptide = *decoy_refs[p];
+          OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
 
-          OPENMS_LOG_DEBUG << "[uis] Decoy transition " << trn.getNativeID() << std::endl;
+          const FragmentIndex& decoy_ions = DecoyIonIndex.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString());
+          const FragmentIndex* target_ions = nullptr; // only needed for matching decoy transitions
 
-          // Check if decoy transition is overlapping with target transition
-          vector<string> target_isoforms_overlap = getMatchingPeptidoforms_(
-              decoy_tr_it->second, TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString()), mz_threshold);
+          // Sort all transitions and make them unique
+          auto transition_vector = decoy_peptides[p]->second;
+          std::sort(transition_vector.begin(), transition_vector.end());
+          auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
 
-          if (target_isoforms_overlap.size() > 0)
+          // Iterate over all transitions
+          for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
           {
-            OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition " << trn.getNativeID() << std::endl;
-            continue;
+            // Check mapping of transitions to other peptidoforms
+            vector<string> decoy_isoforms = getMatchingPeptidoforms_(decoy_tr_it->second, decoy_ions, mz_threshold);
+
+            // Check that transition maps to at least one peptidoform
+            if (decoy_isoforms.size() > 0)
+            {
+              // Check if decoy transition is overlapping with target transition
+              if (target_ions == nullptr)
+              {
+                target_ions = &TargetIonIndex.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString());
+              }
+              vector<string> target_isoforms_overlap = getMatchingPeptidoforms_(decoy_tr_it->second, *target_ions, mz_threshold);
+
+              if (target_isoforms_overlap.size() > 0)
+              {
+                OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition of " << decoy_peptide.id << " at " << decoy_tr_it->second << std::endl;
+                continue;
+              }
+
+              ReactionMonitoringTransition trn;
+              trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
+              trn.setDetectingTransition(false);
+              trn.setMetaValue("insilico_transition", "true");
+              trn.setPrecursorMZ(Math::roundDecimal(target_peptide_sequence.getMonoWeight(Residue::Full, precursor_charge) / precursor_charge, round_decPow));
+              trn.setProductMZ(decoy_tr_it->second);
+              trn.setPeptideRef(decoy_peptide.id);
+              mrmis.annotateTransitionCV(trn, decoy_tr_it->first);
+              trn.setIdentifyingTransition(true);
+              trn.setQuantifyingTransition(false);
+
+              // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
+              // (prefixed with the transition index when merging)
+              String name_suffix = String("_") + String("UISDECOY") +
+                    "_{" + ListUtils::concatenate(decoy_isoforms, "|") + "}_" +
+                    String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
+                    String(decoy_peptide.getRetentionTime()) + "_" + decoy_tr_it->first;
+              trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
+
+              // Append transition
+              result.transitions.push_back(trn);
+              result.index.push_back(result.num_indices);
+              result.name_suffix.push_back(name_suffix);
+            }
+            result.num_indices++;
           }
-          else
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_MRMAssay_error)
+#endif
           {
-            // Append transition
-            transitions.push_back(trn);
+            if (!error) error = std::current_exception();
           }
         }
-        transition_index++;
       }
     }
+    if (error) std::rethrow_exception(error);
+
+    appendUISTransitions(results, transitions);
     endProgress();
   }
 
@@ -34,9 +34,14 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+
 #include <sqlite3.h>
 #include <OpenMS/FORMAT/SqliteConnector.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace OpenMS
 {
 
@@ -269,6 +274,286 @@ namespace OpenMS
     sqlite3_finalize(stmt);
   }
 
+  void TransitionPQPFile::readPQPInput_(const char* filename,
+                                        OpenSwath::LightTargetedExperiment& targeted_exp,
+                                        const std::vector<std::pair<double, double> >& precursor_windows,
+                                        bool legacy_traml_id)
+  {
+    sqlite3 *db;
+    sqlite3_stmt * stmt;
+    String select_sql;
+
+    // Use legacy TraML identifiers for precursors (transition_group_id) and transitions (transition_name)?
+    std::string traml_id = "ID";
+    if (legacy_traml_id)
+    {
+      traml_id = "TRAML_ID";
+    }
+
+    // Open database
+    SqliteConnector conn(filename);
+    db = conn.getDB();
+
+    bool drift_time_exists = SqliteConnector::columnExists(db, "PRECURSOR", "LIBRARY_DRIFT_TIME");
+    bool gene_exists = SqliteConnector::tableExists(db, "GENE");
+    bool adducts_exists = SqliteConnector::columnExists(db, "COMPOUND", "ADDUCTS");
+
+    auto in_windows = [&precursor_windows](double mz)
+    {
+      if (precursor_windows.empty()) return true;
+      for (const auto& w : precursor_windows)
+      {
+        if (w.first < mz && mz < w.second) return true;
+      }
+      return false;
+    };
+
+    // Proteins: every accession is decoded once and referenced by index
+    std::vector<String> protein_accessions;
+    std::map<int, std::vector<Size> > peptide_proteins;
+    {
+      std::map<int, Size> protein_index;
+      SqliteConnector::executePreparedStatement(db, &stmt,
+        "SELECT PEPTIDE_PROTEIN_MAPPING.PEPTIDE_ID, PROTEIN.ID, PROTEIN.PROTEIN_ACCESSION " \
+        "FROM PROTEIN " \
+        "INNER JOIN PEPTIDE_PROTEIN_MAPPING ON PROTEIN.ID = PEPTIDE_PROTEIN_MAPPING.PROTEIN_ID;");
+      while (sqlite3_step(stmt) == SQLITE_ROW)
+      {
+        int protein_id = sqlite3_column_int(stmt, 1);
+        auto prot_it = protein_index.find(protein_id);
+        if (prot_it == protein_index.end())
+        {
+          prot_it = protein_index.insert(std::make_pair(protein_id, protein_accessions.size())).first;
+          String accession;
+          Sql::extractValue<String>(&accession, stmt, 2);
+          protein_accessions.push_back(accession);
+        }
+        peptide_proteins[sqlite3_column_int(stmt, 0)].push_back(prot_it->second);
+      }
+      sqlite3_finalize(stmt);
+    }
+
+    // Precursors: one TSVTransition per precursor, holding only the
+    // precursor-level fields (the per-transition fields are read below)
+    std::vector<TSVTransition> precursors;
+    std::vector<std::vector<Size> > precursor_proteins;
+    std::map<int, Size> precursor_index;
+
+    String select_precursor = "SELECT " \
+                              "PRECURSOR.ID, " \
+                              "PRECURSOR." + traml_id + ", " \
+                              "PRECURSOR.PRECURSOR_MZ, " \
+                              "PRECURSOR.LIBRARY_RT, " \
+                              "PRECURSOR.CHARGE, " \
+                              "PRECURSOR.GROUP_LABEL, " +
+                              String(drift_time_exists ? "PRECURSOR.LIBRARY_DRIFT_TIME, " : "NULL, ");
+
+    // returns false if the precursor is not within the windows
+    auto read_precursor = [&](TSVTransition& precursor)
+    {
+      Sql::extractValue<double>(&precursor.precursor, stmt, 2);
+      if (!in_windows(precursor.precursor)) return false;
+      Sql::extractValue<String>(&precursor.group_id, stmt, 1);
+      Sql::extractValue<double>(&precursor.rt_calibrated, stmt, 3);
+      if (sqlite3_column_type(stmt, 4) != SQLITE_NULL)
+      {
+        precursor.precursor_charge = String(sqlite3_column_int(stmt, 4));
+      }
+      Sql::extractValue<String>(&precursor.peptide_group_label, stmt, 5);
+      Sql::extractValue<double>(&precursor.drift_time, stmt, 6);
+      return true;
+    };
+
+    // Peptide precursors (the joins mirror the ones of the TSVTransition based reader)
+    select_sql = select_precursor +
+                 "PEPTIDE.UNMODIFIED_SEQUENCE, " \
+                 "PEPTIDE.MODIFIED_SEQUENCE, " \
+                 "PEPTIDE.ID, " +
+                 String(gene_exists ? "GENE.GENE_NAME " : "NULL ") +
+                 "FROM PRECURSOR " \
+                 "INNER JOIN PRECURSOR_PEPTIDE_MAPPING ON PRECURSOR.ID = PRECURSOR_PEPTIDE_MAPPING.PRECURSOR_ID " \
+                 "INNER JOIN PEPTIDE ON PRECURSOR_PEPTIDE_MAPPING.PEPTIDE_ID = PEPTIDE.ID ";
+    if (gene_exists)
+    {
+      // a peptide mapping to several genes comes in one row per gene; it is
+      // read only once, with the first gene name in sort order (which is
+      // the one the TSVTransition based reader annotates as well)
+      select_sql += "INNER JOIN PEPTIDE_GENE_MAPPING ON PEPTIDE.ID = PEPTIDE_GENE_MAPPING.PEPTIDE_ID " \
+                    "INNER JOIN GENE ON PEPTIDE_GENE_MAPPING.GENE_ID = GENE.ID " \
+                    "ORDER BY GENE.GENE_NAME";
+    }
+    SqliteConnector::executePreparedStatement(db, &stmt, select_sql);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+      int precursor_id = sqlite3_column_int(stmt, 0);
+      if (precursor_index.find(precursor_id) != precursor_index.end()) continue; // further genes
+
+      // peptides without protein are skipped, as by the TSVTransition based reader
+      auto prot_it = peptide_proteins.find(sqlite3_column_int(stmt, 9));
+      if (prot_it == peptide_proteins.end()) continue;
+
+      TSVTransition precursor;
+      if (!read_precursor(precursor)) continue;
+      Sql::extractValue<String>(&precursor.PeptideSequence, stmt, 7);
+      Sql::extractValue<String>(&precursor.FullPeptideName, stmt, 8);
+      Sql::extractValue<String>(&precursor.GeneName, stmt, 10);
+      if (precursor.GeneName == "NA") precursor.GeneName = "";
+
+      precursor_index[precursor_id] = precursors.size();
+      precursors.push_back(precursor);
+      precursor_proteins.push_back(prot_it->second);
+    }
+    sqlite3_finalize(stmt);
+
+    // Compound precursors (metabolomics)
+    select_sql = select_precursor +
+                 "COMPOUND.COMPOUND_NAME, " \
+                 "COMPOUND.SMILES, " \
+                 "COMPOUND.SUM_FORMULA, " +
+                 String(adducts_exists ? "COMPOUND.ADDUCTS " : "NULL ") +
+                 "FROM PRECURSOR " \
+                 "INNER JOIN PRECURSOR_COMPOUND_MAPPING ON PRECURSOR.ID = PRECURSOR_COMPOUND_MAPPING.PRECURSOR_ID " \
+                 "INNER JOIN COMPOUND ON PRECURSOR_COMPOUND_MAPPING.COMPOUND_ID = COMPOUND.ID;";
+    SqliteConnector::executePreparedStatement(db, &stmt, select_sql);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+      int precursor_id = sqlite3_column_int(stmt, 0);
+      if (precursor_index.find(precursor_id) != precursor_index.end()) continue;
+
+      TSVTransition precursor;
+      if (!read_precursor(precursor)) continue;
+      Sql::extractValue<String>(&precursor.CompoundName, stmt, 7);
+      Sql::extractValue<String>(&precursor.SMILES, stmt, 8);
+      Sql::extractValue<String>(&precursor.SumFormula, stmt, 9);
+      Sql::extractValue<String>(&precursor.Adducts, stmt, 10);
+
+      precursor_index[precursor_id] = precursors.size();
+      precursors.push_back(precursor);
+      precursor_proteins.push_back(std::vector<Size>());
+    }
+    sqlite3_finalize(stmt);
+
+    resolveMixedSequenceGroups_(precursors);
+
+    // Count transitions
+    SqliteConnector::executePreparedStatement(db, &stmt, "SELECT COUNT(*) FROM TRANSITION;");
+    sqlite3_step(stmt);
+    int num_transitions = sqlite3_column_int(stmt, 0);
+    sqlite3_finalize(stmt);
+
+    // Transitions: rows are read first and then sorted the way the
+    // TSVTransition based reader returned them (its UNION query yields the
+    // rows ordered by precursor m/z, product m/z, library RT and transition
+    // identifier), so that transitions, compounds and proteins come out in
+    // the same order as before.
+    std::vector<std::pair<OpenSwath::LightTransition, Size> > rows;
+    if (precursor_windows.empty())
+    {
+      rows.reserve(num_transitions);
+    }
+
+    select_sql = "SELECT " \
+                 "TRANSITION_PRECURSOR_MAPPING.PRECURSOR_ID, " \
+                 "TRANSITION." + traml_id + ", " \
+                 "TRANSITION.PRODUCT_MZ, " \
+                 "TRANSITION.CHARGE, " \
+                 "TRANSITION.LIBRARY_INTENSITY, " \
+                 "TRANSITION.DECOY, " \
+                 "TRANSITION.DETECTING, " \
+                 "TRANSITION.IDENTIFYING, " \
+                 "TRANSITION.QUANTIFYING " \
+                 "FROM TRANSITION " \
+                 "INNER JOIN TRANSITION_PRECURSOR_MAPPING ON TRANSITION.ID = TRANSITION_PRECURSOR_MAPPING.TRANSITION_ID;";
+    SqliteConnector::executePreparedStatement(db, &stmt, select_sql);
+
+    Size progress = 0;
+    startProgress(0, num_transitions, "reading PQP file");
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+      setProgress(progress++);
+      auto prec_it = precursor_index.find(sqlite3_column_int(stmt, 0));
+      if (prec_it == precursor_index.end()) continue; // filtered or incomplete precursor
+      const Size prec_idx = prec_it->second;
+
+      OpenSwath::LightTransition transition;
+      transition.precursor_mz = precursors[prec_idx].precursor;
+      Sql::extractValue<std::string>(&transition.transition_name, stmt, 1);
+      transition.product_mz = -1;
+      Sql::extractValue<double>(&transition.product_mz, stmt, 2);
+      Sql::extractValue<int>(&transition.fragment_charge, stmt, 3); // zero for charge that is not set
+      transition.library_intensity = -1;
+      Sql::extractValue<double>(&transition.library_intensity, stmt, 4);
+      transition.decoy = sqlite3_column_int(stmt, 5) != 0;
+      transition.detecting_transition = sqlite3_column_type(stmt, 6) == SQLITE_NULL || sqlite3_column_int(stmt, 6) != 0;
+      transition.identifying_transition = sqlite3_column_int(stmt, 7) != 0;
+      transition.quantifying_transition = sqlite3_column_type(stmt, 8) == SQLITE_NULL || sqlite3_column_int(stmt, 8) != 0;
+      rows.push_back(std::make_pair(transition, prec_idx));
+    }
+    endProgress();
+    sqlite3_finalize(stmt);
+
+    std::sort(rows.begin(), rows.end(),
+      [&precursors](const std::pair<OpenSwath::LightTransition, Size>& a,
+                    const std::pair<OpenSwath::LightTransition, Size>& b)
+      {
+        const TSVTransition& prec_a = precursors[a.second];
+        const TSVTransition& prec_b = precursors[b.second];
+        if (a.first.precursor_mz != b.first.precursor_mz) return a.first.precursor_mz < b.first.precursor_mz;
+        if (a.first.product_mz != b.first.product_mz) return a.first.product_mz < b.first.product_mz;
+        if (prec_a.rt_calibrated != prec_b.rt_calibrated) return prec_a.rt_calibrated < prec_b.rt_calibrated;
+        if (a.first.transition_name != b.first.transition_name) return a.first.transition_name < b.first.transition_name;
+        if (a.first.library_intensity != b.first.library_intensity) return a.first.library_intensity < b.first.library_intensity;
+        return prec_a.group_id < prec_b.group_id;
+      });
+
+    // Convert each precursor (and its proteins) when it is referenced for the first time
+    std::vector<Size> compound_index(precursors.size(), std::numeric_limits<Size>::max());
+    std::vector<bool> protein_added(protein_accessions.size(), false);
+    targeted_exp.transitions.reserve(targeted_exp.transitions.size() + rows.size());
+    for (auto& row : rows)
+    {
+      const Size prec_idx = row.second;
+      if (compound_index[prec_idx] == std::numeric_limits<Size>::max())
+      {
+        std::vector<TSVTransition>::const_iterator tr_it = precursors.begin() + prec_idx;
+        OpenSwath::LightCompound compound;
+        if (tr_it->isPeptide())
+        {
+          OpenMS::TargetedExperiment::Peptide tramlpeptide;
+          TSVTransition& precursor = precursors[prec_idx];
+          for (Size i : precursor_proteins[prec_idx])
+          {
+            precursor.ProteinName.push_back(protein_accessions[i]);
+          }
+          createPeptide_(tr_it, tramlpeptide);
+          OpenSwathDataAccessHelper::convertTargetedCompound(tramlpeptide, compound);
+
+          for (Size i : precursor_proteins[prec_idx])
+          {
+            if (protein_added[i]) continue;
+            OpenSwath::LightProtein protein;
+            protein.id = protein_accessions[i];
+            protein.sequence = "";
+            targeted_exp.proteins.push_back(protein);
+            protein_added[i] = true;
+          }
+        }
+        else
+        {
+          OpenMS::TargetedExperiment::Compound tramlcompound;
+          createCompound_(tr_it, tramlcompound);
+          OpenSwathDataAccessHelper::convertTargetedCompound(tramlcompound, compound);
+        }
+        compound_index[prec_idx] = targeted_exp.compounds.size();
+        targeted_exp.compounds.push_back(compound);
+      }
+
+      // identifier is shared by all transitions of the precursor
+      row.first.peptide_ref = targeted_exp.compounds[compound_index[prec_idx]].id;
+      targeted_exp.transitions.push_back(std::move(row.first));
+    }
+  }
+
   void TransitionPQPFile::writePQPOutput_(const char* filename, OpenMS::TargetedExperiment& targeted_exp)
   {
     // delete file if present
@@ -706,9 +991,15 @@ namespace OpenMS
                                                          OpenSwath::LightTargetedExperiment& targeted_exp,
                                                          bool legacy_traml_id)
   {
-    std::vector<TSVTransition> transition_list;
-    readPQPInput_(filename, transition_list, legacy_traml_id);
-    TSVToTargetedExperiment_(transition_list, targeted_exp);
+    readPQPInput_(filename, targeted_exp, std::vector<std::pair<double, double> >(), legacy_traml_id);
+  }
+
+  void TransitionPQPFile::convertPQPToTargetedExperiment(const char* filename,
+                                                         OpenSwath::LightTargetedExperiment& targeted_exp,
+                                                         const std::vector<std::pair<double, double> >& precursor_windows,
+                                                         bool legacy_traml_id)
+  {
+    readPQPInput_(filename, targeted_exp, precursor_windows, legacy_traml_id);
   }
 
 }
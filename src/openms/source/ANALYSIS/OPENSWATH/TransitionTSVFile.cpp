@@ -38,20 +38,20 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
-#include <OpenMS/FORMAT/TextFile.h>
+#include <OpenMS/FORMAT/DelimitedTextReader.h>
 
 namespace OpenMS
 {
 
   template<class T>   // primary template
   bool extractName(T& value, const std::string& header_name,
-                   const std::vector<std::string>& tmp_line,
+                   const std::vector<StringView>& tmp_line,
                    const std::map<std::string, int>& header_dict)
   {
     auto tmp = header_dict.find( header_name );
     if (tmp != header_dict.end())
     {
-      value = tmp_line[ tmp->second ];
+      value = tmp_line[ tmp->second ].getString();
       // perform cleanup
       value = value.remove('"');
       value = value.remove('\'');
@@ -63,13 +63,13 @@ namespace OpenMS
 
   template<>   // specialization for int
   bool extractName<int>(int& value, const std::string& header_name,
-                        const std::vector<std::string>& tmp_line,
+                        const std::vector<StringView>& tmp_line,
                         const std::map<std::string, int>& header_dict)
   {
     auto tmp = header_dict.find( header_name );
-    if (tmp != header_dict.end() && !String(tmp_line[ tmp->second ]).empty())
+    if (tmp != header_dict.end() && !tmp_line[ tmp->second ].empty())
     {
-      value = String(tmp_line[ tmp->second ]).toInt();
+      value = DelimitedTextReader::toInt(tmp_line[ tmp->second ]);
       return true;
     }
     return false;
@@ -77,13 +77,13 @@ namespace OpenMS
 
   template<>   // specialization for double
   bool extractName<double>(double& value, const std::string& header_name,
-                        const std::vector<std::string>& tmp_line,
+                        const std::vector<StringView>& tmp_line,
                         const std::map<std::string, int>& header_dict)
   {
     auto tmp = header_dict.find(header_name);
-    if (tmp != header_dict.end() && !String(tmp_line[ tmp->second ]).empty())
+    if (tmp != header_dict.end() && !tmp_line[ tmp->second ].empty())
     {
-      value = String(tmp_line[ tmp->second ]).toDouble();
+      value = DelimitedTextReader::toDouble(tmp_line[ tmp->second ]);
       return true;
     }
     return false;
@@ -91,13 +91,13 @@ namespace OpenMS
 
   template<>   // specialization for bool
   bool extractName<bool>(bool& value, const std::string& header_name,
-                        const std::vector<std::string>& tmp_line,
+                        const std::vector<StringView>& tmp_line,
                         const std::map<std::string, int>& header_dict)
   {
     auto tmp = header_dict.find( header_name );
-    if (tmp != header_dict.end() && !String(tmp_line[ tmp->second ]).empty())
+    if (tmp != header_dict.end() && !tmp_line[ tmp->second ].empty())
     {
-      OpenMS::String str_value = tmp_line[ tmp->second ];
+      OpenMS::String str_value = tmp_line[ tmp->second ].getString();
       if (str_value == "1" || str_value.toUpper() == "TRUE") value = true;
       else if (str_value == "0" || str_value.toUpper() == "FALSE") value = false;
       else return false;
@@ -217,12 +217,12 @@ namespace OpenMS
 
   void TransitionTSVFile::readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, std::vector<TSVTransition>& transition_list)
   {
-    std::ifstream data(filename);
-    std::string   line;
-    std::string   tmp;
+    // the file is memory-mapped and the fields are views into it, so
+    // multi-GB libraries can be read without buffering lines or fields
+    DelimitedTextReader data(filename);
+    const std::vector<StringView>& tmp_line = data.fields();
 
     // read header
-    std::vector<std::string>   tmp_line;
     std::map<std::string, int> header_dict;
     char delimiter = ',';
 
@@ -248,27 +248,21 @@ namespace OpenMS
     // Read header for TSV input
     else
     {
-      TextFile::getLine(data, line);
-      getTSVHeader_(line, delimiter, header_dict);
+      data.readLine();
+      getTSVHeader_(data.line().getString(), delimiter, header_dict);
     }
+    data.setDelimiter(delimiter);
 
     bool spectrast_legacy = false; // we will check below if SpectraST was run in legacy (<5.0) mode or if the RT normalization was forgotten.
     int cnt = 0;
-    while (TextFile::getLine(data, line)) // make sure line endings are handled correctly
+    while (data.readLine()) // handles all line endings and keeps an empty last column
     {
-      line.push_back(delimiter); // avoid losing last column if it is empty
-      std::stringstream lineStream(line);
-
-      while (std::getline(lineStream, tmp, delimiter)) // default getline is fine here, we only want to split the line
-      {
-        tmp_line.push_back(tmp);
-      }
       cnt++;
 
 #ifdef TRANSITIONTSVREADER_TESTING
       for (Size i = 0; i < tmp_line.size(); i++)
       {
-        std::cout << "line " << i << " " << tmp_line[i] << std::endl;
+        std::cout << "line " << i << " " << tmp_line[i].getString() << std::endl;
       }
 
       for (const auto& iter : header_dict)
@@ -289,7 +283,7 @@ namespace OpenMS
 
       //// Required columns (they are guaranteed to be present, see getTSVHeader_)
       // PrecursorMz
-      mytransition.precursor = String(tmp_line[header_dict["PrecursorMz"]]).toDouble();
+      mytransition.precursor = DelimitedTextReader::toDouble(tmp_line[header_dict["PrecursorMz"]]);
 
       // ProductMz
       if (!extractName<double>(mytransition.product, "ProductMz", tmp_line, header_dict) &&
@@ -318,7 +312,7 @@ namespace OpenMS
       {
         if (header_dict.find("SpectraSTRetentionTime") != header_dict.end())
         {
-          spectrastRTExtract(tmp_line[header_dict["SpectraSTRetentionTime"]], mytransition.rt_calibrated, spectrast_legacy);
+          spectrastRTExtract(tmp_line[header_dict["SpectraSTRetentionTime"]].getString(), mytransition.rt_calibrated, spectrast_legacy);
         }
         else
         {
@@ -410,7 +404,7 @@ namespace OpenMS
 
       if (header_dict.find("SpectraSTAnnotation") != header_dict.end())
       {
-        skip_transition = spectrastAnnotationExtract(tmp_line[header_dict["SpectraSTAnnotation"]], mytransition);
+        skip_transition = spectrastAnnotationExtract(tmp_line[header_dict["SpectraSTAnnotation"]].getString(), mytransition);
       }
 
       //// Generate Group IDs
@@ -418,7 +412,7 @@ namespace OpenMS
       if (filetype == FileTypes::MRM)
       {
         std::vector<String> substrings;
-        String(tmp_line[header_dict["SpectraSTFullPeptideName"]]).split("/", substrings);
+        tmp_line[header_dict["SpectraSTFullPeptideName"]].getString().split("/", substrings);
         AASequence peptide = AASequence::fromString(substrings[0]);
 
         mytransition.FullPeptideName = peptide.toString();
@@ -478,8 +472,6 @@ namespace OpenMS
       std::cout << mytransition.fragment_type << std::endl;
       std::cout << mytransition.uniprot_id << std::endl;
 #endif
-
-      tmp_line.clear();
     }
 
     if (spectrast_legacy && retentionTimeInterpretation_ == "iRT")
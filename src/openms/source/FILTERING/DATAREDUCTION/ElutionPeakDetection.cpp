@@ -38,7 +38,7 @@
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
-#include <boost/dynamic_bitset.hpp>
+#include <map>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -48,6 +48,65 @@
 
 namespace OpenMS
 {
+  struct ElutionPeakDetection::Workspace_
+  {
+    /// (RT, intensity) of the trace to be smoothed
+    std::vector<Peak1D> raw;
+    /// smoothing output
+    std::vector<Peak1D> smoothed;
+    /// smoothed intensities of the current trace
+    std::vector<double> smoothed_ints;
+    /// smoothing filters by window size (computing the coefficients is expensive)
+    std::map<int, SavitzkyGolayFilter> filters;
+    /// (smoothed intensity, index) pairs in ascending order
+    std::vector<std::pair<double, Size> > intensity_indices;
+    /// indices already covered by a maximum
+    std::vector<bool> used_idx;
+    /// local maxima and minima of the current trace
+    std::vector<Size> maxes, mins;
+    /// peaks and smoothed intensities of a sub-trace
+    std::vector<PeakType> sub_peaks;
+    std::vector<double> sub_smoothed;
+  };
+
+  namespace
+  {
+    double massTraceNoise(const MassTrace& tr)
+    {
+      // compute RMSE
+      double squared_sum(0.0);
+      const std::vector<double>& smooth_ints = tr.getSmoothedIntensities();
+
+      for (Size i = 0; i < smooth_ints.size(); ++i)
+      {
+        squared_sum += (tr[i].getIntensity() - smooth_ints[i]) * (tr[i].getIntensity() - smooth_ints[i]);
+      }
+
+      double rmse(0.0);
+
+      if (!smooth_ints.empty())
+      {
+        rmse = std::sqrt(squared_sum / smooth_ints.size());
+      }
+
+      return rmse;
+    }
+
+    double apexSNR(const MassTrace& tr)
+    {
+      double noise_level(massTraceNoise(tr));
+
+      double snr = 0;
+      if (noise_level > 0.0)
+      {
+        double smoothed_apex_int(tr.getMaxIntensity(true));
+        snr = smoothed_apex_int / noise_level;
+      }
+
+      return snr;
+    }
+  }
+
   ElutionPeakDetection::ElutionPeakDetection() :
     DefaultParamHandler("ElutionPeakDetection"), ProgressLogger()
   {
@@ -75,23 +134,7 @@ namespace OpenMS
 
   double ElutionPeakDetection::computeMassTraceNoise(const MassTrace& tr)
   {
-    // compute RMSE
-    double squared_sum(0.0);
-    std::vector<double> smooth_ints(tr.getSmoothedIntensities());
-
-    for (Size i = 0; i < smooth_ints.size(); ++i)
-    {
-      squared_sum += (tr[i].getIntensity() - smooth_ints[i]) * (tr[i].getIntensity() - smooth_ints[i]);
-    }
-
-    double rmse(0.0);
-
-    if (!smooth_ints.empty())
-    {
-      rmse = std::sqrt(squared_sum / smooth_ints.size());
-    }
-
-    return rmse;
+    return massTraceNoise(tr);
   }
 
   double ElutionPeakDetection::computeMassTraceSNR(const MassTrace& tr)
@@ -113,24 +156,22 @@ namespace OpenMS
 
   double ElutionPeakDetection::computeApexSNR(const MassTrace& tr)
   {
-    double noise_level(computeMassTraceNoise(tr));
-
-    double snr = 0;
-    if (noise_level > 0.0)
-    {
-      double smoothed_apex_int(tr.getMaxIntensity(true));
-      snr = smoothed_apex_int / noise_level;
-    }
-
     // std::cout << "snr " << snr << " ";
 
-    return snr;
+    return apexSNR(tr);
   }
 
   void ElutionPeakDetection::findLocalExtrema(const MassTrace& tr, const Size& num_neighboring_peaks,
                                               std::vector<Size>& chrom_maxes, std::vector<Size>& chrom_mins)
   {
-    std::vector<double> smoothed_ints_vec(tr.getSmoothedIntensities());
+    Workspace_ ws;
+    findLocalExtrema_(tr, num_neighboring_peaks, chrom_maxes, chrom_mins, ws);
+  }
+
+  void ElutionPeakDetection::findLocalExtrema_(const MassTrace& tr, Size num_neighboring_peaks,
+                                               std::vector<Size>& chrom_maxes, std::vector<Size>& chrom_mins, Workspace_& ws) const
+  {
+    const std::vector<double>& smoothed_ints_vec = tr.getSmoothedIntensities();
 
     Size mt_length(smoothed_ints_vec.size());
 
@@ -145,18 +186,22 @@ namespace OpenMS
     chrom_mins.clear();
 
     // Remember which indices we have already used
-    boost::dynamic_bitset<> used_idx(mt_length);
+    std::vector<bool>& used_idx = ws.used_idx;
+    used_idx.assign(mt_length, false);
 
     // Extract RTs from the chromatogram and store them into vectors for index access
     // Store indices along with smoothed_ints to keep track of the peak order
-    std::multimap<double, Size> intensity_indices;
+    // (ties are ordered by index)
+    std::vector<std::pair<double, Size> >& intensity_indices = ws.intensity_indices;
+    intensity_indices.clear();
     for (Size idx = 0; idx < mt_length; ++idx)
     {
-      intensity_indices.insert(std::make_pair(smoothed_ints_vec[idx], idx));
+      intensity_indices.push_back(std::make_pair(smoothed_ints_vec[idx], idx));
     }
+    std::sort(intensity_indices.begin(), intensity_indices.end());
 
     // Step 1: Identify maxima
-    for (std::multimap<double, Size>::const_iterator c_it = intensity_indices.begin(); c_it != intensity_indices.end(); ++c_it)
+    for (std::vector<std::pair<double, Size> >::const_iterator c_it = intensity_indices.begin(); c_it != intensity_indices.end(); ++c_it)
     {
       double ref_int = c_it->first;
       Size ref_idx = c_it->second;
@@ -320,7 +365,8 @@ namespace OpenMS
     // make sure that single_mtraces is empty
     single_mtraces.clear();
 
-    detectElutionPeaks_(mt, single_mtraces);
+    Workspace_ ws;
+    detectElutionPeaks_(mt, single_mtraces, ws);
     return;
   }
 
@@ -329,22 +375,47 @@ namespace OpenMS
     // make sure that single_mtraces is empty
     single_mtraces.clear();
 
+    // one output slot per input trace: threads write by index and the
+    // result does not depend on the order in which traces are processed
+    std::vector<std::vector<MassTrace> > detected(mt_vec.size());
+
     this->startProgress(0, mt_vec.size(), "elution peak detection");
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-    for (SignedSize i = 0; i < (SignedSize) mt_vec.size(); ++i)
     {
-      IF_MASTERTHREAD this->setProgress(progress);
+      Workspace_ ws; // reused for all traces of this thread
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize) mt_vec.size(); ++i)
+      {
+        IF_MASTERTHREAD this->setProgress(progress);
 
 #ifdef _OPENMP
 #pragma omp atomic
 #endif
-      ++progress;
+        ++progress;
 
-      // push_back to 'single_mtraces' is protected, so threading is ok
-      detectElutionPeaks_(mt_vec[i], single_mtraces);
+        detectElutionPeaks_(mt_vec[i], detected[i], ws);
+      }
+    }
+
+    Size n_detected(0);
+    for (Size i = 0; i < detected.size(); ++i)
+    {
+      n_detected += detected[i].size();
+    }
+    single_mtraces.reserve(n_detected);
+    for (Size i = 0; i < detected.size(); ++i)
+    {
+      for (Size j = 0; j < detected[i].size(); ++j)
+      {
+        single_mtraces.push_back(std::move(detected[i][j]));
+      }
+      std::vector<MassTrace>().swap(detected[i]); // release memory early
     }
 
     this->endProgress();
@@ -384,7 +455,7 @@ namespace OpenMS
     return;
   }
 
-  void ElutionPeakDetection::detectElutionPeaks_(MassTrace& mt, std::vector<MassTrace>& single_mtraces)
+  void ElutionPeakDetection::detectElutionPeaks_(MassTrace& mt, std::vector<MassTrace>& single_mtraces, Workspace_& ws) const
   {
 
     // *********************************************************************
@@ -395,7 +466,7 @@ namespace OpenMS
     Size win_size = std::ceil(chrom_fwhm_ / scan_time);
 
     // add smoothed data (original data is still accessible)
-    smoothData(mt, static_cast<Int>(win_size));
+    smoothData_(mt, static_cast<Int>(win_size), ws);
 
 #ifdef DEBUG_EPD
     Size i = 0;
@@ -414,8 +485,9 @@ namespace OpenMS
     // *********************************************************************
     // Step 2: Identify local maxima and minima
     // *********************************************************************
-    std::vector<Size> maxes, mins;
-    findLocalExtrema(mt, win_size / 2, maxes, mins);
+    std::vector<Size>& maxes = ws.maxes;
+    std::vector<Size>& mins = ws.mins;
+    findLocalExtrema_(mt, win_size / 2, maxes, mins, ws);
 
 #ifdef DEBUG_EPD
     std::cout << "findLocalExtrema returned: maxima " << maxes.size() << " / minima " << mins.size() << std::endl;
@@ -448,7 +520,7 @@ namespace OpenMS
       // *********************************************************************
       if (mt_snr_filtering_)
       {
-        if (computeApexSNR(mt) < chrom_peak_snr_)
+        if (apexSNR(mt) < chrom_peak_snr_)
         {
           snr_ok = false;
         }
@@ -463,12 +535,7 @@ namespace OpenMS
           mt.estimateFWHM(true);
         }
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_ElutionPeakDetection_mtraces)
-#endif
-        {
-          single_mtraces.push_back(mt);
-        }
+        single_mtraces.push_back(mt);
 
       }
     }
@@ -490,8 +557,10 @@ namespace OpenMS
         // *********************************************************************
         // Step 3.1: Create new mass trace (sub-trace between cp_it and split point)
         // *********************************************************************
-        std::vector<PeakType> tmp_mt;
-        std::vector<double> smoothed_tmp;
+        std::vector<PeakType>& tmp_mt = ws.sub_peaks;
+        std::vector<double>& smoothed_tmp = ws.sub_smoothed;
+        tmp_mt.clear();
+        smoothed_tmp.clear();
         while (last_idx <= mins[min_idx])
         {
           tmp_mt.push_back(*cp_it);
@@ -525,7 +594,7 @@ namespace OpenMS
         // *********************************************************************
         if (mt_snr_filtering_)
         {
-          if (computeApexSNR(mt) < chrom_peak_snr_)
+          if (apexSNR(mt) < chrom_peak_snr_)
           {
             snr_ok = false;
           }
@@ -544,12 +613,7 @@ namespace OpenMS
             new_mt.estimateFWHM(true);
           }
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_ElutionPeakDetection_mtraces)
-#endif
-          {
-            single_mtraces.push_back(new_mt);
-          }
+          single_mtraces.push_back(std::move(new_mt));
         }
       }
 
@@ -558,30 +622,43 @@ namespace OpenMS
   }
 
   void ElutionPeakDetection::smoothData(MassTrace& mt, int win_size) const
+  {
+    Workspace_ ws;
+    smoothData_(mt, win_size, ws);
+  }
+
+  void ElutionPeakDetection::smoothData_(MassTrace& mt, int win_size, Workspace_& ws) const
   {
     // alternative smoothing using SavitzkyGolay
     // looking at the unit test, this method gives better fits than lowess smoothing
     // reference paper uses lowess smoothing
 
-    MSSpectrum spectrum;
+    ws.raw.clear();
     for (Size i = 0; i != mt.getSize(); ++i)
     {
-      spectrum.push_back(Peak1D(mt[i].getRT(), mt[i].getIntensity()));
+      ws.raw.push_back(Peak1D(mt[i].getRT(), mt[i].getIntensity()));
+    }
+
+    int frame_length = std::max(3, win_size); // frame length must be at least polynomial_order+1, otherwise SG will fail
+    std::map<int, SavitzkyGolayFilter>::iterator sg = ws.filters.find(frame_length);
+    if (sg == ws.filters.end())
+    {
+      sg = ws.filters.insert(std::make_pair(frame_length, SavitzkyGolayFilter())).first;
+      Param param;
+      param.setValue("polynomial_order", 2);
+      param.setValue("frame_length", frame_length);
+      sg->second.setParameters(param);
     }
+    // the filter leaves the output untouched if the trace is shorter than the frame
+    ws.smoothed = ws.raw;
+    sg->second.filter(ws.raw.begin(), ws.raw.end(), ws.smoothed.begin());
 
-    SavitzkyGolayFilter sg;
-    Param param;
-    param.setValue("polynomial_order", 2);
-    param.setValue("frame_length", std::max(3, win_size)); // frame length must be at least polynomial_order+1, otherwise SG will fail
-    sg.setParameters(param);
-    sg.filter(spectrum);
-    MSSpectrum::iterator iter = spectrum.begin();
-    std::vector<double> smoothed_intensities;
-    for (; iter != spectrum.end(); ++iter)
+    ws.smoothed_ints.clear();
+    for (std::vector<Peak1D>::const_iterator iter = ws.smoothed.begin(); iter != ws.smoothed.end(); ++iter)
     {
-      smoothed_intensities.push_back(iter->getIntensity());
+      ws.smoothed_ints.push_back(iter->getIntensity());
     }
-    mt.setSmoothedIntensities(smoothed_intensities);
+    mt.setSmoothedIntensities(ws.smoothed_ints);
     //alternative end
 
     // std::cout << "win_size elution: " << scan_time << " " << win_size << std::endl;
@@ -42,6 +42,7 @@
 #include <boost/dynamic_bitset.hpp>
 
 #ifdef _OPENMP
+#include <omp.h>
 #endif
 
 // #define FFM_DEBUG
@@ -285,6 +286,22 @@ namespace OpenMS
     return feat_score_;
   }
 
+  struct FeatureFindingMetabo::Workspace_
+  {
+    /// hypotheses generated by this thread
+    std::vector<FeatureHypothesis> hypotheses;
+    /// (index of reference trace, end of its hypotheses in @p hypotheses), in processing order
+    std::vector<std::pair<Size, Size> > segments;
+    /// candidate traces of the current reference trace
+    std::vector<const MassTrace*> local_traces;
+    /// coinciding intensities of two traces (RT scoring)
+    std::vector<double> x, y;
+    /// isotope intensities of the hypothesis under construction (averagine scoring)
+    std::vector<double> hypo_ints;
+    /// averagine model (not thread-safe, so one per thread)
+    CoarseIsotopePatternGenerator averagine;
+  };
+
   FeatureFindingMetabo::FeatureFindingMetabo() :
     DefaultParamHandler("FeatureFindingMetabo"), ProgressLogger()
   {
@@ -348,37 +365,27 @@ namespace OpenMS
     remove_single_traces_ = param_.getValue("remove_single_traces").toBool();
   }
 
-  double FeatureFindingMetabo::computeAveragineSimScore_(const std::vector<double>& hypo_ints, const double& mol_weight) const
+  double FeatureFindingMetabo::computeAveragineSimScore_(const std::vector<double>& hypo_ints, const double& mol_weight, Workspace_& ws) const
   {
-    CoarseIsotopePatternGenerator solver(hypo_ints.size());
-    auto isodist = solver.estimateFromPeptideWeight(mol_weight);
+    ws.averagine.setMaxIsotope(hypo_ints.size());
+    IsotopeDistribution isodist = ws.averagine.estimateFromPeptideWeight(mol_weight);
     // isodist.renormalize();
 
-    IsotopeDistribution::ContainerType averagine_dist = isodist.getContainer();
-    double max_int(0.0), theo_max_int(0.0);
-    for (Size i = 0; i < hypo_ints.size(); ++i)
-    {
-      if (hypo_ints[i] > max_int)
-      {
-        max_int = hypo_ints[i];
-      }
-
-      if (averagine_dist[i].getIntensity() > theo_max_int)
-      {
-        theo_max_int = averagine_dist[i].getIntensity();
-      }
-    }
+    const IsotopeDistribution::ContainerType& averagine_dist = isodist.getContainer();
 
-    // compute normalized intensities
-    std::vector<double> averagine_ratios, hypo_isos;
+    // The cosine similarity does not depend on the scaling of the two vectors,
+    // so normalizing both to their maximum (as in Kenar et al.) is not needed.
+    double mixed_sum(0.0), theo_squared_sum(0.0), hypo_squared_sum(0.0);
     for (Size i = 0; i < hypo_ints.size(); ++i)
     {
-      averagine_ratios.push_back(averagine_dist[i].getIntensity() / theo_max_int);
-      hypo_isos.push_back(hypo_ints[i] / max_int);
+      double theo_int(averagine_dist[i].getIntensity());
+      mixed_sum += theo_int * hypo_ints[i];
+      theo_squared_sum += theo_int * theo_int;
+      hypo_squared_sum += hypo_ints[i] * hypo_ints[i];
     }
 
-    double iso_score = computeCosineSim_(averagine_ratios, hypo_isos);
-    return iso_score;
+    double denom(std::sqrt(theo_squared_sum) * std::sqrt(hypo_squared_sum));
+    return (denom > 0.0) ? mixed_sum / denom : 0.0;
   }
 
   int FeatureFindingMetabo::isLegalIsotopePattern_(const FeatureHypothesis& feat_hypo) const
@@ -398,7 +405,7 @@ namespace OpenMS
     double mono_int(all_ints[0]); // monoisotopic intensity
 
     const Size FEAT_NUM(4);
-    svm_node* nodes = new svm_node[FEAT_NUM + 1];
+    svm_node nodes[FEAT_NUM + 1];
 
     double act_mass(feat_hypo.getCentroidMZ() * feat_hypo.getCharge());
 
@@ -453,7 +460,6 @@ namespace OpenMS
     double predict = svm_predict(isotope_filt_svm_, nodes);
 
     // std::cout << "predict: " << predict << std::endl;
-    delete[] nodes;
 
     return (predict == 2.0) ? 1 : 0;
   }
@@ -553,72 +559,56 @@ namespace OpenMS
     return mz_score;
   }
   
-  double FeatureFindingMetabo::scoreRT_(const MassTrace& tr1, const MassTrace& tr2) const
+  double FeatureFindingMetabo::scoreRT_(const MassTrace& tr1, const MassTrace& tr2, Workspace_& ws) const
   {
     // return success if this filter is disabled
     if (!enable_RT_filtering_) return 1.0;
 
     // continue to check overlap and cosine similarity
     // ...
-    std::map<double, std::vector<double> > coinciding_rts;
-
     std::pair<Size, Size> tr1_fwhm_idx(tr1.getFWHMborders());
     std::pair<Size, Size> tr2_fwhm_idx(tr2.getFWHMborders());
 
-    //    std::cout << tr1_fwhm_idx.first << " " << tr1_fwhm_idx.second << std::endl;
-    //    std::cout << tr2_fwhm_idx.first << " " << tr2_fwhm_idx.second << std::endl;
-
-    //    Size tr1_fwhm_size(tr1_fwhm_idx.second - tr1_fwhm_idx.first);
-    //    Size tr2_fwhm_size(tr2_fwhm_idx.second - tr2_fwhm_idx.first);
-
-    //    double max_length = (tr1_fwhm_size > tr2_fwhm_size) ? tr1_fwhm_size : tr2_fwhm_size;
-
     double tr1_length(tr1.getFWHM());
     double tr2_length(tr2.getFWHM());
     double max_length = (tr1_length > tr2_length) ? tr1_length : tr2_length;
 
     // std::cout << "tr1 " << tr1_length << " tr2 " << tr2_length << std::endl;
 
-    // Extract peak shape between FWHM borders for both peaks
-    for (Size i = tr1_fwhm_idx.first; i <= tr1_fwhm_idx.second; ++i)
-    {
-      coinciding_rts[tr1[i].getRT()].push_back(tr1[i].getIntensity());
-    }
-    for (Size i = tr2_fwhm_idx.first; i <= tr2_fwhm_idx.second; ++i)
-    {
-      coinciding_rts[tr2[i].getRT()].push_back(tr2[i].getIntensity());
-    }
-
-    // Look at peaks at the same RT 
+    // Look at peaks at the same RT between the FWHM borders of both peaks
+    // (both traces are sorted by RT, so a merge finds all coinciding RTs)
     // TODO: this only works if both traces are sampled with equal rate at the same RT
-    std::vector<double> x, y, overlap_rts;
-    for (std::map<double, std::vector<double> >::const_iterator m_it = coinciding_rts.begin(); m_it != coinciding_rts.end(); ++m_it)
-    {
-      if (m_it->second.size() == 2)
+    std::vector<double>& x = ws.x;
+    std::vector<double>& y = ws.y;
+    x.clear();
+    y.clear();
+    double start_rt(0.0), end_rt(0.0);
+    Size i = tr1_fwhm_idx.first, j = tr2_fwhm_idx.first;
+    while (i <= tr1_fwhm_idx.second && j <= tr2_fwhm_idx.second)
+    {
+      if (tr1[i].getRT() < tr2[j].getRT())
+      {
+        ++i;
+      }
+      else if (tr2[j].getRT() < tr1[i].getRT())
       {
-        x.push_back(m_it->second[0]);
-        y.push_back(m_it->second[1]);
-        overlap_rts.push_back(m_it->first);
+        ++j;
+      }
+      else
+      {
+        if (x.empty())
+        {
+          start_rt = tr1[i].getRT();
+        }
+        end_rt = tr1[i].getRT();
+        x.push_back(tr1[i].getIntensity());
+        y.push_back(tr2[j].getIntensity());
+        ++i;
+        ++j;
       }
     }
 
-    //    if (x.size() < std::floor(0.8*max_length))
-    //        {
-    //            return 0.0;
-    //        }
-    // double rt_range(0.0)
-    // if (coinciding_rts.size() > 0)
-    // {
-    //     rt_range = std::fabs(coinciding_rts.rbegin()->first - coinciding_rts.begin()->first);
-    // }
-
-
-    double overlap(0.0);
-    if (overlap_rts.size() > 0)
-    {
-      double start_rt(*(overlap_rts.begin())), end_rt(*(overlap_rts.rbegin()));
-      overlap = std::fabs(end_rt - start_rt);
-    }
+    double overlap(std::fabs(end_rt - start_rt));
 
     double proportion(overlap / max_length);
     if (proportion < 0.7)
@@ -651,20 +641,16 @@ namespace OpenMS
   }
 
 
-  void FeatureFindingMetabo::findLocalFeatures_(const std::vector<const MassTrace*>& candidates, const double total_intensity, std::vector<FeatureHypothesis>& output_hypotheses) const
+  void FeatureFindingMetabo::findLocalFeatures_(const std::vector<const MassTrace*>& candidates, const double total_intensity, Workspace_& ws) const
   {
+    // hypotheses go to the arena of the current thread
+    std::vector<FeatureHypothesis>& output_hypotheses = ws.hypotheses;
+
     // single Mass trace hypothesis
     FeatureHypothesis tmp_hypo;
     tmp_hypo.addMassTrace(*candidates[0]);
     tmp_hypo.setScore((candidates[0]->getIntensity(use_smoothed_intensities_)) / total_intensity);
-
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_FFMetabo_output_hypos)
-#endif
-    {
-      // pushing back to shared vector needs to be synchronized
-      output_hypotheses.push_back(tmp_hypo);
-    }
+    output_hypotheses.push_back(std::move(tmp_hypo));
 
     for (Size charge = charge_lower_bound_; charge <= charge_upper_bound_; ++charge)
     {
@@ -676,6 +662,10 @@ namespace OpenMS
       // double mono_iso_mz(candidates[0]->getCentroidMZ());
       // double mono_iso_int(candidates[0]->computePeakArea());
 
+      // isotope intensities of fh_tmp (for averagine scoring)
+      std::vector<double>& tmp_ints = ws.hypo_ints;
+      tmp_ints.assign(1, candidates[0]->getIntensity(false));
+
       Size last_iso_idx(0);
       Size iso_pos_max(static_cast<Size>(std::floor(charge * local_mz_range_)));
       for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
@@ -697,7 +687,7 @@ namespace OpenMS
 #endif
 
           // Score current mass trace candidates against hypothesis
-          double rt_score(scoreRT_(*candidates[0], *candidates[mt_idx]));
+          double rt_score(scoreRT_(*candidates[0], *candidates[mt_idx], ws));
           double mz_score(scoreMZ_(*candidates[0], *candidates[mt_idx], iso_pos, charge));
 
           // disable intensity scoring for now...
@@ -706,9 +696,9 @@ namespace OpenMS
 
           if (isotope_filtering_model_ == "peptides")
           {
-            std::vector<double> tmp_ints(fh_tmp.getAllIntensities());
             tmp_ints.push_back(candidates[mt_idx]->getIntensity(use_smoothed_intensities_));
-            int_score = computeAveragineSimScore_(tmp_ints, candidates[mt_idx]->getCentroidMZ() * charge);
+            int_score = computeAveragineSimScore_(tmp_ints, candidates[mt_idx]->getCentroidMZ() * charge, ws);
+            tmp_ints.pop_back();
           }
 
 #ifdef FFM_DEBUG
@@ -734,19 +724,14 @@ namespace OpenMS
         if (best_so_far > 0.0)
         {
           fh_tmp.addMassTrace(*candidates[best_idx]);
+          tmp_ints.push_back(candidates[best_idx]->getIntensity(false));
           double weighted_score(((candidates[best_idx]->getIntensity(use_smoothed_intensities_)) * best_so_far) / total_intensity);
 
           fh_tmp.setScore(fh_tmp.getScore() + weighted_score);
           fh_tmp.setCharge(charge);
           last_iso_idx = best_idx;
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_FFMetabo_output_hypos)
-#endif
-          {
-            // pushing back to shared vector needs to be synchronized
-            output_hypotheses.push_back(fh_tmp);
-          }
+          output_hypotheses.push_back(fh_tmp);
         }
         else
         {
@@ -800,10 +785,18 @@ namespace OpenMS
     // and generate isotopic / charge hypotheses
     // *********************************************************** //
 
-    std::vector<FeatureHypothesis> feat_hypos;
+    // every thread collects its hypotheses in its own arena; these are
+    // merged once at the end, ordered by reference trace (so the result does
+    // not depend on the number of threads or the scheduling)
+    Size num_threads(1);
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    std::vector<Workspace_> workspaces(num_threads);
+
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 16)
 #endif
     for (SignedSize i = 0; i < (SignedSize)input_mtraces.size(); ++i)
     {
@@ -813,7 +806,14 @@ namespace OpenMS
 #endif
       ++progress;
 
-      std::vector<const MassTrace*> local_traces;
+      Size thread_num(0);
+#ifdef _OPENMP
+      thread_num = omp_get_thread_num();
+#endif
+      Workspace_& ws = workspaces[thread_num];
+
+      std::vector<const MassTrace*>& local_traces = ws.local_traces;
+      local_traces.clear();
       double ref_trace_mz(input_mtraces[i].getCentroidMZ());
       double ref_trace_rt(input_mtraces[i].getCentroidRT());
 
@@ -832,10 +832,39 @@ namespace OpenMS
           local_traces.push_back(&input_mtraces[ext_idx]);
         }
       }
-      findLocalFeatures_(local_traces, total_intensity, feat_hypos);
+      findLocalFeatures_(local_traces, total_intensity, ws);
+      ws.segments.push_back(std::make_pair(static_cast<Size>(i), ws.hypotheses.size()));
     }
     this->endProgress();
 
+    // merge the arenas: (reference trace, thread, begin, end) of each segment
+    std::vector<std::pair<Size, std::pair<Size, std::pair<Size, Size> > > > segments;
+    Size num_hypos(0);
+    for (Size t = 0; t < workspaces.size(); ++t)
+    {
+      Size begin(0);
+      for (Size s = 0; s < workspaces[t].segments.size(); ++s)
+      {
+        Size end(workspaces[t].segments[s].second);
+        segments.push_back(std::make_pair(workspaces[t].segments[s].first, std::make_pair(t, std::make_pair(begin, end))));
+        begin = end;
+      }
+      num_hypos += workspaces[t].hypotheses.size();
+    }
+    std::sort(segments.begin(), segments.end());
+
+    std::vector<FeatureHypothesis> feat_hypos;
+    feat_hypos.reserve(num_hypos);
+    for (Size s = 0; s < segments.size(); ++s)
+    {
+      std::vector<FeatureHypothesis>& arena = workspaces[segments[s].second.first].hypotheses;
+      for (Size h = segments[s].second.second.first; h < segments[s].second.second.second; ++h)
+      {
+        feat_hypos.push_back(std::move(arena[h]));
+      }
+    }
+    workspaces.clear();
+
     // sort feature candidates by their score
     std::sort(feat_hypos.begin(), feat_hypos.end(), CmpHypothesesByScore());
 
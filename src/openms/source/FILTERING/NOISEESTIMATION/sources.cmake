@@ -7,6 +7,7 @@ SignalToNoiseEstimator.cpp
 SignalToNoiseEstimatorMeanIterative.cpp
 SignalToNoiseEstimatorMedian.cpp
 SignalToNoiseEstimatorMedianRapid.cpp
+SignalToNoiseEstimatorMedianSliding.cpp
 )
 
 ### add path to the filenames
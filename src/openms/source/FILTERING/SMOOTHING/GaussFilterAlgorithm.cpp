@@ -37,6 +37,8 @@
 namespace OpenMS
 {
 
+  const double GaussFilterAlgorithm::EQUIDISTANT_TOLERANCE = 1e-6;
+
   GaussFilterAlgorithm::GaussFilterAlgorithm()  :
     coeffs_(),
     sigma_(0.1),
@@ -75,4 +77,26 @@ namespace OpenMS
 
   }
 
+  double GaussFilterAlgorithm::coefficientAt_(double distance) const
+  {
+    const Size middle = coeffs_.size();
+
+    // search for the left adjacent tabulated point (correct rounding errors of floor)
+    Size left_position = (Size)floor(distance / spacing_);
+    if (left_position > 0 && left_position * spacing_ > distance)
+    {
+      --left_position;
+    }
+    if (left_position >= middle)
+    {
+      return coeffs_[middle - 1];
+    }
+
+    // interpolate between the left and right tabulated points
+    Size right_position = left_position + 1;
+    double d = fabs((left_position * spacing_) - distance) / spacing_;
+    return (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
+                                     : coeffs_[left_position];
+  }
+
 }
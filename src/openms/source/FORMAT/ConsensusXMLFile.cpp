@@ -50,6 +50,7 @@ namespace OpenMS
     ProgressLogger(),
     consensus_map_(nullptr),
     act_cons_element_(),
+    act_cons_handles_(),
     last_meta_(nullptr)
   {
   }
@@ -78,11 +79,13 @@ namespace OpenMS
 
     if (tag == "consensusElement")
     {
+      // add all handles of this element at once (sorted insert into the flat handle set)
+      act_cons_element_.insert(act_cons_handles_);
+      act_cons_handles_.clear();
       if ((!options_.hasRTRange() || options_.getRTRange().encloses(act_cons_element_.getRT())) && (!options_.hasMZRange() || options_.getMZRange().encloses(
                                                                                                       act_cons_element_.getMZ())) && (!options_.hasIntensityRange() || options_.getIntensityRange().encloses(act_cons_element_.getIntensity())))
       {
-        consensus_map_->push_back(act_cons_element_);
-        act_cons_element_.getPeptideIdentifications().clear();
+        consensus_map_->push_back(std::move(act_cons_element_));
       }
       last_meta_ = nullptr;
     }
@@ -142,6 +145,17 @@ namespace OpenMS
   void
   ConsensusXMLFile::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
   {
+    static const XMLCh* s_id = xercesc::XMLString::transcode("id");
+    static const XMLCh* s_map = xercesc::XMLString::transcode("map");
+    static const XMLCh* s_rt = xercesc::XMLString::transcode("rt");
+    static const XMLCh* s_mz = xercesc::XMLString::transcode("mz");
+    static const XMLCh* s_it = xercesc::XMLString::transcode("it");
+    static const XMLCh* s_charge = xercesc::XMLString::transcode("charge");
+    static const XMLCh* s_quality = xercesc::XMLString::transcode("quality");
+    static const XMLCh* s_name = xercesc::XMLString::transcode("name");
+    static const XMLCh* s_type = xercesc::XMLString::transcode("type");
+    static const XMLCh* s_value = xercesc::XMLString::transcode("value");
+
     String tag = sm_.convert(qname);
     String parent_tag;
     if (!open_tags_.empty())
@@ -182,38 +196,41 @@ namespace OpenMS
       last_meta_ = &act_cons_element_;
       // quality
       double quality = 0.0;
-      if (optionalAttributeAsDouble_(quality, attributes, "quality"))
+      if (optionalAttributeAsDouble_(quality, attributes, s_quality))
       {
         act_cons_element_.setQuality(quality);
       }
       // charge
       Int charge = 0;
-      if (optionalAttributeAsInt_(charge, attributes, "charge"))
+      if (optionalAttributeAsInt_(charge, attributes, s_charge))
       {
         act_cons_element_.setCharge(charge);
       }
       // unique id
-      act_cons_element_.setUniqueId(attributeAsString_(attributes, "id"));
+      act_cons_element_.setUniqueId(attributeAsString_(attributes, s_id));
       last_meta_ = &act_cons_element_;
     }
     else if (tag == "centroid")
     {
-      tmp_str = attributeAsString_(attributes, "rt");
-      if (tmp_str != "")
+      const XMLCh* val = attributes.getValue(s_rt);
+      if (val == nullptr) fatalError(LOAD, "Required attribute 'rt' not present!");
+      if (*val != 0)
       {
-        pos_[Peak2D::RT] = asDouble_(tmp_str);
+        pos_[Peak2D::RT] = asDouble_(val);
       }
 
-      tmp_str = attributeAsString_(attributes, "mz");
-      if (tmp_str != "")
+      val = attributes.getValue(s_mz);
+      if (val == nullptr) fatalError(LOAD, "Required attribute 'mz' not present!");
+      if (*val != 0)
       {
-        pos_[Peak2D::MZ] = asDouble_(tmp_str);
+        pos_[Peak2D::MZ] = asDouble_(val);
       }
 
-      tmp_str = attributeAsString_(attributes, "it");
-      if (tmp_str != "")
+      val = attributes.getValue(s_it);
+      if (val == nullptr) fatalError(LOAD, "Required attribute 'it' not present!");
+      if (*val != 0)
       {
-        it_ = asDouble_(tmp_str);
+        it_ = asDouble_(val);
       }
 
     }
@@ -222,13 +239,13 @@ namespace OpenMS
       FeatureHandle act_index_tuple;
       UniqueIdInterface tmp_unique_id_interface;
 
-      tmp_str = attributeAsString_(attributes, "map");
+      tmp_str = attributeAsString_(attributes, s_map);
       if (tmp_str != "")
       {
         tmp_unique_id_interface.setUniqueId(tmp_str);
         UInt64 map_index = tmp_unique_id_interface.getUniqueId();
 
-        tmp_str = attributeAsString_(attributes, "id");
+        tmp_str = attributeAsString_(attributes, s_id);
         if (tmp_str != "")
         {
           tmp_unique_id_interface.setUniqueId(tmp_str);
@@ -237,22 +254,24 @@ namespace OpenMS
           act_index_tuple.setMapIndex(map_index);
           act_index_tuple.setUniqueId(unique_id);
 
-          tmp_str = attributeAsString_(attributes, "rt");
+          const XMLCh* val = attributes.getValue(s_rt);
+          if (val == nullptr) fatalError(LOAD, "Required attribute 'rt' not present!");
           DPosition<2> pos;
-          pos[0] = asDouble_(tmp_str);
-          tmp_str = attributeAsString_(attributes, "mz");
-          pos[1] = asDouble_(tmp_str);
+          pos[0] = asDouble_(val);
+          val = attributes.getValue(s_mz);
+          if (val == nullptr) fatalError(LOAD, "Required attribute 'mz' not present!");
+          pos[1] = asDouble_(val);
 
           act_index_tuple.setPosition(pos);
-          act_index_tuple.setIntensity(attributeAsDouble_(attributes, "it"));
+          act_index_tuple.setIntensity(attributeAsDouble_(attributes, s_it));
 
           Int charge = 0;
-          if (optionalAttributeAsInt_(charge, attributes, "charge"))
+          if (optionalAttributeAsInt_(charge, attributes, s_charge))
           {
             act_index_tuple.setCharge(charge);
           }
 
-          act_cons_element_.insert(act_index_tuple);
+          act_cons_handles_.push_back(act_index_tuple);
         }
       }
       act_cons_element_.getPosition() = pos_;
@@ -304,16 +323,16 @@ namespace OpenMS
         fatalError(LOAD, String("Unexpected UserParam in tag '") + parent_tag + "'");
       }
 
-      String name = attributeAsString_(attributes, "name");
-      String type = attributeAsString_(attributes, "type");
+      String name = attributeAsString_(attributes, s_name);
+      String type = attributeAsString_(attributes, s_type);
 
       if (type == "int")
       {
-        last_meta_->setMetaValue(name, attributeAsInt_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsInt_(attributes, s_value));
       }
       else if (type == "float")
       {
-        last_meta_->setMetaValue(name, attributeAsDouble_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsDouble_(attributes, s_value));
       }
       else if (type == "intList")
       {
@@ -329,7 +348,7 @@ namespace OpenMS
       }
       else if (type == "string")
       {
-        last_meta_->setMetaValue(name, (String) attributeAsString_(attributes, "value"));
+        last_meta_->setMetaValue(name, (String) attributeAsString_(attributes, s_value));
       }
       else
       {
@@ -844,47 +863,11 @@ namespace OpenMS
 
     // write all consensus elements
     os << "\t<consensusElementList>\n";
-    for (Size i = 0; i < consensus_map.size(); ++i)
-    {
-      setProgress(++progress_);
-      // write a consensusElement
-      const ConsensusFeature& elem = consensus_map[i];
-      os << "\t\t<consensusElement id=\"e_" << elem.getUniqueId() << "\" quality=\"" << precisionWrapper(elem.getQuality()) << "\"";
-      if (elem.getCharge() != 0)
-      {
-        os << " charge=\"" << elem.getCharge() << "\"";
-      }
-      os << ">\n";
-      // write centroid
-      os << "\t\t\t<centroid rt=\"" << precisionWrapper(elem.getRT()) << "\" mz=\"" << precisionWrapper(elem.getMZ()) << "\" it=\"" << precisionWrapper(
-        elem.getIntensity()) << "\"/>\n";
-      // write groupedElementList
-      os << "\t\t\t<groupedElementList>\n";
-      for (ConsensusFeature::HandleSetType::const_iterator it = elem.begin(); it != elem.end(); ++it)
-      {
-        os << "\t\t\t\t<element"
-              " map=\"" << it->getMapIndex() << "\""
-                                                " id=\"" << it->getUniqueId() << "\""
-                                                                                 " rt=\"" << precisionWrapper(it->getRT()) << "\""
-                                                                                                                              " mz=\"" << precisionWrapper(it->getMZ()) << "\""
-                                                                                                                                                                           " it=\"" << precisionWrapper(it->getIntensity()) << "\"";
-        if (it->getCharge() != 0)
-        {
-          os << " charge=\"" << it->getCharge() << "\"";
-        }
-        os << "/>\n";
-      }
-      os << "\t\t\t</groupedElementList>\n";
-
-      // write PeptideIdentification
-      for (UInt j = 0; j < elem.getPeptideIdentifications().size(); ++j)
-      {
-        writePeptideIdentification_(filename, os, elem.getPeptideIdentifications()[j], "PeptideIdentification", 3);
-      }
-
-      writeUserParam_("UserParam", os, elem, 3);
-      os << "\t\t</consensusElement>\n";
-    }
+    // elements are serialized in parallel, the output is identical to writing them one by one
+    const Size progress_offset = progress_;
+    writeElementsParallel_(os, consensus_map.size(),
+      [&](std::ostream& chunk, Size i) { writeConsensusElement_(filename, chunk, consensus_map[i]); },
+      [&](Size done) { progress_ = progress_offset + done; setProgress(progress_); });
     os << "\t</consensusElementList>\n";
 
     os << "</consensusXML>\n";
@@ -920,6 +903,7 @@ namespace OpenMS
     //reset members
     consensus_map_ = nullptr;
     act_cons_element_ = ConsensusFeature();
+    act_cons_handles_.clear();
     pos_.clear();
     it_ = 0;
     last_meta_ = nullptr;
@@ -936,20 +920,65 @@ namespace OpenMS
     map.updateRanges();
   }
 
+  void
+  ConsensusXMLFile::writeConsensusElement_(const String& filename, std::ostream& os, const ConsensusFeature& elem)
+  {
+    os << "\t\t<consensusElement id=\"e_" << elem.getUniqueId() << "\" quality=\"" << precisionWrapper(elem.getQuality()) << "\"";
+    if (elem.getCharge() != 0)
+    {
+      os << " charge=\"" << elem.getCharge() << "\"";
+    }
+    os << ">\n";
+    // write centroid
+    os << "\t\t\t<centroid rt=\"" << precisionWrapper(elem.getRT()) << "\" mz=\"" << precisionWrapper(elem.getMZ()) << "\" it=\"" << precisionWrapper(
+      elem.getIntensity()) << "\"/>\n";
+    // write groupedElementList
+    os << "\t\t\t<groupedElementList>\n";
+    for (ConsensusFeature::HandleSetType::const_iterator it = elem.begin(); it != elem.end(); ++it)
+    {
+      os << "\t\t\t\t<element"
+            " map=\"" << it->getMapIndex() << "\""
+                                              " id=\"" << it->getUniqueId() << "\""
+                                                                               " rt=\"" << precisionWrapper(it->getRT()) << "\""
+                                                                                                                            " mz=\"" << precisionWrapper(it->getMZ()) << "\""
+                                                                                                                                                                         " it=\"" << precisionWrapper(it->getIntensity()) << "\"";
+      if (it->getCharge() != 0)
+      {
+        os << " charge=\"" << it->getCharge() << "\"";
+      }
+      os << "/>\n";
+    }
+    os << "\t\t\t</groupedElementList>\n";
+
+    // write PeptideIdentification
+    for (UInt j = 0; j < elem.getPeptideIdentifications().size(); ++j)
+    {
+      writePeptideIdentification_(filename, os, elem.getPeptideIdentifications()[j], "PeptideIdentification", 3);
+    }
+
+    writeUserParam_("UserParam", os, elem, 3);
+    os << "\t\t</consensusElement>\n";
+  }
+
   void
   ConsensusXMLFile::writePeptideIdentification_(const String& filename, std::ostream& os, const PeptideIdentification& id, const String& tag_name,
                                                 UInt indentation_level)
   {
     String indent = String(indentation_level, '\t');
 
-    if (!identifier_id_.has(id.getIdentifier()))
+    // only lookups in the member maps, since this is called from several threads (see store())
+    Map<String, String>::const_iterator run_it = identifier_id_.find(id.getIdentifier());
+    if (run_it == identifier_id_.end())
     {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_ConsensusXMLFile_warning)
+#endif
       warning(STORE, String("Omitting peptide identification because of missing ProteinIdentification with identifier '") + id.getIdentifier()
               + "' while writing '" + filename + "'!");
       return;
     }
     os << indent << "<" << tag_name << " ";
-    os << "identification_run_ref=\"" << identifier_id_[id.getIdentifier()] << "\" ";
+    os << "identification_run_ref=\"" << run_it->second << "\" ";
     os << "score_type=\"" << writeXMLEscape(id.getScoreType()) << "\" ";
     os << "higher_score_better=\"" << (id.isHigherScoreBetter() ? "true" : "false") << "\" ";
     os << "significance_threshold=\"" << id.getSignificanceThreshold() << "\" ";
@@ -996,8 +1025,9 @@ namespace OpenMS
         // empty accessions are not written out (legacy code)
         if (!protein_accession.empty())
         {
+          Map<String, Size>::const_iterator acc_it = accession_to_id_.find(id.getIdentifier() + "_" + protein_accession);
           accs += "PH_";
-          accs += String(accession_to_id_[id.getIdentifier() + "_" + protein_accession]);
+          accs += String(acc_it != accession_to_id_.end() ? acc_it->second : 0);
         }
       }
 
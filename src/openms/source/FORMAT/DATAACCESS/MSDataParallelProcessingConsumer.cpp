@@ -0,0 +1,128 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelProcessingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+
+namespace OpenMS
+{
+
+  MSDataParallelProcessingConsumer::MSDataParallelProcessingConsumer(Interfaces::IMSDataConsumer* next_consumer,
+                                                                     const ParallelExperimentProcessor& processor,
+                                                                     Size buffer_size) :
+    next_consumer_(next_consumer),
+    processor_(processor),
+    buffer_size_(std::max(buffer_size, Size(1)))
+  {
+    spectra_buffer_.reserve(buffer_size_);
+  }
+
+  MSDataParallelProcessingConsumer::~MSDataParallelProcessingConsumer()
+  {
+    try
+    {
+      flush();
+    }
+    catch (const std::exception& e)
+    {
+      OPENMS_LOG_ERROR << "MSDataParallelProcessingConsumer: could not flush the remaining data: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      OPENMS_LOG_ERROR << "MSDataParallelProcessingConsumer: could not flush the remaining data." << std::endl;
+    }
+  }
+
+  void MSDataParallelProcessingConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataParallelProcessingConsumer::setExperimentalSettings(const ExperimentalSettings& exp)
+  {
+    next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataParallelProcessingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    // keep the order in which spectra and chromatograms arrive
+    flushChromatograms_();
+
+    spectra_buffer_.push_back(s);
+    if (spectra_buffer_.size() >= buffer_size_) flushSpectra_();
+  }
+
+  void MSDataParallelProcessingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    // keep the order in which spectra and chromatograms arrive
+    flushSpectra_();
+
+    chromatograms_buffer_.push_back(c);
+    if (chromatograms_buffer_.size() >= buffer_size_) flushChromatograms_();
+  }
+
+  void MSDataParallelProcessingConsumer::flush()
+  {
+    // at most one of the buffers is non-empty
+    flushSpectra_();
+    flushChromatograms_();
+  }
+
+  void MSDataParallelProcessingConsumer::flushSpectra_()
+  {
+    if (spectra_buffer_.empty()) return;
+
+    processor_.processSpectra(spectra_buffer_);
+    for (SpectrumType& s : spectra_buffer_)
+    {
+      next_consumer_->consumeSpectrum(s);
+    }
+    spectra_buffer_.clear();
+  }
+
+  void MSDataParallelProcessingConsumer::flushChromatograms_()
+  {
+    if (chromatograms_buffer_.empty()) return;
+
+    processor_.processChromatograms(chromatograms_buffer_);
+    for (ChromatogramType& c : chromatograms_buffer_)
+    {
+      next_consumer_->consumeChromatogram(c);
+    }
+    chromatograms_buffer_.clear();
+  }
+
+} // namespace OpenMS
+
@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DelimitedTextReader.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/StringUtils.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QFile>
+
+#include <fstream>
+#include <iterator>
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    inline bool isSpace(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    // strip leading and trailing whitespace
+    inline void trim(const char*& begin, const char*& end)
+    {
+      while (begin != end && isSpace(*begin)) ++begin;
+      while (end != begin && isSpace(*(end - 1))) --end;
+    }
+  }
+
+  DelimitedTextReader::DelimitedTextReader(const String& filename, char delimiter) :
+    file_(new QFile(filename.toQString())),
+    pos_(nullptr),
+    end_(nullptr),
+    delimiter_(delimiter),
+    line_number_(0)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    if (!file_->open(QIODevice::ReadOnly))
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const qint64 size = file_->size();
+    if (size == 0)
+    {
+      return;
+    }
+
+    uchar* data = file_->map(0, size);
+    if (data != nullptr)
+    {
+      pos_ = reinterpret_cast<const char*>(data);
+      end_ = pos_ + size;
+      return;
+    }
+
+    // mapping is not possible (e.g. for some special files): fall back to reading the content
+    file_->close();
+    std::ifstream is(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!is)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    pos_ = buffer_.data();
+    end_ = pos_ + buffer_.size();
+  }
+
+  DelimitedTextReader::~DelimitedTextReader()
+  {
+    // QFile::close() also unmaps all mapped regions
+  }
+
+  bool DelimitedTextReader::readLine()
+  {
+    fields_.clear();
+    if (pos_ == end_)
+    {
+      line_ = StringView();
+      return false;
+    }
+
+    // find the line ending (\n, \r\n or \r) and split at the delimiter on the way
+    const char* line_begin = pos_;
+    const char* field_begin = pos_;
+    const char* it = pos_;
+    for (; it != end_ && *it != '\n' && *it != '\r'; ++it)
+    {
+      if (*it == delimiter_)
+      {
+        fields_.push_back(StringView(field_begin, it - field_begin));
+        field_begin = it + 1;
+      }
+    }
+    fields_.push_back(StringView(field_begin, it - field_begin));
+    line_ = StringView(line_begin, it - line_begin);
+
+    // consume the line ending
+    if (it != end_)
+    {
+      if (*it == '\r' && it + 1 != end_ && *(it + 1) == '\n') ++it;
+      ++it;
+    }
+    pos_ = it;
+    ++line_number_;
+    return true;
+  }
+
+  const StringView& DelimitedTextReader::line() const
+  {
+    return line_;
+  }
+
+  const std::vector<StringView>& DelimitedTextReader::fields() const
+  {
+    return fields_;
+  }
+
+  Size DelimitedTextReader::getLineNumber() const
+  {
+    return line_number_;
+  }
+
+  void DelimitedTextReader::setDelimiter(char delimiter)
+  {
+    delimiter_ = delimiter;
+  }
+
+  char DelimitedTextReader::getDelimiter() const
+  {
+    return delimiter_;
+  }
+
+  double DelimitedTextReader::toDouble(const StringView& s)
+  {
+    const char* begin = s.begin();
+    const char* end = s.end();
+    trim(begin, end);
+    double result;
+    if (begin == end || !StringUtils::extractDouble(begin, end, result) || begin != end)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert string '") + s.getString() + "' to a double value");
+    }
+    return result;
+  }
+
+  Int DelimitedTextReader::toInt(const StringView& s)
+  {
+    const char* begin = s.begin();
+    const char* end = s.end();
+    trim(begin, end);
+    Int result;
+    if (begin == end || !boost::spirit::qi::parse(begin, end, boost::spirit::qi::int_, result) || begin != end)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert string '") + s.getString() + "' to an integer value");
+    }
+    return result;
+  }
+
+} // namespace OpenMS
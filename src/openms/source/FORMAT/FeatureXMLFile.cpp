@@ -307,12 +307,10 @@ namespace OpenMS
     // write features with their corresponding attributes
     os << "\t<featureList count=\"" << feature_map.size() << "\">\n";
     startProgress(0, feature_map.size(), "Storing featureXML file");
-    for (Size s = 0; s < feature_map.size(); s++)
-    {
-      writeFeature_(filename, os, feature_map[s], "f_", feature_map[s].getUniqueId(), 0);
-      setProgress(s);
-      // writeFeature_(filename, os, feature_map[s], "f_", s, 0);
-    }
+    // features are serialized in parallel, the output is identical to writing them one by one
+    writeElementsParallel_(os, feature_map.size(),
+      [&](std::ostream& chunk, Size s) { writeFeature_(filename, chunk, feature_map[s], "f_", feature_map[s].getUniqueId(), 0); },
+      [&](Size done) { setProgress(done); });
     endProgress();
 
     os << "\t</featureList>\n";
@@ -348,6 +346,12 @@ namespace OpenMS
     static const XMLCh* s_completion_time = xercesc::XMLString::transcode("completion_time");
     static const XMLCh* s_document_id = xercesc::XMLString::transcode("document_id");
     static const XMLCh* s_id = xercesc::XMLString::transcode("id");
+    static const XMLCh* s_x = xercesc::XMLString::transcode("x");
+    static const XMLCh* s_y = xercesc::XMLString::transcode("y");
+    static const XMLCh* s_charge = xercesc::XMLString::transcode("charge");
+    static const XMLCh* s_score = xercesc::XMLString::transcode("score");
+    static const XMLCh* s_sequence = xercesc::XMLString::transcode("sequence");
+    static const XMLCh* s_protein_refs = xercesc::XMLString::transcode("protein_refs");
 
     // TODO The next line should be removed in OpenMS 1.7 or so!
     static const XMLCh* s_unique_id = xercesc::XMLString::transcode("unique_id");
@@ -409,8 +413,8 @@ namespace OpenMS
     }
     else if (tag == "pt")
     {
-      hull_position_[0] = attributeAsDouble_(attributes, "x");
-      hull_position_[1] = attributeAsDouble_(attributes, "y");
+      hull_position_[0] = attributeAsDouble_(attributes, s_x);
+      hull_position_[1] = attributeAsDouble_(attributes, s_y);
     }
     else if (tag == "convexhull")
     {
@@ -685,12 +689,12 @@ namespace OpenMS
       pep_hit_ = PeptideHit();
       vector<PeptideEvidence> peptide_evidences_;
 
-      pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
-      pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setCharge(attributeAsInt_(attributes, s_charge));
+      pep_hit_.setScore(attributeAsDouble_(attributes, s_score));
+      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, s_sequence))));
 
       //parse optional protein ids to determine accessions
-      const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
+      const XMLCh* refs = attributes.getValue(s_protein_refs);
       if (refs != nullptr)
       {
         String accession_string = sm_.convert(refs);
@@ -1039,13 +1043,18 @@ namespace OpenMS
   {
     String indent = String(indentation_level, '\t');
 
-    if (!identifier_id_.has(id.getIdentifier()))
+    // only lookups in the member maps, since this is called from several threads (see store())
+    Map<String, String>::const_iterator run_it = identifier_id_.find(id.getIdentifier());
+    if (run_it == identifier_id_.end())
     {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_FeatureXMLFile_warning)
+#endif
       warning(STORE, String("Omitting peptide identification because of missing ProteinIdentification with identifier '") + id.getIdentifier() + "' while writing '" + filename + "'!");
       return;
     }
     os << indent << "<" << tag_name << " ";
-    os << "identification_run_ref=\"" << identifier_id_[id.getIdentifier()] << "\" ";
+    os << "identification_run_ref=\"" << run_it->second << "\" ";
     os << "score_type=\"" << writeXMLEscape(id.getScoreType()) << "\" ";
     os << "higher_score_better=\"" << (id.isHigherScoreBetter() ? "true" : "false") << "\" ";
     os << "significance_threshold=\"" << id.getSignificanceThreshold() << "\" ";
@@ -1093,8 +1102,9 @@ namespace OpenMS
         // empty accessions are not written out (legacy code)
         if (!protein_accession.empty())
         {
+          Map<String, Size>::const_iterator acc_it = accession_to_id_.find(id.getIdentifier() + "_" + protein_accession);
           accs += "PH_";
-          accs += String(accession_to_id_[id.getIdentifier() + "_" + protein_accession]);
+          accs += String(acc_it != accession_to_id_.end() ? acc_it->second : 0);
         }
       }
 
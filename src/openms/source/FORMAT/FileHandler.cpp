@@ -39,6 +39,9 @@
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/OMSBinFile.h>
 #include <OpenMS/FORMAT/MzDataFile.h>
 #include <OpenMS/FORMAT/MascotGenericFile.h>
 #include <OpenMS/FORMAT/MS2File.h>
@@ -107,6 +110,21 @@ namespace OpenMS
     return FileTypes::nameToType(tmp);
   }
 
+  FileTypes::Type FileHandler::getXMLEquivalentType(const String& filename)
+  {
+    FileTypes::Type type = getType(filename);
+    if (type == FileTypes::OMSBIN)
+    {
+      switch (OMSBinFile::getContentType(filename))
+      {
+        case OMSBinFile::FEATURES: return FileTypes::FEATUREXML;
+        case OMSBinFile::CONSENSUS: return FileTypes::CONSENSUSXML;
+        case OMSBinFile::IDENTIFICATIONS: return FileTypes::IDXML;
+      }
+    }
+    return type;
+  }
+
   bool FileHandler::hasValidExtension(const String& filename, const FileTypes::Type type)
   {
     FileTypes::Type ft = FileHandler::getTypeByFileName(filename);
@@ -135,6 +153,12 @@ namespace OpenMS
     // so far, compression is only supported for XML files
     vector<String> complete_file;
 
+    // binary files (checked first, the text based detection below cannot handle them)
+    if (OMSBinFile::isOMSBinFile(filename))
+    {
+      return FileTypes::OMSBIN;
+    }
+
     // test whether the file is compressed (bzip2 or gzip)
     ifstream compressed_file(filename.c_str());
     char bz[2];
@@ -476,6 +500,21 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     options_ = options;
   }
 
+  FeatureFileOptions& FileHandler::getFeatOptions()
+  {
+    return feature_options_;
+  }
+
+  const FeatureFileOptions& FileHandler::getFeatOptions() const
+  {
+    return feature_options_;
+  }
+
+  void FileHandler::setFeatOptions(const FeatureFileOptions& options)
+  {
+    feature_options_ = options;
+  }
+
   String FileHandler::computeFileHash(const String& filename)
   {
     QCryptographicHash crypto(QCryptographicHash::Sha1);
@@ -488,7 +527,7 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     return String((QString)crypto.result().toHex());
   }
 
-  bool FileHandler::loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type)
+  bool FileHandler::loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type, ProgressLogger::LogType log)
   {
     //determine file type
     FileTypes::Type type;
@@ -511,7 +550,10 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     //load right file
     if (type == FileTypes::FEATUREXML)
     {
-      FeatureXMLFile().load(filename, map);
+      FeatureXMLFile f;
+      f.getOptions() = feature_options_;
+      f.setLogType(log);
+      f.load(filename, map);
     }
     else if (type == FileTypes::TSV)
     {
@@ -525,6 +567,69 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     {
       KroenikFile().load(filename, map);
     }
+    else if (type == FileTypes::OMSBIN)
+    {
+      OMSBinFile f;
+      f.setLogType(log);
+      f.load(filename, map);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  void FileHandler::storeFeatures(const String& filename, const FeatureMap& map, ProgressLogger::LogType log)
+  {
+    if (getTypeByFileName(filename) == FileTypes::OMSBIN)
+    {
+      OMSBinFile f;
+      f.setLogType(log);
+      f.store(filename, map);
+    }
+    else
+    {
+      FeatureXMLFile f;
+      f.setLogType(log);
+      f.store(filename, map);
+    }
+  }
+
+  bool FileHandler::loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type, ProgressLogger::LogType log)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch ( Exception::FileNotFound& )
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::CONSENSUSXML)
+    {
+      ConsensusXMLFile f;
+      f.setLogType(log);
+      f.load(filename, map);
+    }
+    else if (type == FileTypes::OMSBIN)
+    {
+      OMSBinFile f;
+      f.setLogType(log);
+      f.load(filename, map);
+    }
     else
     {
       return false;
@@ -533,6 +638,71 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     return true;
   }
 
+  void FileHandler::storeConsensusFeatures(const String& filename, const ConsensusMap& map, ProgressLogger::LogType log)
+  {
+    if (getTypeByFileName(filename) == FileTypes::OMSBIN)
+    {
+      OMSBinFile f;
+      f.setLogType(log);
+      f.store(filename, map);
+    }
+    else
+    {
+      ConsensusXMLFile f;
+      f.setLogType(log);
+      f.store(filename, map);
+    }
+  }
+
+  bool FileHandler::loadIdentifications(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, FileTypes::Type force_type)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch ( Exception::FileNotFound& )
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::IDXML)
+    {
+      IdXMLFile().load(filename, protein_ids, peptide_ids);
+    }
+    else if (type == FileTypes::OMSBIN)
+    {
+      OMSBinFile().load(filename, protein_ids, peptide_ids);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  void FileHandler::storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    if (getTypeByFileName(filename) == FileTypes::OMSBIN)
+    {
+      OMSBinFile().store(filename, protein_ids, peptide_ids);
+    }
+    else
+    {
+      IdXMLFile().store(filename, protein_ids, peptide_ids);
+    }
+  }
+
   bool FileHandler::loadExperiment(const String& filename, PeakMap& exp, FileTypes::Type force_type, ProgressLogger::LogType log, const bool rewrite_source_file, const bool compute_hash)
   {
     // setting the flag for hash recomputation only works if source file entries are rewritten
@@ -37,6 +37,18 @@
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLDecoder.h>
 #include <OpenMS/FORMAT/HANDLERS/MzMLSpectrumDecoder.h>
 
+#include <algorithm>
+#include <exception>
+
+#ifndef OPENMS_WINDOWSPLATFORM
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // #define DEBUG_READER
 
 namespace OpenMS
@@ -70,6 +82,7 @@ namespace Internal
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler(const String& filename) :
+    fd_(-1),
     parsing_success_(false),
     skip_xml_checks_(false) 
   {
@@ -77,6 +90,7 @@ namespace Internal
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler() :
+    fd_(-1),
     parsing_success_(false),
     skip_xml_checks_(false) 
   {}
@@ -87,27 +101,80 @@ namespace Internal
     chromatograms_offsets_(source.chromatograms_offsets_),
     index_offset_(source.index_offset_),
     spectra_before_chroms_(source.spectra_before_chroms_),
-    // do not copy the filestream itself but open a new filestream using the same file
-    // this is critical for parallel access to the same file!
-    filestream_(source.filename_.c_str()),
+    fd_(-1),
     parsing_success_(source.parsing_success_),
     skip_xml_checks_(source.skip_xml_checks_)
   {
+    // do not copy the file handles but open the same file again
+    openStreams_(source.filename_);
   }
 
   IndexedMzMLHandler::~IndexedMzMLHandler()
   {
+#ifndef OPENMS_WINDOWSPLATFORM
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+    }
+#endif
   }
 
   void IndexedMzMLHandler::openFile(String filename) 
   {
+    filename_ = filename;
+    openStreams_(filename);
+    parseFooter_(filename);
+  }
+
+  void IndexedMzMLHandler::openStreams_(const String& filename)
+  {
+#ifndef OPENMS_WINDOWSPLATFORM
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+    }
+    fd_ = filename.empty() ? -1 : ::open(filename.c_str(), O_RDONLY);
+#else
     if (filestream_.is_open())
     {
       filestream_.close();
     }
-    filename_ = filename;
-    filestream_.open(filename.c_str());
-    parseFooter_(filename);
+    filestream_.clear();
+    filestream_.open(filename.c_str(), std::ios::binary);
+#endif
+  }
+
+  std::string IndexedMzMLHandler::readRange_(std::streampos start, std::streampos end)
+  {
+    std::string text(static_cast<Size>(end - start), '\0');
+    Size bytes_read(0);
+#ifndef OPENMS_WINDOWSPLATFORM
+    // positioned reads do not touch a shared file pointer -> no locking needed
+    while (fd_ >= 0 && bytes_read < text.size())
+    {
+      ssize_t res = ::pread(fd_, &text[bytes_read], text.size() - bytes_read, static_cast<off_t>(start) + bytes_read);
+      if (res <= 0) break; // error or end of file
+      bytes_read += res;
+    }
+#else
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_IndexedMzMLHandler_read)
+#endif
+    {
+      filestream_.clear();
+      filestream_.seekg(start, filestream_.beg);
+      filestream_.read(&text[0], text.size());
+      bytes_read = filestream_.gcount();
+    }
+#endif
+    text.resize(bytes_read);
+    // stop at the first NUL character (like reading into a C string)
+    Size nul = text.find('\0');
+    if (nul != std::string::npos)
+    {
+      text.resize(nul);
+    }
+    return text;
   }
 
   bool IndexedMzMLHandler::getParsingSuccess() const
@@ -169,13 +236,7 @@ namespace Internal
       endidx = chromatograms_offsets_[chromToGet + 1].second;
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+    std::string text = readRange_(startidx, endidx);
 
 #ifdef DEBUG_READER
     // print the full text we just read
@@ -185,7 +246,7 @@ namespace Internal
     return text;
   }
 
-  std::string IndexedMzMLHandler::getSpectrumById_helper_(int id)
+  void IndexedMzMLHandler::getSpectrumRange_(int id, std::streampos& startidx, std::streampos& endidx) const
   {
     int spectrumToGet = id;
 
@@ -206,9 +267,6 @@ namespace Internal
             + " maximal allowed is " + String(getNrSpectra()) ));
     }
 
-    std::streampos startidx = -1;
-    std::streampos endidx = -1;
-
     if (spectrumToGet == int(getNrSpectra() - 1))
     {
       startidx = spectra_offsets_[spectrumToGet].second;
@@ -228,14 +286,15 @@ namespace Internal
       startidx = spectra_offsets_[spectrumToGet].second;
       endidx = spectra_offsets_[spectrumToGet + 1].second;
     }
+  }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+  std::string IndexedMzMLHandler::getSpectrumById_helper_(int id)
+  {
+    std::streampos startidx = -1;
+    std::streampos endidx = -1;
+    getSpectrumRange_(id, startidx, endidx);
+
+    std::string text = readRange_(startidx, endidx);
 
 #ifdef DEBUG_READER
     // print the full text we just read
@@ -253,6 +312,46 @@ namespace Internal
     return sptr;
   }
 
+  std::string IndexedMzMLHandler::getSpectrumXMLById(int id)
+  {
+    return IndexedMzMLHandler::getSpectrumById_helper_(id);
+  }
+
+  std::string IndexedMzMLHandler::getSpectrumHeaderXMLById(int id)
+  {
+    std::streampos startidx = -1;
+    std::streampos endidx = -1;
+    getSpectrumRange_(id, startidx, endidx);
+
+    // read in growing chunks until the data arrays start (the meta data
+    // usually fits into the first chunk)
+    const std::string data_tag = "<binaryDataArrayList";
+    std::string text;
+    std::streamoff chunk = 4096;
+    std::streampos pos = startidx;
+    while (pos < endidx)
+    {
+      std::streampos chunk_end = std::min(endidx, pos + chunk);
+      std::string part = readRange_(pos, chunk_end);
+      // the tag may start in the previous chunk
+      Size search_from = text.size() > data_tag.size() ? text.size() - data_tag.size() : 0;
+      text += part;
+      Size data_start = text.find(data_tag, search_from);
+      if (data_start != std::string::npos)
+      {
+        text.resize(data_start);
+        break;
+      }
+      if (part.size() < static_cast<Size>(chunk_end - pos)) // end of file
+      {
+        break;
+      }
+      pos = chunk_end;
+      chunk *= 2;
+    }
+    return text;
+  }
+
   const OpenMS::MSSpectrum IndexedMzMLHandler::getMSSpectrumById(int id)
   {
     OpenMS::MSSpectrum s;
@@ -266,6 +365,31 @@ namespace Internal
     MzMLSpectrumDecoder(skip_xml_checks_).domParseSpectrum(text, s);
   }
 
+  void IndexedMzMLHandler::getMSSpectraById(const std::vector<int>& ids, std::vector<MSSpectrum>& spectra)
+  {
+    spectra.resize(ids.size());
+
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
+    {
+      try
+      {
+        getMSSpectrumById(ids[i], spectra[i]);
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_IndexedMzMLHandler_error)
+#endif
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
   OpenMS::Interfaces::ChromatogramPtr IndexedMzMLHandler::getChromatogramById(int id)
   {
     OpenMS::Interfaces::ChromatogramPtr cptr(new OpenMS::Interfaces::Chromatogram);
@@ -0,0 +1,315 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Mathias Walzer $
+// $Authors: Mathias Walzer $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLFragmentHandler.h>
+
+#include <xercesc/dom/DOMImplementationRegistry.hpp>
+
+using namespace std;
+using namespace xercesc;
+
+namespace OpenMS
+{
+  namespace Internal
+  {
+    namespace
+    {
+      // released nodes are recycled by Xerces, but attribute values and text are
+      // only freed together with their document: start a new one after this many characters
+      const Size MAX_SCRATCH_DOCUMENT_CHARS = 1 << 22;
+
+      DOMDocument* createScratchDocument()
+      {
+        StringManager sm;
+        DOMImplementation* impl = DOMImplementationRegistry::getDOMImplementation(sm.convert("Core").c_str());
+        return impl->createDocument(nullptr, sm.convert("MzIdentML").c_str(), nullptr);
+      }
+    }
+
+    MzIdentMLFragmentHandler::MzIdentMLFragmentHandler(vector<ProteinIdentification>& pro_id, vector<PeptideIdentification>& pep_id, const String& filename, const String& version, const ProgressLogger& logger) :
+      XMLHandler(filename, version),
+      converter_(pro_id, pep_id, version, logger),
+      doc_(nullptr),
+      holder_(nullptr),
+      fragment_(),
+      list_shell_(nullptr),
+      deferred_si_(),
+      deferred_sip_(),
+      deferred_done_(false),
+      spectra_data_count_(0),
+      sil_count_(0),
+      doc_chars_(0),
+      xl_ms_search_(false)
+    {
+      // the converter has initialized Xerces already
+      doc_ = createScratchDocument();
+      holder_ = doc_->getDocumentElement();
+    }
+
+    MzIdentMLFragmentHandler::~MzIdentMLFragmentHandler()
+    {
+      // before the converter terminates Xerces
+      doc_->release();
+    }
+
+    bool MzIdentMLFragmentHandler::isCrossLinkingSearch() const
+    {
+      return xl_ms_search_;
+    }
+
+    bool MzIdentMLFragmentHandler::isFragmentRoot_(const String& tag, const String& parent)
+    {
+      if (parent == "SequenceCollection") return tag == "DBSequence" || tag == "Peptide" || tag == "PeptideEvidence";
+      if (parent == "SpectrumIdentificationList") return tag == "SpectrumIdentificationResult";
+      if (parent == "ProteinDetectionList") return tag == "ProteinAmbiguityGroup";
+      if (parent == "Inputs") return tag == "SpectraData" || tag == "SearchDatabase" || tag == "SourceFile";
+      if (parent == "AnalysisSoftwareList") return tag == "AnalysisSoftware";
+      if (parent == "AnalysisCollection") return tag == "SpectrumIdentification";
+      if (parent == "AnalysisProtocolCollection") return tag == "SpectrumIdentificationProtocol";
+      return false;
+    }
+
+    DOMElement* MzIdentMLFragmentHandler::createElement_(const XMLCh* const qname, const Attributes& attributes)
+    {
+      DOMElement* element = doc_->createElement(qname);
+      for (XMLSize_t i = 0; i < attributes.getLength(); ++i)
+      {
+        element->setAttribute(attributes.getQName(i), attributes.getValue(i));
+        doc_chars_ += XMLString::stringLen(attributes.getValue(i));
+      }
+      return element;
+    }
+
+    void MzIdentMLFragmentHandler::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const Attributes& attributes)
+    {
+      String tag = sm_.convert(qname);
+      String parent = open_tags_.empty() ? String() : open_tags_.back();
+      open_tags_.push_back(tag);
+
+      if (tag == "cvParam" && parent == "AdditionalSearchParams")
+      {
+        String accession;
+        if (optionalAttributeAsString_(accession, attributes, "accession") && accession == "MS:1002494") // cross-linking search
+        {
+          // the peptides were converted without the cross-link information already
+          xl_ms_search_ = true;
+          throw EndParsingSoftly(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        }
+      }
+
+      if (!fragment_.empty()) // inside of a fragment: copy the element
+      {
+        DOMElement* element = createElement_(qname, attributes);
+        fragment_.back()->appendChild(element);
+        fragment_.push_back(element);
+      }
+      else if (isFragmentRoot_(tag, parent))
+      {
+        DOMElement* element = createElement_(qname, attributes);
+        (list_shell_ != nullptr ? list_shell_ : holder_)->appendChild(element);
+        fragment_.push_back(element);
+        if (tag == "SpectraData") ++spectra_data_count_;
+      }
+      else if (parent == "AnalysisData" && (tag == "SpectrumIdentificationList" || tag == "ProteinDetectionList"))
+      {
+        // the results need the identification runs
+        convertDeferred_();
+        if (tag == "SpectrumIdentificationList") ++sil_count_;
+        // the results are converted one at a time as children of an attribute-only copy of the list
+        list_shell_ = createElement_(qname, attributes);
+        holder_->appendChild(list_shell_);
+      }
+    }
+
+    void MzIdentMLFragmentHandler::endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname)
+    {
+      open_tags_.pop_back();
+
+      if (!fragment_.empty())
+      {
+        DOMElement* element = fragment_.back();
+        fragment_.pop_back();
+        if (fragment_.empty()) // fragment complete
+        {
+          String tag = sm_.convert(qname);
+          if (tag == "SpectrumIdentification")
+          {
+            deferred_si_.push_back(static_cast<DOMElement*>(holder_->removeChild(element)));
+          }
+          else if (tag == "SpectrumIdentificationProtocol")
+          {
+            deferred_sip_.push_back(static_cast<DOMElement*>(holder_->removeChild(element)));
+          }
+          else
+          {
+            convert_(tag);
+          }
+        }
+        return;
+      }
+
+      String tag = sm_.convert(qname);
+      if (list_shell_ != nullptr && (tag == "SpectrumIdentificationList" || tag == "ProteinDetectionList"))
+      {
+        holder_->removeChild(list_shell_)->release();
+        list_shell_ = nullptr;
+      }
+      else if (tag == "MzIdentML")
+      {
+        convertDeferred_();
+        if (sil_count_ == 0)
+        {
+          fatalError(LOAD, "No SpectrumIdentificationList nodes");
+        }
+        for (vector<ProteinIdentification>::iterator it = converter_.pro_id_->begin(); it != converter_.pro_id_->end(); ++it)
+        {
+          it->sort();
+        }
+      }
+    }
+
+    void MzIdentMLFragmentHandler::characters(const XMLCh* const chars, const XMLSize_t length)
+    {
+      if (fragment_.empty()) return;
+
+      // Xerces may report the text of one element in several chunks
+      const basic_string<XMLCh> text(chars, length);
+      DOMNode* last = fragment_.back()->getLastChild();
+      if (last != nullptr && last->getNodeType() == DOMNode::TEXT_NODE)
+      {
+        dynamic_cast<DOMText*>(last)->appendData(text.c_str());
+      }
+      else
+      {
+        fragment_.back()->appendChild(doc_->createTextNode(text.c_str()));
+      }
+      doc_chars_ += length;
+    }
+
+    void MzIdentMLFragmentHandler::convert_(const String& tag)
+    {
+      DOMNodeList* nodes = holder_->getChildNodes();
+      if (tag == "SpectrumIdentificationResult")
+      {
+        converter_.parseSpectrumIdentificationListElements_(nodes);
+      }
+      else if (tag == "DBSequence")
+      {
+        converter_.parseDBSequenceElements_(nodes);
+      }
+      else if (tag == "Peptide")
+      {
+        converter_.parsePeptideElements_(nodes);
+      }
+      else if (tag == "PeptideEvidence")
+      {
+        converter_.parsePeptideEvidenceElements_(nodes);
+      }
+      else if (tag == "ProteinAmbiguityGroup")
+      {
+        converter_.parseProteinDetectionListElements_(nodes);
+      }
+      else if (tag == "AnalysisSoftware")
+      {
+        converter_.parseAnalysisSoftwareList_(nodes);
+      }
+      else // SpectraData, SearchDatabase, SourceFile
+      {
+        converter_.parseInputElements_(nodes);
+      }
+
+      DOMElement* parent = list_shell_ != nullptr ? list_shell_ : holder_;
+      while (DOMNode* child = parent->getFirstChild())
+      {
+        parent->removeChild(child)->release();
+      }
+      recycleDocument_();
+    }
+
+    void MzIdentMLFragmentHandler::convertDeferred_()
+    {
+      if (deferred_done_) return;
+      deferred_done_ = true;
+
+      if (spectra_data_count_ == 0) fatalError(LOAD, "No SpectraData nodes");
+      if (deferred_si_.empty()) fatalError(LOAD, "No SpectrumIdentification nodes");
+      if (deferred_sip_.empty()) fatalError(LOAD, "No SpectrumIdentificationProtocol nodes");
+
+      // same order as in MzIdentMLDOMHandler::readMzIdentMLFile: runs first, then their parameters
+      for (Size i = 0; i < 2; ++i)
+      {
+        vector<DOMElement*>& deferred = (i == 0) ? deferred_si_ : deferred_sip_;
+        for (vector<DOMElement*>::iterator it = deferred.begin(); it != deferred.end(); ++it)
+        {
+          holder_->appendChild(*it);
+        }
+        if (i == 0)
+        {
+          converter_.parseSpectrumIdentificationElements_(holder_->getChildNodes());
+        }
+        else
+        {
+          converter_.parseSpectrumIdentificationProtocolElements_(holder_->getChildNodes());
+        }
+        for (vector<DOMElement*>::iterator it = deferred.begin(); it != deferred.end(); ++it)
+        {
+          holder_->removeChild(*it)->release();
+        }
+        deferred.clear();
+      }
+    }
+
+    void MzIdentMLFragmentHandler::recycleDocument_()
+    {
+      if (doc_chars_ < MAX_SCRATCH_DOCUMENT_CHARS || !fragment_.empty() || !deferred_si_.empty() || !deferred_sip_.empty())
+      {
+        return;
+      }
+      DOMDocument* doc = createScratchDocument();
+      DOMElement* holder = doc->getDocumentElement();
+      DOMElement* list_shell = nullptr;
+      if (list_shell_ != nullptr)
+      {
+        list_shell = static_cast<DOMElement*>(doc->importNode(list_shell_, false)); // copies the attributes
+        holder->appendChild(list_shell);
+      }
+      doc_->release();
+      doc_ = doc;
+      holder_ = holder;
+      list_shell_ = list_shell;
+      doc_chars_ = 0;
+    }
+
+  } // namespace Internal
+} // namespace OpenMS
@@ -180,6 +180,12 @@ namespace OpenMS
       // Append all spectra to experiment / consumer
       for (Size i = 0; i < spectrum_data_.size(); i++)
       {
+        // instrument settings, acquisition info and source file mostly repeat within a run:
+        // let consecutive spectra of the same MS level point to the same instance
+        SpectrumSettings& last = last_settings_[spectrum_data_[i].spectrum.getMSLevel()];
+        spectrum_data_[i].spectrum.shareSettings(last);
+        last = spectrum_data_[i].spectrum;
+
         if (consumer_ != nullptr)
         {
           consumer_->consumeSpectrum(spectrum_data_[i].spectrum);
@@ -304,7 +310,10 @@ namespace OpenMS
       typedef SpectrumType::PeakType PeakType;
 
       // decode all base64 arrays
-      MzMLHandlerHelper::decodeBase64Arrays(input_data, options_.getSkipXMLChecks());
+      // Peak1D stores single precision intensities: numpress intensities can be
+      // decoded into float directly unless an intensity range is checked on the
+      // double values below
+      MzMLHandlerHelper::decodeBase64Arrays(input_data, options_.getSkipXMLChecks(), !peak_file_options.hasIntensityRange());
 
       //look up the precision and the index of the intensity and m/z array
       bool mz_precision_64 = true;
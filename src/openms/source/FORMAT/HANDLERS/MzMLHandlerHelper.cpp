@@ -162,7 +162,7 @@ namespace OpenMS
     }
   }
 
-  void MzMLHandlerHelper::decodeBase64Arrays(std::vector<BinaryData>& data, const bool skipXMLCheck)
+  void MzMLHandlerHelper::decodeBase64Arrays(std::vector<BinaryData>& data, const bool skipXMLCheck, const bool np_intensity_32)
   {
     // decode all base64 arrays
     for (auto& bindata : data)
@@ -205,11 +205,21 @@ namespace OpenMS
           // decoder always works with 64 bit (takes std::vector<double>)
           MSNumpressCoder::NumpressConfig config;
           config.np_compression = bindata.np_compression;
-          MSNumpressCoder().decodeNP(bindata.base64, bindata.floats_64,  bindata.compression, config);
+          if (np_intensity_32 && bindata.unit_multiplier == 1.0 && bindata.meta.getName() == "intensity array")
+          {
+            // the caller stores intensities in single precision: round once
+            // while decoding instead of going through a double array
+            MSNumpressCoder().decodeNP(bindata.base64, bindata.floats_32, bindata.compression, config);
+            bindata.precision = BinaryData::PRE_32;
+          }
+          else
+          {
+            MSNumpressCoder().decodeNP(bindata.base64, bindata.floats_64,  bindata.compression, config);
 
-          // Next, ensure that we only look at the float array even if the
-          // mzML tags say 32 bit data (I am looking at you, proteowizard)
-          bindata.precision = BinaryData::PRE_64;
+            // Next, ensure that we only look at the float array even if the
+            // mzML tags say 32 bit data (I am looking at you, proteowizard)
+            bindata.precision = BinaryData::PRE_64;
+          }
         }
         else if (bindata.precision == BinaryData::PRE_64)
         {
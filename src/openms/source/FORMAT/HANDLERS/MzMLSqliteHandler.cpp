@@ -108,6 +108,9 @@ namespace OpenMS
 
       std::vector<int> cont_data; cont_data.resize(containers.size());
       std::map<Size,Size> sql_container_map;
+      // buffers are reused for all rows
+      std::string uncompressed;
+      std::vector<double> data;
       while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
       {
         Size id_orig = sqlite3_column_int( stmt, 0 );
@@ -142,10 +145,8 @@ namespace OpenMS
 
         // data_type is one of 0 = mz, 1 = int, 2 = rt
         // compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
-        std::vector<double> data;
         if (compression == 1)
         {
-          std::string uncompressed;
           OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
 
           void* byte_buffer = reinterpret_cast<void *>(&uncompressed[0]);
@@ -161,19 +162,21 @@ namespace OpenMS
         }
         else if (compression == 5)
         {
-          std::string uncompressed;
           OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
           MSNumpressCoder::NumpressConfig config;
           config.setCompression("linear");
-          MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+          data.resize(MSNumpressCoder::decodedSizeBound(uncompressed.size(), config.np_compression));
+          data.resize(MSNumpressCoder().decodeNPRaw(reinterpret_cast<const unsigned char*>(uncompressed.data()),
+                                                    uncompressed.size(), data.data(), data.size(), config));
         }
         else if (compression == 6)
         {
-          std::string uncompressed;
           OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
           MSNumpressCoder::NumpressConfig config;
           config.setCompression("slof");
-          MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+          data.resize(MSNumpressCoder::decodedSizeBound(uncompressed.size(), config.np_compression));
+          data.resize(MSNumpressCoder().decodeNPRaw(reinterpret_cast<const unsigned char*>(uncompressed.data()),
+                                                    uncompressed.size(), data.data(), data.size(), config));
         }
         else
         {
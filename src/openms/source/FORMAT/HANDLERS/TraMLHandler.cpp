@@ -75,6 +75,13 @@ namespace OpenMS
       static const XMLCh* s_fullName = xercesc::XMLString::transcode("fullName");
       static const XMLCh* s_version = xercesc::XMLString::transcode("version");
       static const XMLCh* s_URI = xercesc::XMLString::transcode("URI");
+      static const XMLCh* s_peptide_ref = xercesc::XMLString::transcode("peptideRef");
+      static const XMLCh* s_compound_ref = xercesc::XMLString::transcode("compoundRef");
+      static const XMLCh* s_location = xercesc::XMLString::transcode("location");
+      static const XMLCh* s_ref = xercesc::XMLString::transcode("ref");
+      static const XMLCh* s_software_ref = xercesc::XMLString::transcode("softwareRef");
+      static const XMLCh* s_average_mass_delta = xercesc::XMLString::transcode("averageMassDelta");
+      static const XMLCh* s_monoisotopic_mass_delta = xercesc::XMLString::transcode("monoisotopicMassDelta");
 
       tag_ = sm_.convert(qname);
       open_tags_.push_back(tag_);
@@ -193,12 +200,12 @@ namespace OpenMS
       {
         TargetedExperiment::Peptide::Modification mod;
         double avg_mass_delta(0), mono_mass_delta(0); // zero means no value
-        optionalAttributeAsDouble_(avg_mass_delta, attributes, "averageMassDelta");
-        optionalAttributeAsDouble_(mono_mass_delta, attributes, "monoisotopicMassDelta");
+        optionalAttributeAsDouble_(avg_mass_delta, attributes, s_average_mass_delta);
+        optionalAttributeAsDouble_(mono_mass_delta, attributes, s_monoisotopic_mass_delta);
         mod.avg_mass_delta = avg_mass_delta;
         mod.mono_mass_delta = mono_mass_delta;
 
-        mod.location = attributeAsInt_(attributes, "location") - 1; // TraML stores location starting with 1
+        mod.location = attributeAsInt_(attributes, s_location) - 1; // TraML stores location starting with 1
         actual_peptide_.mods.push_back(mod);
       }
       else if (tag_ == "Compound")
@@ -208,7 +215,7 @@ namespace OpenMS
       }
       else if (tag_ == "Prediction")
       {
-        actual_prediction_.software_ref = attributeAsString_(attributes, "softwareRef");
+        actual_prediction_.software_ref = attributeAsString_(attributes, s_software_ref);
         String contact_ref;
         if (optionalAttributeAsString_(contact_ref, attributes, "contactRef"))
         {
@@ -219,7 +226,7 @@ namespace OpenMS
       {
         actual_rt_ = TargetedExperiment::RetentionTime();
         String software_ref;
-        if (optionalAttributeAsString_(software_ref, attributes, "softwareRef"))
+        if (optionalAttributeAsString_(software_ref, attributes, s_software_ref))
         {
           actual_rt_.software_ref = software_ref;
         }
@@ -233,12 +240,12 @@ namespace OpenMS
           actual_transition_.setName(id);
         }
         String peptide_ref;
-        if (optionalAttributeAsString_(peptide_ref, attributes, "peptideRef"))
+        if (optionalAttributeAsString_(peptide_ref, attributes, s_peptide_ref))
         {
           actual_transition_.setPeptideRef(peptide_ref);
         }
         String compound_ref;
-        if (optionalAttributeAsString_(compound_ref, attributes, "compoundRef"))
+        if (optionalAttributeAsString_(compound_ref, attributes, s_compound_ref))
         {
           actual_transition_.setCompoundRef(compound_ref);
         }
@@ -264,11 +271,11 @@ namespace OpenMS
       {
         actual_sourcefile_.setNativeIDType(attributeAsString_(attributes, s_id));
         actual_sourcefile_.setNameOfFile(attributeAsString_(attributes, s_name));
-        actual_sourcefile_.setPathToFile(attributeAsString_(attributes, "location"));
+        actual_sourcefile_.setPathToFile(attributeAsString_(attributes, s_location));
       }
       else if (tag_ == "ProteinRef")
       {
-        actual_peptide_.protein_refs.push_back(attributeAsString_(attributes, "ref"));
+        actual_peptide_.protein_refs.push_back(attributeAsString_(attributes, s_ref));
       }
       else if (tag_ == "Target")
       {
@@ -279,12 +286,12 @@ namespace OpenMS
           actual_target_.setName(id);
         }
         String peptide_ref;
-        if (optionalAttributeAsString_(peptide_ref, attributes, "peptideRef"))
+        if (optionalAttributeAsString_(peptide_ref, attributes, s_peptide_ref))
         {
           actual_target_.setPeptideRef(peptide_ref);
         }
         String compound_ref;
-        if (optionalAttributeAsString_(compound_ref, attributes, "compoundRef"))
+        if (optionalAttributeAsString_(compound_ref, attributes, s_compound_ref))
         {
           actual_target_.setCompoundRef(compound_ref);
         }
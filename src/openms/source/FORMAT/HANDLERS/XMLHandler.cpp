@@ -37,6 +37,7 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/StringUtils.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 
 #include <set>
@@ -291,6 +292,38 @@ namespace OpenMS
 
     }
 
+    double StringManager::toDouble(const XMLCh * str)
+    {
+      // Numbers in XML attributes are short and plain ASCII. Copy them to a
+      // stack buffer and parse it directly instead of transcoding to a
+      // heap-allocated String first. Anything unusual (very long, non-ASCII
+      // or invalid values) takes the slow path, which also produces the
+      // proper error message.
+      char buffer[64];
+      const XMLCh* it = str;
+      while (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r') ++it;
+      size_t length = 0;
+      while (it[length] != 0)
+      {
+        if (length == sizeof(buffer) || it[length] > 127)
+        {
+          return StringManager().convert(str).toDouble();
+        }
+        buffer[length] = (char)it[length];
+        ++length;
+      }
+      while (length > 0 && (buffer[length - 1] == ' ' || buffer[length - 1] == '\t' || buffer[length - 1] == '\n' || buffer[length - 1] == '\r')) --length;
+
+      const char* begin = buffer;
+      const char* end = buffer + length;
+      double result;
+      if (length == 0 || !StringUtils::extractDouble(begin, end, result) || begin != end)
+      {
+        return StringManager().convert(str).toDouble();
+      }
+      return result;
+    }
+
   }   // namespace Internal
 
 } // namespace OpenMS
@@ -12,6 +12,7 @@ set(sources_list
   MzDataHandler.cpp
   MzIdentMLHandler.cpp
   MzIdentMLDOMHandler.cpp
+  MzIdentMLFragmentHandler.cpp
   MzQuantMLHandler.cpp
   MzMLHandler.cpp
   MzMLHandlerHelper.cpp
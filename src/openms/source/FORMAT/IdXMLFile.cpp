@@ -278,10 +278,11 @@ namespace OpenMS
       Size count_wrong_id(0);
       Size count_empty(0);
 
+      // select the peptide identifications of this run first, so that they
+      // can be serialized in parallel (in the original order) below
+      std::vector<Size> run_peptide_ids;
       for (Size l = 0; l < peptide_ids.size(); ++l)
       {
-        setProgress(l);
-
         if (peptide_ids[l].getIdentifier() != protein_ids[i].getIdentifier())
         {
           ++count_wrong_id;
@@ -292,35 +293,41 @@ namespace OpenMS
           ++count_empty;
           continue;
         }
+        run_peptide_ids.push_back(l);
+      }
+
+      writeElementsParallel_(os, run_peptide_ids.size(), [&](std::ostream& chunk, Size p)
+      {
+        const Size l = run_peptide_ids[p];
 
-        os << "\t\t<PeptideIdentification "
+        chunk << "\t\t<PeptideIdentification "
            << "score_type=\"" << writeXMLEscape(peptide_ids[l].getScoreType()) << "\" ";
         if (peptide_ids[l].isHigherScoreBetter())
         {
-          os << "higher_score_better=\"true\" ";
+          chunk << "higher_score_better=\"true\" ";
         }
         else
         {
-          os << "higher_score_better=\"false\" ";
+          chunk << "higher_score_better=\"false\" ";
         }
-        os << "significance_threshold=\"" << String(peptide_ids[l].getSignificanceThreshold()) << "\" ";
+        chunk << "significance_threshold=\"" << String(peptide_ids[l].getSignificanceThreshold()) << "\" ";
         // mz
         if (peptide_ids[l].hasMZ())
         {
-          os << "MZ=\"" << String(peptide_ids[l].getMZ()) << "\" ";
+          chunk << "MZ=\"" << String(peptide_ids[l].getMZ()) << "\" ";
         }
         // rt
         if (peptide_ids[l].hasRT())
         {
-          os << "RT=\"" << String(peptide_ids[l].getRT()) << "\" ";
+          chunk << "RT=\"" << String(peptide_ids[l].getRT()) << "\" ";
         }
         // spectrum_reference
         const DataValue& dv = peptide_ids[l].getMetaValue("spectrum_reference");
         if (dv != DataValue::EMPTY)
         {
-          os << "spectrum_reference=\"" << writeXMLEscape(dv.toString()) << "\" ";
+          chunk << "spectrum_reference=\"" << writeXMLEscape(dv.toString()) << "\" ";
         }
-        os << ">\n";
+        chunk << ">\n";
 
         // write peptide hits
         std::vector<String> protein_accessions;
@@ -334,15 +341,15 @@ namespace OpenMS
 
         for (const PeptideHit& p_hit : pep_hits)
         {
-          os << "\t\t\t<PeptideHit"
+          chunk << "\t\t\t<PeptideHit"
              << " score=\"" << String(p_hit.getScore()) << "\""
              << " sequence=\"" << writeXMLEscape(p_hit.getSequence().toString()) << "\""
              << " charge=\"" << String(p_hit.getCharge()) << "\"";
 
           const std::vector<PeptideEvidence>& pes = p_hit.getPeptideEvidences();
 
-          createFlankingAAXMLString_(pes, os);
-          createPositionXMLString_(pes, os);
+          createFlankingAAXMLString_(pes, chunk);
+          createPositionXMLString_(pes, chunk);
 
           // Extract all protein accessions.
           // Note: protein accessions correspond to neighboring AAs and start/end
@@ -357,18 +364,20 @@ namespace OpenMS
             // empty accessions are not written out (legacy code)
             if (!protein_accession.empty())
             {
-              protein_accessions.push_back("PH_" + String(accession_to_id[protein_accession]));
+              // read-only lookup, unknown accessions are written as PH_0 (as before)
+              std::unordered_map<string, UInt>::const_iterator acc_it = accession_to_id.find(protein_accession);
+              protein_accessions.push_back("PH_" + String(acc_it != accession_to_id.end() ? acc_it->second : 0));
             }
           }
 
           if (!protein_accessions.empty())
           {
-            os << " protein_refs=\"" << ListUtils::concatenate(protein_accessions, " ") << "\"";
+            chunk << " protein_refs=\"" << ListUtils::concatenate(protein_accessions, " ") << "\"";
           }
 
-          os << " >\n";
-          writeFragmentAnnotations_("UserParam", os, p_hit.getPeakAnnotations(), 4);
-          writeUserParam_("UserParam", os, p_hit, 4);
+          chunk << " >\n";
+          writeFragmentAnnotations_("UserParam", chunk, p_hit.getPeakAnnotations(), 4);
+          writeUserParam_("UserParam", chunk, p_hit, 4);
 
           // write out the (optional) peptide prophet / interprophet results as UserParams
           {
@@ -376,27 +385,27 @@ namespace OpenMS
             for (std::vector<PeptideHit::PepXMLAnalysisResult>::const_iterator ar_it = p_hit.getAnalysisResults().begin();
                 ar_it != p_hit.getAnalysisResults().end(); ++ar_it, ++k)
             {
-              os << "\t\t\t\t<UserParam type=\"string\" name=\"_ar_" << String(k) << "_score_type\" value=\"" << ar_it->score_type << "\"/>" << "\n";
-              os << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_score\" value=\"" << String(ar_it->main_score) << "\"/>" << "\n";
+              chunk << "\t\t\t\t<UserParam type=\"string\" name=\"_ar_" << String(k) << "_score_type\" value=\"" << ar_it->score_type << "\"/>" << "\n";
+              chunk << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_score\" value=\"" << String(ar_it->main_score) << "\"/>" << "\n";
               if (!ar_it->sub_scores.empty())
               {
                 for (std::map<String, double>::const_iterator subscore_it = ar_it->sub_scores.begin();
                     subscore_it != ar_it->sub_scores.end(); ++subscore_it)
                 {
-                  os << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_subscore_" << subscore_it->first <<"\" value=\"" << String(subscore_it->second) << "\"/>" << "\n";
+                  chunk << "\t\t\t\t<UserParam type=\"float\" name=\"_ar_" << String(k) << "_subscore_" << subscore_it->first <<"\" value=\"" << String(subscore_it->second) << "\"/>" << "\n";
                 }
               }
             }
 
           }
-          os << "\t\t\t</PeptideHit>\n";
+          chunk << "\t\t\t</PeptideHit>\n";
         }
 
         // do not write "spectrum_reference" since it is written as attribute already
         pep_id.removeMetaValue("spectrum_reference");
-        writeUserParam_("UserParam", os, pep_id, 3);
-        os << "\t\t</PeptideIdentification>\n";
-      }
+        writeUserParam_("UserParam", chunk, pep_id, 3);
+        chunk << "\t\t</PeptideIdentification>\n";
+      }, [&](Size done) { if (done > 0) setProgress(run_peptide_ids[done - 1]); });
 
       os << "\t</IdentificationRun>\n";
 
@@ -442,6 +451,27 @@ namespace OpenMS
 
   void IdXMLFile::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
   {
+    static const XMLCh* s_accession = xercesc::XMLString::transcode("accession");
+    static const XMLCh* s_score = xercesc::XMLString::transcode("score");
+    static const XMLCh* s_coverage = xercesc::XMLString::transcode("coverage");
+    static const XMLCh* s_sequence = xercesc::XMLString::transcode("sequence");
+    static const XMLCh* s_id = xercesc::XMLString::transcode("id");
+    static const XMLCh* s_score_type = xercesc::XMLString::transcode("score_type");
+    static const XMLCh* s_significance_threshold = xercesc::XMLString::transcode("significance_threshold");
+    static const XMLCh* s_higher_score_better = xercesc::XMLString::transcode("higher_score_better");
+    static const XMLCh* s_mz = xercesc::XMLString::transcode("MZ");
+    static const XMLCh* s_rt = xercesc::XMLString::transcode("RT");
+    static const XMLCh* s_spectrum_reference = xercesc::XMLString::transcode("spectrum_reference");
+    static const XMLCh* s_charge = xercesc::XMLString::transcode("charge");
+    static const XMLCh* s_protein_refs = xercesc::XMLString::transcode("protein_refs");
+    static const XMLCh* s_aa_before = xercesc::XMLString::transcode("aa_before");
+    static const XMLCh* s_aa_after = xercesc::XMLString::transcode("aa_after");
+    static const XMLCh* s_start = xercesc::XMLString::transcode("start");
+    static const XMLCh* s_end = xercesc::XMLString::transcode("end");
+    static const XMLCh* s_name = xercesc::XMLString::transcode("name");
+    static const XMLCh* s_type = xercesc::XMLString::transcode("type");
+    static const XMLCh* s_value = xercesc::XMLString::transcode("value");
+
     String tag = sm_.convert(qname);
 
     //START
@@ -567,13 +597,13 @@ namespace OpenMS
     else if (tag == "ProteinHit")
     {
       prot_hit_ = ProteinHit();
-      String accession = attributeAsString_(attributes, "accession");
+      String accession = attributeAsString_(attributes, s_accession);
       prot_hit_.setAccession(accession);
-      prot_hit_.setScore(attributeAsDouble_(attributes, "score"));
+      prot_hit_.setScore(attributeAsDouble_(attributes, s_score));
 
       // coverage
       double coverage = -std::numeric_limits<double>::max();
-      optionalAttributeAsDouble_(coverage, attributes, "coverage");
+      optionalAttributeAsDouble_(coverage, attributes, s_coverage);
       if (coverage != -std::numeric_limits<double>::max())
       {
         prot_hit_.setCoverage(coverage);
@@ -581,13 +611,13 @@ namespace OpenMS
 
       // sequence
       String tmp;
-      optionalAttributeAsString_(tmp, attributes, "sequence");
+      optionalAttributeAsString_(tmp, attributes, s_sequence);
       prot_hit_.setSequence(std::move(tmp));
 
       last_meta_ = &prot_hit_;
 
       // insert id and accession to map
-      proteinid_to_accession_[attributeAsString_(attributes, "id")] = accession;
+      proteinid_to_accession_[attributeAsString_(attributes, s_id)] = accession;
     }
     // PEPTIDES
     else if (tag == "PeptideIdentification")
@@ -602,35 +632,35 @@ namespace OpenMS
       //set identifier
       pep_id_.setIdentifier(prot_ids_->back().getIdentifier());
 
-      pep_id_.setScoreType(attributeAsString_(attributes, "score_type"));
+      pep_id_.setScoreType(attributeAsString_(attributes, s_score_type));
 
       //optional significance threshold
       double tmp(0.0);
-      optionalAttributeAsDouble_(tmp, attributes, "significance_threshold");
+      optionalAttributeAsDouble_(tmp, attributes, s_significance_threshold);
       if (tmp != 0.0)
       {
         pep_id_.setSignificanceThreshold(tmp);
       }
 
       //score orientation
-      pep_id_.setHigherScoreBetter(asBool_(attributeAsString_(attributes, "higher_score_better")));
+      pep_id_.setHigherScoreBetter(asBool_(attributeAsString_(attributes, s_higher_score_better)));
 
       //MZ
       double tmp2 = -std::numeric_limits<double>::max();
-      optionalAttributeAsDouble_(tmp2, attributes, "MZ");
+      optionalAttributeAsDouble_(tmp2, attributes, s_mz);
       if (tmp2 != -std::numeric_limits<double>::max())
       {
         pep_id_.setMZ(tmp2);
       }
       //RT
       tmp2 = -std::numeric_limits<double>::max();
-      optionalAttributeAsDouble_(tmp2, attributes, "RT");
+      optionalAttributeAsDouble_(tmp2, attributes, s_rt);
       if (tmp2 != -std::numeric_limits<double>::max())
       {
         pep_id_.setRT(tmp2);
       }
       String tmp3;
-      optionalAttributeAsString_(tmp3, attributes, "spectrum_reference");
+      optionalAttributeAsString_(tmp3, attributes, s_spectrum_reference);
       if (!tmp3.empty())
       {
         pep_id_.setMetaValue("spectrum_reference", tmp3);
@@ -643,12 +673,12 @@ namespace OpenMS
       pep_hit_ = PeptideHit();
       peptide_evidences_.clear();
 
-      pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
-      pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setCharge(attributeAsInt_(attributes, s_charge));
+      pep_hit_.setScore(attributeAsDouble_(attributes, s_score));
+      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, s_sequence))));
 
       //parse optional protein ids to determine accessions
-      const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
+      const XMLCh* refs = attributes.getValue(s_protein_refs);
       if (refs != nullptr)
       {
         String accession_string = sm_.convert(refs);
@@ -678,7 +708,7 @@ namespace OpenMS
 
       //aa_before
       String tmp;
-      optionalAttributeAsString_(tmp, attributes, "aa_before");
+      optionalAttributeAsString_(tmp, attributes, s_aa_before);
 
       if (!tmp.empty())
       {
@@ -697,7 +727,7 @@ namespace OpenMS
 
       //aa_after
       tmp = "";
-      optionalAttributeAsString_(tmp, attributes, "aa_after");
+      optionalAttributeAsString_(tmp, attributes, s_aa_after);
       if (!tmp.empty())
       {
         std::vector<String> parts;
@@ -715,7 +745,7 @@ namespace OpenMS
 
       //start
       tmp = "";
-      optionalAttributeAsString_(tmp, attributes, "start");
+      optionalAttributeAsString_(tmp, attributes, s_start);
 
       if (!tmp.empty())
       {
@@ -734,7 +764,7 @@ namespace OpenMS
 
       //end
       tmp = "";
-      optionalAttributeAsString_(tmp, attributes, "end");
+      optionalAttributeAsString_(tmp, attributes, s_end);
       if (!tmp.empty())
       {
         std::vector<String> parts;
@@ -760,8 +790,8 @@ namespace OpenMS
         fatalError(LOAD, "Unexpected tag 'UserParam'!");
       }
 
-      String name = attributeAsString_(attributes, "name");
-      String type = attributeAsString_(attributes, "type");
+      String name = attributeAsString_(attributes, s_name);
+      String type = attributeAsString_(attributes, s_type);
 
       // Handle specially encoded pepXML analysis results
       if (name.hasPrefix("_ar_"))
@@ -772,7 +802,7 @@ namespace OpenMS
         if (val_name.hasPrefix("subscore"))
         {
           String score_name = val_name.substr(val_name.find("_") + 1, val_name.size());
-          current_analysis_result_.sub_scores[score_name] = attributeAsDouble_(attributes, "value");
+          current_analysis_result_.sub_scores[score_name] = attributeAsDouble_(attributes, s_value);
         }
         else if (val_name == "score_type")
         {
@@ -780,26 +810,26 @@ namespace OpenMS
           {
             pep_hit_.addAnalysisResults(current_analysis_result_);
           }
-          current_analysis_result_.score_type = attributeAsString_(attributes, "value");
+          current_analysis_result_.score_type = attributeAsString_(attributes, s_value);
         }
         else if (val_name == "score")
         {
-          current_analysis_result_.main_score = attributeAsDouble_(attributes, "value");
+          current_analysis_result_.main_score = attributeAsDouble_(attributes, s_value);
         }
         return;
       }
 
       if (type == "int")
       {
-        last_meta_->setMetaValue(name, attributeAsInt_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsInt_(attributes, s_value));
       }
       else if (type == "float")
       {
-        last_meta_->setMetaValue(name, attributeAsDouble_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsDouble_(attributes, s_value));
       }
       else if (type == "string")
       {
-        String value = (String)attributeAsString_(attributes, "value");
+        String value = (String)attributeAsString_(attributes, s_value);
 
         // TODO: check if we are parsing a peptide hit
         if (name == Constants::UserParam::FRAGMENT_ANNOTATION_USERPARAM)
@@ -813,15 +843,15 @@ namespace OpenMS
       }
       else if (type == "intList")
       {
-        last_meta_->setMetaValue(name, attributeAsIntList_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsIntList_(attributes, s_value));
       }
       else if (type == "floatList")
       {
-        last_meta_->setMetaValue(name, attributeAsDoubleList_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsDoubleList_(attributes, s_value));
       }
       else if (type == "stringList")
       {
-        last_meta_->setMetaValue(name, attributeAsStringList_(attributes, "value"));
+        last_meta_->setMetaValue(name, attributeAsStringList_(attributes, s_value));
       }
       else
       {
@@ -35,17 +35,427 @@
 #include <OpenMS/FORMAT/MSNumpressCoder.h>
 
 #include <OpenMS/FORMAT/Base64.h>
-#include <OpenMS/MATH/MISC/MSNumpress.h>
+#include <OpenMS/MATH/MISC/MSNumpress.h> // MS_NUMPRESS_THROW_ON_OVERFLOW
 #include <boost/math/special_functions/fpclassify.hpp> // boost::math::isfinite
 // #define NUMPRESS_DEBUG
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
 namespace OpenMS
 {
   const std::string MSNumpressCoder::NamesOfNumpressCompression[] = {"none", "linear", "pic", "slof"};
 
-  using namespace ms; // numpress namespace
+  /*
+    Codecs for the three numpress schemes operating on typed buffers.
+
+    They produce exactly the same bytes (encoding) and the same values
+    (decoding) as the reference implementation in MATH/MISC/MSNumpress.h,
+    which is kept as the reference for the tests. Differences are purely in how the work is done: half bytes are
+    addressed by position and gathered with a single load instead of a
+    branch per half byte, linear data is decoded block-wise (parse
+    residuals, undo the prediction, then scale) and the output is written
+    straight to float or double storage.
+  */
+  namespace
+  {
+  // Block size for the two-pass linear decoder: residuals are parsed from the
+  // half-byte stream into a small integer buffer first, the second-order
+  // prediction is then undone in a tight loop over that buffer.
+  const size_t NP_DECODE_BLOCK = 256;
+
+  inline double npReadFixedPoint(const unsigned char* data)
+  {
+    // fixed point is stored as big-endian IEEE double
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+      bits = (bits << 8) | data[i];
+    }
+    double fp;
+    std::memcpy(&fp, &bits, sizeof(double));
+    return fp;
+  }
+
+  inline void npWriteFixedPoint(double fixed_point, unsigned char* result)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &fixed_point, sizeof(double));
+    for (int i = 0; i < 8; ++i)
+    {
+      result[i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+    }
+  }
+
+  /// reverse the order of the eight half bytes of @p x
+  inline uint32_t npReverseNibbles(uint32_t x)
+  {
+    x = (x >> 16) | (x << 16);
+    x = ((x & 0xff00ff00u) >> 8) | ((x & 0x00ff00ffu) << 8);
+    return ((x & 0xf0f0f0f0u) >> 4) | ((x & 0x0f0f0f0fu) << 4);
+  }
+
+  /**
+    @brief Reader for the half-byte integer stream of linear and pic encoded data
+
+    Decodes the same format as the reference decodeInt() but addresses the
+    stream by half-byte position and gathers all payload half bytes of one
+    integer with a single five-byte load instead of one branch per half byte.
+  */
+  struct NumpressNibbleReader
+  {
+    const unsigned char* data;
+    size_t size; ///< in bytes
+    size_t pos; ///< in half bytes
+
+    NumpressNibbleReader(const unsigned char* d, size_t s, size_t start_byte) :
+      data(d), size(s), pos(2 * start_byte)
+    {}
+
+    inline unsigned int nibble(size_t p) const
+    {
+      return (p & 1) ? (data[p >> 1] & 0xf) : (data[p >> 1] >> 4);
+    }
+
+    /// true while there are integers left (trailing zero half byte is padding)
+    inline bool hasNext() const
+    {
+      if (pos >= 2 * size) return false;
+      return !(pos == 2 * size - 1 && (data[pos >> 1] & 0xf) == 0);
+    }
+
+    inline uint32_t next()
+    {
+      const unsigned int head = nibble(pos++);
+      unsigned int n;
+      uint32_t res;
+      if (head <= 8)
+      {
+        n = head;
+        res = 0;
+      }
+      else
+      {
+        n = head - 8; // 1 <= n <= 7 leading 0xf half bytes
+        res = ~uint32_t(0) << (32 - 4 * n);
+      }
+      const unsigned int count = 8 - n;
+      if (count == 0) return res;
+
+      const size_t last_byte = (pos + count - 1) >> 1;
+      if (last_byte >= size)
+      {
+        throw "[MSNumpressCoder] Corrupt input data! ";
+      }
+
+      uint32_t payload;
+      const size_t b = pos >> 1;
+      if (b + 5 <= size)
+      {
+        // five bytes always cover 8 half bytes starting at an odd position
+        const uint64_t w = (uint64_t(data[b]) << 32) | (uint64_t(data[b + 1]) << 24) |
+                           (uint64_t(data[b + 2]) << 16) | (uint64_t(data[b + 3]) << 8) | uint64_t(data[b + 4]);
+        payload = npReverseNibbles(static_cast<uint32_t>(w >> (8 - 4 * (pos & 1))));
+      }
+      else
+      {
+        payload = 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+          payload |= uint32_t(nibble(pos + i)) << (4 * i);
+        }
+      }
+      if (count < 8) payload &= (uint32_t(1) << (4 * count)) - 1;
+      pos += count;
+      return res | payload;
+    }
+  };
+
+  /**
+    @brief Writer for the half-byte integer stream, byte-identical to the reference encodeInt()
+
+    The number of truncated leading 0x0 / 0xf half bytes is computed from the
+    bit pattern directly, the payload is appended in one shift.
+  */
+  struct NumpressNibbleWriter
+  {
+    unsigned char* out;
+    size_t ri; ///< bytes written
+    uint64_t acc; ///< pending half bytes (lowest 4 * pending bits are valid)
+    unsigned int pending;
+
+    NumpressNibbleWriter(unsigned char* o, size_t start_byte) :
+      out(o), ri(start_byte), acc(0), pending(0)
+    {}
+
+    static inline unsigned int leadingNibbles(uint32_t x)
+    {
+      // number of leading zero half bytes of x (8 for x == 0)
+      unsigned int l = 0;
+      if ((x & 0xffff0000u) == 0) { l += 4; x <<= 16; }
+      if ((x & 0xff000000u) == 0) { l += 2; x <<= 8; }
+      if ((x & 0xf0000000u) == 0) { l += 1; x <<= 4; }
+      if ((x & 0xf0000000u) == 0) { l += 1; }
+      return l;
+    }
+
+    inline void put(uint32_t x)
+    {
+      unsigned int head, count;
+      const uint32_t init = x & 0xf0000000u;
+      if (init == 0)
+      {
+        const unsigned int l = leadingNibbles(x);
+        head = l;
+        count = 8 - l;
+      }
+      else if (init == 0xf0000000u)
+      {
+        unsigned int l = leadingNibbles(~x);
+        if (l > 7) l = 7; // 0xffffffff is stored with one payload half byte
+        head = l + 8;
+        count = 8 - l;
+      }
+      else
+      {
+        head = 0;
+        count = 8;
+      }
+
+      acc = (acc << 4) | head;
+      if (count > 0)
+      {
+        acc = (acc << (4 * count)) | (npReverseNibbles(x) >> (32 - 4 * count));
+      }
+      pending += 1 + count;
+      while (pending >= 2)
+      {
+        pending -= 2;
+        out[ri++] = static_cast<unsigned char>(acc >> (4 * pending));
+      }
+    }
+
+    /// flush a trailing half byte (padded with zero), returns total number of bytes
+    inline size_t finish()
+    {
+      if (pending == 1)
+      {
+        out[ri++] = static_cast<unsigned char>((acc & 0xf) << 4);
+        pending = 0;
+      }
+      return ri;
+    }
+  };
+
+  template <typename T>
+  size_t npDecodeLinear(const unsigned char* data, size_t data_size, T* result, size_t capacity)
+  {
+    if (data_size == 8) return 0;
+    if (data_size < 8) throw "[MSNumpressCoder::decodeLinear] Corrupt input data: not enough bytes to read fixed point! ";
+    const double fixed_point = npReadFixedPoint(data);
+
+    if (data_size < 12) throw "[MSNumpressCoder::decodeLinear] Corrupt input data: not enough bytes to read first value! ";
+    if (capacity < 1) throw "[MSNumpressCoder::decodeLinear] Output buffer too small! ";
+    long long i1 = static_cast<long long>(uint32_t(data[8]) | (uint32_t(data[9]) << 8) | (uint32_t(data[10]) << 16) | (uint32_t(data[11]) << 24));
+    result[0] = static_cast<T>(i1 / fixed_point);
+    if (data_size == 12) return 1;
+
+    if (data_size < 16) throw "[MSNumpressCoder::decodeLinear] Corrupt input data: not enough bytes to read second value! ";
+    if (capacity < 2) throw "[MSNumpressCoder::decodeLinear] Output buffer too small! ";
+    long long i2 = static_cast<long long>(uint32_t(data[12]) | (uint32_t(data[13]) << 8) | (uint32_t(data[14]) << 16) | (uint32_t(data[15]) << 24));
+    result[1] = static_cast<T>(i2 / fixed_point);
+
+    NumpressNibbleReader reader(data, data_size, 16);
+    int diffs[NP_DECODE_BLOCK];
+    long long values[NP_DECODE_BLOCK];
+    size_t ri = 2;
+    while (reader.hasNext())
+    {
+      // 1. parse a block of residuals
+      size_t k = 0;
+      while (k < NP_DECODE_BLOCK && reader.hasNext())
+      {
+        diffs[k++] = static_cast<int>(reader.next());
+      }
+      if (ri + k > capacity) throw "[MSNumpressCoder::decodeLinear] Output buffer too small! ";
+
+      // 2. undo the linear prediction: y_j = 2 y_{j-1} - y_{j-2} + d_j
+      for (size_t j = 0; j < k; ++j)
+      {
+        const long long y = 2 * i2 - i1 + diffs[j];
+        i1 = i2;
+        i2 = y;
+        values[j] = y;
+      }
+
+      // 3. scale into the output (independent per element, vectorizes)
+      T* out = result + ri;
+      for (size_t j = 0; j < k; ++j)
+      {
+        out[j] = static_cast<T>(values[j] / fixed_point);
+      }
+      ri += k;
+    }
+    return ri;
+  }
+
+  template <typename T>
+  size_t npDecodePic(const unsigned char* data, size_t data_size, T* result, size_t capacity)
+  {
+    NumpressNibbleReader reader(data, data_size, 0);
+    size_t ri = 0;
+    while (reader.hasNext())
+    {
+      if (ri >= capacity) throw "[MSNumpressCoder::decodePic] Output buffer too small! ";
+      result[ri++] = static_cast<T>(static_cast<double>(reader.next()));
+    }
+    return ri;
+  }
+
+  template <typename T>
+  size_t npDecodeSlof(const unsigned char* data, size_t data_size, T* result, size_t capacity)
+  {
+    if (data_size < 8) throw "[MSNumpressCoder::decodeSlof] Corrupt input data: not enough bytes to read fixed point! ";
+    const double fixed_point = npReadFixedPoint(data);
+    const size_t n = (data_size - 8) / 2;
+    if (n > capacity) throw "[MSNumpressCoder::decodeSlof] Output buffer too small! ";
+
+    const unsigned char* in = data + 8;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      const unsigned int x0 = in[2 * i] | (in[2 * i + 1] << 8);
+      const unsigned int x1 = in[2 * i + 2] | (in[2 * i + 3] << 8);
+      const unsigned int x2 = in[2 * i + 4] | (in[2 * i + 5] << 8);
+      const unsigned int x3 = in[2 * i + 6] | (in[2 * i + 7] << 8);
+      result[i] = static_cast<T>(std::exp(x0 / fixed_point) - 1);
+      result[i + 1] = static_cast<T>(std::exp(x1 / fixed_point) - 1);
+      result[i + 2] = static_cast<T>(std::exp(x2 / fixed_point) - 1);
+      result[i + 3] = static_cast<T>(std::exp(x3 / fixed_point) - 1);
+    }
+    for (; i < n; ++i)
+    {
+      const unsigned int x = in[2 * i] | (in[2 * i + 1] << 8);
+      result[i] = static_cast<T>(std::exp(x / fixed_point) - 1);
+    }
+    return n;
+  }
+
+  // fixed point estimation, same as the reference implementation but on typed input
+
+  template <typename T>
+  double npOptimalLinearFixedPoint(const T* data, size_t data_size)
+  {
+    if (data_size == 0) return 0;
+    if (data_size == 1) return floor(0x7FFFFFFFl / static_cast<double>(data[0]));
+    double max_double = std::max(static_cast<double>(data[0]), static_cast<double>(data[1]));
+    for (size_t i = 2; i < data_size; ++i)
+    {
+      const double d0 = data[i - 2], d1 = data[i - 1], d2 = data[i];
+      const double extrapol = d1 + (d1 - d0);
+      const double diff = d2 - extrapol;
+      max_double = std::max(max_double, ceil(std::fabs(diff) + 1));
+    }
+    return floor(0x7FFFFFFFl / max_double);
+  }
+
+  template <typename T>
+  double npOptimalLinearFixedPointMass(const T* data, size_t data_size, double mass_acc)
+  {
+    if (data_size < 3) return 0; // the first two points are stored as integers directly
+
+    // the maximal error when rounding to int is 0.5, return failure (-1) if
+    // the required fixed point would overflow the 32 bit residuals
+    const double max_fp = 0.5 / mass_acc;
+    if (max_fp > npOptimalLinearFixedPoint(data, data_size)) return -1;
+    return max_fp;
+  }
+
+  template <typename T>
+  double npOptimalSlofFixedPoint(const T* data, size_t data_size)
+  {
+    if (data_size == 0) return 0;
+    double max_double = 1;
+    for (size_t i = 0; i < data_size; ++i)
+    {
+      max_double = std::max(max_double, log(static_cast<double>(data[i]) + 1));
+    }
+    // 0xFFFE as 0.5 is added during encoding
+    return floor(0xFFFE / max_double);
+  }
+
+  template <typename T>
+  size_t npEncodeLinear(const T* data, size_t data_size, unsigned char* result, double fixed_point)
+  {
+    npWriteFixedPoint(fixed_point, result);
+    if (data_size == 0) return 8;
+
+    long long i1 = static_cast<long long>(data[0] * fixed_point + 0.5);
+    for (int i = 0; i < 4; ++i) result[8 + i] = static_cast<unsigned char>((i1 >> (i * 8)) & 0xff);
+    if (data_size == 1) return 12;
+
+    long long i2 = static_cast<long long>(data[1] * fixed_point + 0.5);
+    for (int i = 0; i < 4; ++i) result[12 + i] = static_cast<unsigned char>((i2 >> (i * 8)) & 0xff);
+
+    NumpressNibbleWriter writer(result, 16);
+    for (size_t i = 2; i < data_size; ++i)
+    {
+      const double scaled = data[i] * fixed_point + 0.5;
+      if (MS_NUMPRESS_THROW_ON_OVERFLOW && scaled > LLONG_MAX)
+      {
+        throw "[MSNumpressCoder::encodeLinear] Next number overflows LLONG_MAX.";
+      }
+      const long long y = static_cast<long long>(scaled);
+      const long long extrapol = i2 + (i2 - i1);
+      if (MS_NUMPRESS_THROW_ON_OVERFLOW && (y - extrapol > INT_MAX || y - extrapol < INT_MIN))
+      {
+        throw "[MSNumpressCoder::encodeLinear] Cannot encode a number that exceeds the bounds of [-INT_MAX, INT_MAX].";
+      }
+      writer.put(static_cast<uint32_t>(static_cast<int>(y - extrapol)));
+      i1 = i2;
+      i2 = y;
+    }
+    return writer.finish();
+  }
+
+  template <typename T>
+  size_t npEncodePic(const T* data, size_t data_size, unsigned char* result)
+  {
+    NumpressNibbleWriter writer(result, 0);
+    for (size_t i = 0; i < data_size; ++i)
+    {
+      if (MS_NUMPRESS_THROW_ON_OVERFLOW && (data[i] + 0.5 > INT_MAX || data[i] < -0.5))
+      {
+        throw "[MSNumpressCoder::encodePic] Cannot use Pic to encode a number larger than INT_MAX or smaller than 0.";
+      }
+      writer.put(static_cast<uint32_t>(data[i] + 0.5));
+    }
+    return writer.finish();
+  }
+
+  template <typename T>
+  size_t npEncodeSlof(const T* data, size_t data_size, unsigned char* result, double fixed_point)
+  {
+    npWriteFixedPoint(fixed_point, result);
+    unsigned char* out = result + 8;
+    for (size_t i = 0; i < data_size; ++i)
+    {
+      const double temp = std::log(data[i] + 1.0) * fixed_point;
+      if (MS_NUMPRESS_THROW_ON_OVERFLOW && temp > USHRT_MAX)
+      {
+        throw "[MSNumpressCoder::encodeSlof] Cannot encode a number that overflows USHRT_MAX.";
+      }
+      const unsigned short x = static_cast<unsigned short>(temp + 0.5);
+      out[2 * i] = static_cast<unsigned char>(x & 0xff);
+      out[2 * i + 1] = static_cast<unsigned char>(x >> 8);
+    }
+    return 8 + 2 * data_size;
+  }
+  }
 
   void MSNumpressCoder::encodeNP(const std::vector<double> & in, String & result,
       bool zlib_compression, const NumpressConfig & config)
@@ -66,8 +476,17 @@ namespace OpenMS
   void MSNumpressCoder::encodeNP(const std::vector<float> & in, String & result,
       bool zlib_compression, const NumpressConfig & config)
   {
-    std::vector<double> dvector(in.begin(), in.end());
-    encodeNP(dvector, result, zlib_compression, config);
+    result.clear();
+    if (in.empty()) return;
+    encodeNPRawT_(&in[0], in.size(), result, config);
+    if (result.empty())
+    {
+      return;
+    }
+
+    std::vector<String> tmp;
+    tmp.push_back(result);
+    Base64::encodeStrings(tmp, result, zlib_compression, false);
   }
 
   void MSNumpressCoder::decodeNP(const String & in, std::vector<double> & out,
@@ -76,24 +495,30 @@ namespace OpenMS
     QByteArray base64_uncompressed;
     Base64::decodeSingleString(in, base64_uncompressed, zlib_compression);
 
-    // Create a temporary string (*not* null-terminated) to hold the data
-    std::string tmpstring(base64_uncompressed.constData(), base64_uncompressed.size());
-    decodeNPRaw(tmpstring, out, config);
+    // decode directly from the buffer, the data is *not* null-terminated
+    decodeNPInternal_(reinterpret_cast<const unsigned char*>(base64_uncompressed.constData()), base64_uncompressed.size(), out, config);
+  }
 
-    // NOTE: it is possible (and likely faster) to call directly the const
-    // unsigned char * function but this would make it necessary to deal with
-    // reinterpret_cast ugliness here ... 
-    //
-    // decodeNP_internal_(reinterpret_cast<const unsigned char*>(base64_uncompressed.constData()), base64_uncompressed.size(), out, config);
+  void MSNumpressCoder::decodeNP(const String & in, std::vector<float> & out,
+      bool zlib_compression, const NumpressConfig & config)
+  {
+    QByteArray base64_uncompressed;
+    Base64::decodeSingleString(in, base64_uncompressed, zlib_compression);
+    decodeNPInternal_(reinterpret_cast<const unsigned char*>(base64_uncompressed.constData()), base64_uncompressed.size(), out, config);
   }
 
   void MSNumpressCoder::encodeNPRaw(const std::vector<double>& in, String& result, const NumpressConfig & config)
   {
     if (in.empty()) return;
+    encodeNPRawT_(&in[0], in.size(), result, config);
+  }
 
-    if (config.np_compression == NONE) return;
+  template <typename T>
+  void MSNumpressCoder::encodeNPRawT_(const T* in, Size dataSize, String& result, const NumpressConfig & config)
+  {
+    if (dataSize == 0) return;
 
-    Size dataSize = in.size();
+    if (config.np_compression == NONE) return;
 
     // using MSNumpress, from johan.teleman@immun.lth.se
     std::vector<unsigned char> numpressed;
@@ -108,11 +533,11 @@ namespace OpenMS
       switch (config.np_compression)
       {
       case LINEAR:
-        numpressed.resize(dataSize * sizeof(std::vector<double>::value_type) + 8);
+        numpressed.resize(dataSize * sizeof(double) + 8);
         break;
 
       case PIC:
-        numpressed.resize(dataSize * sizeof(std::vector<double>::value_type));
+        numpressed.resize(dataSize * sizeof(double));
         break;
 
       case SLOF:
@@ -139,43 +564,43 @@ namespace OpenMS
           // estimate fixed point either by mass accuracy or by using maximal permissible value
           if (config.linear_fp_mass_acc > 0)
           {
-            fixedPoint = numpress::MSNumpress::optimalLinearFixedPointMass(&in[0], dataSize, config.linear_fp_mass_acc);
+            fixedPoint = npOptimalLinearFixedPointMass(in, dataSize, config.linear_fp_mass_acc);
             // catch failure
-            if (fixedPoint < 0.0) fixedPoint = numpress::MSNumpress::optimalLinearFixedPoint(&in[0], dataSize);
+            if (fixedPoint < 0.0) fixedPoint = npOptimalLinearFixedPoint(in, dataSize);
           }
           else
           {
-            fixedPoint = numpress::MSNumpress::optimalLinearFixedPoint(&in[0], dataSize);
+            fixedPoint = npOptimalLinearFixedPoint(in, dataSize);
           }
         }
-        byteCount = numpress::MSNumpress::encodeLinear(&in[0], dataSize, &numpressed[0], fixedPoint);
-        numpressed.resize(byteCount);
+        byteCount = npEncodeLinear(in, dataSize, &numpressed[0], fixedPoint);
         if (config.numpressErrorTolerance > 0.0)   // decompress to check accuracy loss
         {
-          numpress::MSNumpress::decodeLinear(numpressed, unpressed);
+          unpressed.resize(dataSize);
+          npDecodeLinear(&numpressed[0], byteCount, &unpressed[0], dataSize);
         }
         break;
       }
 
       case PIC:
       {
-        byteCount = numpress::MSNumpress::encodePic(&in[0], dataSize, &numpressed[0]);
-        numpressed.resize(byteCount);
+        byteCount = npEncodePic(in, dataSize, &numpressed[0]);
         if (config.numpressErrorTolerance > 0.0)   // decompress to check accuracy loss
         {
-          numpress::MSNumpress::decodePic(numpressed, unpressed);
+          unpressed.resize(dataSize);
+          npDecodePic(&numpressed[0], byteCount, &unpressed[0], dataSize);
         }
         break;
       }
 
       case SLOF:
       {
-        if (config.estimate_fixed_point) {fixedPoint = numpress::MSNumpress::optimalSlofFixedPoint(&in[0], dataSize); }
-        byteCount = numpress::MSNumpress::encodeSlof(&in[0], dataSize, &numpressed[0], fixedPoint);
-        numpressed.resize(byteCount);
+        if (config.estimate_fixed_point) {fixedPoint = npOptimalSlofFixedPoint(in, dataSize); }
+        byteCount = npEncodeSlof(in, dataSize, &numpressed[0], fixedPoint);
         if (config.numpressErrorTolerance > 0.0)   // decompress to check accuracy loss
         {
-          numpress::MSNumpress::decodeSlof(numpressed, unpressed);
+          unpressed.resize(dataSize);
+          npDecodeSlof(&numpressed[0], byteCount, &unpressed[0], dataSize);
         }
         break;
       }
@@ -218,7 +643,7 @@ namespace OpenMS
           for (n=static_cast<int>(dataSize)-1; n>=0; n--)
           {
             double u = unpressed[n];
-            double d = in[n];
+            double d = static_cast<double>(in[n]);
             if (!boost::math::isfinite(u) || !boost::math::isfinite(d))
             {
 #ifdef NUMPRESS_DEBUG
@@ -289,10 +714,56 @@ namespace OpenMS
     decodeNPInternal_(reinterpret_cast<const unsigned char*>(in.c_str()), in.size(), out, config);
   }
 
-  void MSNumpressCoder::decodeNPInternal_(const unsigned char* in, size_t in_size, std::vector<double>& out, const NumpressConfig & config)
+  void MSNumpressCoder::decodeNPRaw(const std::string & in, std::vector<float>& out, const NumpressConfig & config)
+  {
+    decodeNPInternal_(reinterpret_cast<const unsigned char*>(in.c_str()), in.size(), out, config);
+  }
+
+  Size MSNumpressCoder::decodeNPRaw(const unsigned char* in, Size in_size, double* out, Size out_size, const NumpressConfig & config)
+  {
+    return decodeNPInternal_(in, in_size, out, out_size, config);
+  }
+
+  Size MSNumpressCoder::decodeNPRaw(const unsigned char* in, Size in_size, float* out, Size out_size, const NumpressConfig & config)
+  {
+    return decodeNPInternal_(in, in_size, out, out_size, config);
+  }
+
+  Size MSNumpressCoder::decodedSizeBound(Size in_size, NumpressCompression compression)
+  {
+    switch (compression)
+    {
+    case LINEAR:
+      // two 4 byte start values, then at least one half byte per value
+      return in_size < 16 ? 2 : 2 + (in_size - 16) * 2;
+
+    case PIC:
+      return in_size * 2;
+
+    case SLOF:
+      return in_size < 8 ? 0 : (in_size - 8) / 2;
+
+    default:
+      return 0;
+    }
+  }
+
+  template <typename T>
+  void MSNumpressCoder::decodeNPInternal_(const unsigned char* in, size_t in_size, std::vector<T>& out, const NumpressConfig & config)
   {
     out.clear();
     if (in_size == 0) return;
+    if (config.np_compression == NONE) return;
+
+    out.resize(decodedSizeBound(in_size, config.np_compression));
+    Size count = decodeNPInternal_(in, in_size, out.empty() ? nullptr : &out[0], out.size(), config);
+    out.resize(count);
+  }
+
+  template <typename T>
+  Size MSNumpressCoder::decodeNPInternal_(const unsigned char* in, size_t in_size, T* out, Size out_size, const NumpressConfig & config)
+  {
+    if (in_size == 0) return 0;
 
     size_t byteCount = in_size;
 
@@ -304,43 +775,25 @@ namespace OpenMS
     }
 #endif
 
+    size_t count = 0;
     try
     {
-      size_t initialSize;
-
       switch (config.np_compression)
       {
       case LINEAR:
-      {
-        initialSize = byteCount * 2;
-        if (out.size() < initialSize) { out.resize(initialSize); }
-        size_t count = numpress::MSNumpress::decodeLinear(in, byteCount, &out[0]);
-        out.resize(count);
+        count = npDecodeLinear(in, byteCount, out, out_size);
         break;
-      }
 
       case PIC:
-      {
-        initialSize = byteCount * 2;
-        if (out.size() < initialSize) { out.resize(initialSize); }
-        size_t count = numpress::MSNumpress::decodePic(in, byteCount, &out[0]);
-        out.resize(count);
+        count = npDecodePic(in, byteCount, out, out_size);
         break;
-      }
 
       case SLOF:
-      {
-        initialSize = byteCount / 2;
-        if (out.size() < initialSize) { out.resize(initialSize); }
-        size_t count = numpress::MSNumpress::decodeSlof(in, byteCount, &out[0]);
-        out.resize(count);
+        count = npDecodeSlof(in, byteCount, out, out_size);
         break;
-      }
 
       case NONE:
-      {
-        return;
-      }
+        return 0;
 
       default:
         break;
@@ -353,14 +806,14 @@ namespace OpenMS
     }
 
 #ifdef NUMPRESS_DEBUG
-    std::cout << "decodeNPInternal_: output size " << out.size() << std::endl;
-    for (int i = 0; i < out.size(); i++)
+    std::cout << "decodeNPInternal_: output size " << count << std::endl;
+    for (size_t i = 0; i < count; i++)
     {
       std::cout << "array[" << i << "] : " << out[i] << std::endl;
     }
 #endif
 
-
+    return count;
   }
 
 } //namespace OpenMS
@@ -38,6 +38,7 @@
 #include <OpenMS/FORMAT/CVMappingFile.h>
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLHandler.h>
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLFragmentHandler.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
@@ -55,6 +56,20 @@ namespace OpenMS
 
   void MzIdentMLFile::load(const String& filename, std::vector<ProteinIdentification>& poid, std::vector<PeptideIdentification>& peid)
   {
+    const Size pro_size = poid.size();
+    const Size pep_size = peid.size();
+    {
+      Internal::MzIdentMLFragmentHandler handler(poid, peid, filename, schema_version_, *this);
+      parse_(filename, &handler);
+      if (!handler.isCrossLinkingSearch())
+      {
+        return;
+      }
+    }
+
+    // cross-linking MS results can only be converted with the whole document at hand
+    poid.erase(poid.begin() + pro_size, poid.end());
+    peid.erase(peid.begin() + pep_size, peid.end());
     Internal::MzIdentMLDOMHandler handler(poid, peid, schema_version_, *this);
     handler.readMzIdentMLFile(filename);
   }
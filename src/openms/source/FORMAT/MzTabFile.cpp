@@ -35,6 +35,7 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/MzTabFile.h>
 
+#include <OpenMS/FORMAT/DelimitedTextReader.h>
 #include <OpenMS/FORMAT/TextFile.h>
 
 #include <boost/regex.hpp>
@@ -104,7 +105,8 @@ namespace OpenMS
 
   void MzTabFile::load(const String& filename, MzTab& mz_tab)
   {
-  TextFile tf(filename, true);
+  // stream the file instead of buffering all lines (lines are trimmed below)
+  DelimitedTextReader reader(filename);
 
   MzTabMetaData mz_tab_metadata;
   MzTabProteinSectionRows mz_tab_protein_section_data;
@@ -228,10 +230,9 @@ namespace OpenMS
   Size count_smallmolecule_search_engine_score = 0;
 
   Size line_number = 0;
-  for (TextFile::ConstIterator sit = tf.begin(); sit != tf.end(); ++sit, ++line_number)
+  for (; reader.readLine(); ++line_number)
   {
-    //  std::cout << *sit << std::endl;
-    String s = *sit;
+    String s = reader.line().getString();
 
     // skip empty lines or lines that are too short
     if (s.trim().size() < 3)
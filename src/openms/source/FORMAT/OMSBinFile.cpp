@@ -0,0 +1,1294 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/OMSBinFile.h>
+
+#include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/METADATA/MetaInfoRegistry.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// every file starts with these bytes (the first one is non-ASCII, so text files never match)
+    const char OMSBIN_MAGIC[8] = {'\x89', 'O', 'M', 'S', 'B', 'I', 'N', '\n'};
+
+    /// version of the layout written by this implementation
+    const UInt32 OMSBIN_VERSION = 1;
+
+    /**
+      @brief Collects the body of a file and its string table
+
+      Strings are stored once and referenced by their index in the table,
+      which is written in front of the body.
+    */
+    class BinaryWriter
+    {
+public:
+      template <typename T>
+      void put(const T& value)
+      {
+        body_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      template <typename T>
+      void putColumn(const std::vector<T>& column)
+      {
+        if (!column.empty())
+        {
+          body_.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+        }
+      }
+
+      void putSize(Size size)
+      {
+        put<UInt64>(size);
+      }
+
+      void putString(const String& s)
+      {
+        std::pair<std::unordered_map<String, UInt32>::iterator, bool> it = string_index_.insert(std::make_pair(s, UInt32(strings_.size())));
+        if (it.second)
+        {
+          strings_.push_back(&it.first->first);
+        }
+        put<UInt32>(it.first->second);
+      }
+
+      void putStrings(const std::vector<String>& strings)
+      {
+        putSize(strings.size());
+        for (const String& s : strings)
+        {
+          putString(s);
+        }
+      }
+
+      void writeTo(const String& filename, OMSBinFile::ContentType type) const
+      {
+        if (!FileHandler::hasValidExtension(filename, FileTypes::OMSBIN))
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "invalid file extension, expected '" + FileTypes::typeToName(FileTypes::OMSBIN) + "'");
+        }
+        std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+        if (!os)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+
+        std::string header(OMSBIN_MAGIC, sizeof(OMSBIN_MAGIC));
+        UInt32 version = OMSBIN_VERSION, content = type;
+        header.append(reinterpret_cast<const char*>(&version), sizeof(version));
+        header.append(reinterpret_cast<const char*>(&content), sizeof(content));
+        UInt64 string_count = strings_.size();
+        header.append(reinterpret_cast<const char*>(&string_count), sizeof(string_count));
+        os.write(header.data(), header.size());
+
+        for (const String* s : strings_)
+        {
+          UInt32 length = s->size();
+          os.write(reinterpret_cast<const char*>(&length), sizeof(length));
+          os.write(s->data(), length);
+        }
+        os.write(body_.data(), body_.size());
+        if (!os)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "error while writing the file");
+        }
+      }
+
+private:
+      std::string body_;
+      std::unordered_map<String, UInt32> string_index_;
+      /// points to the keys of string_index_, in order of insertion
+      std::vector<const String*> strings_;
+    };
+
+    /**
+      @brief Reads values from the in-memory content of a file
+
+      All accesses are checked against the end of the buffer, so truncated or
+      corrupt files result in an Exception::ParseError.
+    */
+    class BinaryReader
+    {
+public:
+      BinaryReader(const String& filename, const std::string& buffer) :
+        filename_(filename),
+        pos_(buffer.data()),
+        end_(buffer.data() + buffer.size())
+      {
+      }
+
+      template <typename T>
+      T get()
+      {
+        require_(sizeof(T));
+        T value;
+        memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+      }
+
+      template <typename T>
+      void getColumn(std::vector<T>& column, Size count)
+      {
+        if (count > Size(end_ - pos_) / sizeof(T))
+        {
+          fail("unexpected end of file");
+        }
+        column.resize(count);
+        if (count != 0)
+        {
+          memcpy(column.data(), pos_, count * sizeof(T));
+        }
+        pos_ += count * sizeof(T);
+      }
+
+      Size getSize()
+      {
+        return get<UInt64>();
+      }
+
+      /**
+        @brief Reads the number of elements of a list whose elements take at least @p min_bytes each
+
+        A corrupt count fails here instead of causing a huge allocation.
+      */
+      Size getCount(Size min_bytes)
+      {
+        Size count = getSize();
+        if (count > Size(end_ - pos_) / min_bytes)
+        {
+          fail("invalid element count (unexpected end of file)");
+        }
+        return count;
+      }
+
+      const String& getString()
+      {
+        UInt32 index = get<UInt32>();
+        if (index >= strings_.size())
+        {
+          fail("invalid string reference");
+        }
+        return strings_[index];
+      }
+
+      void getStrings(std::vector<String>& strings)
+      {
+        Size count = getSize();
+        strings.clear();
+        for (Size i = 0; i < count; ++i)
+        {
+          strings.push_back(getString());
+        }
+      }
+
+      /// the sequence of a peptide hit (each distinct sequence is parsed only once)
+      const AASequence& getSequence()
+      {
+        UInt32 index = get<UInt32>();
+        if (index >= strings_.size())
+        {
+          fail("invalid string reference");
+        }
+        std::unordered_map<UInt32, AASequence>::iterator it = sequences_.find(index);
+        if (it == sequences_.end())
+        {
+          it = sequences_.insert(std::make_pair(index, AASequence::fromString(strings_[index]))).first;
+        }
+        return it->second;
+      }
+
+      /// the index of a meta value key in the MetaInfoRegistry (each distinct key is registered only once)
+      UInt getMetaIndex()
+      {
+        UInt32 index = get<UInt32>();
+        if (index >= strings_.size())
+        {
+          fail("invalid string reference");
+        }
+        std::unordered_map<UInt32, UInt>::iterator it = meta_indices_.find(index);
+        if (it == meta_indices_.end())
+        {
+          it = meta_indices_.insert(std::make_pair(index, MetaInfoInterface::metaRegistry().registerName(strings_[index], ""))).first;
+        }
+        return it->second;
+      }
+
+      /// checks magic number, version and content type and reads the string table
+      void readHeader(OMSBinFile::ContentType expected)
+      {
+        require_(sizeof(OMSBIN_MAGIC));
+        if (memcmp(pos_, OMSBIN_MAGIC, sizeof(OMSBIN_MAGIC)) != 0)
+        {
+          fail("File might not be a binary OpenMS file (wrong magic number). Aborting!");
+        }
+        pos_ += sizeof(OMSBIN_MAGIC);
+        UInt32 version = get<UInt32>();
+        if (version > OMSBIN_VERSION)
+        {
+          fail(String("File was written by a newer version of OpenMS (format version ") + version + "). Aborting!");
+        }
+        UInt32 content = get<UInt32>();
+        if (content != UInt32(expected))
+        {
+          const char* names[] = {"unknown data", "a feature map", "a consensus map", "identifications"};
+          fail(String("File contains ") + names[content <= 3 ? content : 0] + " instead of " + names[expected] + ".");
+        }
+        readStringTable_();
+      }
+
+      bool atEnd() const
+      {
+        return pos_ == end_;
+      }
+
+      void fail(const String& message) const
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, message);
+      }
+
+private:
+      void readStringTable_()
+      {
+        Size count = getSize();
+        if (count > Size(end_ - pos_) / sizeof(UInt32))
+        {
+          fail("unexpected end of file");
+        }
+        strings_.resize(count);
+        for (Size i = 0; i < count; ++i)
+        {
+          UInt32 length = get<UInt32>();
+          require_(length);
+          strings_[i].assign(pos_, length);
+          pos_ += length;
+        }
+      }
+
+      void require_(Size bytes) const
+      {
+        if (bytes > Size(end_ - pos_))
+        {
+          fail("unexpected end of file");
+        }
+      }
+
+      String filename_;
+      const char* pos_;
+      const char* end_;
+      std::vector<String> strings_;
+      std::unordered_map<UInt32, AASequence> sequences_;
+      std::unordered_map<UInt32, UInt> meta_indices_;
+    };
+
+    /// reads the whole file @p filename into @p buffer
+    void readFile(const String& filename, std::string& buffer)
+    {
+      if (!File::exists(filename))
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+      std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!is)
+      {
+        throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+      is.seekg(0, std::ios::end);
+      buffer.resize(is.tellg());
+      is.seekg(0, std::ios::beg);
+      if (!buffer.empty())
+      {
+        is.read(&buffer[0], buffer.size());
+      }
+    }
+
+    void writeMetaInfo(BinaryWriter& w, const MetaInfoInterface& meta)
+    {
+      std::vector<String> keys;
+      meta.getKeys(keys);
+      w.put<UInt32>(keys.size());
+      for (const String& key : keys)
+      {
+        const DataValue& value = meta.getMetaValue(key);
+        w.putString(key);
+        w.put<Byte>(value.valueType());
+        w.put<Byte>(value.getUnitType());
+        w.put<Int32>(value.getUnit());
+        switch (value.valueType())
+        {
+        case DataValue::STRING_VALUE:
+          w.putString(value.toString());
+          break;
+
+        case DataValue::INT_VALUE:
+          w.put<Int64>(static_cast<long long>(value));
+          break;
+
+        case DataValue::DOUBLE_VALUE:
+          w.put<double>(static_cast<double>(value));
+          break;
+
+        case DataValue::STRING_LIST:
+          w.putStrings(value.toStringList());
+          break;
+
+        case DataValue::INT_LIST:
+        {
+          IntList list = value.toIntList();
+          w.putSize(list.size());
+          w.putColumn(list);
+        }
+        break;
+
+        case DataValue::DOUBLE_LIST:
+        {
+          DoubleList list = value.toDoubleList();
+          w.putSize(list.size());
+          w.putColumn(list);
+        }
+        break;
+
+        case DataValue::EMPTY_VALUE:
+          break;
+        }
+      }
+    }
+
+    void readMetaInfo(BinaryReader& r, MetaInfoInterface& meta)
+    {
+      UInt32 count = r.get<UInt32>();
+      for (UInt32 i = 0; i < count; ++i)
+      {
+        UInt index = r.getMetaIndex();
+        Byte type = r.get<Byte>();
+        Byte unit_type = r.get<Byte>();
+        Int32 unit = r.get<Int32>();
+        DataValue value;
+        switch (type)
+        {
+        case DataValue::STRING_VALUE:
+          value = DataValue(r.getString());
+          break;
+
+        case DataValue::INT_VALUE:
+          value = DataValue(r.get<Int64>());
+          break;
+
+        case DataValue::DOUBLE_VALUE:
+          value = DataValue(r.get<double>());
+          break;
+
+        case DataValue::STRING_LIST:
+        {
+          StringList list;
+          r.getStrings(list);
+          value = DataValue(list);
+        }
+        break;
+
+        case DataValue::INT_LIST:
+        {
+          IntList list;
+          r.getColumn(list, r.getSize());
+          value = DataValue(list);
+        }
+        break;
+
+        case DataValue::DOUBLE_LIST:
+        {
+          DoubleList list;
+          r.getColumn(list, r.getSize());
+          value = DataValue(list);
+        }
+        break;
+
+        case DataValue::EMPTY_VALUE:
+          break;
+
+        default:
+          r.fail(String("invalid meta value type ") + UInt(type));
+        }
+        if (unit_type > DataValue::OTHER)
+        {
+          r.fail(String("invalid unit type ") + UInt(unit_type));
+        }
+        value.setUnitType(DataValue::UnitType(unit_type));
+        value.setUnit(unit);
+        meta.setMetaValue(index, value);
+      }
+    }
+
+    void writeDateTime(BinaryWriter& w, const DateTime& date)
+    {
+      w.putString(date.isValid() ? date.get() : String());
+    }
+
+    void readDateTime(BinaryReader& r, DateTime& date)
+    {
+      const String& s = r.getString();
+      if (!s.empty())
+      {
+        date.set(s);
+      }
+    }
+
+    void writeDataProcessing(BinaryWriter& w, const std::vector<DataProcessing>& processing)
+    {
+      w.putSize(processing.size());
+      for (const DataProcessing& dp : processing)
+      {
+        w.putString(dp.getSoftware().getName());
+        w.putString(dp.getSoftware().getVersion());
+        w.putSize(dp.getProcessingActions().size());
+        for (DataProcessing::ProcessingAction action : dp.getProcessingActions())
+        {
+          w.put<Byte>(action);
+        }
+        writeDateTime(w, dp.getCompletionTime());
+        writeMetaInfo(w, dp);
+      }
+    }
+
+    void readDataProcessing(BinaryReader& r, std::vector<DataProcessing>& processing)
+    {
+      // name, version, action count, completion time, meta value count
+      processing.resize(r.getCount(3 * sizeof(UInt32) + sizeof(UInt64) + sizeof(UInt32)));
+      for (DataProcessing& dp : processing)
+      {
+        dp.getSoftware().setName(r.getString());
+        dp.getSoftware().setVersion(r.getString());
+        Size n_actions = r.getSize();
+        for (Size i = 0; i < n_actions; ++i)
+        {
+          Byte action = r.get<Byte>();
+          if (action >= DataProcessing::SIZE_OF_PROCESSINGACTION)
+          {
+            r.fail(String("invalid processing action ") + UInt(action));
+          }
+          dp.getProcessingActions().insert(DataProcessing::ProcessingAction(action));
+        }
+        DateTime completion_time;
+        readDateTime(r, completion_time);
+        dp.setCompletionTime(completion_time);
+        readMetaInfo(r, dp);
+      }
+    }
+
+    void writeProteinGroups(BinaryWriter& w, const std::vector<ProteinIdentification::ProteinGroup>& groups)
+    {
+      w.putSize(groups.size());
+      for (const ProteinIdentification::ProteinGroup& group : groups)
+      {
+        w.put<double>(group.probability);
+        w.putStrings(group.accessions);
+      }
+    }
+
+    void readProteinGroups(BinaryReader& r, std::vector<ProteinIdentification::ProteinGroup>& groups)
+    {
+      // probability, accession count
+      groups.resize(r.getCount(sizeof(double) + sizeof(UInt64)));
+      for (ProteinIdentification::ProteinGroup& group : groups)
+      {
+        group.probability = r.get<double>();
+        r.getStrings(group.accessions);
+      }
+    }
+
+    void writeProteinIdentifications(BinaryWriter& w, const std::vector<ProteinIdentification>& ids)
+    {
+      w.putSize(ids.size());
+      for (const ProteinIdentification& id : ids)
+      {
+        w.putString(id.getIdentifier());
+        w.putString(id.getSearchEngine());
+        w.putString(id.getSearchEngineVersion());
+        writeDateTime(w, id.getDateTime());
+        w.putString(id.getScoreType());
+        w.put<Byte>(id.isHigherScoreBetter());
+        w.put<double>(id.getSignificanceThreshold());
+
+        const ProteinIdentification::SearchParameters& params = id.getSearchParameters();
+        w.putString(params.db);
+        w.putString(params.db_version);
+        w.putString(params.taxonomy);
+        w.putString(params.charges);
+        w.put<Byte>(params.mass_type);
+        w.putStrings(params.fixed_modifications);
+        w.putStrings(params.variable_modifications);
+        w.put<UInt32>(params.missed_cleavages);
+        w.put<double>(params.fragment_mass_tolerance);
+        w.put<Byte>(params.fragment_mass_tolerance_ppm);
+        w.put<double>(params.precursor_mass_tolerance);
+        w.put<Byte>(params.precursor_mass_tolerance_ppm);
+        w.putString(params.digestion_enzyme.getName());
+        writeMetaInfo(w, params);
+
+        // protein hits: numeric columns first, then strings and meta values per hit
+        const std::vector<ProteinHit>& hits = id.getHits();
+        std::vector<double> scores, coverages;
+        std::vector<UInt32> ranks;
+        for (const ProteinHit& hit : hits)
+        {
+          scores.push_back(hit.getScore());
+          coverages.push_back(hit.getCoverage());
+          ranks.push_back(hit.getRank());
+        }
+        w.putSize(hits.size());
+        w.putColumn(scores);
+        w.putColumn(coverages);
+        w.putColumn(ranks);
+        for (const ProteinHit& hit : hits)
+        {
+          w.putString(hit.getAccession());
+          w.putString(hit.getSequence());
+          writeMetaInfo(w, hit);
+        }
+
+        writeProteinGroups(w, id.getProteinGroups());
+        writeProteinGroups(w, id.getIndistinguishableProteins());
+        writeMetaInfo(w, id);
+      }
+    }
+
+    void readProteinIdentifications(BinaryReader& r, std::vector<ProteinIdentification>& ids)
+    {
+      // 10 strings, 4 flags, 3 doubles, missed cleavages, 2 meta value counts, 5 list counts
+      ids.resize(r.getCount(10 * sizeof(UInt32) + 4 * sizeof(Byte) + 3 * sizeof(double) + sizeof(UInt32) +
+                            2 * sizeof(UInt32) + 5 * sizeof(UInt64)));
+      for (ProteinIdentification& id : ids)
+      {
+        id.setIdentifier(r.getString());
+        id.setSearchEngine(r.getString());
+        id.setSearchEngineVersion(r.getString());
+        DateTime date;
+        readDateTime(r, date);
+        id.setDateTime(date);
+        id.setScoreType(r.getString());
+        id.setHigherScoreBetter(r.get<Byte>() != 0);
+        id.setSignificanceThreshold(r.get<double>());
+
+        ProteinIdentification::SearchParameters& params = id.getSearchParameters();
+        params.db = r.getString();
+        params.db_version = r.getString();
+        params.taxonomy = r.getString();
+        params.charges = r.getString();
+        Byte mass_type = r.get<Byte>();
+        if (mass_type >= ProteinIdentification::SIZE_OF_PEAKMASSTYPE)
+        {
+          r.fail(String("invalid mass type ") + UInt(mass_type));
+        }
+        params.mass_type = ProteinIdentification::PeakMassType(mass_type);
+        r.getStrings(params.fixed_modifications);
+        r.getStrings(params.variable_modifications);
+        params.missed_cleavages = r.get<UInt32>();
+        params.fragment_mass_tolerance = r.get<double>();
+        params.fragment_mass_tolerance_ppm = r.get<Byte>() != 0;
+        params.precursor_mass_tolerance = r.get<double>();
+        params.precursor_mass_tolerance_ppm = r.get<Byte>() != 0;
+        const String& enzyme = r.getString();
+        if (ProteaseDB::getInstance()->hasEnzyme(enzyme))
+        {
+          params.digestion_enzyme = *(ProteaseDB::getInstance()->getEnzyme(enzyme));
+        }
+        readMetaInfo(r, params);
+
+        Size hit_count = r.getSize();
+        std::vector<double> scores, coverages;
+        std::vector<UInt32> ranks;
+        r.getColumn(scores, hit_count);
+        r.getColumn(coverages, hit_count);
+        r.getColumn(ranks, hit_count);
+        std::vector<ProteinHit> hits(hit_count);
+        for (Size i = 0; i < hit_count; ++i)
+        {
+          hits[i].setScore(scores[i]);
+          hits[i].setCoverage(coverages[i]);
+          hits[i].setRank(ranks[i]);
+          hits[i].setAccession(r.getString());
+          hits[i].setSequence(r.getString());
+          readMetaInfo(r, hits[i]);
+        }
+        id.setHits(hits);
+
+        readProteinGroups(r, id.getProteinGroups());
+        readProteinGroups(r, id.getIndistinguishableProteins());
+        readMetaInfo(r, id);
+      }
+    }
+
+    void writePeptideHit(BinaryWriter& w, const PeptideHit& hit)
+    {
+      w.putString(hit.getSequence().toString());
+
+      const std::vector<PeptideEvidence>& evidences = hit.getPeptideEvidences();
+      w.putSize(evidences.size());
+      for (const PeptideEvidence& pe : evidences)
+      {
+        w.putString(pe.getProteinAccession());
+        w.put<Int32>(pe.getStart());
+        w.put<Int32>(pe.getEnd());
+        w.put<char>(pe.getAABefore());
+        w.put<char>(pe.getAAAfter());
+      }
+
+      const std::vector<PeptideHit::PepXMLAnalysisResult>& results = hit.getAnalysisResults();
+      w.putSize(results.size());
+      for (const PeptideHit::PepXMLAnalysisResult& result : results)
+      {
+        w.putString(result.score_type);
+        w.put<Byte>(result.higher_is_better);
+        w.put<double>(result.main_score);
+        w.putSize(result.sub_scores.size());
+        for (const std::pair<const String, double>& sub_score : result.sub_scores)
+        {
+          w.putString(sub_score.first);
+          w.put<double>(sub_score.second);
+        }
+      }
+
+      const std::vector<PeptideHit::PeakAnnotation>& annotations = hit.getPeakAnnotations();
+      w.putSize(annotations.size());
+      for (const PeptideHit::PeakAnnotation& annotation : annotations)
+      {
+        w.putString(annotation.annotation);
+        w.put<Int32>(annotation.charge);
+        w.put<double>(annotation.mz);
+        w.put<double>(annotation.intensity);
+      }
+
+      writeMetaInfo(w, hit);
+    }
+
+    void readPeptideHit(BinaryReader& r, PeptideHit& hit)
+    {
+      hit.setSequence(r.getSequence());
+
+      // accession, start, end, flanking amino acids
+      std::vector<PeptideEvidence> evidences(r.getCount(sizeof(UInt32) + 2 * sizeof(Int32) + 2 * sizeof(char)));
+      for (PeptideEvidence& pe : evidences)
+      {
+        pe.setProteinAccession(r.getString());
+        pe.setStart(r.get<Int32>());
+        pe.setEnd(r.get<Int32>());
+        pe.setAABefore(r.get<char>());
+        pe.setAAAfter(r.get<char>());
+      }
+      hit.setPeptideEvidences(std::move(evidences));
+
+      // score type, direction, main score, sub score count
+      Size result_count = r.getCount(sizeof(UInt32) + sizeof(Byte) + sizeof(double) + sizeof(UInt64));
+      if (result_count != 0)
+      {
+        std::vector<PeptideHit::PepXMLAnalysisResult> results(result_count);
+        for (PeptideHit::PepXMLAnalysisResult& result : results)
+        {
+          result.score_type = r.getString();
+          result.higher_is_better = r.get<Byte>() != 0;
+          result.main_score = r.get<double>();
+          Size sub_score_count = r.getSize();
+          for (Size i = 0; i < sub_score_count; ++i)
+          {
+            const String& name = r.getString();
+            result.sub_scores[name] = r.get<double>();
+          }
+        }
+        hit.setAnalysisResults(results);
+      }
+
+      // annotation, charge, m/z, intensity
+      Size annotation_count = r.getCount(sizeof(UInt32) + sizeof(Int32) + 2 * sizeof(double));
+      if (annotation_count != 0)
+      {
+        std::vector<PeptideHit::PeakAnnotation> annotations(annotation_count);
+        for (PeptideHit::PeakAnnotation& annotation : annotations)
+        {
+          annotation.annotation = r.getString();
+          annotation.charge = r.get<Int32>();
+          annotation.mz = r.get<double>();
+          annotation.intensity = r.get<double>();
+        }
+        hit.setPeakAnnotations(annotations);
+      }
+
+      readMetaInfo(r, hit);
+    }
+
+    void writePeptideIdentifications(BinaryWriter& w, const std::vector<PeptideIdentification>& ids)
+    {
+      // positions and thresholds as columns
+      std::vector<double> rts, mzs, thresholds;
+      std::vector<Byte> higher_better;
+      for (const PeptideIdentification& id : ids)
+      {
+        rts.push_back(id.getRT());
+        mzs.push_back(id.getMZ());
+        thresholds.push_back(id.getSignificanceThreshold());
+        higher_better.push_back(id.isHigherScoreBetter());
+      }
+      w.putSize(ids.size());
+      w.putColumn(rts);
+      w.putColumn(mzs);
+      w.putColumn(thresholds);
+      w.putColumn(higher_better);
+
+      for (const PeptideIdentification& id : ids)
+      {
+        w.putString(id.getIdentifier());
+        w.putString(id.getScoreType());
+        w.putString(id.getBaseName());
+
+        const std::vector<PeptideHit>& hits = id.getHits();
+        std::vector<double> scores;
+        std::vector<UInt32> ranks;
+        std::vector<Int32> charges;
+        for (const PeptideHit& hit : hits)
+        {
+          scores.push_back(hit.getScore());
+          ranks.push_back(hit.getRank());
+          charges.push_back(hit.getCharge());
+        }
+        w.putSize(hits.size());
+        w.putColumn(scores);
+        w.putColumn(ranks);
+        w.putColumn(charges);
+        for (const PeptideHit& hit : hits)
+        {
+          writePeptideHit(w, hit);
+        }
+
+        writeMetaInfo(w, id);
+      }
+    }
+
+    void readPeptideIdentifications(BinaryReader& r, std::vector<PeptideIdentification>& ids)
+    {
+      Size count = r.getSize();
+      std::vector<double> rts, mzs, thresholds;
+      std::vector<Byte> higher_better;
+      r.getColumn(rts, count);
+      r.getColumn(mzs, count);
+      r.getColumn(thresholds, count);
+      r.getColumn(higher_better, count);
+
+      ids.resize(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        PeptideIdentification& id = ids[i];
+        id.setRT(rts[i]);
+        id.setMZ(mzs[i]);
+        id.setSignificanceThreshold(thresholds[i]);
+        id.setHigherScoreBetter(higher_better[i] != 0);
+        id.setIdentifier(r.getString());
+        id.setScoreType(r.getString());
+        id.setBaseName(r.getString());
+
+        Size hit_count = r.getSize();
+        std::vector<double> scores;
+        std::vector<UInt32> ranks;
+        std::vector<Int32> charges;
+        r.getColumn(scores, hit_count);
+        r.getColumn(ranks, hit_count);
+        r.getColumn(charges, hit_count);
+        std::vector<PeptideHit>& hits = id.getHits();
+        hits.resize(hit_count);
+        for (Size j = 0; j < hit_count; ++j)
+        {
+          hits[j].setScore(scores[j]);
+          hits[j].setRank(ranks[j]);
+          hits[j].setCharge(charges[j]);
+          readPeptideHit(r, hits[j]);
+        }
+
+        readMetaInfo(r, id);
+      }
+    }
+
+    /// writes features column-wise (used for the features of a map and, recursively, for subordinates)
+    template <typename FeatureContainer>
+    void writeFeatures(BinaryWriter& w, const FeatureContainer& features)
+    {
+      Size count = features.size();
+      std::vector<Feature::CoordinateType> rts(count), mzs(count);
+      std::vector<Feature::IntensityType> intensities(count);
+      std::vector<Feature::ChargeType> charges(count);
+      std::vector<Feature::QualityType> overall_qualities(count), qualities_rt(count), qualities_mz(count);
+      std::vector<Feature::WidthType> widths(count);
+      std::vector<UInt64> unique_ids(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        const Feature& f = features[i];
+        rts[i] = f.getRT();
+        mzs[i] = f.getMZ();
+        intensities[i] = f.getIntensity();
+        charges[i] = f.getCharge();
+        overall_qualities[i] = f.getOverallQuality();
+        qualities_rt[i] = f.getQuality(0);
+        qualities_mz[i] = f.getQuality(1);
+        widths[i] = f.getWidth();
+        unique_ids[i] = f.getUniqueId();
+      }
+      w.putSize(count);
+      w.putColumn(rts);
+      w.putColumn(mzs);
+      w.putColumn(intensities);
+      w.putColumn(charges);
+      w.putColumn(overall_qualities);
+      w.putColumn(qualities_rt);
+      w.putColumn(qualities_mz);
+      w.putColumn(widths);
+      w.putColumn(unique_ids);
+
+      for (Size i = 0; i < count; ++i)
+      {
+        const Feature& f = features[i];
+        writeMetaInfo(w, f);
+
+        // convex hulls (compressed, as in featureXML)
+        w.putSize(f.getConvexHulls().size());
+        for (ConvexHull2D hull : f.getConvexHulls())
+        {
+          hull.compress();
+          const ConvexHull2D::PointArrayType& points = hull.getHullPoints();
+          w.putSize(points.size());
+          w.putColumn(points);
+        }
+
+        writePeptideIdentifications(w, f.getPeptideIdentifications());
+        writeFeatures(w, f.getSubordinates());
+      }
+    }
+
+    template <typename FeatureContainer>
+    void readFeatures(BinaryReader& r, FeatureContainer& features)
+    {
+      Size count = r.getSize();
+      std::vector<Feature::CoordinateType> rts, mzs;
+      std::vector<Feature::IntensityType> intensities;
+      std::vector<Feature::ChargeType> charges;
+      std::vector<Feature::QualityType> overall_qualities, qualities_rt, qualities_mz;
+      std::vector<Feature::WidthType> widths;
+      std::vector<UInt64> unique_ids;
+      r.getColumn(rts, count);
+      r.getColumn(mzs, count);
+      r.getColumn(intensities, count);
+      r.getColumn(charges, count);
+      r.getColumn(overall_qualities, count);
+      r.getColumn(qualities_rt, count);
+      r.getColumn(qualities_mz, count);
+      r.getColumn(widths, count);
+      r.getColumn(unique_ids, count);
+
+      features.resize(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        Feature& f = features[i];
+        f.setRT(rts[i]);
+        f.setMZ(mzs[i]);
+        f.setIntensity(intensities[i]);
+        f.setCharge(charges[i]);
+        f.setOverallQuality(overall_qualities[i]);
+        f.setQuality(0, qualities_rt[i]);
+        f.setQuality(1, qualities_mz[i]);
+        f.setUniqueId(unique_ids[i]);
+        readMetaInfo(r, f);
+        // the width is mirrored in the "FWHM" meta value (see BaseFeature::setWidth())
+        if (f.metaValueExists("FWHM"))
+        {
+          f.setWidth(widths[i]);
+        }
+
+        std::vector<ConvexHull2D>& hulls = f.getConvexHulls();
+        // point count
+        hulls.resize(r.getCount(sizeof(UInt64)));
+        for (ConvexHull2D& hull : hulls)
+        {
+          ConvexHull2D::PointArrayType points;
+          r.getColumn(points, r.getSize());
+          hull.setHullPoints(points);
+        }
+
+        readPeptideIdentifications(r, f.getPeptideIdentifications());
+        readFeatures(r, f.getSubordinates());
+      }
+    }
+
+    template <typename ConsensusContainer>
+    void writeConsensusFeatures(BinaryWriter& w, const ConsensusContainer& features)
+    {
+      Size count = features.size();
+      std::vector<ConsensusFeature::CoordinateType> rts(count), mzs(count);
+      std::vector<ConsensusFeature::IntensityType> intensities(count);
+      std::vector<ConsensusFeature::ChargeType> charges(count);
+      std::vector<ConsensusFeature::QualityType> qualities(count);
+      std::vector<ConsensusFeature::WidthType> widths(count);
+      std::vector<UInt64> unique_ids(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        const ConsensusFeature& f = features[i];
+        rts[i] = f.getRT();
+        mzs[i] = f.getMZ();
+        intensities[i] = f.getIntensity();
+        charges[i] = f.getCharge();
+        qualities[i] = f.getQuality();
+        widths[i] = f.getWidth();
+        unique_ids[i] = f.getUniqueId();
+      }
+      w.putSize(count);
+      w.putColumn(rts);
+      w.putColumn(mzs);
+      w.putColumn(intensities);
+      w.putColumn(charges);
+      w.putColumn(qualities);
+      w.putColumn(widths);
+      w.putColumn(unique_ids);
+
+      for (Size i = 0; i < count; ++i)
+      {
+        const ConsensusFeature& f = features[i];
+
+        // feature handles as columns
+        Size handle_count = f.size();
+        std::vector<UInt64> map_indices, element_ids;
+        std::vector<FeatureHandle::CoordinateType> handle_rts, handle_mzs;
+        std::vector<FeatureHandle::IntensityType> handle_intensities;
+        std::vector<FeatureHandle::ChargeType> handle_charges;
+        std::vector<FeatureHandle::WidthType> handle_widths;
+        for (const FeatureHandle& h : f)
+        {
+          map_indices.push_back(h.getMapIndex());
+          element_ids.push_back(h.getUniqueId());
+          handle_rts.push_back(h.getRT());
+          handle_mzs.push_back(h.getMZ());
+          handle_intensities.push_back(h.getIntensity());
+          handle_charges.push_back(h.getCharge());
+          handle_widths.push_back(h.getWidth());
+        }
+        w.putSize(handle_count);
+        w.putColumn(map_indices);
+        w.putColumn(element_ids);
+        w.putColumn(handle_rts);
+        w.putColumn(handle_mzs);
+        w.putColumn(handle_intensities);
+        w.putColumn(handle_charges);
+        w.putColumn(handle_widths);
+
+        std::vector<ConsensusFeature::Ratio> ratios = f.getRatios();
+        w.putSize(ratios.size());
+        for (const ConsensusFeature::Ratio& ratio : ratios)
+        {
+          w.put<double>(ratio.ratio_value_);
+          w.putString(ratio.denominator_ref_);
+          w.putString(ratio.numerator_ref_);
+          w.putStrings(ratio.description_);
+        }
+
+        writeMetaInfo(w, f);
+        writePeptideIdentifications(w, f.getPeptideIdentifications());
+      }
+    }
+
+    template <typename ConsensusContainer>
+    void readConsensusFeatures(BinaryReader& r, ConsensusContainer& features)
+    {
+      Size count = r.getSize();
+      std::vector<ConsensusFeature::CoordinateType> rts, mzs;
+      std::vector<ConsensusFeature::IntensityType> intensities;
+      std::vector<ConsensusFeature::ChargeType> charges;
+      std::vector<ConsensusFeature::QualityType> qualities;
+      std::vector<ConsensusFeature::WidthType> widths;
+      std::vector<UInt64> unique_ids;
+      r.getColumn(rts, count);
+      r.getColumn(mzs, count);
+      r.getColumn(intensities, count);
+      r.getColumn(charges, count);
+      r.getColumn(qualities, count);
+      r.getColumn(widths, count);
+      r.getColumn(unique_ids, count);
+
+      features.resize(count);
+      std::vector<FeatureHandle> handles;
+      for (Size i = 0; i < count; ++i)
+      {
+        ConsensusFeature& f = features[i];
+        f.setRT(rts[i]);
+        f.setMZ(mzs[i]);
+        f.setIntensity(intensities[i]);
+        f.setCharge(charges[i]);
+        f.setQuality(qualities[i]);
+        f.setUniqueId(unique_ids[i]);
+
+        Size handle_count = r.getSize();
+        std::vector<UInt64> map_indices, element_ids;
+        std::vector<FeatureHandle::CoordinateType> handle_rts, handle_mzs;
+        std::vector<FeatureHandle::IntensityType> handle_intensities;
+        std::vector<FeatureHandle::ChargeType> handle_charges;
+        std::vector<FeatureHandle::WidthType> handle_widths;
+        r.getColumn(map_indices, handle_count);
+        r.getColumn(element_ids, handle_count);
+        r.getColumn(handle_rts, handle_count);
+        r.getColumn(handle_mzs, handle_count);
+        r.getColumn(handle_intensities, handle_count);
+        r.getColumn(handle_charges, handle_count);
+        r.getColumn(handle_widths, handle_count);
+        handles.resize(handle_count);
+        for (Size j = 0; j < handle_count; ++j)
+        {
+          FeatureHandle& h = handles[j];
+          h.setMapIndex(map_indices[j]);
+          h.setUniqueId(element_ids[j]);
+          h.setRT(handle_rts[j]);
+          h.setMZ(handle_mzs[j]);
+          h.setIntensity(handle_intensities[j]);
+          h.setCharge(handle_charges[j]);
+          h.setWidth(handle_widths[j]);
+        }
+        f.insert(handles);
+
+        // value, denominator, numerator, description count
+        Size ratio_count = r.getCount(sizeof(double) + 2 * sizeof(UInt32) + sizeof(UInt64));
+        if (ratio_count != 0)
+        {
+          std::vector<ConsensusFeature::Ratio> ratios(ratio_count);
+          for (ConsensusFeature::Ratio& ratio : ratios)
+          {
+            ratio.ratio_value_ = r.get<double>();
+            ratio.denominator_ref_ = r.getString();
+            ratio.numerator_ref_ = r.getString();
+            r.getStrings(ratio.description_);
+          }
+          f.setRatios(ratios);
+        }
+
+        readMetaInfo(r, f);
+        if (f.metaValueExists("FWHM"))
+        {
+          f.setWidth(widths[i]);
+        }
+        readPeptideIdentifications(r, f.getPeptideIdentifications());
+      }
+    }
+
+    void writeColumnHeaders(BinaryWriter& w, const ConsensusMap::ColumnHeaders& headers)
+    {
+      w.putSize(headers.size());
+      for (const std::pair<const UInt64, ConsensusMap::ColumnHeader>& header : headers)
+      {
+        w.put<UInt64>(header.first);
+        w.putString(header.second.filename);
+        w.putString(header.second.label);
+        w.putSize(header.second.size);
+        w.put<UInt64>(header.second.unique_id);
+        writeMetaInfo(w, header.second);
+      }
+    }
+
+    void readColumnHeaders(BinaryReader& r, ConsensusMap::ColumnHeaders& headers)
+    {
+      headers.clear();
+      Size count = r.getSize();
+      for (Size i = 0; i < count; ++i)
+      {
+        ConsensusMap::ColumnHeader& header = headers[r.get<UInt64>()];
+        header.filename = r.getString();
+        header.label = r.getString();
+        header.size = r.getSize();
+        header.unique_id = r.get<UInt64>();
+        readMetaInfo(r, header);
+      }
+    }
+  }
+
+  OMSBinFile::OMSBinFile() :
+    ProgressLogger()
+  {
+  }
+
+  OMSBinFile::~OMSBinFile()
+  {
+  }
+
+  void OMSBinFile::load(const String& filename, FeatureMap& feature_map)
+  {
+    std::string buffer;
+    readFile(filename, buffer);
+    BinaryReader reader(filename, buffer);
+    reader.readHeader(FEATURES);
+
+    startProgress(0, 1, "Loading binary feature map");
+    feature_map.clear(true);
+    feature_map.setLoadedFileType(filename);
+    feature_map.setLoadedFilePath(filename);
+    feature_map.setIdentifier(reader.getString());
+    feature_map.setUniqueId(reader.get<UInt64>());
+    readMetaInfo(reader, feature_map);
+    readDataProcessing(reader, feature_map.getDataProcessing());
+    readProteinIdentifications(reader, feature_map.getProteinIdentifications());
+    readPeptideIdentifications(reader, feature_map.getUnassignedPeptideIdentifications());
+    readFeatures(reader, feature_map);
+    if (!reader.atEnd())
+    {
+      reader.fail("unexpected data after the end of the feature map");
+    }
+    feature_map.updateRanges();
+    endProgress();
+  }
+
+  void OMSBinFile::store(const String& filename, const FeatureMap& feature_map)
+  {
+    startProgress(0, 1, "Storing binary feature map");
+    BinaryWriter writer;
+    writer.putString(feature_map.getIdentifier());
+    writer.put<UInt64>(feature_map.getUniqueId());
+    writeMetaInfo(writer, feature_map);
+    writeDataProcessing(writer, feature_map.getDataProcessing());
+    writeProteinIdentifications(writer, feature_map.getProteinIdentifications());
+    writePeptideIdentifications(writer, feature_map.getUnassignedPeptideIdentifications());
+    writeFeatures(writer, feature_map);
+    writer.writeTo(filename, FEATURES);
+    endProgress();
+  }
+
+  void OMSBinFile::load(const String& filename, ConsensusMap& consensus_map)
+  {
+    std::string buffer;
+    readFile(filename, buffer);
+    BinaryReader reader(filename, buffer);
+    reader.readHeader(CONSENSUS);
+
+    startProgress(0, 1, "Loading binary consensus map");
+    consensus_map.clear(true);
+    consensus_map.setLoadedFileType(filename);
+    consensus_map.setLoadedFilePath(filename);
+    consensus_map.setIdentifier(reader.getString());
+    consensus_map.setUniqueId(reader.get<UInt64>());
+    consensus_map.setExperimentType(reader.getString());
+    readMetaInfo(reader, consensus_map);
+    readColumnHeaders(reader, consensus_map.getColumnHeaders());
+    readDataProcessing(reader, consensus_map.getDataProcessing());
+    readProteinIdentifications(reader, consensus_map.getProteinIdentifications());
+    readPeptideIdentifications(reader, consensus_map.getUnassignedPeptideIdentifications());
+    readConsensusFeatures(reader, consensus_map);
+    if (!reader.atEnd())
+    {
+      reader.fail("unexpected data after the end of the consensus map");
+    }
+    consensus_map.updateRanges();
+    endProgress();
+  }
+
+  void OMSBinFile::store(const String& filename, const ConsensusMap& consensus_map)
+  {
+    startProgress(0, 1, "Storing binary consensus map");
+    BinaryWriter writer;
+    writer.putString(consensus_map.getIdentifier());
+    writer.put<UInt64>(consensus_map.getUniqueId());
+    writer.putString(consensus_map.getExperimentType());
+    writeMetaInfo(writer, consensus_map);
+    writeColumnHeaders(writer, consensus_map.getColumnHeaders());
+    writeDataProcessing(writer, consensus_map.getDataProcessing());
+    writeProteinIdentifications(writer, consensus_map.getProteinIdentifications());
+    writePeptideIdentifications(writer, consensus_map.getUnassignedPeptideIdentifications());
+    writeConsensusFeatures(writer, consensus_map);
+    writer.writeTo(filename, CONSENSUS);
+    endProgress();
+  }
+
+  void OMSBinFile::load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)
+  {
+    std::string buffer;
+    readFile(filename, buffer);
+    BinaryReader reader(filename, buffer);
+    reader.readHeader(IDENTIFICATIONS);
+
+    startProgress(0, 1, "Loading binary identifications");
+    readProteinIdentifications(reader, protein_ids);
+    readPeptideIdentifications(reader, peptide_ids);
+    if (!reader.atEnd())
+    {
+      reader.fail("unexpected data after the end of the identifications");
+    }
+    endProgress();
+  }
+
+  void OMSBinFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    startProgress(0, 1, "Storing binary identifications");
+    BinaryWriter writer;
+    writeProteinIdentifications(writer, protein_ids);
+    writePeptideIdentifications(writer, peptide_ids);
+    writer.writeTo(filename, IDENTIFICATIONS);
+    endProgress();
+  }
+
+  bool OMSBinFile::isOMSBinFile(const String& filename)
+  {
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+    char magic[sizeof(OMSBIN_MAGIC)];
+    return is.read(magic, sizeof(magic)) && memcmp(magic, OMSBIN_MAGIC, sizeof(magic)) == 0;
+  }
+
+  OMSBinFile::ContentType OMSBinFile::getContentType(const String& filename)
+  {
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    char magic[sizeof(OMSBIN_MAGIC)];
+    UInt32 version = 0, content = 0;
+    if (!is.read(magic, sizeof(magic)) || memcmp(magic, OMSBIN_MAGIC, sizeof(magic)) != 0 ||
+        !is.read(reinterpret_cast<char*>(&version), sizeof(version)) ||
+        !is.read(reinterpret_cast<char*>(&content), sizeof(content)) ||
+        content < FEATURES || content > IDENTIFICATIONS)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "File is not a binary OpenMS file. Aborting!");
+    }
+    return ContentType(content);
+  }
+
+} // namespace OpenMS
@@ -87,8 +87,7 @@ namespace OpenMS
     ZlibCompression::uncompressString(compressed_data, raw_data);
 
     // Note that we may have zero bytes in the string, so we cannot use QString
-    uncompressed.clear();
-    uncompressed = std::string(raw_data.data(), raw_data.size());
+    uncompressed.assign(raw_data.data(), raw_data.size());
   }
 
   void ZlibCompression::uncompressString(const QByteArray& compressed_data, QByteArray& raw_data)
@@ -17,6 +17,7 @@ ControlledVocabulary.cpp
 CsvFile.cpp
 DTA2DFile.cpp
 DTAFile.cpp
+DelimitedTextReader.cpp
 EDTAFile.cpp
 ExperimentalDesignFile.cpp
 FASTAFile.cpp
@@ -52,6 +53,7 @@ MzQuantMLFile.cpp
 MzTab.cpp
 MzTabFile.cpp
 MzXMLFile.cpp
+OMSBinFile.cpp
 OMSSACSVFile.cpp
 OMSSAXMLFile.cpp
 OSWFile.cpp
@@ -87,7 +87,7 @@ namespace OpenMS
 
   void ConsensusFeature::insert(const ConsensusFeature& cf)
   {
-    handles_.insert(cf.handles_.begin(), cf.handles_.end());
+    handles_.insert(boost::container::ordered_unique_range, cf.handles_.begin(), cf.handles_.end());
   }
 
   void ConsensusFeature::insert(const FeatureHandle& handle)
@@ -107,6 +107,17 @@ namespace OpenMS
     }
   }
 
+  void ConsensusFeature::insert(const std::vector<FeatureHandle>& handles)
+  {
+    Size expected_size = handles_.size() + handles.size();
+    handles_.insert(handles.begin(), handles.end());
+    if (handles_.size() != expected_size)
+    {
+      String key = String(expected_size - handles_.size()) + " duplicate handle(s)";
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The set already contained an element with this key.", key);
+    }
+  }
+
   void ConsensusFeature::insert(UInt64 map_index, const Peak2D& element, UInt64 element_index)
   {
     insert(FeatureHandle(map_index, element, element_index));
@@ -35,8 +35,139 @@
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 
 #include <OpenMS/FORMAT/MzMLFile.h>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QDateTime>
+
+#include <exception>
+#include <fstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
+  namespace
+  {
+    /// identifier and version of the spectrum index cache file
+    const UInt32 INDEX_FILE_IDENTIFIER = 0x52544901;
+
+    template <typename T>
+    void writeValue(std::ofstream& ofs, const T& value)
+    {
+      ofs.write((const char*)&value, sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream& ifs, T& value)
+    {
+      ifs.read((char*)&value, sizeof(T));
+      return bool(ifs);
+    }
+
+    /// size and modification time of the data file (to detect outdated caches)
+    void fileFingerprint(const String& filename, Int64& size, Int64& modified)
+    {
+      QFileInfo info(filename.toQString());
+      size = info.size();
+      modified = info.lastModified().toMSecsSinceEpoch();
+    }
+
+    /**
+      @brief Finds the cvParam with the given accession in text[from, end)
+
+      On success, @p value holds its value attribute and @p tag the text of the whole tag.
+    */
+    bool findCVParam(const std::string& text, Size from, Size end, const std::string& accession, String& value, std::string& tag)
+    {
+      Size pos = text.find("accession=\"" + accession + "\"", from);
+      if (pos == std::string::npos || pos >= end)
+      {
+        return false;
+      }
+      Size tag_begin = text.rfind('<', pos);
+      Size tag_end = text.find('>', pos);
+      if (tag_begin == std::string::npos || tag_end == std::string::npos)
+      {
+        return false;
+      }
+      tag = text.substr(tag_begin, tag_end - tag_begin);
+
+      value.clear();
+      Size value_pos = tag.find(" value=\"");
+      if (value_pos != std::string::npos)
+      {
+        value_pos += 8;
+        value = tag.substr(value_pos, tag.find('"', value_pos) - value_pos);
+      }
+      return true;
+    }
+
+    /// Reads RT, MS level and precursor m/z from the XML of a spectrum (data arrays are not touched)
+    OnDiscMSExperiment::SpectrumIndexEntry parseSpectrumHeader(const std::string& text)
+    {
+      OnDiscMSExperiment::SpectrumIndexEntry entry;
+      entry.rt = -1.0; // same defaults as MSSpectrum
+      entry.ms_level = 1;
+      entry.precursor_mz = 0.0;
+
+      // everything we need is in front of the data arrays
+      Size header_end = text.find("<binaryDataArrayList");
+      if (header_end == std::string::npos)
+      {
+        header_end = text.size();
+      }
+
+      String value;
+      std::string tag;
+      if (findCVParam(text, 0, header_end, "MS:1000511", value, tag)) // ms level
+      {
+        entry.ms_level = value.toInt();
+      }
+      if (findCVParam(text, 0, header_end, "MS:1000016", value, tag)) // scan start time
+      {
+        entry.rt = value.toDouble();
+        if (tag.find("\"UO:0000031\"") != std::string::npos) // minute
+        {
+          entry.rt *= 60.0;
+        }
+      }
+      Size precursors = text.find("<precursorList", 0);
+      if (precursors < header_end && findCVParam(text, precursors, header_end, "MS:1000744", value, tag)) // selected ion m/z
+      {
+        entry.precursor_mz = value.toDouble();
+      }
+      return entry;
+    }
+
+    /// Sets RT, MS level and precursor of a spectrum read without meta data
+    void annotateSpectrum(const OnDiscMSExperiment::SpectrumIndexEntry& entry, MSSpectrum& spectrum)
+    {
+      spectrum.setRT(entry.rt);
+      spectrum.setMSLevel(static_cast<UInt>(entry.ms_level));
+      if (entry.precursor_mz > 0.0)
+      {
+        Precursor precursor;
+        precursor.setMZ(entry.precursor_mz);
+        spectrum.setPrecursors(std::vector<Precursor>(1, precursor));
+      }
+    }
+
+    struct RTLess
+    {
+      bool operator()(const OnDiscMSExperiment::SpectrumIndexEntry& entry, double rt) const
+      {
+        return entry.rt < rt;
+      }
+
+      bool operator()(double rt, const OnDiscMSExperiment::SpectrumIndexEntry& entry) const
+      {
+        return rt < entry.rt;
+      }
+    };
+  }
+
 
   void OnDiscMSExperiment::loadMetaData_(const String& filename)
   {
@@ -48,5 +179,288 @@ namespace OpenMS
     f.setOptions(options);
     f.load(filename, *meta_ms_experiment_.get());
   }
+
+  bool OnDiscMSExperiment::isSortedByRT() const
+  {
+    if (meta_ms_experiment_)
+    {
+      return meta_ms_experiment_->isSorted(false);
+    }
+    // building the index (if needed) does not change the observable state
+    const std::vector<SpectrumIndexEntry>& index = const_cast<OnDiscMSExperiment*>(this)->getSpectrumIndex();
+    for (Size i = 1; i < index.size(); ++i)
+    {
+      if (index[i].rt < index[i - 1].rt)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<MSSpectrum> OnDiscMSExperiment::getSpectra(const std::vector<Size>& ids)
+  {
+    std::vector<MSSpectrum> spectra(ids.size());
+    std::vector<int> int_ids(ids.begin(), ids.end());
+    if (meta_ms_experiment_)
+    {
+      for (Size i = 0; i < ids.size(); ++i)
+      {
+        spectra[i] = meta_ms_experiment_->getSpectrum(ids[i]);
+      }
+      indexed_mzml_file_.getMSSpectraById(int_ids, spectra);
+    }
+    else
+    {
+      indexed_mzml_file_.getMSSpectraById(int_ids, spectra);
+      const std::vector<SpectrumIndexEntry>& index = getSpectrumIndex();
+      for (Size i = 0; i < ids.size(); ++i)
+      {
+        annotateSpectrum(index[ids[i]], spectra[i]);
+      }
+    }
+    return spectra;
+  }
+
+  const std::vector<OnDiscMSExperiment::SpectrumIndexEntry>& OnDiscMSExperiment::getSpectrumIndex()
+  {
+    buildSpectrumIndex_();
+    return spectrum_index_->entries;
+  }
+
+  Size OnDiscMSExperiment::RTBegin(double rt)
+  {
+    const std::vector<SpectrumIndexEntry>& index = getSpectrumIndex();
+    return std::lower_bound(index.begin(), index.end(), rt, RTLess()) - index.begin();
+  }
+
+  Size OnDiscMSExperiment::RTEnd(double rt)
+  {
+    const std::vector<SpectrumIndexEntry>& index = getSpectrumIndex();
+    return std::upper_bound(index.begin(), index.end(), rt, RTLess()) - index.begin();
+  }
+
+  std::vector<Size> OnDiscMSExperiment::getSpectraInRTRange(double rt_min, double rt_max, Int ms_level)
+  {
+    const std::vector<SpectrumIndexEntry>& index = getSpectrumIndex();
+    std::vector<Size> result;
+    for (Size i = 0; i < index.size(); ++i)
+    {
+      if (index[i].rt >= rt_min && index[i].rt <= rt_max &&
+          (ms_level == 0 || index[i].ms_level == ms_level))
+      {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  std::vector<Size> OnDiscMSExperiment::getSpectraByPrecursorMZ(double mz_min, double mz_max, double rt_min, double rt_max)
+  {
+    const std::vector<SpectrumIndexEntry>& index = getSpectrumIndex();
+    std::vector<Size> result;
+    for (Size i = 0; i < index.size(); ++i)
+    {
+      if (index[i].precursor_mz > 0.0 &&
+          index[i].precursor_mz >= mz_min && index[i].precursor_mz <= mz_max &&
+          index[i].rt >= rt_min && index[i].rt <= rt_max)
+      {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  void OnDiscMSExperiment::getArea(double rt_min, double rt_max, double mz_min, double mz_max, Int ms_level, PeakMap& output)
+  {
+    output.clear(true);
+
+    std::vector<Size> ids = getSpectraInRTRange(rt_min, rt_max, ms_level);
+    output.reserveSpaceSpectra(ids.size());
+    for (Size i = 0; i < ids.size(); ++i)
+    {
+      MSSpectrum spectrum = getSpectrum(ids[i]);
+      if (!spectrum.isSorted())
+      {
+        spectrum.sortByPosition();
+      }
+      // select() keeps the data arrays in sync with the peaks
+      std::vector<Size> selected;
+      Size begin = spectrum.MZBegin(mz_min) - spectrum.begin();
+      Size end = spectrum.MZEnd(mz_max) - spectrum.begin();
+      for (Size p = begin; p < end; ++p)
+      {
+        selected.push_back(p);
+      }
+      spectrum.select(selected);
+      output.addSpectrum(std::move(spectrum));
+    }
+    output.updateRanges();
+  }
+
+  void OnDiscMSExperiment::buildSpectrumIndex_()
+  {
+    // called for every spectrum by getSpectrum(): no locking once built
+    if (spectrum_index_->built.load(std::memory_order_acquire))
+    {
+      return;
+    }
+
+    // the index is shared by all copies of this object, which may be used
+    // concurrently (e.g. firstprivate copies in an OpenMP loop)
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_OnDiscMSExperiment_index)
+#endif
+    {
+      if (!spectrum_index_->built.load(std::memory_order_relaxed))
+      {
+        try
+        {
+          readSpectrumIndex_();
+          spectrum_index_->built.store(true, std::memory_order_release);
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  void OnDiscMSExperiment::readSpectrumIndex_()
+  {
+    spectrum_index_->entries.clear();
+
+    String cache_file = getIndexFilename(filename_);
+    if (index_caching_ && loadSpectrumIndex_(cache_file))
+    {
+      return;
+    }
+
+    std::vector<SpectrumIndexEntry> index(getNrSpectra());
+    if (meta_ms_experiment_ && meta_ms_experiment_->size() == getNrSpectra())
+    {
+      // all we need is in memory already
+      for (Size i = 0; i < meta_ms_experiment_->size(); ++i)
+      {
+        const MSSpectrum& spectrum = (*meta_ms_experiment_)[i];
+        index[i].rt = spectrum.getRT();
+        index[i].ms_level = static_cast<Int>(spectrum.getMSLevel());
+        index[i].precursor_mz = spectrum.getPrecursors().empty() ? 0.0 : spectrum.getPrecursors()[0].getMZ();
+      }
+    }
+    else
+    {
+      // read only the spectrum headers (up to the data arrays) using the
+      // offsets of the indexedmzML; positioned reads allow doing this in parallel
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)index.size(); ++i)
+      {
+        try
+        {
+          try
+          {
+            index[i] = parseSpectrumHeader(indexed_mzml_file_.getSpectrumHeaderXMLById(static_cast<int>(i)));
+          }
+          catch (Exception::ConversionError& e)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, e.what(),
+                                        "while reading the header of spectrum " + String(i) + " in " + filename_);
+          }
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_OnDiscMSExperiment_error)
+#endif
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error) std::rethrow_exception(error);
+    }
+    spectrum_index_->entries.swap(index);
+
+    if (index_caching_ && !is_copy_)
+    {
+      storeSpectrumIndex_(cache_file);
+    }
+  }
+
+  bool OnDiscMSExperiment::loadSpectrumIndex_(const String& filename)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    if (!ifs)
+    {
+      return false;
+    }
+
+    UInt32 identifier(0);
+    Int64 size(0), modified(0), expected_size(0), expected_modified(0);
+    UInt64 n(0);
+    fileFingerprint(filename_, expected_size, expected_modified);
+    if (!readValue(ifs, identifier) || identifier != INDEX_FILE_IDENTIFIER ||
+        !readValue(ifs, size) || size != expected_size ||
+        !readValue(ifs, modified) || modified != expected_modified ||
+        !readValue(ifs, n) || n != getNrSpectra())
+    {
+      return false;
+    }
+
+    std::vector<SpectrumIndexEntry> index(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      Int32 ms_level(0);
+      if (!readValue(ifs, index[i].rt) || !readValue(ifs, ms_level) || !readValue(ifs, index[i].precursor_mz))
+      {
+        return false;
+      }
+      index[i].ms_level = ms_level;
+    }
+    spectrum_index_->entries.swap(index);
+    return true;
+  }
+
+  void OnDiscMSExperiment::storeSpectrumIndex_(const String& filename) const
+  {
+    // the cache is optional: if it cannot be written (e.g. read-only
+    // directory), the index is simply built again next time
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    if (!ofs)
+    {
+      return;
+    }
+
+    Int64 size(0), modified(0);
+    fileFingerprint(filename_, size, modified);
+    writeValue(ofs, INDEX_FILE_IDENTIFIER);
+    writeValue(ofs, size);
+    writeValue(ofs, modified);
+    const std::vector<SpectrumIndexEntry>& index = spectrum_index_->entries;
+    writeValue(ofs, static_cast<UInt64>(index.size()));
+    for (Size i = 0; i < index.size(); ++i)
+    {
+      writeValue(ofs, index[i].rt);
+      writeValue(ofs, static_cast<Int32>(index[i].ms_level));
+      writeValue(ofs, index[i].precursor_mz);
+    }
+    ofs.close();
+    if (!ofs) // incomplete file -> remove it
+    {
+      std::remove(filename.c_str());
+    }
+  }
+
+  MSSpectrum OnDiscMSExperiment::getSpectrumFromIndex_(Size id)
+  {
+    MSSpectrum spectrum;
+    indexed_mzml_file_.getMSSpectrumById(static_cast<int>(id), spectrum);
+    annotateSpectrum(getSpectrumIndex()[id], spectrum);
+    return spectrum;
+  }
 } //namespace OpenMS
 
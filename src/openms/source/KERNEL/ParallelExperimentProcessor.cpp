@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
+
+#include <exception>
+
+namespace OpenMS
+{
+
+  ParallelExperimentProcessor::ParallelExperimentProcessor(Size chunk_size) :
+    ProgressLogger(),
+    lambda_spec_(nullptr),
+    lambda_chrom_(nullptr),
+    chunk_size_(std::max(chunk_size, Size(1)))
+  {
+  }
+
+  ParallelExperimentProcessor::~ParallelExperimentProcessor()
+  {
+  }
+
+  void ParallelExperimentProcessor::setSpectraProcessingFunc(SpectrumProcessingFunc f_spec)
+  {
+    lambda_spec_ = f_spec;
+  }
+
+  void ParallelExperimentProcessor::setChromatogramProcessingFunc(ChromatogramProcessingFunc f_chrom)
+  {
+    lambda_chrom_ = f_chrom;
+  }
+
+  void ParallelExperimentProcessor::setChunkSize(Size chunk_size)
+  {
+    chunk_size_ = std::max(chunk_size, Size(1));
+  }
+
+  Size ParallelExperimentProcessor::getChunkSize() const
+  {
+    return chunk_size_;
+  }
+
+  void ParallelExperimentProcessor::processExperiment(PeakMap& exp, const String& label) const
+  {
+    Size nr_items = (lambda_spec_ ? exp.size() : 0) + (lambda_chrom_ ? exp.getChromatograms().size() : 0);
+    startProgress(0, nr_items, label);
+    process_(exp.getSpectra(), lambda_spec_, true);
+    process_(exp.getChromatograms(), lambda_chrom_, true);
+    endProgress();
+  }
+
+  void ParallelExperimentProcessor::processSpectra(std::vector<MSSpectrum>& spectra) const
+  {
+    process_(spectra, lambda_spec_, false);
+  }
+
+  void ParallelExperimentProcessor::processChromatograms(std::vector<MSChromatogram>& chromatograms) const
+  {
+    process_(chromatograms, lambda_chrom_, false);
+  }
+
+  template <typename ContainerT, typename FuncT>
+  void ParallelExperimentProcessor::process_(ContainerT& data, const FuncT& func, bool report_progress) const
+  {
+    if (!func || data.empty()) return;
+
+    std::exception_ptr first_exception;
+    const SignedSize nr_items = static_cast<SignedSize>(data.size());
+    const int chunk_size = static_cast<int>(chunk_size_);
+
+#pragma omp parallel
+    {
+      // thread-local copy of the function, which copies all filter objects captured by value
+      FuncT local_func = func;
+
+#pragma omp for schedule(dynamic, chunk_size)
+      for (SignedSize i = 0; i < nr_items; ++i)
+      {
+        // exceptions must not leave the parallel region
+        try
+        {
+          local_func(data[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (OPENMS_ParallelExperimentProcessor_exception)
+          {
+            if (!first_exception) first_exception = std::current_exception();
+          }
+        }
+        if (report_progress)
+        {
+#pragma omp critical (OPENMS_ParallelExperimentProcessor_progress)
+          nextProgress();
+        }
+      }
+    }
+
+    if (first_exception) std::rethrow_exception(first_exception);
+  }
+
+} // namespace OpenMS
+
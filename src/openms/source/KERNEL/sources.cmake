@@ -18,6 +18,7 @@ MRMTransitionGroup.cpp
 MSExperiment.cpp
 MSSpectrum.cpp
 OnDiscMSExperiment.cpp
+ParallelExperimentProcessor.cpp
 Peak1D.cpp
 Peak2D.cpp
 PeakIndex.cpp
@@ -92,6 +92,64 @@ namespace OpenMS
   }
 
 
+  void IdentificationData::checkDataQuery_(const DataQuery& query) const
+  {
+    // reference to spectrum or feature is required:
+    if (query.data_id.empty())
+    {
+      String msg = "missing identifier in data query";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    // ref. to input file may be missing, but must otherwise be valid:
+    if (query.input_file_opt && !isValidReference_(*query.input_file_opt,
+                                                   input_files_))
+    {
+      String msg = "invalid reference to an input file - register that first";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+  }
+
+
+  void IdentificationData::checkIdentifiedPeptide_(const IdentifiedPeptide&
+                                                   peptide) const
+  {
+    if (peptide.sequence.empty())
+    {
+      String msg = "missing sequence for peptide";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    checkParentMatches_(peptide.parent_matches, MoleculeType::PROTEIN);
+  }
+
+
+  void IdentificationData::checkIdentifiedCompound_(const IdentifiedCompound&
+                                                    compound) const
+  {
+    if (compound.identifier.empty())
+    {
+      String msg = "missing identifier for compound";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+  }
+
+
+  void IdentificationData::checkIdentifiedOligo_(const IdentifiedOligo& oligo)
+    const
+  {
+    if (oligo.sequence.empty())
+    {
+      String msg = "missing sequence for oligonucleotide";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    checkParentMatches_(oligo.parent_matches, MoleculeType::RNA);
+  }
+
+
   IdentificationData::InputFileRef
   IdentificationData::registerInputFile(const String& file)
   {
@@ -188,21 +246,8 @@ namespace OpenMS
   IdentificationData::DataQueryRef
   IdentificationData::registerDataQuery(const DataQuery& query)
   {
-    // reference to spectrum or feature is required:
-    if (query.data_id.empty())
-    {
-      String msg = "missing identifier in data query";
-      throw Exception::IllegalArgument(__FILE__, __LINE__,
-                                       OPENMS_PRETTY_FUNCTION, msg);
-    }
-    // ref. to input file may be missing, but must otherwise be valid:
-    if (query.input_file_opt && !isValidReference_(*query.input_file_opt,
-                                                   input_files_))
-    {
-      String msg = "invalid reference to an input file - register that first";
-      throw Exception::IllegalArgument(__FILE__, __LINE__,
-                                       OPENMS_PRETTY_FUNCTION, msg);
-    }
+    checkDataQuery_(query);
+
     DataQueryRef ref = data_queries_.insert(query).first;
     data_query_lookup_.insert(ref);
     return ref;
@@ -213,13 +258,7 @@ namespace OpenMS
   IdentificationData::registerIdentifiedPeptide(const IdentifiedPeptide&
                                                 peptide)
   {
-    if (peptide.sequence.empty())
-    {
-      String msg = "missing sequence for peptide";
-      throw Exception::IllegalArgument(__FILE__, __LINE__,
-                                       OPENMS_PRETTY_FUNCTION, msg);
-    }
-    checkParentMatches_(peptide.parent_matches, MoleculeType::PROTEIN);
+    checkIdentifiedPeptide_(peptide);
 
     return insertIntoMultiIndex_(identified_peptides_, peptide,
                                  identified_peptide_lookup_);
@@ -230,12 +269,7 @@ namespace OpenMS
   IdentificationData::registerIdentifiedCompound(const IdentifiedCompound&
                                                  compound)
   {
-    if (compound.identifier.empty())
-    {
-      String msg = "missing identifier for compound";
-      throw Exception::IllegalArgument(__FILE__, __LINE__,
-                                       OPENMS_PRETTY_FUNCTION, msg);
-    }
+    checkIdentifiedCompound_(compound);
 
     return insertIntoMultiIndex_(identified_compounds_, compound,
                                  identified_compound_lookup_);
@@ -245,13 +279,7 @@ namespace OpenMS
   IdentificationData::IdentifiedOligoRef
   IdentificationData::registerIdentifiedOligo(const IdentifiedOligo& oligo)
   {
-    if (oligo.sequence.empty())
-    {
-      String msg = "missing sequence for oligonucleotide";
-      throw Exception::IllegalArgument(__FILE__, __LINE__,
-                                       OPENMS_PRETTY_FUNCTION, msg);
-    }
-    checkParentMatches_(oligo.parent_matches, MoleculeType::RNA);
+    checkIdentifiedOligo_(oligo);
 
     return insertIntoMultiIndex_(identified_oligos_, oligo,
                                  identified_oligo_lookup_);
@@ -369,6 +397,314 @@ namespace OpenMS
   }
 
 
+  Size IdentificationData::StagingBuffer::addDataQuery(const DataQuery& query)
+  {
+    queries_.push_back(query);
+    return queries_.size() - 1;
+  }
+
+
+  Size IdentificationData::StagingBuffer::addIdentifiedPeptide(
+    const IdentifiedPeptide& peptide)
+  {
+    peptides_.push_back(peptide);
+    return peptides_.size() - 1;
+  }
+
+
+  Size IdentificationData::StagingBuffer::addIdentifiedCompound(
+    const IdentifiedCompound& compound)
+  {
+    compounds_.push_back(compound);
+    return compounds_.size() - 1;
+  }
+
+
+  Size IdentificationData::StagingBuffer::addIdentifiedOligo(
+    const IdentifiedOligo& oligo)
+  {
+    oligos_.push_back(oligo);
+    return oligos_.size() - 1;
+  }
+
+
+  Size IdentificationData::StagingBuffer::addMoleculeQueryMatch(
+    const MoleculeQueryMatch& match, Size query_index,
+    MoleculeType molecule_type, Size molecule_index)
+  {
+    StagedMatch staged = {match, query_index, molecule_type, molecule_index};
+    matches_.push_back(staged);
+    return matches_.size() - 1;
+  }
+
+
+  IdentificationData::DataQueryRef
+  IdentificationData::StagingBuffer::getDataQueryRef(Size index) const
+  {
+    return query_refs_.at(index);
+  }
+
+
+  IdentificationData::IdentifiedPeptideRef
+  IdentificationData::StagingBuffer::getIdentifiedPeptideRef(Size index) const
+  {
+    return peptide_refs_.at(index);
+  }
+
+
+  IdentificationData::IdentifiedCompoundRef
+  IdentificationData::StagingBuffer::getIdentifiedCompoundRef(Size index) const
+  {
+    return compound_refs_.at(index);
+  }
+
+
+  IdentificationData::IdentifiedOligoRef
+  IdentificationData::StagingBuffer::getIdentifiedOligoRef(Size index) const
+  {
+    return oligo_refs_.at(index);
+  }
+
+
+  IdentificationData::QueryMatchRef
+  IdentificationData::StagingBuffer::getMoleculeQueryMatchRef(Size index) const
+  {
+    return match_refs_.at(index);
+  }
+
+
+  bool IdentificationData::StagingBuffer::empty() const
+  {
+    return queries_.empty() && peptides_.empty() && compounds_.empty() &&
+      oligos_.empty() && matches_.empty();
+  }
+
+
+  void IdentificationData::StagingBuffer::clear()
+  {
+    queries_.clear();
+    peptides_.clear();
+    compounds_.clear();
+    oligos_.clear();
+    matches_.clear();
+    query_refs_.clear();
+    peptide_refs_.clear();
+    compound_refs_.clear();
+    oligo_refs_.clear();
+    match_refs_.clear();
+  }
+
+
+  template <typename ContainerType, typename ElementType, typename RefType>
+  void IdentificationData::commitStagedItems_(
+    ContainerType& container,
+    const vector<const vector<ElementType>*>& items,
+    const vector<vector<RefType>*>& refs, AddressLookup& lookup)
+  {
+    // (buffer, index) pairs in buffer order:
+    vector<pair<Size, Size>> order;
+    for (Size b = 0; b < items.size(); ++b)
+    {
+      refs[b]->clear();
+      refs[b]->resize(items[b]->size());
+      for (Size i = 0; i < items[b]->size(); ++i)
+      {
+        order.push_back(make_pair(b, i));
+      }
+    }
+    if (order.empty()) return;
+
+    // sort by the container's key; "stable" keeps the buffer order within
+    // groups of equal keys, so merging below follows that order:
+    const typename ContainerType::key_from_value& key = container.key_extractor();
+    const typename ContainerType::key_compare& less = container.key_comp();
+    stable_sort(order.begin(), order.end(),
+                [&](const pair<Size, Size>& left, const pair<Size, Size>& right)
+                {
+                  return less(key((*items[left.first])[left.second]),
+                              key((*items[right.first])[right.second]));
+                });
+
+    for (Size start = 0; start < order.size(); )
+    {
+      const ElementType& first = (*items[order[start].first])[order[start].second];
+      ElementType merged = first;
+      // same sequence of operations as in individual registrations
+      // (see "insertIntoMultiIndex_"): merge, then add current step
+      if (current_step_ref_ != processing_steps_.end())
+      {
+        merged.addProcessingStep(current_step_ref_);
+      }
+      Size end = start + 1;
+      for (; end < order.size(); ++end)
+      {
+        const ElementType& next = (*items[order[end].first])[order[end].second];
+        if (less(key(first), key(next))) break; // different key
+        merged += next;
+        if (current_step_ref_ != processing_steps_.end())
+        {
+          merged.addProcessingStep(current_step_ref_);
+        }
+      }
+      RefType ref = insertIntoMultiIndex_(container, merged, lookup);
+      for (Size i = start; i < end; ++i)
+      {
+        (*refs[order[i].first])[order[i].second] = ref;
+      }
+      start = end;
+    }
+  }
+
+
+  void IdentificationData::commitStagingBuffer(StagingBuffer& buffer)
+  {
+    vector<StagingBuffer> buffers(1);
+    swap(buffers[0], buffer);
+    try
+    {
+      commitStagingBuffers(buffers);
+    }
+    catch (...)
+    {
+      swap(buffers[0], buffer);
+      throw;
+    }
+    swap(buffers[0], buffer);
+  }
+
+
+  void IdentificationData::commitStagingBuffers(vector<StagingBuffer>& buffers)
+  {
+    // 1. validate everything before anything is registered:
+    for (const StagingBuffer& buffer : buffers)
+    {
+      for (const DataQuery& query : buffer.queries_) checkDataQuery_(query);
+      for (const IdentifiedPeptide& peptide : buffer.peptides_)
+      {
+        checkIdentifiedPeptide_(peptide);
+        checkAppliedProcessingSteps_(peptide.steps_and_scores);
+      }
+      for (const IdentifiedCompound& compound : buffer.compounds_)
+      {
+        checkIdentifiedCompound_(compound);
+        checkAppliedProcessingSteps_(compound.steps_and_scores);
+      }
+      for (const IdentifiedOligo& oligo : buffer.oligos_)
+      {
+        checkIdentifiedOligo_(oligo);
+        checkAppliedProcessingSteps_(oligo.steps_and_scores);
+      }
+      for (const StagingBuffer::StagedMatch& staged : buffer.matches_)
+      {
+        Size n_molecules = 0;
+        switch (staged.molecule_type)
+        {
+        case MoleculeType::PROTEIN:
+          n_molecules = buffer.peptides_.size();
+          break;
+        case MoleculeType::COMPOUND:
+          n_molecules = buffer.compounds_.size();
+          break;
+        case MoleculeType::RNA:
+          n_molecules = buffer.oligos_.size();
+          break;
+        default:
+          break;
+        }
+        if ((staged.query_index >= buffer.queries_.size()) ||
+            (staged.molecule_index >= n_molecules))
+        {
+          String msg = "invalid index of a data query or identified molecule in staged molecule-query match";
+          throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                           OPENMS_PRETTY_FUNCTION, msg);
+        }
+        checkAppliedProcessingSteps_(staged.match.steps_and_scores);
+      }
+    }
+
+    // 2. data queries (set semantics - the first occurrence is kept):
+    for (StagingBuffer& buffer : buffers)
+    {
+      buffer.query_refs_.clear();
+      buffer.query_refs_.reserve(buffer.queries_.size());
+      for (const DataQuery& query : buffer.queries_)
+      {
+        DataQueryRef ref = data_queries_.insert(query).first;
+        data_query_lookup_.insert(ref);
+        buffer.query_refs_.push_back(ref);
+      }
+    }
+
+    // 3. identified molecules (sorted and merged by key):
+    vector<const vector<IdentifiedPeptide>*> peptides;
+    vector<vector<IdentifiedPeptideRef>*> peptide_refs;
+    vector<const vector<IdentifiedCompound>*> compounds;
+    vector<vector<IdentifiedCompoundRef>*> compound_refs;
+    vector<const vector<IdentifiedOligo>*> oligos;
+    vector<vector<IdentifiedOligoRef>*> oligo_refs;
+    for (StagingBuffer& buffer : buffers)
+    {
+      peptides.push_back(&buffer.peptides_);
+      peptide_refs.push_back(&buffer.peptide_refs_);
+      compounds.push_back(&buffer.compounds_);
+      compound_refs.push_back(&buffer.compound_refs_);
+      oligos.push_back(&buffer.oligos_);
+      oligo_refs.push_back(&buffer.oligo_refs_);
+    }
+    commitStagedItems_(identified_peptides_, peptides, peptide_refs,
+                       identified_peptide_lookup_);
+    commitStagedItems_(identified_compounds_, compounds, compound_refs,
+                       identified_compound_lookup_);
+    commitStagedItems_(identified_oligos_, oligos, oligo_refs,
+                       identified_oligo_lookup_);
+
+    // 4. molecule-query matches (now that the references are known):
+    vector<vector<MoleculeQueryMatch>> resolved(buffers.size());
+    vector<const vector<MoleculeQueryMatch>*> matches;
+    vector<vector<QueryMatchRef>*> match_refs;
+    for (Size b = 0; b < buffers.size(); ++b)
+    {
+      StagingBuffer& buffer = buffers[b];
+      resolved[b].reserve(buffer.matches_.size());
+      for (const StagingBuffer::StagedMatch& staged : buffer.matches_)
+      {
+        resolved[b].push_back(staged.match);
+        MoleculeQueryMatch& match = resolved[b].back();
+        match.data_query_ref = buffer.query_refs_[staged.query_index];
+        if (staged.molecule_type == MoleculeType::PROTEIN)
+        {
+          match.identified_molecule_ref =
+            buffer.peptide_refs_[staged.molecule_index];
+        }
+        else if (staged.molecule_type == MoleculeType::COMPOUND)
+        {
+          match.identified_molecule_ref =
+            buffer.compound_refs_[staged.molecule_index];
+        }
+        else
+        {
+          match.identified_molecule_ref =
+            buffer.oligo_refs_[staged.molecule_index];
+        }
+      }
+      matches.push_back(&resolved[b]);
+      match_refs.push_back(&buffer.match_refs_);
+    }
+    commitStagedItems_(query_matches_, matches, match_refs,
+                       query_match_lookup_);
+
+    // staged items are registered now - keep only the references:
+    for (StagingBuffer& buffer : buffers)
+    {
+      buffer.queries_.clear();
+      buffer.peptides_.clear();
+      buffer.compounds_.clear();
+      buffer.oligos_.clear();
+      buffer.matches_.clear();
+    }
+  }
+
+
   void IdentificationData::addScore(QueryMatchRef match_ref,
                                     ScoreTypeRef score_ref, double value)
   {
@@ -299,7 +299,7 @@ namespace OpenMS
     return accessions;
   }
 
-  std::vector<PeptideHit::PeakAnnotation> PeptideHit::getPeakAnnotations() const
+  const std::vector<PeptideHit::PeakAnnotation>& PeptideHit::getPeakAnnotations() const
   {
     return fragment_annotations_;
   }
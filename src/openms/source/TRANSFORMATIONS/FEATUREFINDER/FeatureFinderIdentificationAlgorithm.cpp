@@ -39,19 +39,22 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/TraceFitter.h>
 
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractor.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 #include <OpenMS/ANALYSIS/SVM/SimpleSVM.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmIdentification.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/TraMLFile.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 
 #include <vector>
+#include <exception>
 #include <numeric>
 #include <fstream>
 #include <algorithm>
+#include <iterator>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -98,6 +101,13 @@ namespace OpenMS
       ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("extract:rt_window", 0.0);
 
+    defaults_.setValue(
+      "extract:batch_size",
+      5000,
+      "Number of peptides for which chromatograms are extracted and features detected in one go. Batches are processed in parallel (see 'threads'); smaller values allow more parallelism. The results do not depend on the batch size. '0' to process all peptides in a single batch.",
+      ListUtils::create<String>("advanced"));
+    defaults_.setMinInt("extract:batch_size", 0);
+
     defaults_.setSectionDescription("extract", "Parameters for ion chromatogram extraction");
 
     defaults_.setValue("detect:peak_width", 60.0, "Expected elution peak width in seconds, for smoothing (Gauss filter). Also determines the RT extration window, unless set explicitly via 'extract:rt_window'.");
@@ -360,36 +370,117 @@ namespace OpenMS
     //-------------------------------------------------------------
     // run feature detection
     //-------------------------------------------------------------
-    OPENMS_LOG_INFO << "Extracting chromatograms..." << endl;
-    ChromatogramExtractor extractor;
-    // extractor.setLogType(ProgressLogger::NONE);
+    // assays are split into batches, each of which is processed
+    // (chromatogram extraction, peak picking, scoring) independently:
+    vector<TargetedExperiment> batch_libraries;
+    vector<OpenSwath::LightTargetedExperiment> batch_assays;
+    createAssayBatches_(batch_libraries, batch_assays);
+
+    // the LC-MS data is not needed after this step - hand it over instead of copying it:
+    boost::shared_ptr<PeakMap> shared = boost::make_shared<PeakMap>();
+    shared->swap(ms_data_);
+    OpenSwath::SpectrumAccessPtr spec_temp =
+      SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(shared);
+    const MSSpectrum reference_spectrum = shared->empty() ? MSSpectrum() : (*shared)[0];
+
+    OPENMS_LOG_INFO << "Extracting chromatograms and detecting chromatographic peaks ("
+                    << batch_libraries.size() << " batch(es))..." << endl;
+    // suppress status output from OpenSWATH, unless in debug mode:
+    if (debug_level_ < 1) OpenMS_Log_info.remove(cout);
+
+    vector<vector<MSChromatogram> > batch_chroms(batch_libraries.size());
+    vector<FeatureMap> batch_features(batch_libraries.size());
+    // exceptions must not leave the parallel region - keep the first one and rethrow it afterwards:
+    std::exception_ptr batch_error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize batch = 0; batch < (SignedSize)batch_libraries.size(); ++batch)
+    {
+      try
+      {
+        // each thread needs its own (light) copy of the spectrum access and feature finder:
+        OpenSwath::SpectrumAccessPtr spec_access = spec_temp->lightClone();
+        MRMFeatureFinderScoring feat_finder;
+        feat_finder.setParameters(feat_finder_.getParameters());
+        feat_finder.setLogType(ProgressLogger::NONE);
+        feat_finder.setStrictFlag(false);
+
+        ChromatogramExtractor extractor;
+        extractor.setLogType(ProgressLogger::NONE);
+        vector<OpenSwath::ChromatogramPtr> chrom_temp;
+        vector<ChromatogramExtractor::ExtractionCoordinates> coords;
+        extractor.prepare_coordinates(chrom_temp, coords, batch_libraries[batch],
+            numeric_limits<double>::quiet_NaN(), false);
+        extractor.extractChromatograms(spec_access, chrom_temp, coords, mz_window_,
+            mz_window_ppm_, "tophat");
+        extractor.return_chromatogram(chrom_temp, coords, batch_libraries[batch],
+            reference_spectrum, batch_chroms[batch], false);
+        chrom_temp.clear();
+
+        boost::shared_ptr<PeakMap> chrom_batch = boost::make_shared<PeakMap>();
+        chrom_batch->getChromatograms().swap(batch_chroms[batch]);
+        OpenSwath::SpectrumAccessPtr chrom_access =
+          SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(chrom_batch);
+        vector<OpenSwath::SwathMap> swath_maps(1);
+        swath_maps[0].sptr = spec_access;
+        MRMFeatureFinderScoring::TransitionGroupMapType transition_group_map;
+        feat_finder.pickExperiment(chrom_access, batch_features[batch],
+                                   batch_assays[batch], TransformationDescription(),
+                                   swath_maps, transition_group_map);
+        batch_chroms[batch].swap(chrom_batch->getChromatograms());
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_FeatureFinderIdentificationAlgorithm_error)
+#endif
+        {
+          if (!batch_error) batch_error = std::current_exception();
+        }
+      }
+    }
+    if (debug_level_ < 1) OpenMS_Log_info.insert(cout); // revert logging change
+    if (batch_error) std::rethrow_exception(batch_error);
+
+    // collect results in batch order:
+    Size n_previous_chroms = chrom_data_.getNrChromatograms();
+    Size n_previous_features = features.size();
+    for (Size batch = 0; batch < batch_libraries.size(); ++batch)
     {
-      vector<OpenSwath::ChromatogramPtr> chrom_temp;
-      vector<ChromatogramExtractor::ExtractionCoordinates> coords;
-      extractor.prepare_coordinates(chrom_temp, coords, library_,
-          numeric_limits<double>::quiet_NaN(), false);
-
-      boost::shared_ptr<PeakMap> shared = boost::make_shared<PeakMap>(ms_data_);
-      OpenSwath::SpectrumAccessPtr spec_temp =
-        SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(shared);
-      extractor.extractChromatograms(spec_temp, chrom_temp, coords, mz_window_,
-          mz_window_ppm_, "tophat");
-      extractor.return_chromatogram(chrom_temp, coords, library_, (*shared)[0],
-          chrom_data_.getChromatograms(), false);
+      chrom_data_.getChromatograms().insert(chrom_data_.getChromatograms().end(),
+          make_move_iterator(batch_chroms[batch].begin()),
+          make_move_iterator(batch_chroms[batch].end()));
+      for (FeatureMap::Iterator feat_it = batch_features[batch].begin();
+           feat_it != batch_features[batch].end(); ++feat_it)
+      {
+        features.push_back(std::move(*feat_it));
+      }
     }
+    batch_chroms.clear();
+    batch_features.clear();
+    // restore the order that a single pass over all assays produces - features
+    // come out ordered by transition group (= peptide reference), chromatograms
+    // by m/z:
+    stable_sort(features.begin() + n_previous_features, features.end(),
+                [](const Feature& a, const Feature& b)
+                {
+                  const String& ref_a = a.getMetaValue("PeptideRef");
+                  const String& ref_b = b.getMetaValue("PeptideRef");
+                  return ref_a < ref_b;
+                });
+    stable_sort(chrom_data_.getChromatograms().begin() + n_previous_chroms,
+                chrom_data_.getChromatograms().end(),
+                [](const MSChromatogram& a, const MSChromatogram& b)
+                {
+                  return a.getProduct().getMZ() < b.getProduct().getMZ();
+                });
 
     OPENMS_LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
               << " chromatogram(s)." << endl;
-
-    OPENMS_LOG_INFO << "Detecting chromatographic peaks..." << endl;
-    // suppress status output from OpenSWATH, unless in debug mode:
-    if (debug_level_ < 1) OpenMS_Log_info.remove(cout);
-    feat_finder_.pickExperiment(chrom_data_, features, library_,
-                                TransformationDescription(), ms_data_);
-    if (debug_level_ < 1) OpenMS_Log_info.insert(cout); // revert logging change
     OPENMS_LOG_INFO << "Found " << features.size() << " feature candidates in total."
              << endl;
-    ms_data_.reset(); // not needed anymore, free up the memory
+    shared.reset(); // not needed anymore, free up the memory
 
     // complete feature annotation:
     annotateFeatures_(features, ref_rt_map);
@@ -468,7 +559,7 @@ namespace OpenMS
     // store feature candidates before filtering
     if (!candidates_out_.empty())
     {
-      FeatureXMLFile().store(candidates_out_, features);
+      FileHandler().storeFeatures(candidates_out_, features);
     }
 
     filterFeatures_(features, with_external_ids);
@@ -874,6 +965,58 @@ namespace OpenMS
     }
   }
 
+  void FeatureFinderIdentificationAlgorithm::createAssayBatches_(
+    vector<TargetedExperiment>& batch_libraries,
+    vector<OpenSwath::LightTargetedExperiment>& batch_assays) const
+  {
+    const vector<TargetedExperiment::Peptide>& peptides = library_.getPeptides();
+    Size batch_size = (batch_size_ == 0) ? peptides.size() : batch_size_;
+    Size n_batches = 1;
+    if (batch_size > 0)
+    {
+      n_batches = max(Size(1), (peptides.size() + batch_size - 1) / batch_size);
+    }
+
+    if (n_batches == 1)
+    {
+      batch_libraries.assign(1, library_);
+    }
+    else
+    {
+      // consecutive peptides go into the same batch, transitions follow their peptide:
+      vector<vector<TargetedExperiment::Peptide> > batch_peptides(n_batches);
+      vector<vector<TargetedExperiment::Transition> > batch_transitions(n_batches);
+      map<String, Size> peptide_batch;
+      for (Size i = 0; i < peptides.size(); ++i)
+      {
+        batch_peptides[i / batch_size].push_back(peptides[i]);
+        peptide_batch[peptides[i].id] = i / batch_size;
+      }
+      for (const TargetedExperiment::Transition& transition : library_.getTransitions())
+      {
+        map<String, Size>::const_iterator pos = peptide_batch.find(transition.getPeptideRef());
+        Size batch = (pos == peptide_batch.end()) ? 0 : pos->second;
+        batch_transitions[batch].push_back(transition);
+      }
+
+      batch_libraries.resize(n_batches);
+      for (Size batch = 0; batch < n_batches; ++batch)
+      {
+        batch_libraries[batch].setProteins(library_.getProteins());
+        batch_libraries[batch].setPeptides(batch_peptides[batch]);
+        batch_libraries[batch].setTransitions(batch_transitions[batch]);
+      }
+    }
+
+    // conversion involves modification lookups, so do it here (single-threaded):
+    batch_assays.resize(n_batches);
+    for (Size batch = 0; batch < n_batches; ++batch)
+    {
+      OpenSwathDataAccessHelper::convertTargetedExp(batch_libraries[batch],
+                                                    batch_assays[batch]);
+    }
+  }
+
   void FeatureFinderIdentificationAlgorithm::checkNumObservations_(Size n_pos, Size n_neg, const String& note) const
   {
     if (n_pos < svm_n_parts_)
@@ -1183,6 +1326,7 @@ namespace OpenMS
 
     isotope_pmin_ = param_.getValue("extract:isotope_pmin");
     n_isotopes_ = param_.getValue("extract:n_isotopes");
+    batch_size_ = param_.getValue("extract:batch_size");
 
     mapping_tolerance_ = param_.getValue("detect:mapping_tolerance");
 
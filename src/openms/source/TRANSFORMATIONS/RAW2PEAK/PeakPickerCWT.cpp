@@ -36,6 +36,7 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerCWT.h>
 
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMeanIterative.h>
+#include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedianSliding.h>
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/TwoDOptimization.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/TICFilter.h>
 
@@ -45,6 +46,8 @@
 #endif
 #endif
 
+#include <memory>
+
 //#define DEBUG_PEAK_PICKING2 1
 
 using namespace std;
@@ -62,6 +65,8 @@ namespace OpenMS
   {
     defaults_.setValue("signal_to_noise", 1.0, "Minimal signal to noise ratio for a peak to be picked.");
     defaults_.setMinFloat("signal_to_noise", 0.0);
+    defaults_.setValue("signal_to_noise_estimator", "mean_iterative", "Noise estimator used for 'signal_to_noise': 'mean_iterative' (SignalToNoiseEstimatorMeanIterative) or the exact median of a sliding window, 'median_sliding' (SignalToNoiseEstimatorMedianSliding, which uses only 'win_len', 'min_required_elements' and 'noise_for_empty_window' of the 'SignalToNoiseEstimationParameter' section).", ListUtils::create<String>("advanced"));
+    defaults_.setValidStrings("signal_to_noise_estimator", ListUtils::create<String>("mean_iterative,median_sliding"));
     defaults_.setValue("thresholds:peak_bound", 10.0, "Minimal peak intensity.", ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("thresholds:peak_bound", 0.0);
     defaults_.setValue("thresholds:peak_bound_ms2_level", 10.0, "Minimal peak intensity for MS/MS peaks.", ListUtils::create<String>("advanced"));
@@ -208,6 +213,7 @@ namespace OpenMS
     signal_to_noise_ = (float)param_.getValue("signal_to_noise");
 
     deconvolution_ = param_.getValue("deconvolution:deconvolution").toBool();
+    snt_median_sliding_ = param_.getValue("signal_to_noise_estimator") == "median_sliding";
   }
 
   bool PeakPickerCWT::getMaxPosition_(
@@ -1133,16 +1139,34 @@ namespace OpenMS
     // copy the profile data into a std::vector<Peak1D>
     MSSpectrum raw_peak_array;
     // signal to noise estimator
-    SignalToNoiseEstimatorMeanIterative<MSSpectrum> sne;
+    std::unique_ptr<SignalToNoiseEstimator<MSSpectrum> > sne;
     Param sne_param(param_.copy("SignalToNoiseEstimationParameter:", true));
-    sne.setParameters(sne_param);
+    if (snt_median_sliding_)
+    {
+      sne.reset(new SignalToNoiseEstimatorMedianSliding<MSSpectrum>());
+      // take over the parameters both estimators have in common
+      Param sliding_param = sne->getDefaults();
+      for (Param::ParamIterator it = sliding_param.begin(); it != sliding_param.end(); ++it)
+      {
+        if (sne_param.exists(it.getName()))
+        {
+          sliding_param.setValue(it.getName(), sne_param.getValue(it.getName()));
+        }
+      }
+      sne_param = sliding_param;
+    }
+    else
+    {
+      sne.reset(new SignalToNoiseEstimatorMeanIterative<MSSpectrum>());
+    }
+    sne->setParameters(sne_param);
 
     raw_peak_array.insert(raw_peak_array.end(), input.begin(), input.end());
 
     PeakIterator it_pick_begin = raw_peak_array.begin();
     PeakIterator it_pick_end   = raw_peak_array.end();
 
-    sne.init(it_pick_begin, it_pick_end);
+    sne->init(it_pick_begin, it_pick_end);
 
     // Upper peak width bound
     double fwhm_upper_bound = (double)param_.getValue("fwhm_upper_bound_factor") * scale_;
@@ -1179,7 +1203,7 @@ namespace OpenMS
       {
         // if the signal to noise ratio at the max position is too small
         // the peak isn't considered
-        if ((area.max != it_pick_end) && (sne.getSignalToNoise(area.max) < signal_to_noise_))
+        if ((area.max != it_pick_end) && (sne->getSignalToNoise(area.max) < signal_to_noise_))
         {
           it_pick_begin = area.max;
           distance_from_scan_border = distance(raw_peak_array.begin(), it_pick_begin);
@@ -1222,7 +1246,7 @@ namespace OpenMS
              && (shape.getFWHM() >= fwhm_bound_)
              && (shape.getFWHM() <= fwhm_upper_bound))
           {
-            shape.signal_to_noise = sne.getSignalToNoise(area.max);
+            shape.signal_to_noise = sne->getSignalToNoise(area.max);
             peak_shapes.push_back(shape);
             ++number_of_peaks;
           }
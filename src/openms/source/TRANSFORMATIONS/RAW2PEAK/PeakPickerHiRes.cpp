@@ -36,11 +36,20 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
+#include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedianSliding.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/MATH/MISC/SplineBisection.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 
+#include <exception>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 using namespace std;
 
@@ -54,6 +63,9 @@ namespace OpenMS
     defaults_.setValue("signal_to_noise", 0.0, "Minimal signal-to-noise ratio for a peak to be picked (0.0 disables SNT estimation!)");
     defaults_.setMinFloat("signal_to_noise", 0.0);
 
+    defaults_.setValue("signal_to_noise_estimator", "median", "Noise estimator used for 'signal_to_noise': 'median' uses an intensity histogram per window (SignalToNoiseEstimatorMedian), 'median_sliding' the exact median of a sliding window (SignalToNoiseEstimatorMedianSliding, which ignores the histogram parameters in the 'SignalToNoise' section).", ListUtils::create<String>("advanced"));
+    defaults_.setValidStrings("signal_to_noise_estimator", ListUtils::create<String>("median,median_sliding"));
+
     defaults_.setValue("spacing_difference_gap", 4.0, "The extension of a peak is stopped if the spacing between two subsequent data points exceeds 'spacing_difference_gap * min_spacing'. 'min_spacing' is the smaller of the two spacings from the peak apex to its two neighboring points. '0' to disable the constraint. Not applicable to chromatograms.", ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("spacing_difference_gap", 0.0);
 
@@ -121,12 +133,22 @@ namespace OpenMS
     }
 
     // signal-to-noise estimation
-    SignalToNoiseEstimatorMedian<MSSpectrum > snt;
-    snt.setParameters(param_.copy("SignalToNoise:", true));
-
+    std::unique_ptr<SignalToNoiseEstimator<MSSpectrum> > snt;
     if (signal_to_noise_ > 0.0)
     {
-      snt.init(input);
+      Param snt_param = param_.copy("SignalToNoise:", true);
+      if (snt_median_sliding_)
+      {
+        snt.reset(new SignalToNoiseEstimatorMedianSliding<MSSpectrum>());
+        // the sliding estimator shares only part of the parameters of the histogram-based one
+        snt_param = snt_param.copySubset(snt->getDefaults());
+      }
+      else
+      {
+        snt.reset(new SignalToNoiseEstimatorMedian<MSSpectrum>());
+      }
+      snt->setParameters(snt_param);
+      snt->init(input);
     }
 
     // find local maxima in profile data
@@ -152,9 +174,9 @@ namespace OpenMS
       double act_snt = 0.0, act_snt_l1 = 0.0, act_snt_r1 = 0.0;
       if (signal_to_noise_ > 0.0)
       {
-        act_snt = snt.getSignalToNoise(input[i]);
-        act_snt_l1 = snt.getSignalToNoise(input[i - 1]);
-        act_snt_r1 = snt.getSignalToNoise(input[i + 1]);
+        act_snt = snt->getSignalToNoise(input[i]);
+        act_snt_l1 = snt->getSignalToNoise(input[i - 1]);
+        act_snt_r1 = snt->getSignalToNoise(input[i + 1]);
       }
 
       // look for peak cores meeting MZ and intensity/SNT criteria
@@ -175,8 +197,8 @@ namespace OpenMS
 
         if (signal_to_noise_ > 0.0)
         {
-          act_snt_l2 = snt.getSignalToNoise(input[i - 2]);
-          act_snt_r2 = snt.getSignalToNoise(input[i + 2]);
+          act_snt_l2 = snt->getSignalToNoise(input[i - 2]);
+          act_snt_r2 = snt->getSignalToNoise(input[i + 2]);
         }
 
         // checking signal-to-noise?
@@ -220,7 +242,7 @@ namespace OpenMS
 
           if (signal_to_noise_ > 0.0)
           {
-            act_snt_lk = snt.getSignalToNoise(input[i - k]);
+            act_snt_lk = snt->getSignalToNoise(input[i - k]);
           }
 
           if ((act_snt_lk >= signal_to_noise_) && 
@@ -261,7 +283,7 @@ namespace OpenMS
 
           if (signal_to_noise_ > 0.0)
           {
-            act_snt_rk = snt.getSignalToNoise(input[i + k]);
+            act_snt_rk = snt->getSignalToNoise(input[i + k]);
           }
 
           if ((act_snt_rk >= signal_to_noise_) && 
@@ -454,65 +476,168 @@ namespace OpenMS
 
     // resize output with respect to input
     output.resize(input.size());
+    output.getChromatograms().resize(input.getChromatograms().size());
+
+    // decide up front which spectra need picking, so invalid input is reported before any work is done
+    std::vector<char> pick_spectrum(input.size());
+    for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+    {
+      pick_spectrum[scan_idx] = isPickingRequired_(input[scan_idx], check_spectrum_type);
+    }
+
+    // peak boundaries of each spectrum / chromatogram, collected in input order below
+    std::vector<std::vector<PeakBoundary> > boundaries_s(input.size());
+    std::vector<std::vector<PeakBoundary> > boundaries_c(input.getChromatograms().size());
 
     Size progress = 0;
     startProgress(0, input.size() + input.getChromatograms().size(), "picking peaks");
 
-    if (input.getNrSpectra() > 0)
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize scan_idx = 0; scan_idx < (SignedSize)input.size(); ++scan_idx)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      try
       {
-        if (ms_levels_.empty()) // auto mode
+        if (pick_spectrum[scan_idx])
         {
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType();
-          if (spectrum_type == SpectrumSettings::CENTROID)
-          {
-            output[scan_idx] = input[scan_idx];
-          }
-          else
-          {
-            std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-
-            pick(input[scan_idx], output[scan_idx], boundaries_s);
-            boundaries_spec.push_back(boundaries_s);
-          }
-        }
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) // manual mode
-        {
-          output[scan_idx] = input[scan_idx];
+          pick(input[scan_idx], output[scan_idx], boundaries_s[scan_idx]);
         }
         else
         {
-          std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-
-                                                  // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType();
-
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
-
-          pick(input[scan_idx], output[scan_idx], boundaries_s);
-          boundaries_spec.push_back(boundaries_s);
+          output[scan_idx] = input[scan_idx];
         }
-        setProgress(++progress);
       }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_PeakPickerHiRes_exception)
+#endif
+        if (!error) error = std::current_exception();
+      }
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_PeakPickerHiRes_progress)
+#endif
+      setProgress(++progress);
     }
 
-
-    for (Size i = 0; i < input.getChromatograms().size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)input.getChromatograms().size(); ++i)
     {
-      MSChromatogram chromatogram;
-      std::vector<PeakBoundary> boundaries_c; // peak boundaries of a single chromatogram
-      pick(input.getChromatograms()[i], chromatogram, boundaries_c);
-      output.addChromatogram(chromatogram);
-      boundaries_chrom.push_back(boundaries_c);
+      try
+      {
+        pick(input.getChromatograms()[i], output.getChromatograms()[i], boundaries_c[i]);
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_PeakPickerHiRes_exception)
+#endif
+        if (!error) error = std::current_exception();
+      }
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_PeakPickerHiRes_progress)
+#endif
       setProgress(++progress);
     }
     endProgress();
 
-    return;
+    if (error) std::rethrow_exception(error);
+
+    // boundaries are only reported for spectra that were picked
+    for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+    {
+      if (pick_spectrum[scan_idx]) boundaries_spec.push_back(boundaries_s[scan_idx]);
+    }
+    boundaries_chrom.insert(boundaries_chrom.end(), boundaries_c.begin(), boundaries_c.end());
+  }
+
+  namespace
+  {
+    /// Stores everything it is handed in a PeakMap (without copying the peak data a second time)
+    class PeakMapFillingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+    public:
+      explicit PeakMapFillingConsumer(PeakMap& exp) :
+        exp_(exp)
+      {
+      }
+
+      void setExperimentalSettings(const ExperimentalSettings& settings) override
+      {
+        static_cast<ExperimentalSettings&>(exp_) = settings;
+      }
+
+      void setExpectedSize(Size s_size, Size c_size) override
+      {
+        exp_.reserve(s_size);
+        exp_.getChromatograms().reserve(c_size);
+      }
+
+      void consumeSpectrum(SpectrumType& s) override
+      {
+        exp_.addSpectrum(std::move(s));
+      }
+
+      void consumeChromatogram(ChromatogramType& c) override
+      {
+        exp_.addChromatogram(std::move(c));
+      }
+
+    private:
+      PeakMap& exp_;
+    };
+
+    /**
+      @brief Reads, processes and emits @p count items in batches of @p batch_size
+
+      Each worker thread reads (@p load) and processes its own items, so
+      @p load has to be thread-safe. Results are handed to @p emit in input
+      order from the calling thread. The first exception thrown by any of the
+      functors is rethrown.
+    */
+    template <typename DataT, typename LoadFuncT, typename ProcessFuncT, typename EmitFuncT>
+    void processInBatches(Size count, Size batch_size, LoadFuncT load, ProcessFuncT process, EmitFuncT emit)
+    {
+      std::vector<DataT> result;
+      for (Size batch_start = 0; batch_start < count; batch_start += batch_size)
+      {
+        const Size batch_end = std::min(count, batch_start + batch_size);
+        result.clear();
+        result.resize(batch_end - batch_start);
+
+        std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)result.size(); ++i)
+        {
+          try
+          {
+            DataT item;
+            load(batch_start + i, item);
+            process(item, result[i]);
+          }
+          catch (...)
+          {
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_PeakPickerHiRes_exception)
+#endif
+            if (!error) error = std::current_exception();
+          }
+        }
+
+        if (error) std::rethrow_exception(error);
+        for (Size i = 0; i < result.size(); ++i)
+        {
+          emit(result[i]);
+        }
+      }
+    }
   }
 
   /**
@@ -527,73 +652,90 @@ namespace OpenMS
     // make sure that output is clear
     output.clear(true);
 
-    // copy experimental settings
-    static_cast<ExperimentalSettings &>(output) = *input.getExperimentalSettings();
+    PeakMapFillingConsumer consumer(output);
+    pickExperiment(input, consumer, check_spectrum_type);
+  }
+
+  void PeakPickerHiRes::pickExperiment(/* const */ OnDiscMSExperiment& input, Interfaces::IMSDataConsumer& consumer, const bool check_spectrum_type) const
+  {
+    consumer.setExpectedSize(input.getNrSpectra(), input.getNrChromatograms());
+    consumer.setExperimentalSettings(*input.getExperimentalSettings());
+
+    // keep a few spectra per thread in flight (reading from the indexed file is thread-safe)
+    Size nr_threads = 1;
+#ifdef _OPENMP
+    nr_threads = omp_get_max_threads();
+#endif
+    const Size batch_size = std::max(Size(16), 8 * nr_threads);
 
     Size progress = 0;
     startProgress(0, input.size() + input.getNrChromatograms(), "picking peaks");
 
-    // resize output with respect to input
-    output.resize(input.size());
-
-    if (input.getNrSpectra() > 0)
-    {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+    processInBatches<MSSpectrum>(input.getNrSpectra(), batch_size,
+      [&input](Size idx, MSSpectrum& s)
+      {
+        s = input.getSpectrum(idx);
+      },
+      [this, check_spectrum_type](MSSpectrum& s, MSSpectrum& out)
       {
-        if (ms_levels_.empty()) //auto mode
+        if (isPickingRequired_(s, check_spectrum_type))
         {
-          MSSpectrum s = input[scan_idx];
           s.sortByPosition();
-
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrumType = s.getType();
-          if (spectrumType == SpectrumSettings::CENTROID)
-          {
-            output[scan_idx] = input[scan_idx];
-          }
-          else
-          {
-            pick(s, output[scan_idx]);
-          }
-        }
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) // manual mode
-        {
-          output[scan_idx] = input[scan_idx];
+          pick(s, out);
         }
         else
         {
-          MSSpectrum s = input[scan_idx];
-          s.sortByPosition();
+          std::swap(s, out);
+        }
+      },
+      [this, &consumer, &progress](MSSpectrum& s)
+      {
+        consumer.consumeSpectrum(s);
+        setProgress(++progress);
+      });
 
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrum_type = s.getType();
+    processInBatches<MSChromatogram>(input.getNrChromatograms(), batch_size,
+      [&input](Size idx, MSChromatogram& c)
+      {
+        c = input.getChromatogram(idx);
+      },
+      [this](MSChromatogram& c, MSChromatogram& out)
+      {
+        pick(c, out);
+      },
+      [this, &consumer, &progress](MSChromatogram& c)
+      {
+        consumer.consumeChromatogram(c);
+        setProgress(++progress);
+      });
 
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
+    endProgress();
+  }
 
-          pick(s, output[scan_idx]);
-        }
-        setProgress(++progress);
-      }
+  bool PeakPickerHiRes::isPickingRequired_(const MSSpectrum& spectrum, const bool check_spectrum_type) const
+  {
+    if (ms_levels_.empty()) // auto mode
+    {
+      return spectrum.getType() != SpectrumSettings::CENTROID;
     }
 
-    for (Size i = 0; i < input.getNrChromatograms(); ++i)
+    if (!ListUtils::contains(ms_levels_, spectrum.getMSLevel())) // manual mode
     {
-      MSChromatogram chromatogram;
-      pick(input.getChromatogram(i), chromatogram);
-      output.addChromatogram(chromatogram);
-      setProgress(++progress);
+      return false;
     }
-    endProgress();
 
-    return;
+    // determine type of spectral data (profile or centroided)
+    if (spectrum.getType() == SpectrumSettings::CENTROID && check_spectrum_type)
+    {
+      throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+    }
+    return true;
   }
 
   void PeakPickerHiRes::updateMembers_()
   {
     signal_to_noise_ = param_.getValue("signal_to_noise");
+    snt_median_sliding_ = param_.getValue("signal_to_noise_estimator") == "median_sliding";
     spacing_difference_gap_ = param_.getValue("spacing_difference_gap");
     if (spacing_difference_gap_ == 0.0) spacing_difference_gap_ = std::numeric_limits<double>::infinity();
     spacing_difference_ = param_.getValue("spacing_difference");
@@ -0,0 +1,192 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Multi-resolution RT x m/z maximum intensity grid of a peak map
+
+    The finest level (level 0) is a regular grid spanning the RT and m/z range
+    of all MS1 peaks. Each cell stores the maximum intensity of the peaks that
+    fall into it (or -1 if the cell is empty). Every further level halves the
+    number of rows and columns of the previous one by taking the maximum of
+    2x2 cells, until a single cell remains.
+
+    The 2D view uses the pyramid to paint dense maps: instead of visiting all
+    raw peaks in the visible area on each repaint, it picks the coarsest level
+    whose cells are still no larger than a pixel (see fillPixels()). Only if
+    the view is zoomed in beyond the resolution of level 0, raw peaks need to
+    be painted.
+
+    The pyramid can be stored to and loaded from a binary file (by convention
+    next to the data file, see getSidecarFilename()). Use matches() to verify
+    that a loaded pyramid was computed from the map at hand.
+
+    @note Data filters are not taken into account. The pyramid must not be
+    used when layer filters are active.
+
+    @ingroup SpectrumWidgets
+  */
+  class OPENMS_GUI_DLLAPI IntensityPyramid
+  {
+public:
+    /// Default constructor (empty pyramid)
+    IntensityPyramid();
+
+    /**
+      @brief Computes the pyramid from the MS1 spectra of @p exp
+
+      The number of rows of level 0 is the number of MS1 scans, but at most
+      @p rt_bins. The number of columns is @p mz_bins.
+
+      @note The spectra must be sorted by m/z.
+    */
+    void build(const PeakMap& exp, Size rt_bins = 1024, Size mz_bins = 4096);
+
+    /// Removes all levels
+    void clear();
+
+    /// Returns if the pyramid contains no data
+    bool empty() const;
+
+    /// Returns the number of levels
+    Size getLevelCount() const;
+
+    /// Returns the number of RT rows of level @p level
+    Size getRTBins(Size level) const;
+
+    /// Returns the number of m/z columns of level @p level
+    Size getMZBins(Size level) const;
+
+    /// Returns the maximum intensity of a cell (-1 if no peak falls into it)
+    float getValue(Size level, Size rt_bin, Size mz_bin) const;
+
+    /// Returns the RT of the lower border of the grid
+    double getRTMin() const;
+
+    /// Returns the m/z of the lower border of the grid
+    double getMZMin() const;
+
+    /// Returns the width of a level 0 cell in RT dimension
+    double getRTBinWidth() const;
+
+    /// Returns the width of a level 0 cell in m/z dimension
+    double getMZBinWidth() const;
+
+    /**
+      @brief Computes the maximum intensity of each pixel of a view
+
+      The view spans [@p rt_min, @p rt_max) x [@p mz_min, @p mz_max) and is
+      divided into @p rt_pixel_count x @p mz_pixel_count pixels. The level
+      whose cells best match the pixel size is chosen. Every cell is assigned
+      to the pixel containing its center.
+
+      @param pixels Output: row-major intensities (RT rows, m/z columns), -1 for empty pixels
+      @return false (and leaves @p pixels untouched) if the pyramid is empty or a pixel is smaller than a level 0 cell
+    */
+    bool fillPixels(double rt_min, double rt_max, double mz_min, double mz_max,
+                    Size rt_pixel_count, Size mz_pixel_count, std::vector<float>& pixels) const;
+
+    /// Returns if the pyramid was computed from a map with the same number of spectra, peaks and MS1 range as @p exp
+    bool matches(const PeakMap& exp) const;
+
+    /**
+      @brief Writes the pyramid to a binary file
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be written
+    */
+    void store(const String& filename) const;
+
+    /**
+      @brief Reads a pyramid written by store()
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file is not a valid pyramid file
+    */
+    void load(const String& filename);
+
+    /// Returns the name of the file a pyramid for @p data_filename is stored in
+    static String getSidecarFilename(const String& data_filename);
+
+protected:
+    /// Summary of the map a pyramid was computed from
+    struct Fingerprint
+    {
+      UInt64 spectra;
+      UInt64 peaks;
+      double rt_min;
+      double rt_max;
+      double mz_min;
+      double mz_max;
+    };
+
+    /// Computes the fingerprint of @p exp (MS1 range only)
+    static Fingerprint fingerprint_(const PeakMap& exp);
+
+    /// Fingerprint of the source map
+    Fingerprint source_;
+
+    /// Lower RT border of the grid
+    double rt_min_;
+
+    /// Lower m/z border of the grid
+    double mz_min_;
+
+    /// RT width of a level 0 cell
+    double rt_width_;
+
+    /// m/z width of a level 0 cell
+    double mz_width_;
+
+    /// Number of RT rows per level
+    std::vector<Size> rt_bins_;
+
+    /// Number of m/z columns per level
+    std::vector<Size> mz_bins_;
+
+    /// Row-major cell intensities per level
+    std::vector<std::vector<float> > levels_;
+  };
+
+} // namespace OpenMS
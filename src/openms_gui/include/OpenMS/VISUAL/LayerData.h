@@ -43,6 +43,7 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/VISUAL/IntensityPyramid.h>
 #include <OpenMS/VISUAL/MultiGradient.h>
 #include <OpenMS/VISUAL/ANNOTATION/Annotations1DContainer.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/DataFilters.h>
@@ -77,6 +78,11 @@ namespace OpenMS
   Persistent changes can be applied to getPeakDataMuteable() and will be
   available on the next cache update.
 
+  @note The peak map may be shared with other layers and is read by a
+  background thread of the 2D view (level-of-detail pyramid). Changes of the
+  peaks, retention times or MS levels must therefore not be made in place:
+  modify a copy and set it with setPeakData() (e.g. when reloading a file).
+
   @note Layer is mainly used as a member variable of SpectrumCanvas which holds
   a vector of LayerData objects.
 
@@ -153,6 +159,9 @@ public:
     /// SharedPtr on On-Disc MSExperiment
     typedef boost::shared_ptr<OnDiscMSExperiment> ODExperimentSharedPtrType;
 
+    /// SharedPtr on the level-of-detail pyramid of the peak data
+    typedef boost::shared_ptr<const IntensityPyramid> IntensityPyramidSharedPtrType;
+
     //@}
 
     /// Default constructor
@@ -179,6 +188,7 @@ public:
       peaks(new ExperimentType()),
       on_disc_peaks(new OnDiscMSExperiment()),
       chromatograms(new ExperimentType()),
+      intensity_pyramid_(),
       current_spectrum_(0),
       cached_spectrum_()
     {
@@ -237,9 +247,27 @@ public:
     void setPeakData(ExperimentSharedPtrType p)
     {
       peaks = p;
+      intensity_pyramid_.reset();
       updateCache_();
     }
 
+    /**
+    @brief Returns the level-of-detail pyramid of the peak data
+
+    The pointer is null as long as no pyramid was computed (it is built in the
+    background by the 2D view) and after the peak data was replaced.
+    */
+    const IntensityPyramidSharedPtrType & getIntensityPyramid() const
+    {
+      return intensity_pyramid_;
+    }
+
+    /// Set the level-of-detail pyramid of the peak data
+    void setIntensityPyramid(IntensityPyramidSharedPtrType p)
+    {
+      intensity_pyramid_ = p;
+    }
+
     /// Set the current on-disc data
     void setOnDiscPeakData(ODExperimentSharedPtrType p)
     {
@@ -470,6 +498,9 @@ private:
     /// chromatogram data
     ExperimentSharedPtrType chromatograms;
 
+    /// level-of-detail pyramid of the peak data (may be null)
+    IntensityPyramidSharedPtrType intensity_pyramid_;
+
     /// Index of the current spectrum
     Size current_spectrum_;
 
@@ -42,6 +42,10 @@
 #include <OpenMS/VISUAL/Spectrum1DCanvas.h>
 #include <OpenMS/KERNEL/PeakIndex.h>
 
+#include <boost/weak_ptr.hpp>
+
+#include <map>
+
 // QT
 class QPainter;
 class QMouseEvent;
@@ -140,6 +144,9 @@ protected slots:
     /// Reacts on changed layer parameters
     void currentLayerParametersChanged_();
 
+    /// Assigns a level-of-detail pyramid computed in the background to its layer
+    void intensityPyramidFinished_();
+
 protected:
     // Docu in base class
     bool finishAdding_() override;
@@ -192,6 +199,22 @@ protected:
     */
     void paintMaximumIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter& p);
 
+    /**
+      @brief Paints maximum intensities from the level-of-detail pyramid of a layer.
+
+      @return false if the layer has no pyramid (yet), data filters are active, or the view is zoomed in beyond the pyramid resolution
+    */
+    bool paintPyramidIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count);
+
+    /**
+      @brief Starts computing (or loading) the level-of-detail pyramid of a peak layer in a background thread.
+
+      Controlled by the 'lod_pyramid' parameter. The background thread reads the peak map of the layer,
+      which must therefore not be changed in place (replace it via LayerData::setPeakData() instead).
+      The result is assigned in intensityPyramidFinished_().
+    */
+    void startIntensityPyramid_(Size layer_index);
+
     /**
       @brief Paints the precursor peaks.
 
@@ -389,6 +412,9 @@ protected:
     double pen_size_max_; ///< maximum number of pixels for one data point
     double canvas_coverage_min_; ///< minimum coverage of the canvas required; if lower, points are upscaled in size
 
+    /// running pyramid computations (future watcher -> peak data of the layer)
+    std::map<QObject*, boost::weak_ptr<const ExperimentType> > pyramid_builds_;
+
   private:
     /// Default C'tor hidden
     Spectrum2DCanvas();
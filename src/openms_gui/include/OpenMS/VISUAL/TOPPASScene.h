@@ -43,6 +43,10 @@
 
 #include <QtWidgets/QGraphicsScene>
 #include <QtCore/QProcess>
+#include <QtCore/QHash>
+#include <QtCore/QElapsedTimer>
+
+#include <map>
 
 namespace OpenMS
 {
@@ -93,11 +97,17 @@ public:
     struct TOPPProcess
     {
       /// Constructor
-      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool) :
+      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool, int rnd = 0) :
         proc(p),
         command(cmd),
         args(arg),
-        tv(tool)
+        tv(tool),
+        round(rnd),
+        threads(1),
+        memory(0),
+        priority(0),
+        queued(0),
+        started(0)
       {
       }
 
@@ -109,6 +119,18 @@ public:
       QStringList args;
       /// The tool which is started (used to call its slots)
       TOPPASToolVertex * tv;
+      /// The round of the tool this process belongs to
+      int round;
+      /// Number of CPU slots occupied while running (set by enqueueProcess() and runNextProcess())
+      int threads;
+      /// Memory (in MB) reserved while running (0 if not declared)
+      UInt memory;
+      /// Scheduling priority: number of tools on the longest path from the tool to the end of the workflow
+      int priority;
+      /// Time (ms since start of the pipeline) when the process was enqueued
+      qint64 queued;
+      /// Time (ms since start of the pipeline) when the process was started
+      qint64 started;
     };
 
     /// The current action mode (creation of a new edge, or panning of the widget)
@@ -204,9 +226,17 @@ public:
     bool isPipelineRunning();
     /// Shows a dialog that allows to specify the output directory. If @p always_ask == false, the dialog won't be shown if a directory has been set, already.
     bool askForOutputDir(bool always_ask = true);
-    /// Enqueues the process, it will be run when the currently pending processes have finished
+    /// Enqueues the process, it will be run as soon as its CPU and memory requirements fit into the budget
     void enqueueProcess(const TOPPProcess & process);
-    /// Runs the next process in the queue, if any
+    /**
+      @brief Starts queued processes as long as they fit into the CPU/memory budget
+
+      Each process occupies as many CPU slots as its tool's 'threads' parameter (at most the number of allowed threads)
+      and the memory declared for its tool (see TOPPASToolVertex::setRequiredMemory()). Among the processes that fit,
+      the one whose tool lies on the longest remaining path of the workflow is started first, so the critical path
+      is not delayed by independent side branches. If nothing is running, the next process is started regardless of
+      its memory requirement.
+    */
     void runNextProcess();
     /// Resets the processes queue
     void resetProcessesQueue();
@@ -240,8 +270,10 @@ public:
     QString getDescription() const;
     /// when description is updated by user, use this to update the description for later storage in file
     void setDescription(const QString & desc);
-    /// sets the maximum number of jobs
+    /// sets the maximum number of CPU threads that running tools may use in total
     void setAllowedThreads(int num_threads);
+    /// sets the memory budget (in MB) for running tools (0 = unlimited)
+    void setMemoryBudget(UInt memory_mb);
     /// returns the hovering edge
     TOPPASEdge* getHoveringEdge();
     /// Checks whether all output vertices are finished, and if yes, emits entirePipelineFinished() (called by finished output vertices)
@@ -275,8 +307,8 @@ public slots:
     void changedParameter(const bool invalidates_running_pipeline);
     /// Invoked by OutfilelistVertex of user changed the folder name
     void changedOutputFolder();
-    /// Called by a finished QProcess to indicate that we are free to start a new one
-    void processFinished();
+    /// Called when the QProcess @p proc has finished: releases its resources, records its timing and starts pending processes
+    void processFinished(QProcess * proc, int exit_code, QProcess::ExitStatus exit_status);
     /// dirty solution: when using ExecutePipeline this slot is called when the pipeline crashes. This will quit the app
     void quitWithError();
 
@@ -355,12 +387,22 @@ protected:
     TOPPASScene * clipboard_;
     /// dry run mode (no tools are actually called)
     bool dry_run_;
-    /// currently running processes...
+    /// CPU slots occupied by the currently running processes
     int threads_active_;
+    /// memory (in MB) reserved by the currently running processes
+    UInt memory_active_;
     /// description text
     QString description_text_;
     /// maximum number of allowed threads
     int allowed_threads_;
+    /// memory budget in MB (0 = unlimited)
+    UInt memory_budget_;
+    /// the currently running processes
+    std::map<QProcess *, TOPPProcess> running_processes_;
+    /// cache for critical path lengths of vertices (cleared when a pipeline is started)
+    QHash<TOPPASVertex *, int> critical_path_;
+    /// time since the pipeline was started (for the timing trace)
+    QElapsedTimer pipeline_timer_;
     /// last node where 'resume' was started
     TOPPASToolVertex* resume_source_;
 
@@ -370,6 +412,12 @@ protected:
     bool isEdgeAllowed_(TOPPASVertex * u, TOPPASVertex * v);
     /// DFS helper method. Returns true, if a back edge has been discovered
     bool dfsVisit_(TOPPASVertex * vertex);
+    /// Returns the number of tools on the longest path starting at @p vertex (including the vertex itself)
+    int criticalPathLength_(TOPPASVertex * vertex);
+    /// Returns whether @p process fits into the free CPU/memory budget
+    bool processFits_(const TOPPProcess & process) const;
+    /// Appends the timing of a finished process to 'TOPPAS_timing.tsv' in the output directory
+    void writeToTimingTrace_(const TOPPProcess & process, int exit_code, QProcess::ExitStatus exit_status);
     /// Performs a sanity check of the pipeline and notifies user when it finds something strange. Returns if pipeline OK.
     /// if 'allowUserOverride' is true, some dialogs are shown which allow the user to ignore some warnings (e.g. disconnected nodes)
     bool sanityCheck_(bool allowUserOverride);
@@ -166,6 +166,12 @@ public:
     void setParam(const Param& param);
     /// Returns the Param object of this tool
     const Param& getParam();
+    /// Returns the number of threads the tool uses (its 'threads' parameter, 1 if it has none)
+    int getRequiredThreads() const;
+    /// Returns the memory (in MB) declared for one run of the tool (0 if not declared)
+    UInt getRequiredMemory() const;
+    /// Declares the memory (in MB) one run of the tool needs, used for scheduling (0 = not declared)
+    void setRequiredMemory(UInt memory_mb);
     /// Checks if all parent nodes have finished the tool execution and, if so, runs the tool
     void run() override;
     /// Updates the vector containing the lists of current output files for all output parameters
@@ -273,6 +279,9 @@ protected:
     /// Breakpoint set?
     bool breakpoint_set_;
 
+    /// Declared memory requirement in MB (0 = not declared)
+    UInt memory_mb_;
+
     /// smart naming of round-based filenames
     /// when basename is not unique we take the preceding directory name
     void smartFileNames_(std::vector<QStringList>& filenames);
@@ -4278,17 +4278,21 @@ namespace OpenMS
         // reload data
         if (layer.type == LayerData::DT_PEAK) //peak data
         {
+          // load into a new map instead of overwriting the current one, which
+          // other views or background threads (2D view pyramid) may still read
+          ExperimentSharedPtrType peaks(new ExperimentType());
           try
           {
-            FileHandler().loadExperiment(layer.filename, *layer.getPeakDataMuteable());
+            FileHandler().loadExperiment(layer.filename, *peaks);
           }
           catch (Exception::BaseException& e)
           {
             QMessageBox::critical(this, "Error", (String("Error while loading file") + layer.filename + "\nError message: " + e.what()).toQString());
-            layer.getPeakDataMuteable()->clear(true);
+            peaks->clear(true);
           }
-          layer.getPeakDataMuteable()->sortSpectra(true);
-          layer.getPeakDataMuteable()->updateRanges(1);
+          peaks->sortSpectra(true);
+          peaks->updateRanges(1);
+          layer.setPeakData(peaks);
         }
         else if (layer.type == LayerData::DT_FEATURE) //feature data
         {
@@ -4319,17 +4323,19 @@ namespace OpenMS
         else if (layer.type == LayerData::DT_CHROMATOGRAM) //chromatogram
         {
           //TODO CHROM
+          ExperimentSharedPtrType peaks(new ExperimentType());
           try
           {
-            FileHandler().loadExperiment(layer.filename, *layer.getPeakDataMuteable());
+            FileHandler().loadExperiment(layer.filename, *peaks);
           }
           catch (Exception::BaseException& e)
           {
             QMessageBox::critical(this, "Error", (String("Error while loading file") + layer.filename + "\nError message: " + e.what()).toQString());
-            layer.getPeakDataMuteable()->clear(true);
+            peaks->clear(true);
           }
-          layer.getPeakDataMuteable()->sortChromatograms(true);
-          layer.getPeakDataMuteable()->updateRanges(1);
+          peaks->sortChromatograms(true);
+          peaks->updateRanges(1);
+          layer.setPeakData(peaks);
 
         }
         /*      else if (layer.type == LayerData::DT_IDENT) // identifications
@@ -0,0 +1,414 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/IntensityPyramid.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// File magic number of stored pyramids (increase on format changes)
+    const UInt32 LOD_FILE_IDENTIFIER = 0x4c4f4401;
+
+    /// Upper bound for the number of levels in a file (a 2^63 grid would not fit in memory anyway)
+    const UInt64 LOD_MAX_LEVELS = 64;
+
+    /// Index of the first of @p n cells (starting at @p origin, width @p width) whose center is >= @p pos
+    Size cellBoundary(double pos, double origin, double width, Size n)
+    {
+      double c = std::ceil((pos - origin) / width - 0.5);
+      if (c <= 0.0) return 0;
+      if (c >= (double)n) return n;
+      return (Size)c;
+    }
+
+    /// Index of the cell containing @p pos (clamped to the grid)
+    Size cellIndex(double pos, double origin, double width, Size n)
+    {
+      double c = (pos - origin) / width;
+      if (c <= 0.0) return 0;
+      if (c >= (double)(n - 1)) return n - 1;
+      return (Size)c;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& ofs, const T& value)
+    {
+      ofs.write((const char*)&value, sizeof(T));
+    }
+
+    template <typename T>
+    void readValue(std::ifstream& ifs, T& value)
+    {
+      ifs.read((char*)&value, sizeof(T));
+    }
+  }
+
+  IntensityPyramid::IntensityPyramid() :
+    source_(),
+    rt_min_(0.0),
+    mz_min_(0.0),
+    rt_width_(1.0),
+    mz_width_(1.0),
+    rt_bins_(),
+    mz_bins_(),
+    levels_()
+  {
+  }
+
+  void IntensityPyramid::clear()
+  {
+    source_ = Fingerprint();
+    rt_min_ = 0.0;
+    mz_min_ = 0.0;
+    rt_width_ = 1.0;
+    mz_width_ = 1.0;
+    rt_bins_.clear();
+    mz_bins_.clear();
+    levels_.clear();
+  }
+
+  IntensityPyramid::Fingerprint IntensityPyramid::fingerprint_(const PeakMap& exp)
+  {
+    Fingerprint fp;
+    fp.spectra = exp.size();
+    fp.peaks = 0;
+    fp.rt_min = std::numeric_limits<double>::max();
+    fp.rt_max = -std::numeric_limits<double>::max();
+    fp.mz_min = std::numeric_limits<double>::max();
+    fp.mz_max = -std::numeric_limits<double>::max();
+    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it)
+    {
+      fp.peaks += it->size();
+      if (it->getMSLevel() != 1 || it->empty()) continue;
+      fp.rt_min = std::min(fp.rt_min, it->getRT());
+      fp.rt_max = std::max(fp.rt_max, it->getRT());
+      fp.mz_min = std::min(fp.mz_min, it->front().getMZ());
+      fp.mz_max = std::max(fp.mz_max, it->back().getMZ());
+    }
+    return fp;
+  }
+
+  void IntensityPyramid::build(const PeakMap& exp, Size rt_bins, Size mz_bins)
+  {
+    clear();
+    source_ = fingerprint_(exp);
+    if (source_.rt_min > source_.rt_max) return; // no MS1 peaks
+
+    Size ms1_scans = 0;
+    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it)
+    {
+      if (it->getMSLevel() == 1 && !it->empty()) ++ms1_scans;
+    }
+    const Size n_rt = std::max(Size(1), std::min(rt_bins, ms1_scans));
+    const Size n_mz = std::max(Size(1), mz_bins);
+
+    rt_min_ = source_.rt_min;
+    mz_min_ = source_.mz_min;
+    rt_width_ = (source_.rt_max - source_.rt_min) / n_rt;
+    mz_width_ = (source_.mz_max - source_.mz_min) / n_mz;
+    // degenerate ranges (e.g. a single scan): any positive width maps everything to the first cell
+    if (!(rt_width_ > 0.0)) rt_width_ = 1.0;
+    if (!(mz_width_ > 0.0)) mz_width_ = 1.0;
+
+    // level 0: maximum intensity of the raw peaks in each cell
+    rt_bins_.push_back(n_rt);
+    mz_bins_.push_back(n_mz);
+    levels_.push_back(std::vector<float>(n_rt * n_mz, -1.0f));
+    std::vector<float>& base = levels_.back();
+    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it)
+    {
+      if (it->getMSLevel() != 1 || it->empty()) continue;
+      float* row = &base[cellIndex(it->getRT(), rt_min_, rt_width_, n_rt) * n_mz];
+      for (PeakMap::SpectrumType::ConstIterator p = it->begin(); p != it->end(); ++p)
+      {
+        float& cell = row[cellIndex(p->getMZ(), mz_min_, mz_width_, n_mz)];
+        cell = std::max(cell, p->getIntensity());
+      }
+    }
+
+    // coarser levels: maximum of 2x2 cells of the previous level
+    while (rt_bins_.back() > 1 || mz_bins_.back() > 1)
+    {
+      const Size rows = rt_bins_.back();
+      const Size cols = mz_bins_.back();
+      const Size next_rows = (rows + 1) / 2;
+      const Size next_cols = (cols + 1) / 2;
+      levels_.push_back(std::vector<float>(next_rows * next_cols, -1.0f));
+      const std::vector<float>& prev = levels_[levels_.size() - 2];
+      std::vector<float>& next = levels_.back();
+      for (Size r = 0; r < rows; ++r)
+      {
+        const float* src = &prev[r * cols];
+        float* dst = &next[(r / 2) * next_cols];
+        for (Size c = 0; c < cols; ++c)
+        {
+          dst[c / 2] = std::max(dst[c / 2], src[c]);
+        }
+      }
+      rt_bins_.push_back(next_rows);
+      mz_bins_.push_back(next_cols);
+    }
+  }
+
+  bool IntensityPyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  Size IntensityPyramid::getLevelCount() const
+  {
+    return levels_.size();
+  }
+
+  Size IntensityPyramid::getRTBins(Size level) const
+  {
+    return rt_bins_[level];
+  }
+
+  Size IntensityPyramid::getMZBins(Size level) const
+  {
+    return mz_bins_[level];
+  }
+
+  float IntensityPyramid::getValue(Size level, Size rt_bin, Size mz_bin) const
+  {
+    return levels_[level][rt_bin * mz_bins_[level] + mz_bin];
+  }
+
+  double IntensityPyramid::getRTMin() const
+  {
+    return rt_min_;
+  }
+
+  double IntensityPyramid::getMZMin() const
+  {
+    return mz_min_;
+  }
+
+  double IntensityPyramid::getRTBinWidth() const
+  {
+    return rt_width_;
+  }
+
+  double IntensityPyramid::getMZBinWidth() const
+  {
+    return mz_width_;
+  }
+
+  bool IntensityPyramid::fillPixels(double rt_min, double rt_max, double mz_min, double mz_max,
+                                    Size rt_pixel_count, Size mz_pixel_count, std::vector<float>& pixels) const
+  {
+    if (empty() || rt_pixel_count == 0 || mz_pixel_count == 0) return false;
+
+    const double rt_pixel = (rt_max - rt_min) / rt_pixel_count;
+    const double mz_pixel = (mz_max - mz_min) / mz_pixel_count;
+    if (rt_pixel < rt_width_ || mz_pixel < mz_width_) return false; // zoomed in too far
+
+    // coarsest level whose cells are not larger than a pixel
+    Size level = 0;
+    double scale = 1.0;
+    while (level + 1 < levels_.size() && 2.0 * scale * rt_width_ <= rt_pixel && 2.0 * scale * mz_width_ <= mz_pixel)
+    {
+      ++level;
+      scale *= 2.0;
+    }
+    const Size rows = rt_bins_[level];
+    const Size cols = mz_bins_[level];
+    const double cell_rt = scale * rt_width_;
+    const double cell_mz = scale * mz_width_;
+    const std::vector<float>& cells = levels_[level];
+
+    // pixel p covers cells [boundary[p], boundary[p + 1])
+    std::vector<Size> rt_boundary(rt_pixel_count + 1), mz_boundary(mz_pixel_count + 1);
+    for (Size p = 0; p <= rt_pixel_count; ++p)
+    {
+      rt_boundary[p] = cellBoundary(rt_min + p * rt_pixel, rt_min_, cell_rt, rows);
+    }
+    for (Size p = 0; p <= mz_pixel_count; ++p)
+    {
+      mz_boundary[p] = cellBoundary(mz_min + p * mz_pixel, mz_min_, cell_mz, cols);
+    }
+
+    pixels.assign(rt_pixel_count * mz_pixel_count, -1.0f);
+    const Size col_begin = mz_boundary.front();
+    const Size col_end = mz_boundary.back();
+    if (col_begin >= col_end) return true;
+
+    // collapse the rows of each RT pixel first, then the columns of each m/z pixel
+    std::vector<float> row_max(cols);
+    for (Size rp = 0; rp < rt_pixel_count; ++rp)
+    {
+      if (rt_boundary[rp] >= rt_boundary[rp + 1]) continue;
+      std::fill(row_max.begin() + col_begin, row_max.begin() + col_end, -1.0f);
+      for (Size r = rt_boundary[rp]; r < rt_boundary[rp + 1]; ++r)
+      {
+        const float* src = &cells[r * cols];
+        for (Size c = col_begin; c < col_end; ++c)
+        {
+          row_max[c] = std::max(row_max[c], src[c]);
+        }
+      }
+      float* dst = &pixels[rp * mz_pixel_count];
+      for (Size mp = 0; mp < mz_pixel_count; ++mp)
+      {
+        for (Size c = mz_boundary[mp]; c < mz_boundary[mp + 1]; ++c)
+        {
+          dst[mp] = std::max(dst[mp], row_max[c]);
+        }
+      }
+    }
+    return true;
+  }
+
+  bool IntensityPyramid::matches(const PeakMap& exp) const
+  {
+    Fingerprint fp = fingerprint_(exp);
+    return fp.spectra == source_.spectra && fp.peaks == source_.peaks &&
+           fp.rt_min == source_.rt_min && fp.rt_max == source_.rt_max &&
+           fp.mz_min == source_.mz_min && fp.mz_max == source_.mz_max;
+  }
+
+  void IntensityPyramid::store(const String& filename) const
+  {
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    writeValue(ofs, LOD_FILE_IDENTIFIER);
+    writeValue(ofs, source_.spectra);
+    writeValue(ofs, source_.peaks);
+    writeValue(ofs, source_.rt_min);
+    writeValue(ofs, source_.rt_max);
+    writeValue(ofs, source_.mz_min);
+    writeValue(ofs, source_.mz_max);
+    writeValue(ofs, rt_min_);
+    writeValue(ofs, mz_min_);
+    writeValue(ofs, rt_width_);
+    writeValue(ofs, mz_width_);
+    writeValue(ofs, (UInt64)levels_.size());
+    for (Size i = 0; i < levels_.size(); ++i)
+    {
+      writeValue(ofs, (UInt64)rt_bins_[i]);
+      writeValue(ofs, (UInt64)mz_bins_[i]);
+      ofs.write((const char*)levels_[i].data(), levels_[i].size() * sizeof(float));
+    }
+    ofs.close();
+    if (ofs.fail())
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing the intensity pyramid.");
+    }
+  }
+
+  void IntensityPyramid::load(const String& filename)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    if (ifs.fail())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    ifs.seekg(0, ifs.end);
+    UInt64 bytes_left = ifs.tellg();
+    ifs.seekg(0, ifs.beg);
+
+    UInt32 identifier = 0;
+    readValue(ifs, identifier);
+    if (!ifs || identifier != LOD_FILE_IDENTIFIER)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "File might not be an intensity pyramid file (wrong file magic number). Aborting!", filename);
+    }
+
+    IntensityPyramid tmp;
+    UInt64 level_count = 0;
+    readValue(ifs, tmp.source_.spectra);
+    readValue(ifs, tmp.source_.peaks);
+    readValue(ifs, tmp.source_.rt_min);
+    readValue(ifs, tmp.source_.rt_max);
+    readValue(ifs, tmp.source_.mz_min);
+    readValue(ifs, tmp.source_.mz_max);
+    readValue(ifs, tmp.rt_min_);
+    readValue(ifs, tmp.mz_min_);
+    readValue(ifs, tmp.rt_width_);
+    readValue(ifs, tmp.mz_width_);
+    readValue(ifs, level_count);
+    if (!ifs || level_count > LOD_MAX_LEVELS || !(tmp.rt_width_ > 0.0) || !(tmp.mz_width_ > 0.0))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid intensity pyramid header.", filename);
+    }
+    bytes_left -= ifs.tellg();
+
+    for (UInt64 i = 0; i < level_count; ++i)
+    {
+      UInt64 rows = 0, cols = 0;
+      readValue(ifs, rows);
+      readValue(ifs, cols);
+      // each level must halve the previous one (this also bounds the allocation below)
+      bool valid_size = (i == 0) ? (rows > 0 && cols > 0 && rows <= bytes_left && cols <= bytes_left / rows / sizeof(float))
+                                 : (rows == (tmp.rt_bins_.back() + 1) / 2 && cols == (tmp.mz_bins_.back() + 1) / 2);
+      if (!ifs || !valid_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid size of intensity pyramid level " + String(i) + ".", filename);
+      }
+      tmp.rt_bins_.push_back(rows);
+      tmp.mz_bins_.push_back(cols);
+      tmp.levels_.push_back(std::vector<float>(rows * cols));
+      ifs.read((char*)tmp.levels_.back().data(), rows * cols * sizeof(float));
+      if (!ifs)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unexpected end of file.", filename);
+      }
+    }
+    if (level_count > 0 && (tmp.rt_bins_.back() != 1 || tmp.mz_bins_.back() != 1))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Incomplete intensity pyramid.", filename);
+    }
+    *this = tmp;
+  }
+
+  String IntensityPyramid::getSidecarFilename(const String& data_filename)
+  {
+    return data_filename + ".lod";
+  }
+
+} // namespace OpenMS
@@ -1200,9 +1200,21 @@ namespace OpenMS
 
     // sort spectra in ascending order of position (ensure that we sort all spectra as well as the currently
     // TODO: check why this is need since we load data already sorted! 
-    for (Size i = 0; i < getCurrentLayer_().getPeakData()->size(); ++i)
+    // The peak map may be shared with other views (e.g. the 2D view that opened
+    // this spectrum), so unsorted data is sorted in a copy instead of in place.
+    const ExperimentType & exp = *getCurrentLayer_().getPeakData();
+    for (Size i = 0; i < exp.size(); ++i)
     {
-      (*getCurrentLayer_().getPeakDataMuteable())[i].sortByPosition();
+      if (!exp[i].isSorted())
+      {
+        ExperimentSharedPtrType sorted(new ExperimentType(exp));
+        for (Size j = i; j < sorted->size(); ++j)
+        {
+          (*sorted)[j].sortByPosition();
+        }
+        getCurrentLayer_().setPeakData(sorted);
+        break;
+      }
     }
     getCurrentLayer_().sortCurrentSpectrumByPosition();
 
@@ -45,6 +45,7 @@
 #include <OpenMS/VISUAL/ColorSelector.h>
 #include <OpenMS/VISUAL/MultiGradientSelector.h>
 #include <OpenMS/VISUAL/DIALOGS/FeatureEditDialog.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/SYSTEM/FileWatcher.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 //STL
@@ -60,6 +61,8 @@
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/QFutureWatcher>
 
 //boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -80,6 +83,50 @@ namespace OpenMS
 {
   using namespace Internal;
 
+  namespace
+  {
+    typedef QFutureWatcher<LayerData::IntensityPyramidSharedPtrType> PyramidWatcher;
+
+    /// Loads the pyramid from @p sidecar (if given and up to date) or computes it (and tries to store it to @p sidecar)
+    LayerData::IntensityPyramidSharedPtrType buildIntensityPyramid(LayerData::ConstExperimentSharedPtrType exp, String sidecar)
+    {
+      try
+      {
+        boost::shared_ptr<IntensityPyramid> pyramid(new IntensityPyramid());
+        if (!sidecar.empty() && File::exists(sidecar))
+        {
+          try
+          {
+            pyramid->load(sidecar);
+            if (pyramid->matches(*exp)) return pyramid;
+          }
+          catch (Exception::BaseException&)
+          {
+            // outdated or broken file: recompute below
+          }
+        }
+        pyramid->build(*exp);
+        if (!sidecar.empty())
+        {
+          try
+          {
+            pyramid->store(sidecar);
+          }
+          catch (Exception::BaseException&)
+          {
+            // e.g. read-only directory: the pyramid is used anyway
+          }
+        }
+        return pyramid;
+      }
+      catch (std::bad_alloc&)
+      {
+        // not enough memory: paint raw peaks
+        return LayerData::IntensityPyramidSharedPtrType();
+      }
+    }
+  }
+
   Spectrum2DCanvas::Spectrum2DCanvas(const Param & preferences, QWidget * parent) :
     SpectrumCanvas(preferences, parent),
     projection_mz_(),
@@ -103,6 +150,8 @@ namespace OpenMS
     defaults_.setMaxInt("dot:feature_icon_size", 999);
     defaults_.setValue("mapping_of_mz_to", "y_axis", "Determines which axis is the m/z axis.");
     defaults_.setValidStrings("mapping_of_mz_to", ListUtils::create<String>("x_axis,y_axis"));
+    defaults_.setValue("lod_pyramid", "on", "Level-of-detail intensity pyramid that speeds up painting of large peak maps. It is computed in the background after loading. 'persist' additionally stores it next to the data file ('.lod') and reuses it on the next load.");
+    defaults_.setValidStrings("lod_pyramid", ListUtils::create<String>("off,on,persist"));
     defaultsToParam_();
     setName("Spectrum2DCanvas");
     setParameters(preferences);
@@ -634,10 +683,106 @@ namespace OpenMS
     painter.restore();
   }
 
+  bool Spectrum2DCanvas::paintPyramidIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count)
+  {
+    const LayerData & layer = getLayer(layer_index);
+    const LayerData::IntensityPyramidSharedPtrType & pyramid = layer.getIntensityPyramid();
+    // the pyramid is computed from all peaks, i.e. it cannot honor filters
+    if (!pyramid || layer.filters.isActive())
+    {
+      return false;
+    }
+
+    const double rt_min = visible_area_.minPosition()[1];
+    const double rt_max = visible_area_.maxPosition()[1];
+    const double mz_min = visible_area_.minPosition()[0];
+    const double mz_max = visible_area_.maxPosition()[0];
+
+    vector<float> pixels;
+    if (!pyramid->fillPixels(rt_min, rt_max, mz_min, mz_max, rt_pixel_count, mz_pixel_count, pixels))
+    {
+      return false;
+    }
+
+    Int image_width = buffer_.width();
+    Int image_height = buffer_.height();
+    double snap_factor = snap_factors_[layer_index];
+    double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
+    double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
+    for (Size rt = 0; rt < rt_pixel_count; ++rt)
+    {
+      const float * row = &pixels[rt * mz_pixel_count];
+      for (Size mz = 0; mz < mz_pixel_count; ++mz)
+      {
+        if (row[mz] < 0.0) continue;
+        QPoint pos;
+        dataToWidget_(mz_min + (mz + 0.5) * mz_step_size, rt_min + (rt + 0.5) * rt_step_size, pos);
+        if (pos.y() < image_height && pos.x() < image_width)
+        {
+          buffer_.setPixel(pos.x(), pos.y(), heightColor_(row[mz], layer.gradient, snap_factor).rgb());
+        }
+      }
+    }
+    return true;
+  }
+
+  void Spectrum2DCanvas::startIntensityPyramid_(Size layer_index)
+  {
+    String mode = param_.getValue("lod_pyramid");
+    const LayerData & layer = getLayer(layer_index);
+    // on-disc data has no peaks in memory
+    if (mode == "off" || layer.type != LayerData::DT_PEAK || layer.getPeakData()->getSize() == 0)
+    {
+      return;
+    }
+    String sidecar;
+    if (mode == "persist" && !layer.filename.empty())
+    {
+      sidecar = IntensityPyramid::getSidecarFilename(layer.filename);
+    }
+
+    // The worker shares the peak map of the layer: reloading replaces the
+    // layer's map (see LayerData::setPeakData) instead of changing it in place,
+    // and the worker keeps the old one alive until it is done.
+    PyramidWatcher * watcher = new PyramidWatcher(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(intensityPyramidFinished_()));
+    pyramid_builds_[watcher] = layer.getPeakData();
+    watcher->setFuture(QtConcurrent::run(buildIntensityPyramid, layer.getPeakData(), sidecar));
+  }
+
+  void Spectrum2DCanvas::intensityPyramidFinished_()
+  {
+    PyramidWatcher * watcher = static_cast<PyramidWatcher *>(sender());
+    std::map<QObject *, boost::weak_ptr<const ExperimentType> >::iterator it = pyramid_builds_.find(watcher);
+    if (it != pyramid_builds_.end())
+    {
+      // the layer might have been closed or its data replaced in the meantime
+      LayerData::ConstExperimentSharedPtrType exp = it->second.lock();
+      LayerData::IntensityPyramidSharedPtrType pyramid = watcher->result();
+      for (Size i = 0; exp && pyramid && i < getLayerCount(); ++i)
+      {
+        if (getLayer(i).type == LayerData::DT_PEAK && getLayer(i).getPeakData() == exp)
+        {
+          getLayer_(i).setIntensityPyramid(pyramid);
+          update_buffer_ = true;
+          update_(OPENMS_PRETTY_FUNCTION);
+        }
+      }
+      pyramid_builds_.erase(it);
+    }
+    watcher->deleteLater();
+  }
+
   void Spectrum2DCanvas::paintMaximumIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter & painter)
   {
     //set painter to black (we operate directly on the pixels for all colored data)
     painter.setPen(Qt::black);
+
+    // use the precomputed maxima unless zoomed in too far
+    if (paintPyramidIntensities_(layer_index, rt_pixel_count, mz_pixel_count))
+    {
+      return;
+    }
     //temporary variables
     Int image_width = buffer_.width();
     Int image_height = buffer_.height();
@@ -1259,6 +1404,7 @@ namespace OpenMS
       {
         setLayerFlag(LayerData::P_PRECURSORS, true); // show precursors if no MS1 data is contained
       }
+      startIntensityPyramid_(current_layer_);
     }
     else if (layers_.back().type == LayerData::DT_FEATURE)  // feature data
     {
@@ -2844,6 +2990,25 @@ namespace OpenMS
   {
     //update nearest peak
     selected_peak_.clear();
+
+    // the peak data was reloaded: discard the pyramid (and pending results for the old data) and compute a new one
+    if (getLayer(i).type == LayerData::DT_PEAK)
+    {
+      for (std::map<QObject *, boost::weak_ptr<const ExperimentType> >::iterator it = pyramid_builds_.begin(); it != pyramid_builds_.end(); )
+      {
+        if (it->second.lock() == getLayer(i).getPeakData())
+        {
+          pyramid_builds_.erase(it++);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+      getLayer_(i).setIntensityPyramid(LayerData::IntensityPyramidSharedPtrType());
+      startIntensityPyramid_(i);
+    }
+
     recalculateRanges_(0, 1, 2);
     resetZoom(false);     //no repaint as this is done in intensityModeChange_() anyway
     intensityModeChange_();
@@ -59,6 +59,8 @@
 #include <QtCore/QTextStream>
 #include <QtWidgets/QMessageBox>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -87,7 +89,12 @@ namespace OpenMS
     clipboard_(nullptr),
     dry_run_(true),
     threads_active_(0),
+    memory_active_(0),
     allowed_threads_(1),
+    memory_budget_(0),
+    running_processes_(),
+    critical_path_(),
+    pipeline_timer_(),
     resume_source_(nullptr)
   {
     /*	ATTENTION!
@@ -670,6 +677,9 @@ namespace OpenMS
       QFile logfile(out_dir_ + QDir::separator() + "TOPPAS.log");
       if (logfile.exists())
         logfile.remove();
+      QFile tracefile(out_dir_ + QDir::separator() + "TOPPAS_timing.tsv");
+      if (tracefile.exists())
+        tracefile.remove();
 
       // reset processes
       topp_processes_queue_.clear();
@@ -741,6 +751,10 @@ namespace OpenMS
         save_param.setValue("vertices:" + id + ":tool_name", DataValue(ttv->getName()));
         save_param.setValue("vertices:" + id + ":tool_type", DataValue(ttv->getType()));
         save_param.insert("vertices:" + id + ":parameters:", ttv->getParam());
+        if (ttv->getRequiredMemory() > 0) // optional, used for scheduling
+        {
+          save_param.setValue("vertices:" + id + ":memory", (int)ttv->getRequiredMemory());
+        }
         save_param.setValue("vertices:" + id + ":x_pos", DataValue(tv->x()));
         save_param.setValue("vertices:" + id + ":y_pos", DataValue(tv->y()));
         continue;
@@ -962,6 +976,10 @@ namespace OpenMS
           Param param_param = vertices_param.copy(current_id + ":parameters:", true);
           TOPPASToolVertex* tv = new TOPPASToolVertex(tool_name, tool_type);
           tv->setParam(param_param);
+          if (vertices_param.exists(current_id + ":memory")) // declared memory in MB (optional)
+          {
+            tv->setRequiredMemory(std::max(0, (int)vertices_param.getValue(current_id + ":memory")));
+          }
 
           connectToolVertexSignals(tv);
 
@@ -1342,6 +1360,40 @@ namespace OpenMS
     logfile.close();
   }
 
+  void TOPPASScene::writeToTimingTrace_(const TOPPProcess& process, int exit_code, QProcess::ExitStatus exit_status)
+  {
+    QFile tracefile(out_dir_ + QDir::separator() + "TOPPAS_timing.tsv");
+    bool write_header = !tracefile.exists();
+    if (!tracefile.open(QIODevice::Append | QIODevice::Text))
+    {
+      std::cerr << "Could not write to timing trace '" << String(tracefile.fileName()) << "'" << std::endl;
+      return;
+    }
+
+    // times in seconds since the start of the pipeline
+    qint64 finished = pipeline_timer_.elapsed();
+    QTextStream ts(&tracefile);
+    if (write_header)
+    {
+      ts << "node\ttool\ttype\tround\tthreads\tmemory_mb\tpriority\tqueued\tstarted\tfinished\tqueue_time\trun_time\texit_code\tstatus\n";
+    }
+    ts << process.tv->getTopoNr() << "\t"
+       << process.tv->getName().toQString() << "\t"
+       << process.tv->getType().toQString() << "\t"
+       << process.round << "\t"
+       << process.threads << "\t"
+       << process.memory << "\t"
+       << process.priority << "\t"
+       << process.queued / 1000.0 << "\t"
+       << process.started / 1000.0 << "\t"
+       << finished / 1000.0 << "\t"
+       << (process.started - process.queued) / 1000.0 << "\t"
+       << (finished - process.started) / 1000.0 << "\t"
+       << exit_code << "\t"
+       << (exit_status != QProcess::NormalExit ? "crashed" : (exit_code != 0 ? "failed" : "finished")) << "\n";
+    tracefile.close();
+  }
+
   void TOPPASScene::logTOPPOutput(const QString& out)
   {
     TOPPASToolVertex* sender = qobject_cast<TOPPASToolVertex*>(QObject::sender());
@@ -1657,16 +1709,32 @@ namespace OpenMS
   void TOPPASScene::setPipelineRunning(bool b)
   {
     running_ = b;
-    if (!running_) // whenever we stop the pipeline and user is not looking, the icon should flash
+    if (running_)
+    {
+      // the workflow might have been edited since the last run
+      critical_path_.clear();
+      pipeline_timer_.start();
+    }
+    else // whenever we stop the pipeline and user is not looking, the icon should flash
     {
       resume_source_ = nullptr;
       QApplication::alert(nullptr); // flash Taskbar || Dock
     }
   }
 
-  void TOPPASScene::processFinished()
+  void TOPPASScene::processFinished(QProcess* proc, int exit_code, QProcess::ExitStatus exit_status)
   {
-    --threads_active_;
+    std::map<QProcess*, TOPPProcess>::iterator it = running_processes_.find(proc);
+    if (it != running_processes_.end())
+    {
+      threads_active_ -= it->second.threads;
+      memory_active_ -= it->second.memory;
+      if (!dry_run_)
+      {
+        writeToTimingTrace_(it->second, exit_code, exit_status);
+      }
+      running_processes_.erase(it);
+    }
     // try to run next in line
     runNextProcess();
   }
@@ -1993,7 +2061,42 @@ namespace OpenMS
 
   void TOPPASScene::enqueueProcess(const TOPPProcess& process)
   {
-    topp_processes_queue_ << process;
+    TOPPProcess tp = process;
+    tp.threads = tp.tv->getRequiredThreads();
+    tp.memory = tp.tv->getRequiredMemory();
+    tp.priority = criticalPathLength_(tp.tv);
+    tp.queued = pipeline_timer_.isValid() ? pipeline_timer_.elapsed() : 0;
+    topp_processes_queue_ << tp;
+  }
+
+  int TOPPASScene::criticalPathLength_(TOPPASVertex* vertex)
+  {
+    QHash<TOPPASVertex*, int>::const_iterator cached = critical_path_.constFind(vertex);
+    if (cached != critical_path_.constEnd())
+    {
+      return *cached;
+    }
+    int longest_child = 0;
+    for (TOPPASVertex::ConstEdgeIterator it = vertex->outEdgesBegin(); it != vertex->outEdgesEnd(); ++it)
+    {
+      longest_child = std::max(longest_child, criticalPathLength_((*it)->getTargetVertex()));
+    }
+    int length = longest_child + (qobject_cast<TOPPASToolVertex*>(vertex) ? 1 : 0);
+    critical_path_.insert(vertex, length);
+    return length;
+  }
+
+  bool TOPPASScene::processFits_(const TOPPProcess& process) const
+  {
+    if (threads_active_ == 0)
+    {
+      return true; // never stall: a single tool may exceed the budget
+    }
+    if (threads_active_ + std::min(process.threads, allowed_threads_) > allowed_threads_)
+    {
+      return false;
+    }
+    return memory_budget_ == 0 || memory_active_ + process.memory <= memory_budget_;
   }
 
   void TOPPASScene::runNextProcess()
@@ -2004,11 +2107,28 @@ namespace OpenMS
 
     used = true;
 
-    while (!topp_processes_queue_.empty() && threads_active_ < allowed_threads_)
+    while (!topp_processes_queue_.empty())
     {
-      ++threads_active_; // will be decreased, once the tool finishes
-      TOPPProcess tp = topp_processes_queue_.first();
-      topp_processes_queue_.pop_front();
+      // among the processes which fit into the free budget, take the one on the longest remaining path (first come, first served on ties)
+      int next = -1;
+      for (int i = 0; i < topp_processes_queue_.size(); ++i)
+      {
+        if ((next == -1 || topp_processes_queue_[i].priority > topp_processes_queue_[next].priority) && processFits_(topp_processes_queue_[i]))
+        {
+          next = i;
+        }
+      }
+      if (next == -1)
+      {
+        break; // wait for running processes to free resources
+      }
+      TOPPProcess tp = topp_processes_queue_.takeAt(next);
+      // will be released once the tool finishes (which might happen right away for dry runs)
+      tp.threads = std::min(tp.threads, allowed_threads_);
+      tp.started = pipeline_timer_.isValid() ? pipeline_timer_.elapsed() : 0;
+      threads_active_ += tp.threads;
+      memory_active_ += tp.memory;
+      running_processes_.insert(std::make_pair(tp.proc, tp));
       FakeProcess* p = qobject_cast<FakeProcess*>(tp.proc);
       if (p)
       {
@@ -2349,6 +2469,11 @@ namespace OpenMS
     allowed_threads_ = num_jobs;
   }
 
+  void TOPPASScene::setMemoryBudget(UInt memory_mb)
+  {
+    memory_budget_ = memory_mb;
+  }
+
   bool TOPPASScene::isGUIMode() const
   {
     return gui_;
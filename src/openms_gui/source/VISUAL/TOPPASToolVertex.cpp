@@ -52,6 +52,8 @@
 
 #include <QSvgRenderer>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -86,7 +88,8 @@ namespace OpenMS
     param_(),
     status_(TOOL_READY),
     tool_ready_(true),
-    breakpoint_set_(false)
+    breakpoint_set_(false),
+    memory_mb_(0)
   {
     pen_color_ = Qt::black;
     brush_color_ = QColor(245, 245, 245);
@@ -103,7 +106,8 @@ namespace OpenMS
     type_(type),
     param_(),
     tool_ready_(true),
-    breakpoint_set_(false)
+    breakpoint_set_(false),
+    memory_mb_(0)
   {
     pen_color_ = Qt::black;
     brush_color_ = QColor(245, 245, 245);
@@ -121,7 +125,8 @@ namespace OpenMS
     param_(rhs.param_),
     status_(rhs.status_),
     tool_ready_(rhs.tool_ready_),
-    breakpoint_set_(false)
+    breakpoint_set_(false),
+    memory_mb_(rhs.memory_mb_)
   {
     pen_color_ = Qt::black;
     brush_color_ = QColor(245, 245, 245);
@@ -145,6 +150,7 @@ namespace OpenMS
     finished_ = rhs.finished_;
     status_ = rhs.status_;
     breakpoint_set_ = false;
+    memory_mb_ = rhs.memory_mb_;
 
     return *this;
   }
@@ -731,7 +737,7 @@ namespace OpenMS
         }
       }
       toolScheduledSlot();
-      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findExecutable(name_).toQString(), args, this));
+      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findExecutable(name_).toQString(), args, this, round));
     }
 
     // run pending processes
@@ -798,13 +804,14 @@ namespace OpenMS
 
     //clean up
     QProcess* p = qobject_cast<QProcess*>(QObject::sender());
+
+    ts->processFinished(p, ec, es);
+
     if (p)
     {
       delete p;
     }
 
-    ts->processFinished();
-
     __DEBUG_END_METHOD__
   }
 
@@ -880,6 +887,25 @@ namespace OpenMS
     return param_;
   }
 
+  int TOPPASToolVertex::getRequiredThreads() const
+  {
+    if (!param_.exists("threads"))
+    {
+      return 1;
+    }
+    return std::max(1, (int)param_.getValue("threads"));
+  }
+
+  UInt TOPPASToolVertex::getRequiredMemory() const
+  {
+    return memory_mb_;
+  }
+
+  void TOPPASToolVertex::setRequiredMemory(UInt memory_mb)
+  {
+    memory_mb_ = memory_mb;
+  }
+
   void TOPPASToolVertex::setParam(const Param& param)
   {
     param_ = param;
@@ -12,6 +12,7 @@ EnhancedTabBarWidgetInterface.cpp
 EnhancedWorkspace.cpp
 GUIProgressLoggerImpl.cpp
 HistogramWidget.cpp
+IntensityPyramid.cpp
 LayerData.cpp
 ListEditor.cpp
 MetaDataBrowser.cpp
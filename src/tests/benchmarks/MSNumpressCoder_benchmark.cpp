@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/MSNumpressCoder.h>
+#include <OpenMS/MATH/MISC/MSNumpress.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace OpenMS;
+
+/**
+  Reports the decoding throughput (MB/s of decoded 64 bit values) of the
+  MSNumpressCoder buffer codecs (double and float output) and of the
+  reference implementation in MATH/MISC/MSNumpress on synthetic data.
+
+  Usage: MSNumpressCoder_benchmark [number of values] [repeats]
+*/
+
+namespace
+{
+  // same synthetic data as in MSNumpressCoder_test
+  void setupData(std::vector<double>& mz, std::vector<double>& intensity, Size n)
+  {
+    mz.resize(n);
+    intensity.resize(n);
+    double val = 200.0;
+    for (Size i = 0; i < n; i++)
+    {
+      val += 0.001 + ((i * 7919) % 1000) * 1e-6;
+      mz[i] = val;
+      intensity[i] = (i * 104729) % 100000;
+    }
+  }
+}
+
+int main(int argc, const char** argv)
+{
+  using namespace ms::numpress;
+
+  const Size n = argc > 1 ? Size(std::atol(argv[1])) : 2000000;
+  const int repeats = argc > 2 ? std::atoi(argv[2]) : 10;
+  if (n == 0 || repeats <= 0)
+  {
+    std::cerr << "Usage: " << argv[0] << " [number of values] [repeats]" << std::endl;
+    return 1;
+  }
+
+  std::vector<double> mz, intensity;
+  setupData(mz, intensity, n);
+  const double megabytes = repeats * n * sizeof(double) / 1e6;
+
+  MSNumpressCoder::NumpressConfig config;
+  config.numpressErrorTolerance = 0.0;
+  const MSNumpressCoder::NumpressCompression schemes[] = {MSNumpressCoder::LINEAR, MSNumpressCoder::PIC, MSNumpressCoder::SLOF};
+  int result = 0;
+  for (Size k = 0; k < 3; ++k)
+  {
+    config.np_compression = schemes[k];
+    const std::vector<double>& in = (k == 0) ? mz : intensity;
+    String raw;
+    MSNumpressCoder().encodeNPRaw(in, raw, config);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(raw.c_str());
+    std::vector<double> buffer_ref(MSNumpressCoder::decodedSizeBound(raw.size(), config.np_compression));
+    std::vector<double> buffer(buffer_ref.size());
+    std::vector<float> buffer_32(buffer_ref.size());
+
+    StopWatch sw;
+    sw.start();
+    size_t decoded_ref = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+      if (k == 0) decoded_ref = MSNumpress::decodeLinear(data, raw.size(), &buffer_ref[0]);
+      else if (k == 1) decoded_ref = MSNumpress::decodePic(data, raw.size(), &buffer_ref[0]);
+      else decoded_ref = MSNumpress::decodeSlof(data, raw.size(), &buffer_ref[0]);
+    }
+    sw.stop();
+    const double t_ref = sw.getClockTime();
+
+    sw.reset();
+    sw.start();
+    Size decoded = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+      decoded = MSNumpressCoder().decodeNPRaw(data, raw.size(), &buffer[0], buffer.size(), config);
+    }
+    sw.stop();
+    const double t_64 = sw.getClockTime();
+
+    sw.reset();
+    sw.start();
+    for (int r = 0; r < repeats; ++r)
+    {
+      MSNumpressCoder().decodeNPRaw(data, raw.size(), &buffer_32[0], buffer_32.size(), config);
+    }
+    sw.stop();
+    const double t_32 = sw.getClockTime();
+
+    // the timings are only meaningful if both implementations decode the same values
+    buffer_ref.resize(decoded_ref);
+    buffer.resize(decoded);
+    if (buffer != buffer_ref)
+    {
+      std::cerr << MSNumpressCoder::NamesOfNumpressCompression[schemes[k]] << ": decoded values differ from the reference implementation!" << std::endl;
+      result = 1;
+    }
+
+    std::cout << MSNumpressCoder::NamesOfNumpressCompression[schemes[k]] << " decode MB/s: reference " << megabytes / t_ref
+              << ", double " << megabytes / t_64 << " (" << t_ref / t_64 << "x)"
+              << ", float " << megabytes / t_32 << " (" << t_ref / t_32 << "x)" << std::endl;
+  }
+  return result;
+}
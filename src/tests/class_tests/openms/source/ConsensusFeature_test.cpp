@@ -37,6 +37,7 @@
 
 ///////////////////////////
 #include <OpenMS/KERNEL/ConsensusFeature.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
 ///////////////////////////
 
 #include <OpenMS/CHEMISTRY/ElementDB.h>
@@ -430,6 +431,59 @@ START_SECTION((void insert(const FeatureHandle &handle)))
   TEST_EQUAL(it==cons.end(), true)
 END_SECTION
 
+START_SECTION((void insert(const std::vector<FeatureHandle>& handles)))
+  ConsensusFeature cons;
+  std::vector<FeatureHandle> handles;
+  // unsorted input, including a handle already contained in the feature
+  for (UInt i = 0; i < 5; ++i)
+  {
+    FeatureHandle fh(4 - i, tmp_feature);
+    fh.setUniqueId(i);
+    handles.push_back(fh);
+  }
+  cons.insert(handles.back());
+  handles.pop_back();
+  cons.insert(handles);
+
+  TEST_EQUAL(cons.size(), 5)
+  UInt64 map_index = 0;
+  for (ConsensusFeature::HandleSetType::const_iterator it = cons.begin(); it != cons.end(); ++it, ++map_index)
+  {
+    TEST_EQUAL(it->getMapIndex(), map_index)
+    TEST_EQUAL(it->getUniqueId(), 4 - map_index)
+  }
+
+  // duplicates are rejected, the new handles are still inserted
+  std::vector<FeatureHandle> dup(2, FeatureHandle(7, tmp_feature));
+  TEST_EXCEPTION(Exception::InvalidValue, cons.insert(dup))
+  TEST_EQUAL(cons.size(), 6)
+END_SECTION
+
+START_SECTION([EXTRA](large consensus features))
+  // many handles per feature, filled handle by handle and in bulk
+  const UInt n = 500;
+  std::vector<FeatureHandle> handles;
+  ConsensusFeature single;
+  for (UInt i = 0; i < n; ++i)
+  {
+    FeatureHandle fh((i * 7919) % n, tmp_feature);
+    fh.setUniqueId(i);
+    handles.push_back(fh);
+    single.insert(fh);
+  }
+  ConsensusFeature bulk;
+  bulk.insert(handles);
+  TEST_EQUAL(single.size(), n)
+  TEST_EQUAL(bulk.size(), n)
+  TEST_EQUAL(single.getFeatures() == bulk.getFeatures(), true)
+  TEST_EQUAL(std::is_sorted(bulk.begin(), bulk.end(), FeatureHandle::IndexLess()), true)
+
+  ConsensusMap map;
+  map.resize(100, bulk);
+  TEST_EQUAL(map[99].size(), n)
+  TEST_EQUAL(map[99].rbegin()->getMapIndex(), n - 1)
+END_SECTION
+
 START_SECTION((void insert(UInt64 map_index, const BaseFeature &element)))
   ConsensusFeature cons;
   cons.insert(2, tmp_feature);
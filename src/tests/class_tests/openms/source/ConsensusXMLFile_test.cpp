@@ -45,6 +45,10 @@
 
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -245,6 +249,82 @@ START_SECTION([EXTRA](bool isValid(const String &filename)))
   TEST_EQUAL(f.isValid(tmp_filename, std::cerr), true);
 END_SECTION
 
+START_SECTION([EXTRA] parallel store is identical to serial store)
+{
+  // enough consensus features for several chunks of the parallel writer
+  ConsensusMap map;
+  map.getColumnHeaders()[0].filename = "a.mzML";
+  map.getColumnHeaders()[0].size = 5000;
+  map.getColumnHeaders()[1].filename = "b.mzML";
+  map.getColumnHeaders()[1].size = 5000;
+  map.getProteinIdentifications().resize(1);
+  map.getProteinIdentifications()[0].setIdentifier("run");
+  for (Size i = 0; i < 10; ++i)
+  {
+    ProteinHit hit;
+    hit.setAccession("P" + String(i));
+    map.getProteinIdentifications()[0].insertHit(hit);
+  }
+  for (Size i = 0; i < 5000; ++i)
+  {
+    ConsensusFeature cf;
+    cf.setRT(100.0 + i * 0.5);
+    cf.setMZ(400.0 + i * 0.01);
+    cf.setIntensity(1000.0f + i);
+    cf.setCharge(1 + i % 4);
+    cf.setUniqueId(i + 1);
+    cf.setMetaValue("index", (Int)i);
+    Peak2D p;
+    p.setRT(cf.getRT());
+    p.setMZ(cf.getMZ());
+    p.setIntensity(cf.getIntensity());
+    cf.insert(0, p, 2 * i);
+    cf.insert(1, p, 2 * i + 1);
+
+    PeptideIdentification pep;
+    pep.setIdentifier("run");
+    pep.setRT(cf.getRT());
+    pep.setMZ(cf.getMZ());
+    pep.setMetaValue("spectrum_reference", "scan=" + String(i));
+    PeptideHit hit(1.0 / (i + 1), 1, 2, AASequence::fromString("PEPTIDEK"));
+    hit.addPeptideEvidence(PeptideEvidence("P" + String(i % 10), 10, 17, 'K', 'A'));
+    hit.setMetaValue("hit_index", (Int)i);
+    pep.insertHit(hit);
+    cf.getPeptideIdentifications().push_back(pep);
+    map.push_back(cf);
+  }
+  map.getUnassignedPeptideIdentifications().push_back(map[0].getPeptideIdentifications()[0]);
+
+  ConsensusXMLFile f;
+  String parallel_file, serial_file;
+  NEW_TMP_FILE(parallel_file);
+  NEW_TMP_FILE(serial_file);
+  f.store(parallel_file, map);
+#ifdef _OPENMP
+  int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  f.store(serial_file, map);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+  TEST_FILE_EQUAL(parallel_file.c_str(), serial_file.c_str())
+
+  ConsensusMap map2;
+  f.load(parallel_file, map2);
+  TEST_EQUAL(map2.size(), map.size())
+  ABORT_IF(map2.size() != map.size())
+  TEST_EQUAL(map2[4321].getUniqueId(), 4322)
+  TEST_EQUAL(map2[4321].getMetaValue("index"), 4321)
+  TEST_EQUAL(map2[4321].size(), 2)
+  TEST_EQUAL(map2[4321].getPeptideIdentifications().size(), 1)
+  ABORT_IF(map2[4321].getPeptideIdentifications().size() != 1)
+  const PeptideHit& hit = map2[4321].getPeptideIdentifications()[0].getHits()[0];
+  TEST_EQUAL(hit.getMetaValue("hit_index"), 4321)
+  TEST_EQUAL(hit.getPeptideEvidences()[0].getProteinAccession(), "P1")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -0,0 +1,196 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DelimitedTextReader.h>
+#include <OpenMS/FORMAT/TextFile.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(DelimitedTextReader, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+String tmp_file;
+NEW_TMP_FILE(tmp_file)
+{
+  ofstream os(tmp_file.c_str(), ios_base::out | ios_base::binary);
+  os << "PrecursorMz\tProductMz\tName\n"
+     << "500.25\t 600.5 \tPEPTIDE\r\n"
+     << "\n"
+     << "1\t2\t\r"
+     << "last\tline";
+}
+
+DelimitedTextReader* ptr = nullptr;
+DelimitedTextReader* null_ptr = nullptr;
+START_SECTION((explicit DelimitedTextReader(const String& filename, char delimiter = '\t')))
+{
+  ptr = new DelimitedTextReader(tmp_file);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EXCEPTION(Exception::FileNotFound, DelimitedTextReader("this_file_does_not_exist.tsv"))
+}
+END_SECTION
+
+START_SECTION((~DelimitedTextReader()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((bool readLine()))
+{
+  DelimitedTextReader reader(tmp_file);
+  TEST_EQUAL(reader.getLineNumber(), 0)
+
+  TEST_EQUAL(reader.readLine(), true)
+  TEST_EQUAL(reader.fields().size(), 3)
+  TEST_EQUAL(reader.fields()[0].getString(), "PrecursorMz")
+  TEST_EQUAL(reader.fields()[2].getString(), "Name")
+
+  // \r\n line ending, whitespace is preserved
+  TEST_EQUAL(reader.readLine(), true)
+  TEST_EQUAL(reader.line().getString(), "500.25\t 600.5 \tPEPTIDE")
+  TEST_EQUAL(reader.fields().size(), 3)
+  TEST_EQUAL(reader.fields()[1].getString(), " 600.5 ")
+
+  // empty line
+  TEST_EQUAL(reader.readLine(), true)
+  TEST_EQUAL(reader.line().empty(), true)
+  TEST_EQUAL(reader.fields().size(), 1)
+
+  // \r line ending, trailing delimiter gives an empty last field
+  TEST_EQUAL(reader.readLine(), true)
+  TEST_EQUAL(reader.fields().size(), 3)
+  TEST_EQUAL(reader.fields()[2].empty(), true)
+
+  // last line without line ending
+  TEST_EQUAL(reader.readLine(), true)
+  TEST_EQUAL(reader.line().getString(), "last\tline")
+  TEST_EQUAL(reader.getLineNumber(), 5)
+
+  TEST_EQUAL(reader.readLine(), false)
+  TEST_EQUAL(reader.fields().size(), 0)
+  TEST_EQUAL(reader.readLine(), false)
+
+  // same lines as TextFile
+  TextFile tf(tmp_file);
+  DelimitedTextReader reader2(tmp_file);
+  for (TextFile::ConstIterator it = tf.begin(); it != tf.end(); ++it)
+  {
+    TEST_EQUAL(reader2.readLine(), true)
+    TEST_EQUAL(reader2.line().getString(), *it)
+  }
+  TEST_EQUAL(reader2.readLine(), false)
+
+  // empty file
+  DelimitedTextReader reader3(OPENMS_GET_TEST_DATA_PATH("TextFile_test_empty_infile.txt"));
+  TEST_EQUAL(reader3.readLine(), false)
+}
+END_SECTION
+
+START_SECTION((const StringView& line() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const std::vector<StringView>& fields() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getLineNumber() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setDelimiter(char delimiter)))
+{
+  DelimitedTextReader reader(tmp_file, ',');
+  TEST_EQUAL(reader.getDelimiter(), ',')
+  reader.readLine();
+  TEST_EQUAL(reader.fields().size(), 1)
+  reader.setDelimiter('\t');
+  reader.readLine();
+  TEST_EQUAL(reader.fields().size(), 3)
+}
+END_SECTION
+
+START_SECTION((char getDelimiter() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static double toDouble(const StringView& s)))
+{
+  String s("500.25\t 600.5 \t1e-3\tabc\t\t12.5x");
+  std::vector<String> parts;
+  s.split('\t', parts);
+  TEST_REAL_SIMILAR(DelimitedTextReader::toDouble(StringView(parts[0])), 500.25)
+  TEST_REAL_SIMILAR(DelimitedTextReader::toDouble(StringView(parts[1])), 600.5)
+  TEST_REAL_SIMILAR(DelimitedTextReader::toDouble(StringView(parts[2])), 1e-3)
+  TEST_EXCEPTION(Exception::ConversionError, DelimitedTextReader::toDouble(StringView(parts[3])))
+  TEST_EXCEPTION(Exception::ConversionError, DelimitedTextReader::toDouble(StringView(parts[4])))
+  TEST_EXCEPTION(Exception::ConversionError, DelimitedTextReader::toDouble(StringView(parts[5])))
+  // only the viewed range is parsed
+  String full("123.5678");
+  TEST_REAL_SIMILAR(DelimitedTextReader::toDouble(StringView(full.c_str(), 5)), 123.5)
+}
+END_SECTION
+
+START_SECTION((static Int toInt(const StringView& s)))
+{
+  TEST_EQUAL(DelimitedTextReader::toInt(StringView(String("42"))), 42)
+  TEST_EQUAL(DelimitedTextReader::toInt(StringView(String(" -7 "))), -7)
+  TEST_EXCEPTION(Exception::ConversionError, DelimitedTextReader::toInt(StringView(String("4.2"))))
+  TEST_EXCEPTION(Exception::ConversionError, DelimitedTextReader::toInt(StringView(String(""))))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -122,6 +122,24 @@ START_SECTION((void detectPeaks(std::vector< MassTrace > &, std::vector< MassTra
         //        TEST_EQUAL(splitted_mt[3].getLabel(), "T1.4");//lowess with regression
         //        TEST_EQUAL(splitted_mt[4].getLabel(), "T1.5");//lowess with regression
         //        TEST_EQUAL(splitted_mt[5].getLabel(), "T1.6");//lowess with regression
+
+        // output follows the input order, regardless of the parallel processing
+        std::vector<MassTrace> many_mt, many_splitted;
+        for (Size i = 0; i < 100; ++i)
+        {
+          many_mt.push_back(output_mt[0]);
+          many_mt.back().setLabel(String("T") + i);
+        }
+        test_epd.detectPeaks(many_mt, many_splitted);
+        TEST_EQUAL(many_splitted.size(), 200);
+        ABORT_IF(many_splitted.size() != 200)
+        for (Size i = 0; i < 100; ++i)
+        {
+          TEST_EQUAL(many_splitted[2 * i].getLabel(), String("T") + i + ".1");
+          TEST_EQUAL(many_splitted[2 * i + 1].getLabel(), String("T") + i + ".2");
+          TEST_EQUAL(many_splitted[2 * i].getSize(), splitted_mt[0].getSize());
+          TEST_REAL_SIMILAR(many_splitted[2 * i].getCentroidRT(), splitted_mt[0].getCentroidRT());
+        }
     }
 }
 END_SECTION
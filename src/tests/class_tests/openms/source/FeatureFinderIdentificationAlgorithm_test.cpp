@@ -33,11 +33,15 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
 
 ///////////////////////////
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderIdentificationAlgorithm.h>
 ///////////////////////////
 
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -61,6 +65,56 @@ START_SECTION(~FeatureFinderIdentificationAlgorithm())
 }
 END_SECTION
 
+START_SECTION((void run(std::vector<PeptideIdentification> peptides, const std::vector<ProteinIdentification>& proteins, std::vector<PeptideIdentification> peptides_ext, std::vector<ProteinIdentification> proteins_ext, FeatureMap& features, const FeatureMap& seeds = FeatureMap())))
+{
+  PeakMap ms_data;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("../../../topp/FeatureFinderIdentification_1_input.mzML"), ms_data);
+  vector<ProteinIdentification> proteins;
+  vector<PeptideIdentification> peptides;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("../../../topp/FeatureFinderIdentification_1_input.idXML"), proteins, peptides);
+
+  // results must not depend on how the assays are split into batches:
+  vector<FeatureMap> results;
+  vector<vector<String> > chrom_ids;
+  Size batch_sizes[] = {0, 1, 3};
+  for (Size batch_size : batch_sizes)
+  {
+    FeatureFinderIdentificationAlgorithm ffid;
+    Param params = ffid.getParameters();
+    params.setValue("extract:mz_window", 0.1);
+    params.setValue("extract:batch_size", batch_size);
+    params.setValue("detect:peak_width", 60.0);
+    params.setValue("model:type", "none");
+    ffid.setParameters(params);
+    ffid.getMSData() = ms_data;
+
+    FeatureMap features;
+    ffid.run(peptides, proteins, vector<PeptideIdentification>(), vector<ProteinIdentification>(), features);
+    results.push_back(features);
+    chrom_ids.push_back(vector<String>());
+    for (const MSChromatogram& chrom : ffid.getChromatograms().getChromatograms())
+    {
+      chrom_ids.back().push_back(chrom.getNativeID());
+    }
+  }
+
+  TEST_NOT_EQUAL(results[0].size(), 0)
+  for (Size i = 1; i < results.size(); ++i)
+  {
+    TEST_EQUAL(results[i].size(), results[0].size())
+    TEST_EQUAL(chrom_ids[i] == chrom_ids[0], true)
+    ABORT_IF(results[i].size() != results[0].size())
+    for (Size j = 0; j < results[0].size(); ++j)
+    {
+      TEST_EQUAL(results[i][j].getMetaValue("PeptideRef"), results[0][j].getMetaValue("PeptideRef"))
+      TEST_REAL_SIMILAR(results[i][j].getRT(), results[0][j].getRT())
+      TEST_REAL_SIMILAR(results[i][j].getMZ(), results[0][j].getMZ())
+      TEST_REAL_SIMILAR(results[i][j].getIntensity(), results[0][j].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
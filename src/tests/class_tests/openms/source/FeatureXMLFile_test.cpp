@@ -44,6 +44,10 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -388,6 +392,44 @@ START_SECTION([EXTRA])
 END_SECTION
 
 
+START_SECTION([EXTRA] parallel store is identical to serial store)
+{
+  // enough features for several chunks of the parallel writer
+  FeatureMap map;
+  for (Size i = 0; i < 5000; ++i)
+  {
+    Feature f;
+    f.setRT(100.0 + i * 0.5);
+    f.setMZ(400.0 + i * 0.01);
+    f.setIntensity(1000.0f + i);
+    f.setCharge(1 + i % 4);
+    f.setUniqueId(i + 1);
+    f.setMetaValue("index", (Int)i);
+    map.push_back(f);
+  }
+  FeatureXMLFile f;
+  String parallel_file, serial_file;
+  NEW_TMP_FILE(parallel_file);
+  NEW_TMP_FILE(serial_file);
+  f.store(parallel_file, map);
+#ifdef _OPENMP
+  int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  f.store(serial_file, map);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+  TEST_FILE_EQUAL(parallel_file.c_str(), serial_file.c_str())
+
+  FeatureMap map2;
+  f.load(parallel_file, map2);
+  TEST_EQUAL(map2.size(), map.size())
+  TEST_EQUAL(map2[4321].getUniqueId(), 4322)
+  TEST_EQUAL(map2[4321].getMetaValue("index"), 4321)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -41,8 +41,12 @@
 ///////////////////////////
 
 #include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/FORMAT/OMSBinFile.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
 
 START_TEST(FileHandler, "$Id$")
 
@@ -240,6 +244,59 @@ TEST_EQUAL(tmp.loadFeatures(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_2_options.
 TEST_EQUAL(map.size(), 7);
 TEST_EQUAL(tmp.loadFeatures(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_2_options.featureXML"), map), true)
 TEST_EQUAL(map.size(), 7);
+
+// options are used for featureXML
+tmp.getFeatOptions().setRTRange(DRange<1>(DPosition<1>(1.5), DPosition<1>(4.5)));
+TEST_EQUAL(tmp.loadFeatures(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_2_options.featureXML"), map), true)
+TEST_EQUAL(map.size(), 5);
+END_SECTION
+
+START_SECTION((FeatureFileOptions& getFeatOptions()))
+FileHandler a;
+a.getFeatOptions().setLoadConvexHull(false);
+TEST_EQUAL(a.getFeatOptions().getLoadConvexHull(), false)
+END_SECTION
+
+START_SECTION((const FeatureFileOptions& getFeatOptions() const))
+const FileHandler a;
+TEST_EQUAL(a.getFeatOptions().getLoadConvexHull(), true)
+END_SECTION
+
+START_SECTION((void setFeatOptions(const FeatureFileOptions&)))
+FileHandler a;
+FeatureFileOptions options;
+options.setLoadSubordinates(false);
+a.setFeatOptions(options);
+TEST_EQUAL(a.getFeatOptions().getLoadSubordinates(), false)
+END_SECTION
+
+START_SECTION((static FileTypes::Type getXMLEquivalentType(const String& filename)))
+FileHandler fh;
+TEST_EQUAL(FileHandler::getXMLEquivalentType(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML")), FileTypes::FEATUREXML)
+TEST_EQUAL(FileHandler::getXMLEquivalentType(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML")), FileTypes::MZML)
+
+// temporary files have no omsBin extension: the type is determined from the content
+String features_bin;
+NEW_TMP_FILE(features_bin)
+FeatureMap features;
+fh.loadFeatures(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), features);
+OMSBinFile().store(features_bin, features);
+TEST_EQUAL(FileHandler::getType(features_bin), FileTypes::OMSBIN)
+TEST_EQUAL(FileHandler::getXMLEquivalentType(features_bin), FileTypes::FEATUREXML)
+
+String consensus_bin;
+NEW_TMP_FILE(consensus_bin)
+ConsensusMap consensus;
+fh.loadConsensusFeatures(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), consensus);
+OMSBinFile().store(consensus_bin, consensus);
+TEST_EQUAL(FileHandler::getXMLEquivalentType(consensus_bin), FileTypes::CONSENSUSXML)
+
+String ids_bin;
+NEW_TMP_FILE(ids_bin)
+vector<ProteinIdentification> proteins;
+vector<PeptideIdentification> peptides;
+OMSBinFile().store(ids_bin, proteins, peptides);
+TEST_EQUAL(FileHandler::getXMLEquivalentType(ids_bin), FileTypes::IDXML)
 END_SECTION
 
 START_SECTION((void storeExperiment(const String &filename, const MSExperiment<>&exp, ProgressLogger::LogType log = ProgressLogger::NONE)))
@@ -39,6 +39,8 @@
 
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilterAlgorithm.h>
 
+#include <cmath>
+
 ///////////////////////////
 
 START_TEST(GaussFilterAlgorithm<D>, "$Id$")
@@ -98,6 +100,33 @@ START_SECTION((template <typename ConstIterT, typename IterT> bool filter(ConstI
   TEST_REAL_SIMILAR(*it,1.0)
 END_SECTION 
 
+START_SECTION([EXTRA] equidistant fast path agrees with the generic integration)
+  // equidistant input takes the tabulated path, moving the last point away
+  // breaks the equidistance and forces the generic path for the same data
+  std::vector<double> mz, mz_irregular, intensities;
+  for (Size i = 0; i < 41; ++i)
+  {
+    mz.push_back(500.0 + 0.03 * i);
+    intensities.push_back(100.0 + 50.0 * std::sin(0.4 * i));
+  }
+  mz_irregular = mz;
+  mz_irregular.back() += 0.5;
+
+  std::vector<double> mz_out(41), int_out(41), mz_out_irregular(41), int_out_irregular(41);
+  GaussFilterAlgorithm gauss;
+  gauss.initialize(0.2, 0.01, 10.0, false);
+  gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), int_out.begin());
+  gauss.filter(mz_irregular.begin(), mz_irregular.end(), intensities.begin(), mz_out_irregular.begin(), int_out_irregular.begin());
+
+  TOLERANCE_RELATIVE(1.0 + 1e-9)
+  // points further than the kernel half-width from the moved peak are unaffected
+  for (Size i = 0; i < 30; ++i)
+  {
+    TEST_REAL_SIMILAR(int_out[i], int_out_irregular[i])
+  }
+  TOLERANCE_RELATIVE(1.0 + 1e-5)
+END_SECTION
+
 START_SECTION((bool filter(OpenMS::Interfaces::SpectrumPtr spectrum)))
 
   OpenMS::Interfaces::SpectrumPtr spectrum(new OpenMS::Interfaces::Spectrum);
@@ -67,7 +67,7 @@ START_SECTION(virtual ~ILPDCWrapper())
 END_SECTION
 
 
-START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbose_level) const))
+START_SECTION((double compute(const FeatureMap& fm, PairsType &pairs, Size verbose_level) const))
 {
   EmpiricalFormula ef("H1");
   Adduct a(+1, 1, ef.getMonoWeight(), "H1", 0.1, 0, "");
@@ -84,8 +84,72 @@ START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbos
   TEST_EQUAL(pairs.size(), 0);
 
   // real data test
+  fm.resize(5);
+  Adduct a2(+1, 2, ef.getMonoWeight(), "H1", 0.1, 0, "");
+  Compomer c1, c2;
+  c1.add(a, Compomer::LEFT);
+  c1.add(a, Compomer::RIGHT);
+  c2.add(a2, Compomer::LEFT);
+  c2.add(a2, Compomer::RIGHT);
+  pairs.push_back(ChargePair(0, 1, 1, 1, c1, 0, false));
+  pairs.push_back(ChargePair(1, 2, 2, 2, c2, 0, false)); // feature 1 cannot be 1+ and 2+ at the same time
+  pairs.push_back(ChargePair(3, 4, 1, 1, c1, 0, false)); // separate component without conflicts
+
+  double score = iw.compute(fm, pairs, 1);
+  TEST_EQUAL(pairs.size(), 3);
+  double active_score(0);
+  for (Size i = 0; i < pairs.size(); ++i)
+  {
+    // the more probable explanation of feature 1 wins
+    TEST_EQUAL(pairs[i].isActive(), pairs[i].getElementIndex(0) != 0);
+    if (pairs[i].isActive()) active_score += pairs[i].getEdgeScore();
+  }
+  TEST_REAL_SIMILAR(score, active_score);
 
+}
+END_SECTION
+
+START_SECTION([EXTRA] components solved by the ILP next to small components)
+{
+  EmpiricalFormula ef("H1");
+  Adduct a(+1, 1, ef.getMonoWeight(), "H1", 0.1, 0, "");
+  Adduct a2(+1, 2, ef.getMonoWeight(), "H1", 0.1, 0, "");
+  Compomer c1, c2;
+  c1.add(a, Compomer::LEFT);
+  c1.add(a, Compomer::RIGHT);
+  c2.add(a2, Compomer::LEFT);
+  c2.add(a2, Compomer::RIGHT);
 
+  FeatureMap fm;
+  fm.resize(13);
+  ILPDCWrapper::PairsType pairs;
+  pairs.push_back(ChargePair(0, 1, 1, 1, c1, 0, false)); // small component
+  // chain of 9 features with two charge variants each: 2^9 = 512 assignments, too many to enumerate
+  for (Size f = 2; f < 10; ++f)
+  {
+    pairs.push_back(ChargePair(f, f + 1, 1, 1, c1, 0, false));
+    pairs.push_back(ChargePair(f, f + 1, 2, 2, c2, 0, false));
+  }
+  pairs.push_back(ChargePair(11, 12, 1, 1, c1, 0, false)); // another small component, listed after the ILP edges
+
+  ILPDCWrapper iw;
+  double score = iw.compute(fm, pairs, 1);
+  TEST_EQUAL(pairs.size(), 18);
+  double active_score(0);
+  Size active_count(0);
+  for (Size i = 0; i < pairs.size(); ++i)
+  {
+    // the more probable 1+ explanation wins everywhere; results of the ILP are written back to the right edges
+    TEST_EQUAL(pairs[i].isActive(), pairs[i].getCharge(0) == 1)
+    TEST_EQUAL(pairs[i].getEdgeScore() > 0, true)
+    if (pairs[i].isActive())
+    {
+      active_score += pairs[i].getEdgeScore();
+      ++active_count;
+    }
+  }
+  TEST_EQUAL(active_count, 10)
+  TEST_REAL_SIMILAR(score, active_score)
 }
 END_SECTION
 
@@ -40,6 +40,10 @@
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/CONCEPT/FuzzyStringComparator.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 ///////////////////////////
 
 START_TEST(IdXMLFile, "$Id$")
@@ -296,6 +300,68 @@ START_SECTION(([EXTRA] XLMS data labeled cross-linker))
   TEST_EQUAL(peptide_ids[0].getHits()[0].getPeakAnnotations()[25].annotation, "[alpha|xi$y8]")
 
 END_SECTION
+START_SECTION([EXTRA] parallel store is identical to serial store)
+{
+  // enough peptide identifications for several chunks of the parallel writer
+  vector<ProteinIdentification> protein_ids(1);
+  protein_ids[0].setIdentifier("run");
+  protein_ids[0].setScoreType("score");
+  for (Size i = 0; i < 10; ++i)
+  {
+    ProteinHit hit;
+    hit.setAccession("P" + String(i));
+    hit.setMetaValue("description", "protein " + String(i));
+    protein_ids[0].insertHit(hit);
+  }
+  vector<PeptideIdentification> peptide_ids;
+  for (Size i = 0; i < 5000; ++i)
+  {
+    PeptideIdentification pep;
+    pep.setIdentifier("run");
+    pep.setScoreType("score");
+    pep.setRT(100.0 + i * 0.5);
+    pep.setMZ(400.0 + i * 0.01);
+    pep.setMetaValue("spectrum_reference", "scan=" + String(i));
+    pep.setMetaValue("index", (Int)i);
+    for (Size k = 0; k < 2; ++k)
+    {
+      PeptideHit hit(1.0 / (i + k + 1), k + 1, 2, AASequence::fromString(k == 0 ? "PEPTIDEK" : "PEPTIDER"));
+      hit.addPeptideEvidence(PeptideEvidence("P" + String((i + k) % 10), 10, 17, 'K', 'A'));
+      hit.setMetaValue("hit_index", (Int)(2 * i + k));
+      pep.insertHit(hit);
+    }
+    peptide_ids.push_back(pep);
+  }
+
+  IdXMLFile f;
+  String parallel_file, serial_file;
+  NEW_TMP_FILE(parallel_file);
+  NEW_TMP_FILE(serial_file);
+  f.store(parallel_file, protein_ids, peptide_ids, "doc");
+#ifdef _OPENMP
+  int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  f.store(serial_file, protein_ids, peptide_ids, "doc");
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+  TEST_FILE_EQUAL(parallel_file.c_str(), serial_file.c_str())
+
+  vector<ProteinIdentification> protein_ids2;
+  vector<PeptideIdentification> peptide_ids2;
+  f.load(parallel_file, protein_ids2, peptide_ids2);
+  TEST_EQUAL(peptide_ids2.size(), peptide_ids.size())
+  ABORT_IF(peptide_ids2.size() != peptide_ids.size())
+  TEST_EQUAL(peptide_ids2[4321].getMetaValue("index"), 4321)
+  TEST_EQUAL(peptide_ids2[4321].getMetaValue("spectrum_reference"), "scan=4321")
+  TEST_EQUAL(peptide_ids2[4321].getHits().size(), 2)
+  ABORT_IF(peptide_ids2[4321].getHits().size() != 2)
+  TEST_EQUAL(peptide_ids2[4321].getHits()[1].getMetaValue("hit_index"), 8643)
+  TEST_EQUAL(peptide_ids2[4321].getHits()[1].getPeptideEvidences()[0].getProteinAccession(), "P2")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
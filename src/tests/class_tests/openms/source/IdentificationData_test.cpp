@@ -42,6 +42,8 @@
 
 ///////////////////////////
 
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
 START_TEST(IdentificationData, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -519,6 +521,104 @@ START_SECTION((void cleanup(bool require_query_match = true, bool require_identi
 }
 END_SECTION
 
+START_SECTION((void commitStagingBuffers(std::vector<StagingBuffer>& buffers)))
+{
+  // register the same items individually and via staging buffers:
+  IdentificationData serial, staged;
+  IdentificationData::ScoreTypeRef serial_score_ref =
+    serial.registerScoreType(IdentificationData::ScoreType("score", true));
+  IdentificationData::ScoreTypeRef staged_score_ref =
+    staged.registerScoreType(IdentificationData::ScoreType("score", true));
+  IdentificationData::ParentMoleculeRef serial_rna_ref =
+    serial.registerParentMolecule(IdentificationData::ParentMolecule("rna_1", IdentificationData::MoleculeType::RNA));
+  IdentificationData::ParentMoleculeRef staged_rna_ref =
+    staged.registerParentMolecule(IdentificationData::ParentMolecule("rna_1", IdentificationData::MoleculeType::RNA));
+
+  // (query, oligo sequence, charge, score) - first and third entry share query and oligo:
+  vector<String> queries = ListUtils::create<String>("spectrum_1,spectrum_2,spectrum_1");
+  vector<String> sequences = ListUtils::create<String>("ACGU,UUGC,ACGU");
+  vector<Int> charges = ListUtils::create<Int>("0,2,3");
+  vector<double> scores = ListUtils::create<double>("1.0,2.0,3.0");
+
+  vector<IdentificationData::StagingBuffer> buffers(2);
+  for (Size i = 0; i < queries.size(); ++i)
+  {
+    IdentificationData::DataQuery query(queries[i]);
+    IdentificationData::IdentifiedOligo oligo(NASequence::fromString(sequences[i]));
+
+    oligo.parent_matches[serial_rna_ref];
+    IdentificationData::MoleculeQueryMatch match(
+      serial.registerIdentifiedOligo(oligo), serial.registerDataQuery(query),
+      charges[i]);
+    match.addScore(serial_score_ref, scores[i]);
+    match.setMetaValue("index", int(i));
+    serial.registerMoleculeQueryMatch(match);
+
+    IdentificationData::StagingBuffer& buffer = buffers[i % 2];
+    oligo.parent_matches.clear();
+    oligo.parent_matches[staged_rna_ref];
+    Size query_index = buffer.addDataQuery(query);
+    Size oligo_index = buffer.addIdentifiedOligo(oligo);
+    IdentificationData::MoleculeQueryMatch staged_match(
+      IdentificationData::IdentifiedOligoRef(),
+      IdentificationData::DataQueryRef(), charges[i]);
+    staged_match.addScore(staged_score_ref, scores[i]);
+    staged_match.setMetaValue("index", int(i));
+    buffer.addMoleculeQueryMatch(staged_match, query_index,
+                                 IdentificationData::MoleculeType::RNA,
+                                 oligo_index);
+  }
+  TEST_EQUAL(buffers[0].empty(), false);
+  staged.commitStagingBuffers(buffers);
+  TEST_EQUAL(buffers[0].empty(), true);
+  TEST_EQUAL(buffers[1].empty(), true);
+
+  TEST_EQUAL(staged.getDataQueries().size(), serial.getDataQueries().size());
+  TEST_EQUAL(staged.getIdentifiedOligos().size(),
+             serial.getIdentifiedOligos().size());
+  TEST_EQUAL(staged.getMoleculeQueryMatches().size(),
+             serial.getMoleculeQueryMatches().size());
+  TEST_EQUAL(staged.getMoleculeQueryMatches().size(), 2);
+
+  // references to duplicates point to the same (merged) entries:
+  TEST_EQUAL(buffers[0].getDataQueryRef(0) == buffers[0].getDataQueryRef(1),
+             true);
+  TEST_EQUAL(buffers[0].getIdentifiedOligoRef(0) ==
+             buffers[0].getIdentifiedOligoRef(1), true);
+  IdentificationData::QueryMatchRef merged_ref =
+    buffers[0].getMoleculeQueryMatchRef(0);
+  TEST_EQUAL(merged_ref == buffers[0].getMoleculeQueryMatchRef(1), true);
+  TEST_EQUAL(merged_ref->data_query_ref->data_id, "spectrum_1");
+  TEST_EQUAL(merged_ref->getIdentifiedOligoRef()->sequence.toString(), "ACGU");
+  TEST_EQUAL(buffers[1].getMoleculeQueryMatchRef(0)->charge, 2);
+
+  // merged in the same way as with individual registration:
+  for (const auto& match : serial.getMoleculeQueryMatches())
+  {
+    if (match.data_query_ref->data_id != "spectrum_1") continue;
+    TEST_EQUAL(merged_ref->charge, match.charge);
+    TEST_EQUAL(merged_ref->charge, 3);
+    TEST_REAL_SIMILAR(merged_ref->getScore(staged_score_ref).first,
+                      match.getScore(serial_score_ref).first);
+    TEST_EQUAL(merged_ref->getMetaValue("index"), match.getMetaValue("index"));
+  }
+
+  // invalid items - nothing is registered:
+  IdentificationData::StagingBuffer buffer;
+  buffer.addDataQuery(IdentificationData::DataQuery("spectrum_3"));
+  buffer.addMoleculeQueryMatch(
+    IdentificationData::MoleculeQueryMatch(IdentificationData::IdentifiedOligoRef(),
+                                           IdentificationData::DataQueryRef()),
+    0, IdentificationData::MoleculeType::RNA, 0);
+  TEST_EXCEPTION(Exception::IllegalArgument, staged.commitStagingBuffer(buffer));
+  TEST_EQUAL(staged.getDataQueries().size(), 2);
+  TEST_EQUAL(buffer.empty(), false);
+  buffer.clear();
+  buffer.addDataQuery(IdentificationData::DataQuery(""));
+  TEST_EXCEPTION(Exception::IllegalArgument, staged.commitStagingBuffer(buffer));
+}
+END_SECTION
+
 START_SECTION((static bool isBetterScore(double first, double second, bool higher_better)))
 {
   TEST_EQUAL(IdentificationData::isBetterScore(2.0, 1.0, true), true);
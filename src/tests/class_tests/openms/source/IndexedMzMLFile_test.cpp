@@ -172,6 +172,63 @@ START_SECTION(( OpenMS::Interfaces::SpectrumPtr getSpectrumById(int id)  ))
 }
 END_SECTION
 
+START_SECTION(( void getMSSpectraById(const std::vector<int>& ids, std::vector<OpenMS::MSSpectrum>& spectra) ))
+{
+  IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+
+  std::vector<int> ids;
+  for (int k = 0; k < 4; ++k) // every spectrum multiple times
+  {
+    for (int i = (int)file.getNrSpectra() - 1; i >= 0; --i)
+    {
+      ids.push_back(i);
+    }
+  }
+  std::vector<MSSpectrum> spectra;
+  file.getMSSpectraById(ids, spectra);
+  TEST_EQUAL(spectra.size(), ids.size())
+  for (Size i = 0; i < ids.size(); ++i)
+  {
+    MSSpectrum s = file.getMSSpectrumById(ids[i]);
+    TEST_EQUAL(spectra[i].size(), s.size())
+    TEST_EQUAL(spectra[i] == s, true)
+  }
+
+  ids.push_back((int)file.getNrSpectra());
+  TEST_EXCEPTION(Exception::IllegalArgument, file.getMSSpectraById(ids, spectra));
+}
+END_SECTION
+
+START_SECTION(( std::string getSpectrumXMLById(int id) ))
+{
+  IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+
+  std::string text = file.getSpectrumXMLById(0);
+  TEST_EQUAL(text.substr(0, 9), "<spectrum")
+  TEST_EQUAL(text.find("<binaryDataArrayList") != std::string::npos, true)
+  TEST_EQUAL(text.find("<spectrum", 1), std::string::npos)
+
+  TEST_EXCEPTION(Exception::IllegalArgument,file.getSpectrumXMLById(-1));
+  TEST_EXCEPTION(Exception::IllegalArgument,file.getSpectrumXMLById( file.getNrSpectra()+1));
+}
+END_SECTION
+
+START_SECTION(( std::string getSpectrumHeaderXMLById(int id) ))
+{
+  IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+
+  for (int i = 0; i < (int)file.getNrSpectra(); ++i)
+  {
+    std::string full = file.getSpectrumXMLById(i);
+    std::string text = file.getSpectrumHeaderXMLById(i);
+    TEST_EQUAL(text, full.substr(0, full.find("<binaryDataArrayList")))
+  }
+
+  TEST_EXCEPTION(Exception::IllegalArgument,file.getSpectrumHeaderXMLById(-1));
+  TEST_EXCEPTION(Exception::IllegalArgument,file.getSpectrumHeaderXMLById( file.getNrSpectra()+1));
+}
+END_SECTION
+
 START_SECTION(( OpenMS::Interfaces::ChromatogramPtr getChromatogramById(int id) ))
 {
   IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
@@ -59,6 +59,16 @@ public:
     return getMatchingPeptidoforms_(fragment_ion, ions, mz_threshold);
   }
 
+  std::vector<std::string> getMatchingPeptidoforms_test(const double fragment_ion, const FragmentIndex& ions, const double mz_threshold)
+  {
+    return getMatchingPeptidoforms_(fragment_ion, ions, mz_threshold);
+  }
+
+  void buildIonIndex_test(const IonMapT& ion_map, IonIndexT& ion_index)
+  {
+    buildIonIndex_(ion_map, ion_index);
+  }
+
   int getSwath_test(const std::vector<std::pair<double, double> >& swathes, const double precursor_mz)
   {
     return getSwath_(swathes, precursor_mz);
@@ -133,6 +143,48 @@ START_SECTION(std::vector<std::string> MRMAssay::getMatchingPeptidoforms_(const
 
 END_SECTION
 
+START_SECTION(std::vector<std::string> getMatchingPeptidoforms_(const double fragment_ion, const FragmentIndex& ions, const double mz_threshold))
+{
+  MRMAssay_test mrma;
+
+  MRMAssay::IonMapT ion_map;
+  std::vector<std::pair<double, std::string> >& ions = ion_map[0]["PEPTIDEK"];
+  ions.push_back(std::make_pair(100.00, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.01, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.10, "PEPT(UniMod:21)IDEK"));
+  ions.push_back(std::make_pair(100.12, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.11, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.20, "PEPTIDEK"));
+
+  MRMAssay::IonIndexT ion_index;
+  mrma.buildIonIndex_test(ion_map, ion_index);
+  const MRMAssay::FragmentIndex& index = ion_index.at(0).at("PEPTIDEK");
+  TEST_EQUAL(index.ions.size(), 6)
+  TEST_EQUAL(index.peptidoforms.size(), 2)
+  TEST_EQUAL(index.peptidoforms[0], "PEPT(UniMod:21)IDEK")
+  TEST_EQUAL(index.peptidoforms[1], "PEPTIDEK")
+  TEST_REAL_SIMILAR(index.ions[2].first, 100.10)
+  TEST_EQUAL(index.ions[2].second, 0)
+
+  // same results as the linear scan
+  double queries[] = {99.95, 100.0, 100.06, 100.105, 100.17, 100.3};
+  double thresholds[] = {0.01, 0.03, 0.06, 0.1};
+  for (double q : queries)
+  {
+    for (double t : thresholds)
+    {
+      TEST_EQUAL(ListUtils::concatenate(mrma.getMatchingPeptidoforms_test(q, index, t), "|"),
+                 ListUtils::concatenate(mrma.getMatchingPeptidoforms_test(q, ions, t), "|"))
+    }
+  }
+
+  std::vector<std::string> isoforms = mrma.getMatchingPeptidoforms_test(100.06, index, 0.06);
+  TEST_EQUAL(isoforms.size(), 2)
+  TEST_EQUAL(isoforms[0], "PEPT(UniMod:21)IDEK")
+  TEST_EQUAL(isoforms[1], "PEPTIDEK")
+}
+END_SECTION
+
 START_SECTION(int MRMAssay::getSwath_(const std::vector<std::pair<double, double> > swathes, const double precursor_mz))
 {
   MRMAssay_test mrma;
@@ -0,0 +1,183 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelProcessingConsumer.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+using namespace OpenMS;
+
+START_TEST(MSDataParallelProcessingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap expc;
+for (Size i = 0; i < 25; ++i)
+{
+  MSSpectrum s;
+  s.setRT(i);
+  s.setNativeID(String("spectrum=") + i);
+  Peak1D p;
+  p.setMZ(100.0);
+  p.setIntensity(1.0);
+  s.push_back(p);
+  expc.addSpectrum(s);
+}
+for (Size i = 0; i < 5; ++i)
+{
+  MSChromatogram c;
+  c.setNativeID(String("chromatogram=") + i);
+  ChromatogramPeak p;
+  p.setRT(1.0);
+  p.setIntensity(1.0);
+  c.push_back(p);
+  expc.addChromatogram(c);
+}
+
+ParallelExperimentProcessor processor;
+processor.setSpectraProcessingFunc([](MSSpectrum& s) { s[0].setIntensity(s.getRT()); });
+processor.setChromatogramProcessingFunc([](MSChromatogram& c) { c[0].setIntensity(42.0); });
+
+MSDataParallelProcessingConsumer* ptr = nullptr;
+MSDataParallelProcessingConsumer* null_ptr = nullptr;
+START_SECTION((MSDataParallelProcessingConsumer(Interfaces::IMSDataConsumer* next_consumer, const ParallelExperimentProcessor& processor, Size buffer_size = 1000)))
+{
+  MSDataStoringConsumer storing_consumer;
+  ptr = new MSDataParallelProcessingConsumer(&storing_consumer, processor);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((~MSDataParallelProcessingConsumer()))
+{
+  MSDataStoringConsumer storing_consumer;
+  {
+    MSDataParallelProcessingConsumer parallel_consumer(&storing_consumer, processor);
+    PeakMap exp = expc;
+    parallel_consumer.consumeSpectrum(exp.getSpectrum(0));
+    TEST_EQUAL(storing_consumer.getData().size(), 0) // still buffered
+  }
+  // flushed on destruction
+  TEST_EQUAL(storing_consumer.getData().size(), 1)
+}
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+{
+  MSDataStoringConsumer storing_consumer;
+  MSDataParallelProcessingConsumer parallel_consumer(&storing_consumer, processor, 10);
+
+  PeakMap exp = expc;
+  parallel_consumer.setExpectedSize(exp.size(), 0);
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    parallel_consumer.consumeSpectrum(exp.getSpectrum(i));
+  }
+  // the last 5 spectra are still buffered
+  TEST_EQUAL(storing_consumer.getData().size(), 20)
+  parallel_consumer.flush();
+
+  const PeakMap& result = storing_consumer.getData();
+  TEST_EQUAL(result.size(), 25)
+  for (Size i = 0; i < result.size(); ++i)
+  {
+    TEST_EQUAL(result[i].getNativeID(), String("spectrum=") + i)
+    TEST_REAL_SIMILAR(result[i][0].getIntensity(), i)
+  }
+  // the input is not modified
+  TEST_EQUAL(exp == expc, true)
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+{
+  MSDataStoringConsumer storing_consumer;
+  MSDataParallelProcessingConsumer parallel_consumer(&storing_consumer, processor, 2);
+
+  PeakMap exp = expc;
+  for (Size i = 0; i < exp.getChromatograms().size(); ++i)
+  {
+    parallel_consumer.consumeChromatogram(exp.getChromatogram(i));
+  }
+  parallel_consumer.flush();
+
+  const PeakMap& result = storing_consumer.getData();
+  TEST_EQUAL(result.getChromatograms().size(), 5)
+  for (Size i = 0; i < result.getChromatograms().size(); ++i)
+  {
+    TEST_EQUAL(result.getChromatograms()[i].getNativeID(), String("chromatogram=") + i)
+    TEST_REAL_SIMILAR(result.getChromatograms()[i][0].getIntensity(), 42.0)
+  }
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  // mixed input keeps its order
+  MSDataStoringConsumer storing_consumer;
+  MSDataParallelProcessingConsumer parallel_consumer(&storing_consumer, processor, 100);
+
+  PeakMap exp = expc;
+  parallel_consumer.consumeSpectrum(exp.getSpectrum(0));
+  parallel_consumer.consumeChromatogram(exp.getChromatogram(0));
+  TEST_EQUAL(storing_consumer.getData().size(), 1)
+  TEST_EQUAL(storing_consumer.getData().getChromatograms().size(), 0)
+  parallel_consumer.flush();
+  TEST_EQUAL(storing_consumer.getData().getChromatograms().size(), 1)
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+{
+  NOT_TESTABLE // passed on to the next consumer
+}
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const ExperimentalSettings& exp)))
+{
+  NOT_TESTABLE // passed on to the next consumer
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
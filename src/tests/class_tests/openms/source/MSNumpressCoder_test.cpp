@@ -41,7 +41,9 @@
 ///////////////////////////
 
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/MATH/MISC/MSNumpress.h>
 #include <cmath>       /* pow */
+#include <cstring>     /* memcmp */
 
 using namespace std;
 
@@ -134,6 +136,20 @@ bool check_vec2_rel(std::vector<double> vec, double eps)
   return true;
 }
 
+// m/z like (slowly increasing, irregular spacing) and intensity like data
+void setup_test_vec3(std::vector<double>& mz, std::vector<double>& intensity, OpenMS::Size n)
+{
+  mz.resize(n);
+  intensity.resize(n);
+  double val = 200.0;
+  for (OpenMS::Size i = 0; i < n; i++)
+  {
+    val += 0.001 + ((i * 7919) % 1000) * 1e-6;
+    mz[i] = val;
+    intensity[i] = (i * 104729) % 100000;
+  }
+}
+
 START_TEST(MSNumpressCoder, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -199,6 +215,102 @@ START_SECTION(( void decodeNP(const String & in, std::vector<double> & out, bool
 }
 END_SECTION
 
+START_SECTION(( void decodeNP(const String & in, std::vector<float> & out, bool zlib_compression, const NumpressConfig & config) ))
+{
+  String in = "QWR64UAAAADo//8/0P//f1kSgA==";
+
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::LINEAR;
+
+  std::vector<float> out;
+  std::vector<double> out_64;
+  MSNumpressCoder().decodeNP(in, out, false, config);
+  MSNumpressCoder().decodeNP(in, out_64, false, config);
+
+  TEST_EQUAL(out.size(), 4)
+  for (Size i = 0; i < out.size(); ++i)
+  {
+    TEST_EQUAL(out[i], static_cast<float>(out_64[i]))
+  }
+}
+END_SECTION
+
+START_SECTION(( void decodeNPRaw(const std::string & in, std::vector<float> & out, const NumpressConfig & config) ))
+{
+  std::vector<double> in = setup_test_vec2();
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::SLOF;
+
+  String raw;
+  MSNumpressCoder().encodeNPRaw(in, raw, config);
+  std::vector<float> out;
+  std::vector<double> out_64;
+  MSNumpressCoder().decodeNPRaw(raw, out, config);
+  MSNumpressCoder().decodeNPRaw(raw, out_64, config);
+
+  TEST_EQUAL(out.size(), 100)
+  TEST_EQUAL(out_64.size(), 100)
+  ABORT_IF(out.size() != out_64.size())
+  for (Size i = 0; i < out.size(); ++i)
+  {
+    TEST_EQUAL(out[i], static_cast<float>(out_64[i]))
+  }
+}
+END_SECTION
+
+START_SECTION(( Size decodeNPRaw(const unsigned char* in, Size in_size, double* out, Size out_size, const NumpressConfig & config) ))
+{
+  std::vector<double> in = setup_test_vec2();
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::LINEAR;
+
+  String raw;
+  MSNumpressCoder().encodeNPRaw(in, raw, config);
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(raw.c_str());
+
+  std::vector<double> out(MSNumpressCoder::decodedSizeBound(raw.size(), config.np_compression));
+  Size count = MSNumpressCoder().decodeNPRaw(data, raw.size(), &out[0], out.size(), config);
+  TEST_EQUAL(count, 100)
+  out.resize(count);
+  TEST_EQUAL(check_vec2_rel(out, 0.1e-6), true)
+
+  // output buffer too small
+  std::vector<double> small(50);
+  TEST_EXCEPTION(Exception::ConversionError, MSNumpressCoder().decodeNPRaw(data, raw.size(), &small[0], small.size(), config))
+
+  // truncated input
+  TEST_EXCEPTION(Exception::ConversionError, MSNumpressCoder().decodeNPRaw(data, 10, &out[0], out.size(), config))
+}
+END_SECTION
+
+START_SECTION(( Size decodeNPRaw(const unsigned char* in, Size in_size, float* out, Size out_size, const NumpressConfig & config) ))
+{
+  std::vector<double> in = setup_test_vec2();
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::PIC;
+
+  String raw;
+  MSNumpressCoder().encodeNPRaw(in, raw, config);
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(raw.c_str());
+
+  std::vector<float> out(MSNumpressCoder::decodedSizeBound(raw.size(), config.np_compression));
+  Size count = MSNumpressCoder().decodeNPRaw(data, raw.size(), &out[0], out.size(), config);
+  TEST_EQUAL(count, 100)
+  TEST_EQUAL(out[0], 400.0)
+  TEST_EQUAL(out[99], 499.0)
+}
+END_SECTION
+
+START_SECTION(( static Size decodedSizeBound(Size in_size, NumpressCompression compression) ))
+{
+  TEST_EQUAL(MSNumpressCoder::decodedSizeBound(8, MSNumpressCoder::LINEAR), 2)
+  TEST_EQUAL(MSNumpressCoder::decodedSizeBound(20, MSNumpressCoder::LINEAR), 10)
+  TEST_EQUAL(MSNumpressCoder::decodedSizeBound(20, MSNumpressCoder::PIC), 40)
+  TEST_EQUAL(MSNumpressCoder::decodedSizeBound(20, MSNumpressCoder::SLOF), 6)
+  TEST_EQUAL(MSNumpressCoder::decodedSizeBound(20, MSNumpressCoder::NONE), 0)
+}
+END_SECTION
+
 START_SECTION(([MSNumpressCoder::NumpressConfig] NumpressConfig()))
 {
   MSNumpressCoder::NumpressConfig * config = new MSNumpressCoder::NumpressConfig();
@@ -399,6 +511,68 @@ START_SECTION([EXTRA] test_large_SLOF)
 }
 END_SECTION
 
+///////////////////////////////////////////////////////////////////////////
+// Compare against the reference implementation
+///////////////////////////////////////////////////////////////////////////
+
+START_SECTION([EXTRA] compare_reference_implementation)
+{
+  using namespace ms::numpress;
+  std::vector<double> mz, intensity;
+  setup_test_vec3(mz, intensity, 10000);
+  MSNumpressCoder::NumpressConfig config;
+  config.numpressErrorTolerance = 0.0; // compare encodings only
+
+  // linear: identical bytes and identical decoded values
+  {
+    config.np_compression = MSNumpressCoder::LINEAR;
+    String raw;
+    MSNumpressCoder().encodeNPRaw(mz, raw, config);
+    std::vector<unsigned char> ref;
+    MSNumpress::encodeLinear(mz, ref, MSNumpress::optimalLinearFixedPoint(&mz[0], mz.size()));
+    TEST_EQUAL(raw.size(), ref.size())
+    TEST_EQUAL(std::memcmp(raw.c_str(), &ref[0], ref.size()), 0)
+
+    std::vector<double> out, ref_out;
+    MSNumpressCoder().decodeNPRaw(raw, out, config);
+    MSNumpress::decodeLinear(ref, ref_out);
+    TEST_EQUAL(out == ref_out, true)
+  }
+
+  // pic
+  {
+    config.np_compression = MSNumpressCoder::PIC;
+    String raw;
+    MSNumpressCoder().encodeNPRaw(intensity, raw, config);
+    std::vector<unsigned char> ref;
+    MSNumpress::encodePic(intensity, ref);
+    TEST_EQUAL(raw.size(), ref.size())
+    TEST_EQUAL(std::memcmp(raw.c_str(), &ref[0], ref.size()), 0)
+
+    std::vector<double> out, ref_out;
+    MSNumpressCoder().decodeNPRaw(raw, out, config);
+    MSNumpress::decodePic(ref, ref_out);
+    TEST_EQUAL(out == ref_out, true)
+  }
+
+  // slof
+  {
+    config.np_compression = MSNumpressCoder::SLOF;
+    String raw;
+    MSNumpressCoder().encodeNPRaw(intensity, raw, config);
+    std::vector<unsigned char> ref;
+    MSNumpress::encodeSlof(intensity, ref, MSNumpress::optimalSlofFixedPoint(&intensity[0], intensity.size()));
+    TEST_EQUAL(raw.size(), ref.size())
+    TEST_EQUAL(std::memcmp(raw.c_str(), &ref[0], ref.size()), 0)
+
+    std::vector<double> out, ref_out;
+    MSNumpressCoder().decodeNPRaw(raw, out, config);
+    MSNumpress::decodeSlof(ref, ref_out);
+    TEST_EQUAL(out == ref_out, true)
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -126,6 +126,42 @@ START_SECTION((virtual void align(std::vector<PeakMap >&, std::vector<Transforma
 }
 END_SECTION
 
+START_SECTION(([EXTRA] maps aligned in parallel do not depend on each other))
+{
+  std::vector<PeakMap > maps(4);
+  for (Size m = 0; m < maps.size(); ++m)
+  {
+    for (UInt i = 0; i < 20; ++i)
+    {
+      PeakSpectrum spectrum;
+      spectrum.setRT(i * (1.0 + 0.1 * (m % 2)) + 10.0 * (m % 2));
+      spectrum.setMSLevel(1);
+      for (float mz = 500.0; mz <= 900; mz += 100.0)
+      {
+        Peak1D peak;
+        peak.setMZ(mz + i);
+        peak.setIntensity(mz + i);
+        spectrum.push_back(peak);
+      }
+      maps[m].addSpectrum(spectrum);
+    }
+  }
+
+  MapAlignmentAlgorithmSpectrumAlignment ma;
+  std::vector<TransformationDescription> transformations;
+  ma.align(maps, transformations);
+  TEST_EQUAL(transformations.size(), 4)
+  // maps 1 and 3 are identical, so are their transformations
+  TEST_EQUAL(transformations[1].getDataPoints().size(), transformations[3].getDataPoints().size())
+  TEST_EQUAL(transformations[1].getDataPoints().empty(), false)
+  for (Size i = 0; i < transformations[1].getDataPoints().size(); ++i)
+  {
+    TEST_REAL_SIMILAR(transformations[1].getDataPoints()[i].first, transformations[3].getDataPoints()[i].first)
+    TEST_REAL_SIMILAR(transformations[1].getDataPoints()[i].second, transformations[3].getDataPoints()[i].second)
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -38,6 +38,7 @@
 ///////////////////////////
 
 #include <OpenMS/FORMAT/MzIdentMLFile.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
 #include <OpenMS/CONCEPT/FuzzyStringComparator.h>
 #include <OpenMS/CHEMISTRY/CrossLinksDB.h>
 #include <OpenMS/CONCEPT/Constants.h>
@@ -365,6 +366,51 @@ START_SECTION(([EXTRA] regression test for file loading on example files))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] streamed load matches DOM load))
+{
+  for (const String& name : {"MzIdentMLFile_msgf_mini.mzid", "MzIdentML_3runs.mzid"})
+  {
+    String input_path = String(OPENMS_GET_TEST_DATA_PATH("")) + name;
+    std::vector<ProteinIdentification> protein_ids, protein_ids_dom;
+    std::vector<PeptideIdentification> peptide_ids, peptide_ids_dom;
+    MzIdentMLFile().load(input_path, protein_ids, peptide_ids);
+    ProgressLogger logger;
+    Internal::MzIdentMLDOMHandler(protein_ids_dom, peptide_ids_dom, "1.1.0", logger).readMzIdentMLFile(input_path);
+
+    TEST_EQUAL(protein_ids.size(), protein_ids_dom.size())
+    ABORT_IF(protein_ids.size() != protein_ids_dom.size())
+    for (Size i = 0; i < protein_ids.size(); ++i)
+    {
+      TEST_EQUAL(protein_ids[i].getSearchEngine(), protein_ids_dom[i].getSearchEngine())
+      TEST_EQUAL(protein_ids[i].getSearchParameters().db, protein_ids_dom[i].getSearchParameters().db)
+      TEST_EQUAL(protein_ids[i].getHits().size(), protein_ids_dom[i].getHits().size())
+      ABORT_IF(protein_ids[i].getHits().size() != protein_ids_dom[i].getHits().size())
+      for (Size j = 0; j < protein_ids[i].getHits().size(); ++j)
+      {
+        TEST_EQUAL(protein_ids[i].getHits()[j].getAccession(), protein_ids_dom[i].getHits()[j].getAccession())
+      }
+    }
+    TEST_EQUAL(peptide_ids.size(), peptide_ids_dom.size())
+    ABORT_IF(peptide_ids.size() != peptide_ids_dom.size())
+    for (Size i = 0; i < peptide_ids.size(); ++i)
+    {
+      TEST_EQUAL(peptide_ids[i].getScoreType(), peptide_ids_dom[i].getScoreType())
+      TEST_REAL_SIMILAR(peptide_ids[i].getRT(), peptide_ids_dom[i].getRT())
+      TEST_REAL_SIMILAR(peptide_ids[i].getMZ(), peptide_ids_dom[i].getMZ())
+      TEST_EQUAL(peptide_ids[i].getMetaValue("spectrum_reference"), peptide_ids_dom[i].getMetaValue("spectrum_reference"))
+      TEST_EQUAL(peptide_ids[i].getHits().size(), peptide_ids_dom[i].getHits().size())
+      ABORT_IF(peptide_ids[i].getHits().size() != peptide_ids_dom[i].getHits().size())
+      for (Size j = 0; j < peptide_ids[i].getHits().size(); ++j)
+      {
+        TEST_EQUAL(peptide_ids[i].getHits()[j].getSequence(), peptide_ids_dom[i].getHits()[j].getSequence())
+        TEST_REAL_SIMILAR(peptide_ids[i].getHits()[j].getScore(), peptide_ids_dom[i].getHits()[j].getScore())
+        TEST_EQUAL(peptide_ids[i].getHits()[j].getPeptideEvidences().size(), peptide_ids_dom[i].getHits()[j].getPeptideEvidences().size())
+      }
+    }
+  }
+}
+END_SECTION
+
 
 START_SECTION(([EXTRA] compability issues))
 {
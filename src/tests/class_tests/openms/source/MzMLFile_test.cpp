@@ -981,6 +981,43 @@ START_SECTION([EXTRA] load intensity range)
 }
 END_SECTION
 
+START_SECTION([EXTRA] load numpress compressed intensities)
+{
+  // numpress intensities are decoded into single precision directly unless an
+  // intensity range is set - both paths have to give the same peaks
+  PeakMap exp_original;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp_original);
+
+  MzMLFile file;
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::SLOF;
+  config.estimate_fixed_point = true;
+  file.getOptions().setNumpressConfigurationIntensity(config);
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  file.store(tmp_filename, exp_original);
+
+  PeakMap exp_32, exp_64;
+  MzMLFile().load(tmp_filename, exp_32);
+  MzMLFile file_range;
+  file_range.getOptions().setIntensityRange(makeRange(-1.0e10, 1.0e10));
+  file_range.load(tmp_filename, exp_64);
+
+  TEST_EQUAL(exp_32.size(), exp_original.size())
+  TEST_EQUAL(exp_32.size(), exp_64.size())
+  TOLERANCE_RELATIVE(1.001) // slof is lossy
+  for (Size i = 0; i < exp_32.size(); ++i)
+  {
+    TEST_EQUAL(exp_32[i].size(), exp_original[i].size())
+    TEST_EQUAL(exp_32[i] == exp_64[i], true)
+    for (Size k = 0; k < exp_32[i].size(); ++k)
+    {
+      TEST_REAL_SIMILAR(exp_32[i][k].getIntensity(), exp_original[i][k].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 
 START_SECTION((template <typename MapType> void store(const String& filename, const MapType& map) const))
 {
@@ -0,0 +1,266 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/OMSBinFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(OMSBinFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+OMSBinFile* ptr = nullptr;
+OMSBinFile* null_ptr = nullptr;
+START_SECTION((OMSBinFile()))
+{
+  ptr = new OMSBinFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION((~OMSBinFile()))
+{
+  delete ptr;
+}
+END_SECTION
+
+String feature_file;
+NEW_TMP_FILE(feature_file)
+
+START_SECTION((void store(const String& filename, const FeatureMap& feature_map)))
+{
+  FeatureMap map;
+  FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), map);
+  OMSBinFile().store(feature_file, map);
+  TEST_EQUAL(OMSBinFile::isOMSBinFile(feature_file), true)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, OMSBinFile().store("test.featureXML", map))
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, FeatureMap& feature_map)))
+{
+  FeatureMap map, map_bin;
+  FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), map);
+  OMSBinFile().load(feature_file, map_bin);
+  TEST_EQUAL(map_bin.size(), map.size())
+  TEST_EQUAL(map_bin.getLoadedFileType(), FileTypes::OMSBIN)
+  // the document identifier differs only by the loaded file
+  map.setLoadedFilePath(feature_file);
+  map.setLoadedFileType(feature_file);
+  TEST_EQUAL(map_bin == map, true)
+  TEST_EQUAL(map_bin.getProteinIdentifications() == map.getProteinIdentifications(), true)
+  TEST_EQUAL(map_bin.getUnassignedPeptideIdentifications() == map.getUnassignedPeptideIdentifications(), true)
+  TEST_EQUAL(map_bin.getDataProcessing() == map.getDataProcessing(), true)
+  for (Size i = 0; i < map.size(); ++i)
+  {
+    TEST_EQUAL(map_bin[i] == map[i], true)
+  }
+
+  TEST_EXCEPTION(Exception::FileNotFound, OMSBinFile().load("this_file_does_not_exist.omsBin", map))
+  // XML is not accepted
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), map))
+  // neither is a different content type
+  ConsensusMap cmap;
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(feature_file, cmap))
+
+  // truncated files are detected
+  String truncated_file;
+  NEW_TMP_FILE(truncated_file)
+  {
+    ifstream is(feature_file.c_str(), ios::binary);
+    string content((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+    ofstream os(truncated_file.c_str(), ios::binary);
+    os.write(content.data(), content.size() / 2);
+  }
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(truncated_file, map))
+}
+END_SECTION
+
+String consensus_file;
+NEW_TMP_FILE(consensus_file)
+
+START_SECTION((void store(const String& filename, const ConsensusMap& consensus_map)))
+{
+  ConsensusMap map;
+  ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), map);
+  OMSBinFile().store(consensus_file, map);
+  TEST_EQUAL(OMSBinFile::isOMSBinFile(consensus_file), true)
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, ConsensusMap& consensus_map)))
+{
+  ConsensusMap map, map_bin;
+  ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), map);
+  OMSBinFile().load(consensus_file, map_bin);
+  TEST_EQUAL(map_bin.size(), map.size())
+  map.setLoadedFilePath(consensus_file);
+  map.setLoadedFileType(consensus_file);
+  TEST_EQUAL(map_bin == map, true)
+  TEST_EQUAL(map_bin.getColumnHeaders().size(), map.getColumnHeaders().size())
+  TEST_EQUAL(map_bin.getExperimentType(), map.getExperimentType())
+  for (Size i = 0; i < map.size(); ++i)
+  {
+    TEST_EQUAL(map_bin[i] == map[i], true)
+    TEST_EQUAL(map_bin[i].getFeatures().size(), map[i].getFeatures().size())
+  }
+
+  FeatureMap fmap;
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(consensus_file, fmap))
+}
+END_SECTION
+
+String id_file;
+NEW_TMP_FILE(id_file)
+
+START_SECTION((void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)))
+{
+  vector<ProteinIdentification> protein_ids;
+  vector<PeptideIdentification> peptide_ids;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+  OMSBinFile().store(id_file, protein_ids, peptide_ids);
+  TEST_EQUAL(OMSBinFile::isOMSBinFile(id_file), true)
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)))
+{
+  vector<ProteinIdentification> protein_ids, protein_ids_bin;
+  vector<PeptideIdentification> peptide_ids, peptide_ids_bin;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+  OMSBinFile().load(id_file, protein_ids_bin, peptide_ids_bin);
+  TEST_EQUAL(protein_ids_bin.size(), protein_ids.size())
+  TEST_EQUAL(peptide_ids_bin.size(), peptide_ids.size())
+  TEST_EQUAL(protein_ids_bin == protein_ids, true)
+  TEST_EQUAL(peptide_ids_bin == peptide_ids, true)
+  TEST_EQUAL(peptide_ids_bin[0].getHits()[0].getSequence(), peptide_ids[0].getHits()[0].getSequence())
+
+  // meta values of all types (with units) survive
+  PeptideIdentification pep;
+  pep.setMetaValue("string", DataValue("value"));
+  pep.setMetaValue("int", DataValue(-17));
+  DataValue dv(1.5);
+  dv.setUnitType(DataValue::UNIT_ONTOLOGY);
+  dv.setUnit(10);
+  pep.setMetaValue("double", dv);
+  pep.setMetaValue("strings", DataValue(ListUtils::create<String>("a,b,c")));
+  pep.setMetaValue("ints", DataValue(ListUtils::create<Int>("1,2,3")));
+  pep.setMetaValue("doubles", DataValue(ListUtils::create<double>("1.5,2.5")));
+  pep.setMetaValue("empty", DataValue());
+  PeptideHit hit(12.3, 1, 2, AASequence::fromString("PEPT(Phospho)IDEK"));
+  hit.addPeptideEvidence(PeptideEvidence("PROT1", 3, 12, 'K', 'A'));
+  pep.insertHit(hit);
+  String meta_file;
+  NEW_TMP_FILE(meta_file)
+  OMSBinFile().store(meta_file, vector<ProteinIdentification>(), vector<PeptideIdentification>(1, pep));
+  OMSBinFile().load(meta_file, protein_ids_bin, peptide_ids_bin);
+  TEST_EQUAL(protein_ids_bin.empty(), true)
+  TEST_EQUAL(peptide_ids_bin.size(), 1)
+  TEST_EQUAL(peptide_ids_bin[0] == pep, true)
+  TEST_EQUAL(peptide_ids_bin[0].getMetaValue("double").getUnit(), 10)
+  TEST_EQUAL(peptide_ids_bin[0].hasRT(), false)
+
+  // corrupt element counts are detected before anything is allocated
+  String corrupt_file;
+  NEW_TMP_FILE(corrupt_file)
+  OMSBinFile().store(corrupt_file, vector<ProteinIdentification>(), vector<PeptideIdentification>());
+  {
+    // the file ends with the number of protein and of peptide identifications
+    fstream fs(corrupt_file.c_str(), ios::in | ios::out | ios::binary);
+    fs.seekp(-2 * Int(sizeof(UInt64)), ios::end);
+    UInt64 count = UInt64(1) << 50;
+    fs.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(corrupt_file, protein_ids_bin, peptide_ids_bin))
+}
+END_SECTION
+
+START_SECTION((static bool isOMSBinFile(const String& filename)))
+{
+  TEST_EQUAL(OMSBinFile::isOMSBinFile(feature_file), true)
+  TEST_EQUAL(OMSBinFile::isOMSBinFile(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML")), false)
+  TEST_EQUAL(OMSBinFile::isOMSBinFile("this_file_does_not_exist.omsBin"), false)
+}
+END_SECTION
+
+START_SECTION((static ContentType getContentType(const String& filename)))
+{
+  TEST_EQUAL(OMSBinFile::getContentType(feature_file), OMSBinFile::FEATURES)
+  TEST_EQUAL(OMSBinFile::getContentType(consensus_file), OMSBinFile::CONSENSUS)
+  TEST_EQUAL(OMSBinFile::getContentType(id_file), OMSBinFile::IDENTIFICATIONS)
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile::getContentType(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML")))
+  TEST_EXCEPTION(Exception::FileNotFound, OMSBinFile::getContentType("this_file_does_not_exist.omsBin"))
+}
+END_SECTION
+
+START_SECTION([EXTRA] selection through FileHandler and FileTypes)
+{
+  TEST_EQUAL(FileTypes::typeToName(FileTypes::OMSBIN), "omsBin")
+  TEST_EQUAL(FileHandler::getTypeByFileName("test.omsBin"), FileTypes::OMSBIN)
+  TEST_EQUAL(FileHandler::getTypeByContent(feature_file), FileTypes::OMSBIN)
+
+  FileHandler fh;
+  FeatureMap map;
+  TEST_EQUAL(fh.loadFeatures(feature_file, map, FileTypes::OMSBIN), true)
+  TEST_EQUAL(map.empty(), false)
+  ConsensusMap cmap;
+  TEST_EQUAL(fh.loadConsensusFeatures(consensus_file, cmap, FileTypes::OMSBIN), true)
+  TEST_EQUAL(cmap.empty(), false)
+  vector<ProteinIdentification> protein_ids;
+  vector<PeptideIdentification> peptide_ids;
+  TEST_EQUAL(fh.loadIdentifications(id_file, protein_ids, peptide_ids, FileTypes::OMSBIN), true)
+  TEST_EQUAL(peptide_ids.empty(), false)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -35,6 +35,10 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
 ///////////////////////////
 
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
@@ -129,6 +133,11 @@ START_SECTION((bool isSortedByRT() const))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   TEST_EQUAL(tmp.isSortedByRT(), true);
+
+  // without meta data, the spectrum index is used
+  OnDiscPeakMap headers; headers.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  TEST_EQUAL(headers.getMetaData().get() == nullptr, true);
+  TEST_EQUAL(headers.isSortedByRT(), true);
 }
 END_SECTION
 
@@ -198,6 +207,78 @@ START_SECTION((MSSpectrum getSpectrum(Size id)))
 }
 END_SECTION
 
+START_SECTION((std::vector<MSSpectrum> getSpectra(const std::vector<Size>& ids)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  std::vector<Size> ids;
+  for (Size i = tmp.getNrSpectra(); i > 0; --i)
+  {
+    ids.push_back(i - 1);
+  }
+  std::vector<MSSpectrum> spectra = tmp.getSpectra(ids);
+  TEST_EQUAL(spectra.size(), ids.size());
+  for (Size i = 0; i < ids.size(); ++i)
+  {
+    TEST_EQUAL(spectra[i] == tmp.getSpectrum(ids[i]), true);
+  }
+
+  // without meta data
+  OnDiscPeakMap no_meta; no_meta.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  spectra = no_meta.getSpectra(ids);
+  TEST_EQUAL(spectra.size(), ids.size());
+  for (Size i = 0; i < ids.size(); ++i)
+  {
+    TEST_EQUAL(spectra[i].size(), tmp.getSpectrum(ids[i]).size());
+    TEST_REAL_SIMILAR(spectra[i].getRT(), tmp.getSpectrum(ids[i]).getRT());
+  }
+}
+END_SECTION
+
+START_SECTION(([EXTRA] concurrent getSpectrum))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  std::vector<Size> sizes(tmp.getNrSpectra());
+  for (Size i = 0; i < sizes.size(); ++i)
+  {
+    sizes[i] = tmp.getSpectrum(i).size();
+  }
+  const SignedSize n = 20 * sizes.size();
+  std::vector<Size> parallel_sizes(n);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (SignedSize i = 0; i < n; ++i)
+  {
+    parallel_sizes[i] = tmp.getSpectrum(i % sizes.size()).size();
+  }
+  for (SignedSize i = 0; i < n; ++i)
+  {
+    TEST_EQUAL(parallel_sizes[i], sizes[i % sizes.size()]);
+  }
+}
+END_SECTION
+
+START_SECTION(([EXTRA] concurrent getSpectrum from copies without meta data))
+{
+  // firstprivate copies share the index of the original, which is built once
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  const SignedSize n = 20 * tmp.getNrSpectra();
+  std::vector<double> rts(n);
+#ifdef _OPENMP
+#pragma omp parallel for firstprivate(tmp)
+#endif
+  for (SignedSize i = 0; i < n; ++i)
+  {
+    rts[i] = tmp.getSpectrum(i % tmp.getNrSpectra()).getRT();
+  }
+  const std::vector<OnDiscPeakMap::SpectrumIndexEntry>& index = tmp.getSpectrumIndex();
+  for (SignedSize i = 0; i < n; ++i)
+  {
+    TEST_REAL_SIMILAR(rts[i], index[i % index.size()].rt);
+  }
+}
+END_SECTION
+
 START_SECTION(OpenMS::Interfaces::SpectrumPtr getSpectrumById(Size id))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
@@ -233,6 +314,153 @@ START_SECTION(OpenMS::Interfaces::ChromatogramPtr getChromatogramById(Size id))
 }
 END_SECTION
 
+START_SECTION((const std::vector<SpectrumIndexEntry>& getSpectrumIndex()))
+{
+  // index from meta data and from spectrum headers must agree
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  OnDiscPeakMap headers; headers.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  std::vector<OnDiscPeakMap::SpectrumIndexEntry> index = tmp.getSpectrumIndex();
+  std::vector<OnDiscPeakMap::SpectrumIndexEntry> index_headers = headers.getSpectrumIndex();
+  TEST_EQUAL(index.size(), tmp.getNrSpectra());
+  TEST_EQUAL(index_headers.size(), index.size());
+  ABORT_IF(index_headers.size() != index.size())
+  for (Size i = 0; i < index.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(index_headers[i].rt, tmp.getMetaData()->getSpectrum(i).getRT());
+    TEST_REAL_SIMILAR(index_headers[i].rt, index[i].rt);
+    TEST_EQUAL(index_headers[i].ms_level, index[i].ms_level);
+    TEST_REAL_SIMILAR(index_headers[i].precursor_mz, index[i].precursor_mz);
+  }
+
+  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  TEST_EQUAL(failed.getSpectrumIndex().empty(), true);
+}
+END_SECTION
+
+START_SECTION((Size RTBegin(double rt)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  const PeakMap& meta = *tmp.getMetaData();
+  TEST_EQUAL(tmp.RTBegin(-1.0e6), 0);
+  TEST_EQUAL(tmp.RTBegin(1.0e6), tmp.getNrSpectra());
+  TEST_EQUAL(tmp.RTBegin(meta[0].getRT()), 0);
+  TEST_EQUAL(tmp.RTBegin(meta[1].getRT()), Size(meta.RTBegin(meta[1].getRT()) - meta.begin()));
+}
+END_SECTION
+
+START_SECTION((Size RTEnd(double rt)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  const PeakMap& meta = *tmp.getMetaData();
+  TEST_EQUAL(tmp.RTEnd(-1.0e6), 0);
+  TEST_EQUAL(tmp.RTEnd(1.0e6), tmp.getNrSpectra());
+  TEST_EQUAL(tmp.RTEnd(meta[0].getRT()), Size(meta.RTEnd(meta[0].getRT()) - meta.begin()));
+}
+END_SECTION
+
+START_SECTION((std::vector<Size> getSpectraInRTRange(double rt_min, double rt_max, Int ms_level = 0)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  const PeakMap& meta = *tmp.getMetaData();
+  std::vector<Size> all = tmp.getSpectraInRTRange(-1.0e6, 1.0e6);
+  TEST_EQUAL(all.size(), tmp.getNrSpectra());
+  std::vector<Size> none = tmp.getSpectraInRTRange(1.0e6, 2.0e6);
+  TEST_EQUAL(none.size(), 0);
+
+  std::vector<Size> first = tmp.getSpectraInRTRange(meta[0].getRT(), meta[0].getRT(), meta[0].getMSLevel());
+  TEST_EQUAL(first.empty(), false);
+  ABORT_IF(first.empty())
+  TEST_EQUAL(first[0], 0);
+
+  Size ms1(0);
+  for (Size i = 0; i < meta.size(); ++i)
+  {
+    if (meta[i].getMSLevel() == 1) ++ms1;
+  }
+  TEST_EQUAL(tmp.getSpectraInRTRange(-1.0e6, 1.0e6, 1).size(), ms1);
+}
+END_SECTION
+
+START_SECTION((std::vector<Size> getSpectraByPrecursorMZ(double mz_min, double mz_max, double rt_min, double rt_max)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  const PeakMap& meta = *tmp.getMetaData();
+  Size with_precursor(0);
+  for (Size i = 0; i < meta.size(); ++i)
+  {
+    if (!meta[i].getPrecursors().empty()) ++with_precursor;
+  }
+  TEST_EQUAL(tmp.getSpectraByPrecursorMZ(0.0, 1.0e6).size(), with_precursor);
+  TEST_EQUAL(tmp.getSpectraByPrecursorMZ(0.0, 1.0e6, 1.0e6, 2.0e6).size(), 0);
+}
+END_SECTION
+
+START_SECTION((void getArea(double rt_min, double rt_max, double mz_min, double mz_max, Int ms_level, PeakMap& output)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  MSSpectrum s = tmp.getSpectrum(0);
+  PeakMap area;
+  tmp.getArea(s.getRT(), s.getRT(), s[0].getMZ(), s[9].getMZ(), 0, area);
+  TEST_EQUAL(area.empty(), false);
+  ABORT_IF(area.empty())
+  TEST_REAL_SIMILAR(area[0].getRT(), s.getRT());
+  TEST_EQUAL(area[0].size(), 10);
+  TEST_REAL_SIMILAR(area[0][0].getMZ(), s[0].getMZ());
+  TEST_REAL_SIMILAR(area[0][9].getMZ(), s[9].getMZ());
+
+  tmp.getArea(1.0e6, 2.0e6, 0.0, 1.0e6, 0, area);
+  TEST_EQUAL(area.empty(), true);
+}
+END_SECTION
+
+START_SECTION((static String getIndexFilename(const String& filename)))
+{
+  TEST_EQUAL(OnDiscPeakMap::getIndexFilename("a.mzML"), "a.mzML.rtidx");
+}
+END_SECTION
+
+START_SECTION((void setIndexCaching(bool caching)))
+{
+  // copy the input, the cache is written next to it
+  String filename;
+  NEW_TMP_FILE(filename);
+  {
+    std::ifstream in(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), std::ios::binary);
+    std::ofstream out(filename.c_str(), std::ios::binary);
+    out << in.rdbuf();
+  }
+  String cache = OnDiscPeakMap::getIndexFilename(filename);
+
+  // caching is off by default
+  OnDiscPeakMap tmp; tmp.openFile(filename);
+  std::vector<OnDiscPeakMap::SpectrumIndexEntry> index = tmp.getSpectrumIndex();
+  TEST_EQUAL(File::exists(cache), false);
+
+  // copies never write the cache
+  OnDiscPeakMap original; original.setIndexCaching(true); original.openFile(filename, true);
+  OnDiscPeakMap copy(original);
+  TEST_EQUAL(copy.getSpectrumIndex().size(), index.size());
+  TEST_EQUAL(File::exists(cache), false);
+
+  OnDiscPeakMap caching; caching.setIndexCaching(true); caching.openFile(filename);
+  TEST_EQUAL(caching.getSpectrumIndex().size(), index.size());
+  TEST_EQUAL(File::exists(cache), true);
+
+  // without meta data, the index comes from the cache and annotates the spectra
+  OnDiscPeakMap cached; cached.setIndexCaching(true); cached.openFile(filename, true);
+  TEST_EQUAL(cached.getSpectrumIndex().size(), index.size());
+  MSSpectrum s = cached.getSpectrum(0);
+  TEST_REAL_SIMILAR(s.getRT(), index[0].rt);
+  TEST_EQUAL(s.getMSLevel(), index[0].ms_level);
+  TEST_EQUAL(s.size(), 19914);
+  File::remove(cache);
+
+  OnDiscPeakMap uncached; uncached.openFile(filename, true);
+  TEST_EQUAL(uncached.getSpectrumIndex().size(), index.size());
+  TEST_EQUAL(File::exists(cache), false);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
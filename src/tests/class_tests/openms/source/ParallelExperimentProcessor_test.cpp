@@ -0,0 +1,205 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/ParallelExperimentProcessor.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ParallelExperimentProcessor, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap expc;
+for (Size i = 0; i < 100; ++i)
+{
+  MSSpectrum s;
+  s.setRT(i);
+  for (Size j = 0; j < 10; ++j)
+  {
+    Peak1D p;
+    p.setMZ(100.0 + j);
+    p.setIntensity(1.0 + j);
+    s.push_back(p);
+  }
+  expc.addSpectrum(s);
+}
+for (Size i = 0; i < 10; ++i)
+{
+  MSChromatogram c;
+  for (Size j = 0; j < 5; ++j)
+  {
+    ChromatogramPeak p;
+    p.setRT(j);
+    p.setIntensity(2.0);
+    c.push_back(p);
+  }
+  expc.addChromatogram(c);
+}
+
+ParallelExperimentProcessor* ptr = nullptr;
+ParallelExperimentProcessor* null_ptr = nullptr;
+START_SECTION((ParallelExperimentProcessor(Size chunk_size = 16)))
+{
+  ptr = new ParallelExperimentProcessor();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getChunkSize(), 16)
+}
+END_SECTION
+
+START_SECTION((virtual ~ParallelExperimentProcessor()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void setChunkSize(Size chunk_size)))
+{
+  ParallelExperimentProcessor processor;
+  processor.setChunkSize(3);
+  TEST_EQUAL(processor.getChunkSize(), 3)
+  processor.setChunkSize(0);
+  TEST_EQUAL(processor.getChunkSize(), 1)
+}
+END_SECTION
+
+START_SECTION((Size getChunkSize() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setSpectraProcessingFunc(SpectrumProcessingFunc f_spec)))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION((void setChromatogramProcessingFunc(ChromatogramProcessingFunc f_chrom)))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION((void processExperiment(PeakMap& exp, const String& label = "processing data") const))
+{
+  PeakMap exp = expc;
+  ParallelExperimentProcessor processor(7);
+
+  // no functions set: nothing happens
+  processor.processExperiment(exp);
+  TEST_EQUAL(exp == expc, true)
+
+  processor.setSpectraProcessingFunc([](MSSpectrum& s) { s.resize(Size(s.getRT())); });
+  processor.setChromatogramProcessingFunc([](MSChromatogram& c) { c[0].setIntensity(5.0); });
+  processor.processExperiment(exp);
+
+  TEST_EQUAL(exp.size(), 100)
+  TEST_EQUAL(exp.getChromatograms().size(), 10)
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp[i].size(), std::min(i, Size(10)))
+  }
+  for (Size i = 0; i < exp.getChromatograms().size(); ++i)
+  {
+    TEST_REAL_SIMILAR(exp.getChromatogram(i)[0].getIntensity(), 5.0)
+    TEST_REAL_SIMILAR(exp.getChromatogram(i)[1].getIntensity(), 2.0)
+  }
+
+  // every thread works on its own copy of the captured state
+  PeakMap exp2 = expc;
+  Size counter = 0;
+  processor.setSpectraProcessingFunc([counter](MSSpectrum& s) mutable { ++counter; s.setMSLevel(counter); });
+  processor.setChromatogramProcessingFunc(nullptr);
+  processor.processExperiment(exp2);
+  for (Size i = 0; i < exp2.size(); ++i)
+  {
+    TEST_EQUAL(exp2[i].getMSLevel() >= 1, true)
+    TEST_EQUAL(exp2[i].getMSLevel() <= 100, true)
+  }
+  TEST_EQUAL(counter, 0)
+  TEST_EQUAL(exp2.getChromatograms() == expc.getChromatograms(), true)
+
+  // exceptions are passed on to the caller
+  PeakMap exp3 = expc;
+  processor.setSpectraProcessingFunc([](MSSpectrum& s)
+  {
+    if (s.getRT() == 42) throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test");
+    s.clear(false);
+  });
+  TEST_EXCEPTION(Exception::IllegalArgument, processor.processExperiment(exp3))
+  TEST_EQUAL(exp3[41].size(), 0)
+  TEST_EQUAL(exp3[42].size(), 10)
+  TEST_EQUAL(exp3[43].size(), 0)
+}
+END_SECTION
+
+START_SECTION((void processSpectra(std::vector<MSSpectrum>& spectra) const))
+{
+  std::vector<MSSpectrum> spectra = expc.getSpectra();
+  ParallelExperimentProcessor processor(1);
+  processor.setSpectraProcessingFunc([](MSSpectrum& s) { s.setRT(s.getRT() * 2); });
+  processor.processSpectra(spectra);
+  for (Size i = 0; i < spectra.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(spectra[i].getRT(), 2.0 * i)
+  }
+}
+END_SECTION
+
+START_SECTION((void processChromatograms(std::vector<MSChromatogram>& chromatograms) const))
+{
+  std::vector<MSChromatogram> chromatograms = expc.getChromatograms();
+  ParallelExperimentProcessor processor;
+  processor.setChromatogramProcessingFunc([](MSChromatogram& c) { c.setName("processed"); });
+  processor.processChromatograms(chromatograms);
+  for (Size i = 0; i < chromatograms.size(); ++i)
+  {
+    TEST_STRING_EQUAL(chromatograms[i].getName(), "processed")
+  }
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
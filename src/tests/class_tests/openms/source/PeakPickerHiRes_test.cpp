@@ -35,6 +35,8 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 
 ///////////////////////////
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
@@ -216,6 +218,25 @@ START_SECTION([EXTRA](template <typename PeakType> void pickExperiment(const MSE
   }
 END_SECTION
 
+START_SECTION([EXTRA] signal_to_noise_estimator = median_sliding)
+  PeakPickerHiRes pp_sliding;
+  Param p_sliding = pp_sliding.getParameters();
+  p_sliding.setValue("signal_to_noise", 0.0);
+  pp_sliding.setParameters(p_sliding);
+  MSSpectrum all_peaks;
+  pp_sliding.pick(input[0], all_peaks);
+
+  p_sliding.setValue("signal_to_noise", 4.0);
+  p_sliding.setValue("signal_to_noise_estimator", "median_sliding");
+  pp_sliding.setParameters(p_sliding);
+  MSSpectrum sliding_peaks;
+  pp_sliding.pick(input[0], sliding_peaks);
+
+  // the S/N threshold only removes peaks, but must keep the prominent ones
+  TEST_EQUAL(sliding_peaks.empty(), false)
+  TEST_EQUAL(sliding_peaks.size() < all_peaks.size(), true)
+END_SECTION
+
 output.clear(true);
 input.clear(true);
 //
@@ -491,4 +512,40 @@ START_SECTION(void pick(const MSSpectrum& input, MSSpectrum& output, std::vector
     
 END_SECTION
 
+START_SECTION(void pickExperiment(OnDiscMSExperiment& input, Interfaces::IMSDataConsumer& consumer, const bool check_spectrum_type = true) const)
+{
+  // on-disc picking (batched and prefetched) must give the same result as in-memory picking
+  PeakPickerHiRes pp;
+  PeakMap in_memory, picked_in_memory;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), in_memory);
+  pp.pickExperiment(in_memory, picked_in_memory, false);
+
+  OnDiscPeakMap on_disc;
+  on_disc.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+
+  MSDataStoringConsumer consumer;
+  pp.pickExperiment(on_disc, consumer, false);
+  const PeakMap& picked_consumer = consumer.getData();
+
+  PeakMap picked_on_disc;
+  pp.pickExperiment(on_disc, picked_on_disc, false);
+
+  TEST_EQUAL(picked_consumer.size(), picked_in_memory.size())
+  TEST_EQUAL(picked_on_disc.size(), picked_in_memory.size())
+  TEST_EQUAL(picked_consumer.getChromatograms().size(), picked_in_memory.getChromatograms().size())
+  TEST_EQUAL(picked_on_disc.getChromatograms().size(), picked_in_memory.getChromatograms().size())
+  for (Size scan_idx = 0; scan_idx < picked_in_memory.size(); ++scan_idx)
+  {
+    TEST_EQUAL(picked_consumer[scan_idx].getNativeID(), picked_in_memory[scan_idx].getNativeID())
+    TEST_EQUAL(picked_consumer[scan_idx].size(), picked_in_memory[scan_idx].size())
+    TEST_EQUAL(picked_on_disc[scan_idx].size(), picked_in_memory[scan_idx].size())
+    for (Size peak_idx = 0; peak_idx < picked_in_memory[scan_idx].size(); ++peak_idx)
+    {
+      TEST_REAL_SIMILAR(picked_consumer[scan_idx][peak_idx].getMZ(), picked_in_memory[scan_idx][peak_idx].getMZ())
+      TEST_REAL_SIMILAR(picked_consumer[scan_idx][peak_idx].getIntensity(), picked_in_memory[scan_idx][peak_idx].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 END_TEST
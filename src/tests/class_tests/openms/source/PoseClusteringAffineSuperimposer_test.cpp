@@ -338,6 +338,46 @@ START_SECTION(([EXTRA]virtual void run(const std::vector<Peak2D> & map_model, co
 }
 END_SECTION
 
+START_SECTION(([EXTRA] pairing 'sweep' and 'scan' hash the same transformations))
+{
+  // scene = model shifted by 30 and scaled by 1.02, plus some unrelated points
+  std::vector<Peak2D> map_model, map_scene;
+  for (Size i = 0; i < 300; ++i)
+  {
+    Peak2D p;
+    p.setMZ(300.0 + (i * 7919) % 1200 + 0.001 * (i % 13));
+    p.setRT(10.0 + (i * 104729) % 3600);
+    p.setIntensity(1000.0 + (i * 7) % 500);
+    map_model.push_back(p);
+    if (i % 5 != 0)
+    {
+      p.setRT(p.getRT() * 1.02 + 30.0);
+      p.setMZ(p.getMZ() + 0.002);
+    }
+    else
+    {
+      p.setRT(10.0 + (i * 15485863) % 3600);
+    }
+    map_scene.push_back(p);
+  }
+
+  Param parameters;
+  parameters.setValue(String("num_used_points"), -1);
+  TransformationDescription transformation_scan, transformation_sweep;
+  PoseClusteringAffineSuperimposer pcat;
+  parameters.setValue(String("pairing"), "scan");
+  pcat.setParameters(parameters);
+  pcat.run(map_model, map_scene, transformation_scan);
+  parameters.setValue(String("pairing"), "sweep");
+  pcat.setParameters(parameters);
+  pcat.run(map_model, map_scene, transformation_sweep);
+
+  TEST_STRING_EQUAL(transformation_sweep.getModelType(), "linear")
+  TEST_REAL_SIMILAR(transformation_sweep.getModelParameters().getValue("slope"), transformation_scan.getModelParameters().getValue("slope"))
+  TEST_REAL_SIMILAR(transformation_sweep.getModelParameters().getValue("intercept"), transformation_scan.getModelParameters().getValue("intercept"))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -0,0 +1,140 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+#include <OpenMS/FORMAT/DTAFile.h>
+
+///////////////////////////
+#include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedianSliding.h>
+///////////////////////////
+
+#include <algorithm>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SignalToNoiseEstimatorMedianSliding, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SignalToNoiseEstimatorMedianSliding< >* ptr = nullptr;
+SignalToNoiseEstimatorMedianSliding< >* nullPointer = nullptr;
+START_SECTION((SignalToNoiseEstimatorMedianSliding()))
+  ptr = new SignalToNoiseEstimatorMedianSliding<>;
+  TEST_NOT_EQUAL(ptr, nullPointer)
+END_SECTION
+
+START_SECTION((SignalToNoiseEstimatorMedianSliding& operator=(const SignalToNoiseEstimatorMedianSliding &source)))
+  MSSpectrum raw_data;
+  SignalToNoiseEstimatorMedianSliding<> sne;
+  sne.init(raw_data);
+  SignalToNoiseEstimatorMedianSliding<> sne2 = sne;
+  NOT_TESTABLE
+END_SECTION
+
+START_SECTION((SignalToNoiseEstimatorMedianSliding(const SignalToNoiseEstimatorMedianSliding &source)))
+  MSSpectrum raw_data;
+  SignalToNoiseEstimatorMedianSliding<> sne;
+  sne.init(raw_data);
+  SignalToNoiseEstimatorMedianSliding<> sne2(sne);
+  NOT_TESTABLE
+END_SECTION
+
+START_SECTION((virtual ~SignalToNoiseEstimatorMedianSliding()))
+  delete ptr;
+END_SECTION
+
+START_SECTION([EXTRA](virtual void init(const PeakIterator& it_begin, const PeakIterator& it_end)))
+  MSSpectrum raw_data;
+  DTAFile dta_file;
+  dta_file.load(OPENMS_GET_TEST_DATA_PATH("SignalToNoiseEstimator_test.dta"), raw_data);
+
+  double win_len = 40.0;
+  SignalToNoiseEstimatorMedianSliding< MSSpectrum > sne;
+  Param p;
+  p.setValue("win_len", win_len);
+  p.setValue("noise_for_empty_window", 2.0);
+  p.setValue("min_required_elements", 10);
+  sne.setParameters(p);
+  sne.init(raw_data.begin(), raw_data.end());
+
+  // compare against the median computed from scratch for every window
+  for (MSSpectrum::const_iterator it = raw_data.begin(); it != raw_data.end(); ++it)
+  {
+    std::vector<double> window;
+    for (MSSpectrum::const_iterator w = raw_data.begin(); w != raw_data.end(); ++w)
+    {
+      if (w->getMZ() >= it->getMZ() - win_len / 2 && w->getMZ() <= it->getMZ() + win_len / 2)
+      {
+        window.push_back(w->getIntensity());
+      }
+    }
+    double noise = 2.0;
+    if (window.size() >= 10)
+    {
+      std::sort(window.begin(), window.end());
+      noise = std::max(1.0, window[(window.size() + 1) / 2 - 1]);
+    }
+    TEST_REAL_SIMILAR(sne.getSignalToNoise(it), it->getIntensity() / noise)
+  }
+  TEST_EQUAL(sne.getSparseWindowPercent() < 20, true)
+END_SECTION
+
+START_SECTION((double getSparseWindowPercent() const))
+  MSSpectrum raw_data;
+  for (Size i = 0; i < 20; ++i)
+  {
+    Peak1D peak;
+    peak.setMZ(100.0 + i * 10.0);
+    peak.setIntensity(100.0);
+    raw_data.push_back(peak);
+  }
+  SignalToNoiseEstimatorMedianSliding< MSSpectrum > sne;
+  Param p;
+  p.setValue("win_len", 25.0); // three points per window, except at the borders
+  p.setValue("min_required_elements", 3);
+  p.setValue("noise_for_empty_window", 50.0);
+  p.setValue("write_log_messages", "false");
+  sne.setParameters(p);
+  sne.init(raw_data);
+  TEST_REAL_SIMILAR(sne.getSparseWindowPercent(), 10.0)
+  TEST_REAL_SIMILAR(sne.getSignalToNoise(raw_data[0]), 2.0)
+  TEST_REAL_SIMILAR(sne.getSignalToNoise(raw_data[10]), 1.0)
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -506,6 +506,57 @@ START_SECTION((void unify(const SpectrumSettings &rhs)))
 }
 END_SECTION
 
+START_SECTION((bool shareSettings(const SpectrumSettings& rhs)))
+  SpectrumSettings s1, s2;
+  s1.getInstrumentSettings().setPolarity(IonSource::POSITIVE);
+  s2.getInstrumentSettings().setPolarity(IonSource::POSITIVE);
+  s1.getSourceFile().setNameOfFile("run.raw");
+  s2.getAcquisitionInfo().setMethodOfCombination("sum");
+
+  TEST_EQUAL(s2.shareSettings(s1), true)
+  TEST_EQUAL(&s2.getInstrumentSettings() == &static_cast<const SpectrumSettings&>(s1).getInstrumentSettings(), true)
+  // differing blocks are kept
+  TEST_EQUAL(s2.getSourceFile().getNameOfFile(), "")
+  TEST_EQUAL(s2.getAcquisitionInfo().getMethodOfCombination(), "sum")
+
+  SpectrumSettings s3;
+  s3.getInstrumentSettings().setPolarity(IonSource::NEGATIVE);
+  s3.getAcquisitionInfo().setMethodOfCombination("mean");
+  s3.getSourceFile().setNameOfFile("other.raw");
+  TEST_EQUAL(s3.shareSettings(s1), false)
+END_SECTION
+
+START_SECTION([EXTRA] copy-on-write of shared settings)
+  SpectrumSettings s1;
+  s1.getInstrumentSettings().setPolarity(IonSource::POSITIVE);
+  s1.getAcquisitionInfo().setMethodOfCombination("sum");
+
+  SpectrumSettings s2(s1);
+  const SpectrumSettings& c1 = s1;
+  const SpectrumSettings& c2 = s2;
+  TEST_EQUAL(&c1.getAcquisitionInfo() == &c2.getAcquisitionInfo(), true)
+
+  // modifying the copy does not change the original
+  s2.getAcquisitionInfo().setMethodOfCombination("mean");
+  s2.getInstrumentSettings().setPolarity(IonSource::NEGATIVE);
+  TEST_EQUAL(c1.getAcquisitionInfo().getMethodOfCombination(), "sum")
+  TEST_EQUAL(c1.getInstrumentSettings().getPolarity(), IonSource::POSITIVE)
+  TEST_EQUAL(c2.getAcquisitionInfo().getMethodOfCombination(), "mean")
+  TEST_EQUAL(c1 == c2, false)
+
+  // default constructed settings are not changed through another spectrum
+  SpectrumSettings empty;
+  TEST_EQUAL(empty.getInstrumentSettings().getPolarity(), IonSource::POLNULL)
+  TEST_EQUAL(empty == SpectrumSettings(), true)
+
+  // a moved-from object remains usable
+  SpectrumSettings moved(std::move(s2));
+  TEST_EQUAL(moved.getAcquisitionInfo().getMethodOfCombination(), "mean")
+  TEST_EQUAL(s2.getInstrumentSettings().getPolarity(), IonSource::NEGATIVE)
+  s2 = std::move(moved);
+  TEST_EQUAL(s2.getAcquisitionInfo().getMethodOfCombination(), "mean")
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -0,0 +1,110 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+///////////////////////////
+
+#include <xercesc/util/PlatformUtils.hpp>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace OpenMS::Internal;
+using namespace std;
+
+START_TEST(StringManager, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+xercesc::XMLPlatformUtils::Initialize();
+
+StringManager* ptr = nullptr;
+StringManager* null_ptr = nullptr;
+START_SECTION(StringManager())
+{
+  ptr = new StringManager();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION(~StringManager())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((template <size_t N> static bool transcodeASCII(const char * str, XMLCh (&dest)[N])))
+{
+  XMLCh key[8];
+  TEST_EQUAL(StringManager::transcodeASCII("charge", key), true)
+  TEST_EQUAL(String(StringManager().convert(key)), "charge")
+  TEST_EQUAL(StringManager::transcodeASCII("", key), true)
+  TEST_EQUAL(key[0], 0)
+  // 7 characters and the terminating zero fit, 8 characters do not
+  TEST_EQUAL(StringManager::transcodeASCII("1234567", key), true)
+  TEST_EQUAL(StringManager::transcodeASCII("12345678", key), false)
+  TEST_EQUAL(StringManager::transcodeASCII("ch\xe4rge", key), false)
+}
+END_SECTION
+
+START_SECTION((static double toDouble(const XMLCh * str)))
+{
+  StringManager sm;
+  TEST_REAL_SIMILAR(StringManager::toDouble(sm.convert("1234.5678").c_str()), 1234.5678)
+  TEST_REAL_SIMILAR(StringManager::toDouble(sm.convert("-1.5e-3").c_str()), -1.5e-3)
+  TEST_REAL_SIMILAR(StringManager::toDouble(sm.convert(" 42 ").c_str()), 42.0)
+  TEST_REAL_SIMILAR(StringManager::toDouble(sm.convert("\t3.25\n").c_str()), 3.25)
+  TEST_EQUAL(std::isnan(StringManager::toDouble(sm.convert("nan").c_str())), true)
+  // values longer than the internal buffer take the String::toDouble() path
+  TEST_REAL_SIMILAR(StringManager::toDouble(sm.convert("0.000000000000000000000000000000000000000000000000000000000000000000000001").c_str()), 1e-72)
+  // same results as String::toDouble()
+  for (const char* s : {"0", "1.0", "-0.5", "1e10", "3.14159265358979", "722.3"})
+  {
+    TEST_EQUAL(StringManager::toDouble(sm.convert(s).c_str()), String(s).toDouble())
+  }
+  TEST_EXCEPTION(Exception::ConversionError, StringManager::toDouble(sm.convert("").c_str()))
+  TEST_EXCEPTION(Exception::ConversionError, StringManager::toDouble(sm.convert("   ").c_str()))
+  TEST_EXCEPTION(Exception::ConversionError, StringManager::toDouble(sm.convert("1.5abc").c_str()))
+  TEST_EXCEPTION(Exception::ConversionError, StringManager::toDouble(sm.convert("abc").c_str()))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -35,6 +35,8 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/TraMLFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <OpenMS/FORMAT/SqliteConnector.h>
 
 #include <boost/assign/std/vector.hpp>
 #include <boost/assign/list_of.hpp>
@@ -46,6 +48,19 @@
 using namespace OpenMS;
 using namespace std;
 
+// gives access to the TSVTransition based reader, which the direct reader has to reproduce
+class TransitionPQPFileLegacyReader :
+  public TransitionPQPFile
+{
+public:
+  void read(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp)
+  {
+    std::vector<TSVTransition> transition_list;
+    readPQPInput_(filename, transition_list);
+    TSVToTargetedExperiment_(transition_list, targeted_exp);
+  }
+};
+
 START_TEST(TransitionPQPFile, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -81,6 +96,187 @@ START_SECTION( void convertPQPToTargetedExperiment(const char * filename, OpenMS
 }
 END_SECTION
 
+START_SECTION( void convertPQPToTargetedExperiment(const char * filename, OpenSwath::LightTargetedExperiment & targeted_exp, bool legacy_traml_id = false))
+{
+  // the direct reader needs to produce the same result as the conversion from a full TargetedExperiment
+  TargetedExperiment traml;
+  TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), traml);
+  String pqp_file;
+  NEW_TMP_FILE(pqp_file)
+  TransitionPQPFile pqp;
+  pqp.convertTargetedExperimentToPQP(pqp_file.c_str(), traml);
+
+  TargetedExperiment heavy;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), heavy);
+  OpenSwath::LightTargetedExperiment expected;
+  OpenSwathDataAccessHelper::convertTargetedExp(heavy, expected);
+
+  OpenSwath::LightTargetedExperiment light;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), light);
+
+  TEST_EQUAL(light.getTransitions().size(), expected.getTransitions().size())
+  TEST_EQUAL(light.getCompounds().size(), expected.getCompounds().size())
+  TEST_EQUAL(light.getProteins().size(), expected.getProteins().size())
+
+  std::map<std::string, const OpenSwath::LightTransition*> expected_transitions;
+  for (const auto& tr : expected.getTransitions()) expected_transitions[tr.transition_name] = &tr;
+  for (const auto& tr : light.getTransitions())
+  {
+    TEST_EQUAL(expected_transitions.count(tr.transition_name), 1)
+    if (expected_transitions.count(tr.transition_name) == 0) continue;
+    const OpenSwath::LightTransition& ex = *expected_transitions[tr.transition_name];
+    TEST_EQUAL(tr.peptide_ref, ex.peptide_ref)
+    TEST_REAL_SIMILAR(tr.precursor_mz, ex.precursor_mz)
+    TEST_REAL_SIMILAR(tr.product_mz, ex.product_mz)
+    TEST_REAL_SIMILAR(tr.library_intensity, ex.library_intensity)
+    TEST_EQUAL(tr.fragment_charge, ex.fragment_charge)
+    TEST_EQUAL(tr.decoy, ex.decoy)
+    TEST_EQUAL(tr.detecting_transition, ex.detecting_transition)
+    TEST_EQUAL(tr.identifying_transition, ex.identifying_transition)
+    TEST_EQUAL(tr.quantifying_transition, ex.quantifying_transition)
+  }
+
+  std::map<std::string, const OpenSwath::LightCompound*> expected_compounds;
+  for (const auto& c : expected.getCompounds()) expected_compounds[c.id] = &c;
+  for (const auto& c : light.getCompounds())
+  {
+    TEST_EQUAL(expected_compounds.count(c.id), 1)
+    if (expected_compounds.count(c.id) == 0) continue;
+    const OpenSwath::LightCompound& ex = *expected_compounds[c.id];
+    TEST_EQUAL(c.sequence, ex.sequence)
+    TEST_EQUAL(c.charge, ex.charge)
+    TEST_REAL_SIMILAR(c.rt, ex.rt)
+    TEST_EQUAL(c.peptide_group_label, ex.peptide_group_label)
+    TEST_EQUAL(c.protein_refs.size(), ex.protein_refs.size())
+    TEST_EQUAL(c.modifications.size(), ex.modifications.size())
+  }
+}
+END_SECTION
+
+START_SECTION([EXTRA] void convertPQPToTargetedExperiment(const char * filename, OpenSwath::LightTargetedExperiment & targeted_exp, bool legacy_traml_id = false) keeps the order of the TSVTransition based reader)
+{
+  TargetedExperiment traml;
+  TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), traml);
+  String pqp_file;
+  NEW_TMP_FILE(pqp_file)
+  TransitionPQPFile pqp;
+  pqp.convertTargetedExperimentToPQP(pqp_file.c_str(), traml);
+
+  OpenSwath::LightTargetedExperiment expected;
+  TransitionPQPFileLegacyReader().read(pqp_file.c_str(), expected);
+  OpenSwath::LightTargetedExperiment light;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), light);
+
+  TEST_EQUAL(light.getTransitions().size(), expected.getTransitions().size())
+  TEST_EQUAL(light.getCompounds().size(), expected.getCompounds().size())
+  TEST_EQUAL(light.getProteins().size(), expected.getProteins().size())
+  ABORT_IF(light.getTransitions().size() != expected.getTransitions().size())
+  for (Size i = 0; i < light.getTransitions().size(); ++i)
+  {
+    const OpenSwath::LightTransition& tr = light.getTransitions()[i];
+    const OpenSwath::LightTransition& ex = expected.getTransitions()[i];
+    TEST_EQUAL(tr.transition_name, ex.transition_name)
+    TEST_EQUAL(tr.peptide_ref, ex.peptide_ref)
+    TEST_EQUAL(tr.identifying_transition, ex.identifying_transition)
+  }
+  ABORT_IF(light.getCompounds().size() != expected.getCompounds().size())
+  for (Size i = 0; i < light.getCompounds().size(); ++i)
+  {
+    TEST_EQUAL(light.getCompounds()[i].id, expected.getCompounds()[i].id)
+  }
+  ABORT_IF(light.getProteins().size() != expected.getProteins().size())
+  for (Size i = 0; i < light.getProteins().size(); ++i)
+  {
+    TEST_EQUAL(light.getProteins()[i].id, expected.getProteins()[i].id)
+  }
+}
+END_SECTION
+
+START_SECTION([EXTRA] void convertPQPToTargetedExperiment(const char * filename, OpenSwath::LightTargetedExperiment & targeted_exp, bool legacy_traml_id = false) with peptides mapping to several genes)
+{
+  TargetedExperiment traml;
+  TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), traml);
+  String pqp_file;
+  NEW_TMP_FILE(pqp_file)
+  TransitionPQPFile pqp;
+  pqp.convertTargetedExperimentToPQP(pqp_file.c_str(), traml);
+
+  OpenSwath::LightTargetedExperiment single_gene;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), single_gene);
+
+  // map every peptide to a second gene, which sorts before all others
+  {
+    SqliteConnector conn(pqp_file);
+    conn.executeStatement("INSERT INTO GENE (ID, GENE_NAME, DECOY) VALUES (1000000, 'AAA_second_gene', 0);");
+    conn.executeStatement("INSERT INTO PEPTIDE_GENE_MAPPING (PEPTIDE_ID, GENE_ID) SELECT ID, 1000000 FROM PEPTIDE;");
+  }
+
+  // each transition is still read once, the peptides get the first gene name
+  OpenSwath::LightTargetedExperiment multi_gene;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), multi_gene);
+  TEST_EQUAL(multi_gene.getTransitions().size(), single_gene.getTransitions().size())
+  TEST_EQUAL(multi_gene.getCompounds().size(), single_gene.getCompounds().size())
+  ABORT_IF(multi_gene.getTransitions().size() != single_gene.getTransitions().size())
+  for (Size i = 0; i < multi_gene.getTransitions().size(); ++i)
+  {
+    TEST_EQUAL(multi_gene.getTransitions()[i].transition_name, single_gene.getTransitions()[i].transition_name)
+  }
+  for (const auto& c : multi_gene.getCompounds())
+  {
+    if (!c.sequence.empty())
+    {
+      TEST_EQUAL(c.gene_name, "AAA_second_gene")
+    }
+  }
+}
+END_SECTION
+
+START_SECTION( void convertPQPToTargetedExperiment(const char * filename, OpenSwath::LightTargetedExperiment & targeted_exp, const std::vector<std::pair<double, double> >& precursor_windows, bool legacy_traml_id = false))
+{
+  TargetedExperiment traml;
+  TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), traml);
+  String pqp_file;
+  NEW_TMP_FILE(pqp_file)
+  TransitionPQPFile pqp;
+  pqp.convertTargetedExperimentToPQP(pqp_file.c_str(), traml);
+
+  OpenSwath::LightTargetedExperiment all;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), all);
+  TEST_EQUAL(all.getTransitions().empty(), false)
+
+  // window around the precursor of the first transition only
+  double mz = all.getTransitions()[0].precursor_mz;
+  std::vector<std::pair<double, double> > windows(1, std::make_pair(mz - 0.5, mz + 0.5));
+  Size expected_transitions = 0;
+  std::set<std::string> expected_compounds;
+  for (const auto& tr : all.getTransitions())
+  {
+    if (windows[0].first < tr.precursor_mz && tr.precursor_mz < windows[0].second)
+    {
+      ++expected_transitions;
+      expected_compounds.insert(tr.peptide_ref);
+    }
+  }
+
+  OpenSwath::LightTargetedExperiment filtered;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), filtered, windows);
+  TEST_EQUAL(filtered.getTransitions().size(), expected_transitions)
+  TEST_EQUAL(filtered.getCompounds().size(), expected_compounds.size())
+  for (const auto& tr : filtered.getTransitions())
+  {
+    TEST_EQUAL(windows[0].first < tr.precursor_mz && tr.precursor_mz < windows[0].second, true)
+  }
+
+  // no window contains any precursor
+  OpenSwath::LightTargetedExperiment empty;
+  windows[0] = std::make_pair(0.0, 1.0);
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), empty, windows);
+  TEST_EQUAL(empty.getTransitions().size(), 0)
+  TEST_EQUAL(empty.getCompounds().size(), 0)
+  TEST_EQUAL(empty.getProteins().size(), 0)
+}
+END_SECTION
+
 START_SECTION( void validateTargetedExperiment(OpenMS::TargetedExperiment & targeted_exp))
 {
   NOT_TESTABLE
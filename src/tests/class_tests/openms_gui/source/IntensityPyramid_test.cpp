@@ -0,0 +1,292 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/IntensityPyramid.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <fstream>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IntensityPyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// 4 MS1 scans (RT 10-40) with peaks at m/z 100, 200, 300, 500: intensity of peak j in scan i is 10 * i + j + 1
+// the MS2 scan must be ignored
+PeakMap exp;
+double mzs[] = {100.0, 200.0, 300.0, 500.0};
+for (Size i = 0; i < 4; ++i)
+{
+  MSSpectrum spec;
+  spec.setRT(10.0 * (i + 1));
+  spec.setMSLevel(1);
+  for (Size j = 0; j < 4; ++j)
+  {
+    Peak1D p;
+    p.setMZ(mzs[j]);
+    p.setIntensity(10.0 * i + j + 1);
+    spec.push_back(p);
+  }
+  exp.addSpectrum(spec);
+  if (i == 1)
+  {
+    MSSpectrum ms2;
+    ms2.setRT(25.0);
+    ms2.setMSLevel(2);
+    Peak1D p;
+    p.setMZ(300.0);
+    p.setIntensity(1000.0);
+    ms2.push_back(p);
+    exp.addSpectrum(ms2);
+  }
+}
+
+IntensityPyramid* ptr = nullptr;
+IntensityPyramid* null_ptr = nullptr;
+START_SECTION((IntensityPyramid()))
+  ptr = new IntensityPyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getLevelCount(), 0)
+END_SECTION
+
+START_SECTION((~IntensityPyramid()))
+  delete ptr;
+END_SECTION
+
+START_SECTION((void build(const PeakMap& exp, Size rt_bins = 1024, Size mz_bins = 4096)))
+  IntensityPyramid pyramid;
+  pyramid.build(exp, 4, 4);
+  TEST_EQUAL(pyramid.empty(), false)
+  TEST_EQUAL(pyramid.getLevelCount(), 3)
+  TEST_EQUAL(pyramid.getRTBins(0), 4)
+  TEST_EQUAL(pyramid.getMZBins(0), 4)
+  TEST_EQUAL(pyramid.getRTBins(1), 2)
+  TEST_EQUAL(pyramid.getMZBins(1), 2)
+  TEST_EQUAL(pyramid.getRTBins(2), 1)
+  TEST_EQUAL(pyramid.getMZBins(2), 1)
+  TEST_REAL_SIMILAR(pyramid.getRTMin(), 10.0)
+  TEST_REAL_SIMILAR(pyramid.getMZMin(), 100.0)
+  TEST_REAL_SIMILAR(pyramid.getRTBinWidth(), 7.5)
+  TEST_REAL_SIMILAR(pyramid.getMZBinWidth(), 100.0)
+  for (Size i = 0; i < 4; ++i)
+  {
+    for (Size j = 0; j < 4; ++j)
+    {
+      TEST_REAL_SIMILAR(pyramid.getValue(0, i, j), 10.0 * i + j + 1)
+    }
+  }
+  TEST_REAL_SIMILAR(pyramid.getValue(1, 0, 0), 12.0)
+  TEST_REAL_SIMILAR(pyramid.getValue(1, 0, 1), 14.0)
+  TEST_REAL_SIMILAR(pyramid.getValue(1, 1, 0), 32.0)
+  TEST_REAL_SIMILAR(pyramid.getValue(1, 1, 1), 34.0)
+  TEST_REAL_SIMILAR(pyramid.getValue(2, 0, 0), 34.0)
+
+  // fewer MS1 scans than requested rows
+  pyramid.build(exp, 100, 3);
+  TEST_EQUAL(pyramid.getRTBins(0), 4)
+  TEST_EQUAL(pyramid.getMZBins(0), 3)
+  TEST_EQUAL(pyramid.getLevelCount(), 3)
+
+  // no MS1 peaks
+  pyramid.build(PeakMap());
+  TEST_EQUAL(pyramid.empty(), true)
+END_SECTION
+
+START_SECTION((void clear()))
+  IntensityPyramid pyramid;
+  pyramid.build(exp, 4, 4);
+  pyramid.clear();
+  TEST_EQUAL(pyramid.empty(), true)
+  TEST_EQUAL(pyramid.getLevelCount(), 0)
+END_SECTION
+
+START_SECTION((bool empty() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getLevelCount() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getRTBins(Size level) const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getMZBins(Size level) const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((float getValue(Size level, Size rt_bin, Size mz_bin) const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((double getRTMin() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((double getMZMin() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((double getRTBinWidth() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((double getMZBinWidth() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((bool fillPixels(double rt_min, double rt_max, double mz_min, double mz_max, Size rt_pixel_count, Size mz_pixel_count, std::vector<float>& pixels) const))
+  IntensityPyramid pyramid;
+  vector<float> pixels;
+  TEST_EQUAL(pyramid.fillPixels(10.0, 40.0, 100.0, 500.0, 4, 4, pixels), false)
+
+  pyramid.build(exp, 4, 4);
+  // one cell per pixel: level 0
+  TEST_EQUAL(pyramid.fillPixels(10.0, 40.0, 100.0, 500.0, 4, 4, pixels), true)
+  TEST_EQUAL(pixels.size(), 16)
+  for (Size i = 0; i < 4; ++i)
+  {
+    for (Size j = 0; j < 4; ++j)
+    {
+      TEST_REAL_SIMILAR(pixels[i * 4 + j], 10.0 * i + j + 1)
+    }
+  }
+  // 2x2 cells per pixel: level 1
+  TEST_EQUAL(pyramid.fillPixels(10.0, 40.0, 100.0, 500.0, 2, 2, pixels), true)
+  TEST_EQUAL(pixels.size(), 4)
+  TEST_REAL_SIMILAR(pixels[0], 12.0)
+  TEST_REAL_SIMILAR(pixels[1], 14.0)
+  TEST_REAL_SIMILAR(pixels[2], 32.0)
+  TEST_REAL_SIMILAR(pixels[3], 34.0)
+  // anisotropic: 1 RT pixel, 4 m/z pixels
+  TEST_EQUAL(pyramid.fillPixels(10.0, 40.0, 100.0, 500.0, 1, 4, pixels), true)
+  TEST_REAL_SIMILAR(pixels[0], 31.0)
+  TEST_REAL_SIMILAR(pixels[1], 32.0)
+  TEST_REAL_SIMILAR(pixels[2], 33.0)
+  TEST_REAL_SIMILAR(pixels[3], 34.0)
+  // sub-area: only the last two scans and the first two m/z cells
+  TEST_EQUAL(pyramid.fillPixels(25.0, 40.0, 100.0, 300.0, 2, 2, pixels), true)
+  TEST_REAL_SIMILAR(pixels[0], 21.0)
+  TEST_REAL_SIMILAR(pixels[1], 22.0)
+  TEST_REAL_SIMILAR(pixels[2], 31.0)
+  TEST_REAL_SIMILAR(pixels[3], 32.0)
+  // outside of the data
+  TEST_EQUAL(pyramid.fillPixels(100.0, 200.0, 100.0, 500.0, 1, 1, pixels), true)
+  TEST_REAL_SIMILAR(pixels[0], -1.0)
+  // zoomed in beyond level 0
+  pixels.clear();
+  TEST_EQUAL(pyramid.fillPixels(10.0, 40.0, 100.0, 500.0, 8, 8, pixels), false)
+  TEST_EQUAL(pixels.size(), 0)
+END_SECTION
+
+START_SECTION((bool matches(const PeakMap& exp) const))
+  IntensityPyramid pyramid;
+  pyramid.build(exp, 4, 4);
+  TEST_EQUAL(pyramid.matches(exp), true)
+  PeakMap exp2 = exp;
+  exp2[0][0].setMZ(99.0);
+  TEST_EQUAL(pyramid.matches(exp2), false)
+  exp2 = exp;
+  exp2[1].push_back(Peak1D());
+  TEST_EQUAL(pyramid.matches(exp2), false)
+END_SECTION
+
+START_SECTION((void store(const String& filename) const))
+  NOT_TESTABLE // tested with load
+END_SECTION
+
+START_SECTION((void load(const String& filename)))
+  IntensityPyramid pyramid, loaded;
+  pyramid.build(exp, 4, 4);
+  String filename;
+  NEW_TMP_FILE(filename)
+  pyramid.store(filename);
+  loaded.load(filename);
+  TEST_EQUAL(loaded.matches(exp), true)
+  TEST_EQUAL(loaded.getLevelCount(), pyramid.getLevelCount())
+  TEST_REAL_SIMILAR(loaded.getRTBinWidth(), pyramid.getRTBinWidth())
+  TEST_REAL_SIMILAR(loaded.getMZBinWidth(), pyramid.getMZBinWidth())
+  for (Size l = 0; l < pyramid.getLevelCount(); ++l)
+  {
+    TEST_EQUAL(loaded.getRTBins(l), pyramid.getRTBins(l))
+    TEST_EQUAL(loaded.getMZBins(l), pyramid.getMZBins(l))
+    for (Size i = 0; i < pyramid.getRTBins(l); ++i)
+    {
+      for (Size j = 0; j < pyramid.getMZBins(l); ++j)
+      {
+        TEST_EQUAL(loaded.getValue(l, i, j), pyramid.getValue(l, i, j))
+      }
+    }
+  }
+
+  TEST_EXCEPTION(Exception::FileNotFound, loaded.load("this_file_does_not_exist.lod"))
+
+  // not a pyramid file
+  String garbage;
+  NEW_TMP_FILE(garbage)
+  {
+    ofstream ofs(garbage.c_str());
+    ofs << "no intensity pyramid";
+  }
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(garbage))
+
+  // truncated file
+  {
+    ifstream ifs(filename.c_str(), ios::binary);
+    string content((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    ofstream ofs(garbage.c_str(), ios::binary);
+    ofs.write(content.data(), content.size() - 8);
+  }
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(garbage))
+  // a failed load leaves the pyramid untouched
+  TEST_EQUAL(loaded.matches(exp), true)
+END_SECTION
+
+START_SECTION((static String getSidecarFilename(const String& data_filename)))
+  TEST_EQUAL(IntensityPyramid::getSidecarFilename("data/run1.mzML"), "data/run1.mzML.lod")
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -34,7 +34,7 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FILTERING/BASELINE/MorphologicalFilter.h>
-#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/APPLICATIONS/PeakMapProcessingBase.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -88,11 +88,11 @@ using namespace std;
 /// @cond TOPPCLASSES
 
 class TOPPBaselineFilter :
-  public TOPPBase
+  public TOPPPeakMapProcessingBase
 {
 public:
   TOPPBaselineFilter() :
-    TOPPBase("BaselineFilter", "Removes the baseline from profile spectra using a top-hat filter.")
+    TOPPPeakMapProcessingBase("BaselineFilter", "Removes the baseline from profile spectra using a top-hat filter.")
   {
   }
 
@@ -108,6 +108,8 @@ protected:
     setValidStrings_("struc_elem_unit", ListUtils::create<String>("Thomson,DataPoints"));
     registerStringOption_("method", "<string>", "tophat", "The name of the morphological filter to be applied. If you are unsure, use the default.", false);
     setValidStrings_("method", ListUtils::create<String>("identity,erosion,dilation,opening,closing,gradient,tophat,bothat,erosion_simple,dilation_simple"));
+
+    registerProcessOption_();
   }
 
   ExitCodes main_(int, const char **) override
@@ -118,6 +120,31 @@ protected:
     String in = getStringOption_("in");
     String out = getStringOption_("out");
 
+    MorphologicalFilter morph_filter;
+    morph_filter.setLogType(log_type_);
+
+    Param parameters;
+    parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
+    parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
+    parameters.setValue("method", getStringOption_("method"));
+
+    morph_filter.setParameters(parameters);
+
+    if (isLowMemory_())
+    {
+      // spectra are filtered in parallel blocks; MorphologicalFilter cannot be
+      // copied and keeps internal buffers, so each call sets up its own filter
+      ParallelExperimentProcessor processor;
+      processor.setSpectraProcessingFunc([parameters](MSSpectrum& s)
+      {
+        MorphologicalFilter filter;
+        filter.setParameters(parameters);
+        filter.filter(s);
+      });
+      return processLowMemory_(in, out, processor, DataProcessing::BASELINE_REDUCTION,
+                               CHECK_PROFILE | CHECK_SORTED_SPECTRA);
+    }
+
     //-------------------------------------------------------------
     // loading input
     //-------------------------------------------------------------
@@ -133,34 +160,15 @@ protected:
                   " contain chromatograms. This tool currently cannot handle them, sorry.";
       return INCOMPATIBLE_INPUT_DATA;
     }
-    // check for peak type (raw data required)
-    if (ms_exp[0].getType(true) == SpectrumSettings::CENTROID)
+    ExitCodes check = checkInput_(ms_exp, CHECK_PROFILE | CHECK_SORTED_SPECTRA);
+    if (check != EXECUTION_OK)
     {
-      writeLog_("Warning: OpenMS peak type estimation indicates that this is not raw data!");
-    }
-
-    //check if spectra are sorted
-    for (Size i = 0; i < ms_exp.size(); ++i)
-    {
-      if (!ms_exp[i].isSorted())
-      {
-        writeLog_("Error: Not all spectra are sorted according to peak m/z positions. Use FileFilter to sort the input!");
-        return INCOMPATIBLE_INPUT_DATA;
-      }
+      return check;
     }
 
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    MorphologicalFilter morph_filter;
-    morph_filter.setLogType(log_type_);
-
-    Param parameters;
-    parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
-    parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
-    parameters.setValue("method", getStringOption_("method"));
-
-    morph_filter.setParameters(parameters);
     morph_filter.filterExperiment(ms_exp);
 
     //-------------------------------------------------------------
@@ -81,6 +81,15 @@ using namespace std;
 </PARAMETERS>
   \endcode
 
+  <B> Scheduling </B>
+
+  Tools are started as soon as their input is available and their resource needs fit into the budget given by
+  @p num_jobs (CPU threads) and @p memory (MB). A tool occupies as many CPU threads as its own 'threads' parameter.
+  Its memory need can be declared per tool node in the <TT>*.toppas</TT> file (<TT>vertices:&lt;id&gt;:memory</TT>, in MB).
+  When several tools are ready, the one on the longest remaining path of the workflow is started first.
+
+  A timing trace of all tool runs (queue time, run time, exit status) is written to <TT>TOPPAS_timing.tsv</TT> in the output directory.
+
     <B>The command line parameters of this tool are:</B>
     @verbinclude TOPP_ExecutePipeline.cli
     <B>INI file documentation of this tool:</B>
@@ -108,8 +117,10 @@ protected:
     setValidFormats_("in", ListUtils::create<String>("toppas"));
     registerStringOption_("out_dir", "<directory>", "", "Directory for output files (default: user's home directory)", false);
     registerStringOption_("resource_file", "<file>", "", "A TOPPAS resource file (*.trf) specifying the files this workflow is to be applied to", false);
-    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of jobs running in parallel", false, false);
+    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of CPU threads used by tools running in parallel (a tool occupies as many as its 'threads' parameter)", false, false);
     setMinInt_("num_jobs", 1);
+    registerIntOption_("memory", "<MB>", 0, "Memory budget for tools running in parallel, based on the memory declared for each tool node (0 = unlimited)", false, true);
+    setMinInt_("memory", 0);
   }
 
   ExitCodes main_(int argc, const char ** argv) override
@@ -118,6 +129,7 @@ protected:
     QString out_dir_name = getStringOption_("out_dir").toQString();
     QString resource_file = getStringOption_("resource_file").toQString();
     int num_jobs = getIntOption_("num_jobs");
+    int memory = getIntOption_("memory");
 
     QApplication a(argc, const_cast<char **>(argv), false);
 
@@ -137,6 +149,7 @@ protected:
 
     ts.load(toppas_file);
     ts.setAllowedThreads(num_jobs);
+    ts.setMemoryBudget(memory);
 
     if (resource_file != "")
     {
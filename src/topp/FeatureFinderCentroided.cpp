@@ -33,7 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/MzMLFile.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/RangeUtils.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinder.h>
@@ -149,9 +149,9 @@ protected:
     registerInputFile_("in", "<file>", "", "input file");
     setValidFormats_("in", ListUtils::create<String>("mzML"));
     registerOutputFile_("out", "<file>", "", "output file");
-    setValidFormats_("out", ListUtils::create<String>("featureXML"));
+    setValidFormats_("out", ListUtils::create<String>("featureXML,omsBin"));
     registerInputFile_("seeds", "<file>", "", "User specified seed list", false);
-    setValidFormats_("seeds", ListUtils::create<String>("featureXML"));
+    setValidFormats_("seeds", ListUtils::create<String>("featureXML,omsBin"));
 
     registerOutputFile_("out_mzq", "<file>", "", "Optional output file of MzQuantML.", false, true);
     setValidFormats_("out_mzq", ListUtils::create<String>("mzq"));
@@ -206,7 +206,7 @@ protected:
     FeatureMap seeds;
     if (getStringOption_("seeds") != "")
     {
-      FeatureXMLFile().load(getStringOption_("seeds"), seeds);
+      FileHandler().loadFeatures(getStringOption_("seeds"), seeds);
     }
 
     //setup of FeatureFinder
@@ -261,8 +261,6 @@ protected:
     addDataProcessing_(features, getProcessingInfo_(DataProcessing::QUANTITATION));
 
     // write features to user specified output file
-    FeatureXMLFile map_file;
-
     // Remove detailed convex hull information and subordinate features
     // (unless requested otherwise) to reduce file size of feature files
     // unless debugging is turned on.
@@ -280,7 +278,7 @@ protected:
       }
     }
 
-    map_file.store(out, features);
+    FileHandler().storeFeatures(out, features, log_type_);
 
     if (!out_mzq.trim().empty())
     {
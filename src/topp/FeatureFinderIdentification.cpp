@@ -39,8 +39,7 @@
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderIdentificationAlgorithm.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
-#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/TraMLFile.h>
 #include <OpenMS/FORMAT/TransformationXMLFile.h>
@@ -180,19 +179,19 @@ protected:
     registerInputFile_("in", "<file>", "", "Input file: LC-MS raw data");
     setValidFormats_("in", ListUtils::create<String>("mzML"));
     registerInputFile_("id", "<file>", "", "Input file: Peptide identifications derived directly from 'in'");
-    setValidFormats_("id", ListUtils::create<String>("idXML"));
+    setValidFormats_("id", ListUtils::create<String>("idXML,omsBin"));
     registerInputFile_("id_ext", "<file>", "", "Input file: 'External' peptide identifications (e.g. from aligned runs)", false);
-    setValidFormats_("id_ext", ListUtils::create<String>("idXML"));
+    setValidFormats_("id_ext", ListUtils::create<String>("idXML,omsBin"));
     registerOutputFile_("out", "<file>", "", "Output file: Features");
-    setValidFormats_("out", ListUtils::create<String>("featureXML"));
+    setValidFormats_("out", ListUtils::create<String>("featureXML,omsBin"));
     registerOutputFile_("lib_out", "<file>", "", "Output file: Assay library", false);
     setValidFormats_("lib_out", ListUtils::create<String>("traML"));
     registerOutputFile_("chrom_out", "<file>", "", "Output file: Chromatograms", false);
     setValidFormats_("chrom_out", ListUtils::create<String>("mzML"));
     registerOutputFile_("candidates_out", "<file>", "", "Output file: Feature candidates (before filtering and model fitting)", false);
-    setValidFormats_("candidates_out", ListUtils::create<String>("featureXML"));
+    setValidFormats_("candidates_out", ListUtils::create<String>("featureXML,omsBin"));
     registerInputFile_("candidates_in", "<file>", "", "Input file: Feature candidates from a previous run. If set, only feature classification and elution model fitting are carried out, if enabled. Many parameters are ignored.", false, true);
-    setValidFormats_("candidates_in", ListUtils::create<String>("featureXML"));
+    setValidFormats_("candidates_in", ListUtils::create<String>("featureXML,omsBin"));
 
     Param algo_with_subsection;
     Param subsection = FeatureFinderIdentificationAlgorithm().getDefaults();
@@ -241,12 +240,12 @@ protected:
       vector<ProteinIdentification> proteins, proteins_ext;
 
       // "internal" IDs:
-      IdXMLFile().load(id, proteins, peptides);
+      FileHandler().loadIdentifications(id, proteins, peptides);
 
       // "external" IDs:
       if (!id_ext.empty())
       {
-        IdXMLFile().load(id_ext, proteins_ext, peptides_ext);
+        FileHandler().loadIdentifications(id_ext, proteins_ext, peptides_ext);
       }
 
       //-------------------------------------------------------------
@@ -283,7 +282,7 @@ protected:
       // load feature candidates
       //-------------------------------------------------------------
       OPENMS_LOG_INFO << "Reading feature candidates from a previous run..." << endl;
-      FeatureXMLFile().load(candidates_in, features);
+      FileHandler().loadFeatures(candidates_in, features);
       OPENMS_LOG_INFO << "Found " << features.size() << " feature candidates in total."
                << endl;
       ffid_algo.runOnCandidates(features);
@@ -294,7 +293,7 @@ protected:
     //-------------------------------------------------------------
 
     OPENMS_LOG_INFO << "Writing final results..." << endl;
-    FeatureXMLFile().store(out, features);
+    FileHandler().storeFeatures(out, features, log_type_);
 
 
     return EXECUTION_OK;
@@ -32,7 +32,7 @@
 // $Authors: Erhan Kenar, Holger Franken $
 // --------------------------------------------------------------------------
 #include <OpenMS/FORMAT/MzMLFile.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/MassTrace.h>
@@ -121,7 +121,7 @@ protected:
     registerInputFile_("in", "<file>", "", "Centroided mzML file");
     setValidFormats_("in", ListUtils::create<String>("mzML"));
     registerOutputFile_("out", "<file>", "", "FeatureXML file with metabolite features");
-    setValidFormats_("out", ListUtils::create<String>("featureXML"));
+    setValidFormats_("out", ListUtils::create<String>("featureXML,omsBin"));
 
     registerOutputFile_("out_chrom", "<file>", "", "Optional mzML file with chromatograms", false);
     setValidFormats_("out_chrom", ListUtils::create<String>("mzML"));
@@ -379,9 +379,7 @@ protected:
       feat_map.setPrimaryMSRunPath({in}, ms_peakmap);
     }    
 
-    FeatureXMLFile feature_xml_file;
-    feature_xml_file.setLogType(log_type_);
-    feature_xml_file.store(out, feat_map);
+    FileHandler().storeFeatures(out, feat_map, log_type_);
   
     return EXECUTION_OK;
   }
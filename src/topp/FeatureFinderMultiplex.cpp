@@ -42,7 +42,6 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/MATH/STATISTICS/LinearRegression.h>
 #include <OpenMS/KERNEL/RangeUtils.h>
 #include <OpenMS/KERNEL/ChromatogramTools.h>
@@ -51,8 +50,7 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/MATH/STATISTICS/LinearRegression.h>
 
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
-#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/MzQuantMLFile.h>
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexDeltaMasses.h>
@@ -150,9 +148,9 @@ public:
     registerInputFile_("in", "<file>", "", "LC-MS dataset in either centroid or profile mode");
     setValidFormats_("in", ListUtils::create<String>("mzML"));
     registerOutputFile_("out", "<file>", "", "Output file containing the individual peptide features.", false);
-    setValidFormats_("out", ListUtils::create<String>("featureXML"));
+    setValidFormats_("out", ListUtils::create<String>("featureXML,omsBin"));
     registerOutputFile_("out_multiplets", "<file>", "", "Optional output file containing all detected peptide groups (i.e. peptide pairs or triplets or singlets or ..). The m/z-RT positions correspond to the lightest peptide in each group.", false, true);
-    setValidFormats_("out_multiplets", ListUtils::create<String>("consensusXML"));
+    setValidFormats_("out_multiplets", ListUtils::create<String>("consensusXML,omsBin"));
     registerOutputFile_("out_blacklist", "<file>", "", "Optional output file containing all peaks which have been associated with a peptide feature (and subsequently blacklisted).", false, true);
     setValidFormats_("out_blacklist", ListUtils::create<String>("mzML"));
     
@@ -172,31 +170,29 @@ public:
   }
   
   /**
-   * @brief Write feature map to featureXML file.
+   * @brief Write feature map to featureXML or omsBin file.
    *
-   * @param filename    name of featureXML file
+   * @param filename    name of featureXML or omsBin file
    * @param map    feature map for output
    */
   void writeFeatureMap_(const String& filename, FeatureMap& map) const
   {    
-    FeatureXMLFile file;
-    file.store(filename, map);
+    FileHandler().storeFeatures(filename, map, log_type_);
   }
   
   /**
-   * @brief Write consensus map to consensusXML file.
+   * @brief Write consensus map to consensusXML or omsBin file.
    *
-   * @param filename    name of consensusXML file
+   * @param filename    name of consensusXML or omsBin file
    * @param map    consensus map for output
    */
   void writeConsensusMap_(const String& filename, ConsensusMap& map) const
   {     
-    ConsensusXMLFile file;
     for (auto & ch : map.getColumnHeaders())
     {
       ch.second.filename = getStringOption_("in");
     }
-    file.store(filename, map);
+    FileHandler().storeConsensusFeatures(filename, map, log_type_);
   }
   
   /**
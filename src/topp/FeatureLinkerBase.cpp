@@ -80,9 +80,9 @@ protected:
   void registerOptionsAndFlags_() override   // only for "unlabeled" algorithms!
   {
     registerInputFileList_("in", "<files>", ListUtils::create<String>(""), "input files separated by blanks", true);
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,omsBin"));
     registerOutputFile_("out", "<file>", "", "Output file", true);
-    setValidFormats_("out", ListUtils::create<String>("consensusXML"));
+    setValidFormats_("out", ListUtils::create<String>("consensusXML,omsBin"));
     registerInputFile_("design", "<file>", "", "input file containing the experimental design", false);
     setValidFormats_("design", ListUtils::create<String>("tsv"));
     addEmptyLine_();
@@ -109,11 +109,11 @@ protected:
     //-------------------------------------------------------------
     // check for valid input
     //-------------------------------------------------------------
-    // check if all input files have the correct type
-    FileTypes::Type file_type = FileHandler::getType(ins[0]);
+    // check if all input files have the correct type (omsBin files count as the XML type of their content)
+    FileTypes::Type file_type = FileHandler::getXMLEquivalentType(ins[0]);
     for (Size i = 0; i < ins.size(); ++i)
     {
-      if (FileHandler::getType(ins[i]) != file_type)
+      if (FileHandler::getXMLEquivalentType(ins[i]) != file_type)
       {
         writeLog_("Error: All input files must be of the same type!");
         return ILLEGAL_PARAMETERS;
@@ -185,13 +185,13 @@ protected:
       }
 
       vector<FeatureMap > maps(ins.size());
-      FeatureXMLFile f;
-      FeatureFileOptions param = f.getOptions();
+      FileHandler f;
+      FeatureFileOptions param = f.getFeatOptions();
 
       // to save memory don't load convex hulls and subordinates
       param.setLoadSubordinates(false);
       param.setLoadConvexHull(false);
-      f.setOptions(param);
+      f.setFeatOptions(param);
 
       Size progress = 0;
       setLogType(ProgressLogger::CMD);
@@ -199,7 +199,7 @@ protected:
       for (Size i = 0; i < ins.size(); ++i)
       {
         FeatureMap tmp;
-        f.load(ins[i], tmp);
+        f.loadFeatures(ins[i], tmp);
 
         StringList ms_runs;
         tmp.getPrimaryMSRunPath(ms_runs);
@@ -283,10 +283,10 @@ protected:
     else
     {
       vector<ConsensusMap> maps(ins.size());
-      ConsensusXMLFile f;
+      FileHandler f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        f.load(ins[i], maps[i]);
+        f.loadConsensusFeatures(ins[i], maps[i]);
         maps[i].updateRanges();
         // copy over information on the primary MS run
         StringList ms_runs;
@@ -327,7 +327,7 @@ protected:
     out_map.sortPeptideIdentificationsByMapIndex();
 
     // write output
-    ConsensusXMLFile().store(out, out_map);
+    FileHandler().storeConsensusFeatures(out, out_map);
 
     // some statistics
     map<Size, UInt> num_consfeat_of_size;
@@ -39,6 +39,7 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/OMSBinFile.h>
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/MzDataFile.h>
@@ -123,6 +124,10 @@ using namespace std;
   @ref OpenMS::SpecArrayFile "peplist"
   @ref OpenMS::KroenikFile "kroenik"
   @ref OpenMS::EDTAFile "edta"
+  @ref OpenMS::OMSBinFile "omsBin"
+
+  Binary omsBin files can hold feature maps or consensus maps (and identifications, which are not
+  handled by this tool). As output type, omsBin stores the same kind of map as the input file contains.
 
   @note See @ref TOPP_IDFileConverter for similar functionality for protein/peptide identification file formats.
 
@@ -328,7 +333,7 @@ protected:
   {
     registerInputFile_("in", "<file>", "", "Input file to convert.");
     registerStringOption_("in_type", "<type>", "", "Input file type -- default: determined from file extension or content\n", false, true); // for TOPPAS
-    String formats("mzML,mzXML,mgf,raw,cachedMzML,mzData,dta,dta2d,featureXML,consensusXML,ms2,fid,tsv,peplist,kroenik,edta");
+    String formats("mzML,mzXML,mgf,raw,cachedMzML,mzData,dta,dta2d,featureXML,consensusXML,ms2,fid,tsv,peplist,kroenik,edta,omsBin");
     setValidFormats_("in", ListUtils::create<String>(formats));
     setValidStrings_("in_type", ListUtils::create<String>(formats));
     
@@ -336,7 +341,7 @@ protected:
     String method("none,ensure,reassign");
     setValidStrings_("UID_postprocessing", ListUtils::create<String>(method));
 
-    formats = "mzData,mzXML,mzML,cachedMzML,dta2d,mgf,featureXML,consensusXML,edta,csv";
+    formats = "mzData,mzXML,mzML,cachedMzML,dta2d,mgf,featureXML,consensusXML,edta,csv,omsBin";
     registerOutputFile_("out", "<file>", "", "Output file");
     setValidFormats_("out", ListUtils::create<String>(formats));
     registerStringOption_("out_type", "<type>", "", "Output file type -- default: determined from file extension or content\nNote: that not all conversion paths work or make sense.", false, true);
@@ -527,6 +532,44 @@ protected:
         exp.set2DData<true>(fm);
       }
     }
+    else if (in_type == FileTypes::OMSBIN)
+    {
+      // from here on, treat the input like its XML counterpart
+      OMSBinFile::ContentType content = OMSBinFile::getContentType(in);
+      if (content == OMSBinFile::FEATURES)
+      {
+        OMSBinFile().load(in, fm);
+        fm.sortByPosition();
+        in_type = FileTypes::FEATUREXML;
+      }
+      else if (content == OMSBinFile::CONSENSUS)
+      {
+        OMSBinFile().load(in, cm);
+        cm.sortByPosition();
+        in_type = FileTypes::CONSENSUSXML;
+      }
+      else
+      {
+        OPENMS_LOG_ERROR << "Incompatible input data: the omsBin file contains identifications. Use IDFileConverter or FileHandler::loadIdentifications() for those.";
+        return INCOMPATIBLE_INPUT_DATA;
+      }
+      if ((out_type != FileTypes::FEATUREXML) &&
+          (out_type != FileTypes::CONSENSUSXML) &&
+          (out_type != FileTypes::OMSBIN))
+      {
+        // You will lose information and waste memory. Enough reasons to issue a warning!
+        if (in_type == FileTypes::FEATUREXML)
+        {
+          writeLog_("Warning: Converting features to peaks. You will lose information!");
+          exp.set2DData<true>(fm);
+        }
+        else
+        {
+          writeLog_("Warning: Converting consensus features to peaks. You will lose information!");
+          exp.set2DData(cm);
+        }
+      }
+    }
     else if (in_type == FileTypes::CACHEDMZML)
     {
       // Determine location of meta information (empty mzML)
@@ -888,6 +931,33 @@ protected:
       IBSpectraFile ibfile;
       ibfile.store(out, cm);
     }
+    else if (out_type == FileTypes::OMSBIN)
+    {
+      if ((in_type == FileTypes::FEATUREXML) || (in_type == FileTypes::TSV) ||
+          (in_type == FileTypes::PEPLIST) || (in_type == FileTypes::KROENIK))
+      {
+        if (uid_postprocessing == "ensure")
+        {
+          fm.applyMemberFunction(&UniqueIdInterface::ensureUniqueId);
+        }
+        else if (uid_postprocessing == "reassign")
+        {
+          fm.applyMemberFunction(&UniqueIdInterface::setUniqueId);
+        }
+        addDataProcessing_(fm, getProcessingInfo_(DataProcessing::FORMAT_CONVERSION));
+        OMSBinFile().store(out, fm);
+      }
+      else if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::EDTA)
+      {
+        addDataProcessing_(cm, getProcessingInfo_(DataProcessing::FORMAT_CONVERSION));
+        OMSBinFile().store(out, cm);
+      }
+      else
+      {
+        OPENMS_LOG_ERROR << "Incompatible input data: FileConverter can only convert feature and consensus maps to omsBin format.";
+        return INCOMPATIBLE_INPUT_DATA;
+      }
+    }
     else
     {
       writeLog_("Unknown output file type given. Aborting!");
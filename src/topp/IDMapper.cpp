@@ -34,10 +34,7 @@
 
 #include <OpenMS/config.h>
 
-#include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/MzIdentMLFile.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
-#include <OpenMS/FORMAT/ConsensusXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
@@ -94,6 +91,9 @@ using namespace std;
     Peptide positions are always matched against centroid positions. By default, the consensus centroids are used. However, if @p consensus:use_subelements is set, the centroids of sub-features are considered instead.
     In this case, a peptide identification is mapped to a consensus feature if any of its sub-features matches.
 
+    Feature maps, consensus maps and identifications can also be given as binary omsBin files (see @ref OpenMS::OMSBinFile), which are
+    read and written much faster. The format of the output file is determined by its extension.
+
     @note Currently mzIdentML (mzid) is not directly supported as an input/output format of this tool. Convert mzid files to/from idXML using @ref TOPP_IDFileConverter if necessary.
 
     <B>The command line parameters of this tool are:</B>
@@ -133,11 +133,11 @@ protected:
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("id", "<file>", "", "Protein/peptide identifications file");
-    setValidFormats_("id", ListUtils::create<String>("mzid,idXML"));
+    setValidFormats_("id", ListUtils::create<String>("mzid,idXML,omsBin"));
     registerInputFile_("in", "<file>", "", "Feature map/consensus map file");
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,mzq"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,mzq,omsBin"));
     registerOutputFile_("out", "<file>", "", "Output file (the format depends on the input file format).");
-    setValidFormats_("out", ListUtils::create<String>("featureXML,consensusXML,mzq"));
+    setValidFormats_("out", ListUtils::create<String>("featureXML,consensusXML,mzq,omsBin"));
 
     addEmptyLine_();
     IDMapper mapper;
@@ -180,10 +180,10 @@ protected:
     String id = getStringOption_("id");
     vector<ProteinIdentification> protein_ids;
     vector<PeptideIdentification> peptide_ids;
-    FileTypes::Type in_type = FileHandler::getType(id);
-    if (in_type == FileTypes::IDXML)
+    FileTypes::Type in_type = FileHandler::getXMLEquivalentType(id);
+    if (in_type == FileTypes::IDXML) // idXML or omsBin
     {
-      IdXMLFile().load(id, protein_ids, peptide_ids);
+      FileHandler().loadIdentifications(id, protein_ids, peptide_ids);
     }
     else if (in_type == FileTypes::MZIDENTML)
     {
@@ -199,7 +199,7 @@ protected:
     String in = getStringOption_("in");
     String spectra = getStringOption_("spectra:in");
     String out = getStringOption_("out");
-    in_type = FileHandler::getType(in);
+    in_type = FileHandler::getXMLEquivalentType(in);
     //----------------------------------------------------------------
     //create mapper
     //----------------------------------------------------------------
@@ -219,9 +219,9 @@ protected:
     if (in_type == FileTypes::CONSENSUSXML)
     {
       // OPENMS_LOG_DEBUG << "Processing consensus map..." << endl;
-      ConsensusXMLFile file;
+      FileHandler file;
       ConsensusMap map;
-      file.load(in, map);
+      file.loadConsensusFeatures(in, map);
 
       PeakMap exp;
       if (!spectra.empty())
@@ -242,7 +242,7 @@ protected:
       // sort list of peptide identifications in each consensus feature by map index
       map.sortPeptideIdentificationsByMapIndex();
 
-      file.store(out, map);
+      file.storeConsensusFeatures(out, map);
     }
 
     //----------------------------------------------------------------
@@ -252,8 +252,8 @@ protected:
     {
       // OPENMS_LOG_DEBUG << "Processing feature map..." << endl;
       FeatureMap map;
-      FeatureXMLFile file;
-      file.load(in, map);
+      FileHandler file;
+      file.loadFeatures(in, map);
 
       PeakMap exp;
 
@@ -270,7 +270,7 @@ protected:
       //annotate output with data processing info
       addDataProcessing_(map, getProcessingInfo_(DataProcessing::IDENTIFICATION_MAPPING));
 
-      file.store(out, map);
+      file.storeFeatures(out, map);
     }
 
     //----------------------------------------------------------------
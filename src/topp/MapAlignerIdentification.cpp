@@ -115,9 +115,31 @@ public:
   }
 
 private:
-  template <typename MapType, typename FileType>
+  // feature and consensus maps are read and written through FileHandler
+  // (XML or binary omsBin, depending on the file):
+  void loadMap_(FileHandler& handler, const String& filename, FeatureMap& map)
+  {
+    handler.loadFeatures(filename, map);
+  }
+
+  void loadMap_(FileHandler& handler, const String& filename, ConsensusMap& map)
+  {
+    handler.loadConsensusFeatures(filename, map);
+  }
+
+  void storeMap_(FileHandler& handler, const String& filename, const FeatureMap& map)
+  {
+    handler.storeFeatures(filename, map);
+  }
+
+  void storeMap_(FileHandler& handler, const String& filename, const ConsensusMap& map)
+  {
+    handler.storeConsensusFeatures(filename, map);
+  }
+
+  template <typename MapType>
   void loadInitialMaps_(vector<MapType>& maps, StringList& ins, 
-                        FileType& input_file)
+                        FileHandler& input_file)
   {
     // custom progress logger for this task:
     ProgressLogger progresslogger;
@@ -126,16 +148,16 @@ private:
     for (Size i = 0; i < ins.size(); ++i)
     {
       progresslogger.setProgress(i);
-      input_file.load(ins[i], maps[i]);
+      loadMap_(input_file, ins[i], maps[i]);
     }
     progresslogger.endProgress();
   }
 
   // helper function to avoid code duplication between consensusXML and
   // featureXML storage operations:
-  template <typename MapType, typename FileType>
+  template <typename MapType>
   void storeTransformedMaps_(vector<MapType>& maps, StringList& outs, 
-                             FileType& output_file)
+                             FileHandler& output_file)
   {
     // custom progress logger for this task:
     ProgressLogger progresslogger;
@@ -147,7 +169,7 @@ private:
       // annotate output with data processing info:
       addDataProcessing_(maps[i], 
                          getProcessingInfo_(DataProcessing::ALIGNMENT));
-      output_file.store(outs[i], maps[i]);
+      storeMap_(output_file, outs[i], maps[i]);
     }
     progresslogger.endProgress();
   }
@@ -210,7 +232,7 @@ private:
 
     if (!reference_file.empty())
     {
-      FileTypes::Type filetype = FileHandler::getType(reference_file);
+      FileTypes::Type filetype = FileHandler::getXMLEquivalentType(reference_file);
       if (filetype == FileTypes::MZML)
       {
         PeakMap experiment;
@@ -220,20 +242,20 @@ private:
       else if (filetype == FileTypes::FEATUREXML)
       {
         FeatureMap features;
-        FeatureXMLFile().load(reference_file, features);
+        FileHandler().loadFeatures(reference_file, features);
         algorithm.setReference(features);
       }
       else if (filetype == FileTypes::CONSENSUSXML)
       {
         ConsensusMap consensus;
-        ConsensusXMLFile().load(reference_file, consensus);
+        FileHandler().loadConsensusFeatures(reference_file, consensus);
         algorithm.setReference(consensus);
       }
       else if (filetype == FileTypes::IDXML)
       {
         vector<ProteinIdentification> proteins;
         vector<PeptideIdentification> peptides;
-        IdXMLFile().load(reference_file, proteins, peptides);
+        FileHandler().loadIdentifications(reference_file, proteins, peptides);
         algorithm.setReference(peptides);
       }
     }
@@ -243,7 +265,7 @@ private:
 
   void registerOptionsAndFlags_() override
   {
-    String formats = "featureXML,consensusXML,idXML";
+    String formats = "featureXML,consensusXML,idXML,omsBin";
     TOPPMapAlignerBase::registerOptionsAndFlags_(formats, REF_FLEXIBLE);
     // TODO: potentially move to base class so every aligner has to support design
     registerInputFile_("design", "<file>", "", "input file containing the experimental design", false);
@@ -284,7 +306,7 @@ private:
     StringList input_files = getStringList_("in");
     StringList output_files = getStringList_("out");
     StringList trafo_files = getStringList_("trafo_out");
-    FileTypes::Type in_type = FileHandler::getType(input_files[0]);
+    FileTypes::Type in_type = FileHandler::getXMLEquivalentType(input_files[0]);
 
     vector<TransformationDescription> transformations;
 
@@ -294,13 +316,13 @@ private:
     if (in_type == FileTypes::FEATUREXML)
     {
       vector<FeatureMap> feature_maps(input_files.size());
-      FeatureXMLFile fxml_file;
+      FileHandler fxml_file;
       if (output_files.empty())
       {
         // store only transformation descriptions, not transformed data =>
         // we can load only minimum required information:
-        fxml_file.getOptions().setLoadConvexHull(false);
-        fxml_file.getOptions().setLoadSubordinates(false);
+        fxml_file.getFeatOptions().setLoadConvexHull(false);
+        fxml_file.getFeatOptions().setLoadSubordinates(false);
       }
       loadInitialMaps_(feature_maps, input_files, fxml_file);
 
@@ -392,7 +414,7 @@ private:
     else if (in_type == FileTypes::CONSENSUSXML)
     {
       std::vector<ConsensusMap> consensus_maps(input_files.size());
-      ConsensusXMLFile cxml_file;
+      FileHandler cxml_file;
       loadInitialMaps_(consensus_maps, input_files, cxml_file);
 
       performAlignment_(algorithm, consensus_maps, transformations,
@@ -412,7 +434,7 @@ private:
     {
       vector<vector<ProteinIdentification> > protein_ids(input_files.size());
       vector<vector<PeptideIdentification> > peptide_ids(input_files.size());
-      IdXMLFile idxml_file;
+      FileHandler idxml_file;
       ProgressLogger progresslogger;
       progresslogger.setLogType(log_type_);
       progresslogger.startProgress(0, input_files.size(),
@@ -420,7 +442,7 @@ private:
       for (Size i = 0; i < input_files.size(); ++i)
       {
         progresslogger.setProgress(i);
-        idxml_file.load(input_files[i], protein_ids[i], peptide_ids[i]);
+        idxml_file.loadIdentifications(input_files[i], protein_ids[i], peptide_ids[i]);
       }
       progresslogger.endProgress();
 
@@ -435,7 +457,7 @@ private:
         for (Size i = 0; i < output_files.size(); ++i)
         {
           progresslogger.setProgress(i);
-          idxml_file.store(output_files[i], protein_ids[i], peptide_ids[i]);
+          idxml_file.storeIdentifications(output_files[i], protein_ids[i], peptide_ids[i]);
         }
         progresslogger.endProgress();
       }
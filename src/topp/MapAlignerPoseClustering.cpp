@@ -85,7 +85,7 @@ using namespace std;
   applied to. The alignment algorithm implemented here is the pose clustering
   algorithm as described in doi:10.1093/bioinformatics/btm209. It is used to
   find an affine transformation, which is further refined by a feature grouping
-  step.  This algorithm can be applied to features (featureXML) and peaks
+  step.  This algorithm can be applied to features (featureXML or omsBin) and peaks
   (mzML), but it has mostly been developed and tested on features.  For more
   details and algorithm-specific parameters (set in the INI file) see "Detailed
   Description" in the @ref OpenMS::MapAlignmentAlgorithmPoseClustering "algorithm documentation".
@@ -118,7 +118,7 @@ public:
 protected:
   void registerOptionsAndFlags_() override
   {
-    TOPPMapAlignerBase::registerOptionsAndFlags_("featureXML,mzML",
+    TOPPMapAlignerBase::registerOptionsAndFlags_("featureXML,mzML,omsBin",
                                                  REF_RESTRICTED);
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
@@ -150,7 +150,7 @@ protected:
     Size reference_index = getIntOption_("reference:index");
     String reference_file = getStringOption_("reference:file");
 
-    FileTypes::Type in_type = FileHandler::getType(in_files[0]);
+    FileTypes::Type in_type = FileHandler::getXMLEquivalentType(in_files[0]);
     String file;
     if (!reference_file.empty())
     {
@@ -172,7 +172,16 @@ protected:
         Size s = 0;
         if (in_type == FileTypes::FEATUREXML) 
         {
-          s = f.loadSize(in_files[i]);
+          if (FileHandler::getType(in_files[i]) == FileTypes::OMSBIN)
+          {
+            FeatureMap map; // omsBin files can only be loaded completely
+            FileHandler().loadFeatures(in_files[i], map);
+            s = map.size();
+          }
+          else
+          {
+            s = f.loadSize(in_files[i]);
+          }
         }
         else if (in_type == FileTypes::MZML) // this is expensive!
         {
@@ -191,19 +200,19 @@ protected:
       file = in_files[reference_index];
     }
 
-    FeatureXMLFile f_fxml;
+    FileHandler f_fxml;
     if (out_files.empty()) // no need to store featureXML, thus we can load only minimum required information
     {
-      f_fxml.getOptions().setLoadConvexHull(false);
-      f_fxml.getOptions().setLoadSubordinates(false);
+      f_fxml.getFeatOptions().setLoadConvexHull(false);
+      f_fxml.getFeatOptions().setLoadSubordinates(false);
     }
     if (in_type == FileTypes::FEATUREXML)
     {
       FeatureMap map_ref;
-      FeatureXMLFile f_fxml_tmp; // for the reference, we never need CH or subordinates
-      f_fxml_tmp.getOptions().setLoadConvexHull(false);
-      f_fxml_tmp.getOptions().setLoadSubordinates(false);
-      f_fxml_tmp.load(file, map_ref);
+      FileHandler f_fxml_tmp; // for the reference, we never need CH or subordinates
+      f_fxml_tmp.getFeatOptions().setLoadConvexHull(false);
+      f_fxml_tmp.getFeatOptions().setLoadSubordinates(false);
+      f_fxml_tmp.loadFeatures(file, map_ref);
       algorithm.setReference(map_ref);
     }
     else if (in_type == FileTypes::MZML)
@@ -228,10 +237,10 @@ protected:
       if (in_type == FileTypes::FEATUREXML)
       {
         FeatureMap map;
-        // workaround for loading: use temporary FeatureXMLFile since it is not thread-safe
-        FeatureXMLFile f_fxml_tmp; // do not use OMP-firstprivate, since FeatureXMLFile has no copy c'tor
-        f_fxml_tmp.getOptions() = f_fxml.getOptions();
-        f_fxml_tmp.load(in_files[i], map);
+        // workaround for loading: use a temporary FileHandler since the file classes are not thread-safe
+        FileHandler f_fxml_tmp;
+        f_fxml_tmp.setFeatOptions(f_fxml.getFeatOptions());
+        f_fxml_tmp.loadFeatures(in_files[i], map);
         if (i == static_cast<int>(reference_index)) trafo.fitModel("identity");
         else algorithm.align(map, trafo);
         if (out_files.size())
@@ -239,7 +248,7 @@ protected:
           MapAlignmentTransformer::transformRetentionTimes(map, trafo);
           // annotate output with data processing info
           addDataProcessing_(map, getProcessingInfo_(DataProcessing::ALIGNMENT));
-          f_fxml_tmp.store(out_files[i], map);
+          f_fxml_tmp.storeFeatures(out_files[i], map);
         }
       }
       else if (in_type == FileTypes::MZML)
@@ -36,11 +36,9 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilter.h>
-#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/APPLICATIONS/PeakMapProcessingBase.h>
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 
-#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
-
 using namespace OpenMS;
 using namespace std;
 
@@ -90,43 +88,14 @@ using namespace std;
 
 
 class TOPPNoiseFilterGaussian :
-  public TOPPBase
+  public TOPPPeakMapProcessingBase
 {
 public:
   TOPPNoiseFilterGaussian() :
-    TOPPBase("NoiseFilterGaussian", "Removes noise from profile spectra by using Gaussian filter (on uniform as well as non-uniform data).")
+    TOPPPeakMapProcessingBase("NoiseFilterGaussian", "Removes noise from profile spectra by using Gaussian filter (on uniform as well as non-uniform data).")
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFGaussMzMLConsumer :
-    public MSDataWritingConsumer 
-  {
-
-  public:
-
-    NFGaussMzMLConsumer(const String& filename, const GaussFilter& gf) :
-      MSDataWritingConsumer(filename) 
-    {
-      gf_ = gf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      gf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) override 
-    {
-      gf_.filter(c);
-    }
-
-  private:
-    GaussFilter gf_;
-  };
-
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input raw data file ");
@@ -134,8 +103,7 @@ public:
     registerOutputFile_("out", "<file>", "", "output raw data file ");
     setValidFormats_("out", ListUtils::create<String>("mzML"));
 
-    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
-    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+    registerProcessOption_();
 
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
@@ -145,32 +113,13 @@ public:
     return GaussFilter().getDefaults();
   }
 
-  ExitCodes doLowMemAlgorithm(const GaussFilter& gauss)
-  {
-    ///////////////////////////////////
-    // Create the consumer object, add data processing
-    ///////////////////////////////////
-    NFGaussMzMLConsumer gaussConsumer(out, gauss);
-    gaussConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
-
-    ///////////////////////////////////
-    // Create new MSDataReader and set our consumer
-    ///////////////////////////////////
-    MzMLFile mz_data_file;
-    mz_data_file.setLogType(log_type_);
-    mz_data_file.transform(in, &gaussConsumer);
-
-    return EXECUTION_OK;
-  }
-
   ExitCodes main_(int, const char **) override
   {
     //-------------------------------------------------------------
     // parameter handling
     //-------------------------------------------------------------
-    in = getStringOption_("in");
-    out = getStringOption_("out");
-    String process_option = getStringOption_("processOption");
+    String in = getStringOption_("in");
+    String out = getStringOption_("out");
 
     Param filter_param = getParam_().copy("algorithm:", true);
     writeDebug_("Parameters passed to filter", filter_param, 3);
@@ -179,9 +128,14 @@ public:
     gauss.setLogType(log_type_);
     gauss.setParameters(filter_param);
 
-    if (process_option == "lowmemory")
+    if (isLowMemory_())
     {
-      return doLowMemAlgorithm(gauss);
+      // spectra are smoothed in parallel blocks, each thread uses its own copy of the filter
+      ParallelExperimentProcessor processor;
+      processor.setSpectraProcessingFunc([gauss](MSSpectrum& s) mutable { gauss.filter(s); });
+      processor.setChromatogramProcessingFunc([gauss](MSChromatogram& c) mutable { gauss.filter(c); });
+      return processLowMemory_(in, out, processor, DataProcessing::SMOOTHING,
+                               CHECK_PROFILE | CHECK_SORTED_SPECTRA | CHECK_SORTED_CHROMATOGRAMS);
     }
 
     //-------------------------------------------------------------
@@ -198,30 +152,10 @@ public:
                   " contain chromatograms. This tool currently cannot handle them, sorry.";
       return INCOMPATIBLE_INPUT_DATA;
     }
-    //check for peak type (profile data required)
-    if (!exp.empty() && exp[0].getType(true) == SpectrumSettings::CENTROID)
+    ExitCodes check = checkInput_(exp, CHECK_PROFILE | CHECK_SORTED_SPECTRA | CHECK_SORTED_CHROMATOGRAMS);
+    if (check != EXECUTION_OK)
     {
-      writeLog_("Warning: OpenMS peak type estimation indicates that this is not profile data!");
-    }
-
-    //check if spectra are sorted
-    for (Size i = 0; i < exp.size(); ++i)
-    {
-      if (!exp[i].isSorted())
-      {
-        writeLog_("Error: Not all spectra are sorted according to peak m/z positions. Use FileFilter to sort the input!");
-        return INCOMPATIBLE_INPUT_DATA;
-      }
-    }
-
-    //check if chromatograms are sorted
-    for (Size i = 0; i < exp.getChromatograms().size(); ++i)
-    {
-      if (!exp.getChromatogram(i).isSorted())
-      {
-        writeLog_("Error: Not all chromatograms are sorted according to peak m/z positions. Use FileFilter to sort the input!");
-        return INCOMPATIBLE_INPUT_DATA;
-      }
+      return check;
     }
 
     //-------------------------------------------------------------
@@ -248,9 +182,6 @@ public:
 
     return EXECUTION_OK;
   }
-
-  String in;
-  String out;
 };
 
 
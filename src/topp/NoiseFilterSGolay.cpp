@@ -36,11 +36,9 @@
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
-#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/APPLICATIONS/PeakMapProcessingBase.h>
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 
-#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
-
 using namespace OpenMS;
 using namespace std;
 
@@ -93,43 +91,14 @@ using namespace std;
 
 
 class TOPPNoiseFilterSGolay :
-  public TOPPBase
+  public TOPPPeakMapProcessingBase
 {
 public:
   TOPPNoiseFilterSGolay() :
-    TOPPBase("NoiseFilterSGolay", "Removes noise from profile spectra by using a Savitzky Golay filter. Requires uniform (equidistant) data.")
+    TOPPPeakMapProcessingBase("NoiseFilterSGolay", "Removes noise from profile spectra by using a Savitzky Golay filter. Requires uniform (equidistant) data.")
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFSGolayMzMLConsumer :
-    public MSDataWritingConsumer 
-  {
-
-  public:
-
-    NFSGolayMzMLConsumer(const String& filename, const SavitzkyGolayFilter& sgf) :
-      MSDataWritingConsumer(filename) 
-    {
-      sgf_ = sgf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      sgf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) override 
-    {
-      sgf_.filter(c);
-    }
-
-  private:
-    SavitzkyGolayFilter sgf_;
-  };
-
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input raw data file ");
@@ -137,8 +106,7 @@ public:
     registerOutputFile_("out", "<file>", "", "output raw data file ");
     setValidFormats_("out", ListUtils::create<String>("mzML"));
 
-    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
-    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+    registerProcessOption_();
 
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
@@ -148,32 +116,13 @@ public:
     return SavitzkyGolayFilter().getDefaults();
   }
 
-  ExitCodes doLowMemAlgorithm(const SavitzkyGolayFilter& sgolay)
-  {
-    ///////////////////////////////////
-    // Create the consumer object, add data processing
-    ///////////////////////////////////
-    NFSGolayMzMLConsumer sgolayConsumer(out, sgolay);
-    sgolayConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
-
-    ///////////////////////////////////
-    // Create new MSDataReader and set our consumer
-    ///////////////////////////////////
-    MzMLFile mz_data_file;
-    mz_data_file.setLogType(log_type_);
-    mz_data_file.transform(in, &sgolayConsumer);
-
-    return EXECUTION_OK;
-  }
-
   ExitCodes main_(int, const char **) override
   {
     //-------------------------------------------------------------
     // parameter handling
     //-------------------------------------------------------------
-    in = getStringOption_("in");
-    out = getStringOption_("out");
-    String process_option = getStringOption_("processOption");
+    String in = getStringOption_("in");
+    String out = getStringOption_("out");
 
     Param filter_param = getParam_().copy("algorithm:", true);
     writeDebug_("Parameters passed to filter", filter_param, 3);
@@ -182,9 +131,14 @@ public:
     sgolay.setLogType(log_type_);
     sgolay.setParameters(filter_param);
 
-    if (process_option == "lowmemory")
+    if (isLowMemory_())
     {
-      return doLowMemAlgorithm(sgolay);
+      // spectra are smoothed in parallel blocks, each thread uses its own copy of the filter
+      ParallelExperimentProcessor processor;
+      processor.setSpectraProcessingFunc([sgolay](MSSpectrum& s) mutable { sgolay.filter(s); });
+      processor.setChromatogramProcessingFunc([sgolay](MSChromatogram& c) mutable { sgolay.filter(c); });
+      return processLowMemory_(in, out, processor, DataProcessing::SMOOTHING,
+                               CHECK_PROFILE | CHECK_SORTED_SPECTRA | CHECK_SORTED_CHROMATOGRAMS);
     }
 
     //-------------------------------------------------------------
@@ -201,30 +155,10 @@ public:
                   " contain chromatograms. This tool currently cannot handle them, sorry.";
       return INCOMPATIBLE_INPUT_DATA;
     }
-    //check for peak type (profile data required)
-    if (!exp.empty() && exp[0].getType(true) == SpectrumSettings::CENTROID)
+    ExitCodes check = checkInput_(exp, CHECK_PROFILE | CHECK_SORTED_SPECTRA | CHECK_SORTED_CHROMATOGRAMS);
+    if (check != EXECUTION_OK)
     {
-      writeLog_("Warning: OpenMS peak type estimation indicates that this is not profile data!");
-    }
-
-    //check if spectra are sorted
-    for (Size i = 0; i < exp.size(); ++i)
-    {
-      if (!exp[i].isSorted())
-      {
-        writeLog_("Error: Not all spectra are sorted according to peak m/z positions. Use FileFilter to sort the input!");
-        return INCOMPATIBLE_INPUT_DATA;
-      }
-    }
-
-    //check if chromatograms are sorted
-    for (Size i = 0; i < exp.getChromatograms().size(); ++i)
-    {
-      if (!exp.getChromatogram(i).isSorted())
-      {
-        writeLog_("Error: Not all chromatograms are sorted according to peak m/z positions. Use FileFilter to sort the input!");
-        return INCOMPATIBLE_INPUT_DATA;
-      }
+      return check;
     }
 
     //-------------------------------------------------------------
@@ -244,9 +178,6 @@ public:
     return EXECUTION_OK;
   }
 
-  String in;
-  String out;
-
 };
 
 
@@ -37,9 +37,6 @@
 #include <OpenMS/ANALYSIS/ID/PeptideProteinResolution.h>
 #include <OpenMS/ANALYSIS/QUANTITATION/PeptideAndProteinQuant.h>
 
-#include <OpenMS/FORMAT/ConsensusXMLFile.h>
-#include <OpenMS/FORMAT/FeatureXMLFile.h>
-#include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/MzTabFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
@@ -87,6 +84,8 @@ using namespace std;
 
     <B>Input: featureXML or consensusXML</B>
 
+    Feature and consensus maps (as well as identifications, see below) can also be given as binary omsBin files (see @ref OpenMS::OMSBinFile).
+
     Quantification is based on the intensity values of the features in the input files. Feature intensities are first accumulated to peptide abundances, according to the peptide identifications annotated to the features/feature groups. Then, abundances of the peptides of a protein are averaged to compute the protein abundance.
 
     The peptide-to-protein step uses the (e.g. 3) most abundant proteotypic peptides per protein to compute the protein abundances. This is a general version of the "top 3 approach" (but only for relative quantification) described in:\n
@@ -355,9 +354,9 @@ protected:
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "Input file");
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,idXML"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,idXML,omsBin"));
     registerInputFile_("protein_groups", "<file>", "", "Protein inference results for the identification runs that were used to annotate the input (e.g. from ProteinProphet via IDFileConverter or Fido via FidoAdapter).\nInformation about indistinguishable proteins will be used for protein quantification.", false);
-    setValidFormats_("protein_groups", ListUtils::create<String>("idXML"));
+    setValidFormats_("protein_groups", ListUtils::create<String>("idXML,omsBin"));
 
     registerInputFile_("design", "<file>", "", "input file containing the experimental design", false);
     setValidFormats_("design", ListUtils::create<String>("tsv"));
@@ -732,7 +731,7 @@ protected:
     if (!protein_groups.empty()) // read protein inference data
     {
       vector<ProteinIdentification> proteins;
-      IdXMLFile().load(protein_groups, proteins, peptides_);
+      FileHandler().loadIdentifications(protein_groups, proteins, peptides_);
       if (proteins.empty() || 
           proteins[0].getIndistinguishableProteins().empty())
       {
@@ -751,7 +750,7 @@ protected:
       }
     }
 
-    FileTypes::Type in_type = FileHandler::getType(in);
+    FileTypes::Type in_type = FileHandler::getXMLEquivalentType(in);
 
     PeptideAndProteinQuant quantifier;
     algo_params_ = quantifier.getParameters();
@@ -765,7 +764,7 @@ protected:
     if (in_type == FileTypes::FEATUREXML)
     {
       FeatureMap features;
-      FeatureXMLFile().load(in, features);
+      FileHandler().loadFeatures(in, features);
       columns_headers_[0].filename = in;
 
       ed = getExperimentalDesignFeatureMap_(design_file, features);
@@ -786,7 +785,7 @@ protected:
       spectral_counting_ = true;
       vector<ProteinIdentification> proteins;
       vector<PeptideIdentification> peptides;
-      IdXMLFile().load(in, proteins, peptides);
+      FileHandler().loadIdentifications(in, proteins, peptides);
       for (Size i = 0; i < proteins.size(); ++i)
       {
         columns_headers_[i].filename = proteins[i].getSearchEngine() + "_" + proteins[i].getDateTime().toString(Qt::ISODate);
@@ -807,7 +806,7 @@ protected:
     else // consensusXML
     {
       ConsensusMap consensus;
-      ConsensusXMLFile().load(in, consensus);
+      FileHandler().loadConsensusFeatures(in, consensus);
       columns_headers_ = consensus.getColumnHeaders();
 
       ed = getExperimentalDesignConsensusMap_(design_file, consensus);
@@ -33,7 +33,7 @@
 // --------------------------------------------------------------------------
 
 
-#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/APPLICATIONS/PeakMapProcessingBase.h>
 
 #include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
 
@@ -74,11 +74,11 @@ using namespace std;
 /// @cond TOPPCLASSES
 
 class TOPPSpectraFilterNLargest :
-  public TOPPBase
+  public TOPPPeakMapProcessingBase
 {
 public:
   TOPPSpectraFilterNLargest() :
-    TOPPBase("SpectraFilterNLargest", "Applies thresholdfilter to peak spectra.")
+    TOPPPeakMapProcessingBase("SpectraFilterNLargest", "Applies thresholdfilter to peak spectra.")
   {
   }
 
@@ -91,6 +91,8 @@ protected:
     registerOutputFile_("out", "<file>", "", "output file ");
     setValidFormats_("out", ListUtils::create<String>("mzML"));
 
+    registerProcessOption_();
+
     // register one section for each algorithm
     registerSubsection_("algorithm", "Algorithm parameter subsection.");
 
@@ -111,6 +113,24 @@ protected:
     String in(getStringOption_("in"));
     String out(getStringOption_("out"));
 
+    Param filter_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Used filter parameters", filter_param, 3);
+
+    NLargest filter;
+    filter.setParameters(filter_param);
+
+    // spectra are filtered in parallel, each thread uses its own copy of the filter
+    ParallelExperimentProcessor processor;
+    processor.setLogType(log_type_);
+
+    processor.setSpectraProcessingFunc([filter](MSSpectrum& s) mutable { filter.filterPeakSpectrum(s); });
+
+    if (isLowMemory_())
+    {
+      // meta data arrays cannot be sorted, they are removed on the fly
+      return processLowMemory_(in, out, processor, DataProcessing::FILTERING, REMOVE_META_DATA_ARRAYS);
+    }
+
     //-------------------------------------------------------------
     // loading input
     //-------------------------------------------------------------
@@ -123,20 +143,12 @@ protected:
     //-------------------------------------------------------------
     // if meta data arrays are present, remove them and warn
     //-------------------------------------------------------------
-    if (exp.clearMetaDataArrays())
-    {
-      writeLog_("Warning: Spectrum meta data arrays cannot be sorted. They are deleted.");
-    }
+    checkInput_(exp, REMOVE_META_DATA_ARRAYS);
 
     //-------------------------------------------------------------
     // filter
     //-------------------------------------------------------------
-    Param filter_param = getParam_().copy("algorithm:", true);
-    writeDebug_("Used filter parameters", filter_param, 3);
-
-    NLargest filter;
-    filter.setParameters(filter_param);
-    filter.filterPeakMap(exp);
+    processor.processExperiment(exp, "filtering spectra");
 
     //-------------------------------------------------------------
     // writing output
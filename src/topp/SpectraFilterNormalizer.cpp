@@ -33,7 +33,7 @@
 // --------------------------------------------------------------------------
 
 
-#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/APPLICATIONS/PeakMapProcessingBase.h>
 
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
 
@@ -76,11 +76,11 @@ using namespace std;
 /// @cond TOPPCLASSES
 
 class TOPPSpectraFilterNormalizer :
-  public TOPPBase
+  public TOPPPeakMapProcessingBase
 {
 public:
   TOPPSpectraFilterNormalizer() :
-    TOPPBase("SpectraFilterNormalizer", "Normalizes intensity of peak spectra.")
+    TOPPPeakMapProcessingBase("SpectraFilterNormalizer", "Normalizes intensity of peak spectra.")
   {
   }
 
@@ -93,6 +93,8 @@ protected:
     registerOutputFile_("out", "<file>", "", "output file");
     setValidFormats_("out", ListUtils::create<String>("mzML"));
 
+    registerProcessOption_();
+
     // register one section for each algorithm
     registerSubsection_("algorithm", "Algorithm parameter subsection.");
 
@@ -113,6 +115,22 @@ protected:
     String in(getStringOption_("in"));
     String out(getStringOption_("out"));
 
+    Param filter_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Used filter parameters", filter_param, 3);
+
+    Normalizer filter;
+    filter.setParameters(filter_param);
+
+    // spectra are filtered in parallel, each thread uses its own copy of the filter
+    ParallelExperimentProcessor processor;
+    processor.setLogType(log_type_);
+    processor.setSpectraProcessingFunc([filter](MSSpectrum& s) { filter.filterPeakSpectrum(s); });
+
+    if (isLowMemory_())
+    {
+      return processLowMemory_(in, out, processor, DataProcessing::FILTERING, NO_CHECKS);
+    }
+
     //-------------------------------------------------------------
     // loading input
     //-------------------------------------------------------------
@@ -125,12 +143,7 @@ protected:
     //-------------------------------------------------------------
     // filter
     //-------------------------------------------------------------
-    Param filter_param = getParam_().copy("algorithm:", true);
-    writeDebug_("Used filter parameters", filter_param, 3);
-
-    Normalizer filter;
-    filter.setParameters(filter_param);
-    filter.filterPeakMap(exp);
+    processor.processExperiment(exp, "filtering spectra");
 
     //-------------------------------------------------------------
     // writing output
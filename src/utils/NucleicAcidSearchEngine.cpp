@@ -744,6 +744,14 @@ protected:
     IdentificationData::ScoreTypeRef score_ref =
       id_data.getScoreTypes().begin();
 
+    // collect results in one staging buffer per thread and register them
+    // afterwards - with the (default) static schedule, each thread processes
+    // a contiguous range of spectra, so the buffers are in spectrum order:
+    vector<IdentificationData::StagingBuffer> buffers(1);
+#ifdef _OPENMP
+    buffers.resize(omp_get_max_threads());
+#endif
+
 // @TODO: change OpenMP schedule from default ("static") to "dynamic"/"guided"?
 #pragma omp parallel for
     for (SignedSize scan_index = 0;
@@ -751,6 +759,13 @@ protected:
     {
       if (annotated_hits[scan_index].empty()) continue;
 
+#ifdef _OPENMP
+      IdentificationData::StagingBuffer& buffer =
+        buffers[omp_get_thread_num()];
+#else
+      IdentificationData::StagingBuffer& buffer = buffers[0];
+#endif
+
       const MSSpectrum& spectrum = exp[scan_index];
       IdentificationData::DataQuery query(spectrum.getNativeID(), file_ref,
                                           spectrum.getRT(),
@@ -758,9 +773,7 @@ protected:
       query.setMetaValue("scan_index", static_cast<unsigned int>(scan_index));
       query.setMetaValue("precursor_intensity",
                          spectrum.getPrecursors()[0].getIntensity());
-      IdentificationData::DataQueryRef query_ref;
-#pragma omp critical (id_data_access)
-      query_ref = id_data.registerDataQuery(query);
+      Size query_index = buffer.addDataQuery(query);
 
       if (resolve_ambiguous_mods_ && (annotated_hits[scan_index].size() > 1))
       {
@@ -777,14 +790,14 @@ protected:
         // transfer parent matches from unmodified oligo:
         IdentificationData::IdentifiedOligo oligo = *hit.oligo_ref;
         oligo.sequence = hit.sequence;
-        IdentificationData::IdentifiedOligoRef oligo_ref;
-#pragma omp critical (id_data_access)
-        oligo_ref = id_data.registerIdentifiedOligo(oligo);
+        Size oligo_index = buffer.addIdentifiedOligo(oligo);
 
         Int charge = hit.precursor_ref->charge;
         if ((charge > 0) && negative_mode) charge = -charge;
-        IdentificationData::MoleculeQueryMatch match(oligo_ref, query_ref,
-                                                     charge);
+        // references to query and oligo are set when the buffer is committed:
+        IdentificationData::MoleculeQueryMatch match(
+          IdentificationData::IdentifiedOligoRef(),
+          IdentificationData::DataQueryRef(), charge);
         match.addScore(score_ref, score, id_data.getCurrentProcessingStep());
         match.peak_annotations[id_data.getCurrentProcessingStep()] =
           hit.annotations;
@@ -796,10 +809,12 @@ protected:
         {
           match.setMetaValue("adduct", hit.precursor_ref->adduct);
         }
-#pragma omp critical (id_data_access)
-        id_data.registerMoleculeQueryMatch(match);
+        buffer.addMoleculeQueryMatch(match, query_index,
+                                     IdentificationData::MoleculeType::RNA,
+                                     oligo_index);
       }
     }
+    id_data.commitStagingBuffers(buffers);
     id_data.cleanup();
   }
 
@@ -466,6 +466,7 @@ protected:
 
     registerInputFile_("swath_windows_file", "<file>", "", "Optional, tab-separated file containing the SWATH windows for extraction: lower_offset upper_offset. Note that the first line is a header and will be skipped.", false, true);
     registerFlag_("sort_swath_maps", "Sort input SWATH files when matching to SWATH windows from swath_windows_file", true);
+    registerFlag_("restrict_tr_to_swath_windows", "Only load precursors from a PQP transition file (-tr) that can be extracted from one of the SWATH windows of the input (reduces memory and loading time for large libraries; ignored for -sonar)", true);
 
     registerFlag_("use_ms1_traces", "Extract the precursor ion trace(s) and use for scoring", true);
     registerFlag_("enable_uis_scoring", "Enable additional scoring of identification assays", true);
@@ -806,20 +807,32 @@ protected:
     ///////////////////////////////////
     // Load the transitions
     ///////////////////////////////////
-    OpenSwath::LightTargetedExperiment transition_exp = loadTransitionList(tr_type, tr_file, tsv_reader_param);
-    OPENMS_LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
-      transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
-
-    if (tr_type == FileTypes::PQP)
+    OpenSwath::LightTargetedExperiment transition_exp;
+    auto load_transitions = [&](const std::vector<std::pair<double, double> >& precursor_windows)
     {
-      remove(out_osw.c_str());
-      if (!out_osw.empty())
-      {
-        std::ifstream  src(tr_file.c_str(), std::ios::binary);
-        std::ofstream  dst(out_osw.c_str(), std::ios::binary);
+      transition_exp = loadTransitionList(tr_type, tr_file, tsv_reader_param, precursor_windows);
+      OPENMS_LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
+        transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
 
-        dst << src.rdbuf();
+      if (tr_type == FileTypes::PQP)
+      {
+        remove(out_osw.c_str());
+        if (!out_osw.empty())
+        {
+          std::ifstream  src(tr_file.c_str(), std::ios::binary);
+          std::ofstream  dst(out_osw.c_str(), std::ios::binary);
+
+          dst << src.rdbuf();
+        }
       }
+    };
+
+    // with -restrict_tr_to_swath_windows, the transitions can only be loaded
+    // once the SWATH windows are known (see below)
+    bool restrict_tr = getFlag_("restrict_tr_to_swath_windows") && !sonar;
+    if (!restrict_tr)
+    {
+      load_transitions(std::vector<std::pair<double, double> >());
     }
 
     ///////////////////////////////////
@@ -854,6 +867,19 @@ protected:
     }
 
 
+    if (restrict_tr)
+    {
+      // SWATH windows are known now, restrict the library to the precursors
+      // that will actually be extracted
+      std::vector<std::pair<double, double> > precursor_windows;
+      for (const auto& m : swath_maps)
+      {
+        if (m.ms1) continue;
+        precursor_windows.push_back(std::make_pair(m.lower, m.upper - min_upper_edge_dist));
+      }
+      load_transitions(precursor_windows);
+    }
+
     ///////////////////////////////////
     // Get the transformation information (using iRT peptides)
     ///////////////////////////////////